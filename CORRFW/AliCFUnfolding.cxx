@@ -65,6 +65,11 @@
 // If no argument is passed to this function, then the second option   //
 // is used.                                                            //
 //                                                                     //
+// Unless smoothing is used, the Bayes iterations run on dense arrays  //
+// over the measured and true bins when these fit in memory            //
+// (::SetDenseGrid), and the randomized unfoldings of the correlated   //
+// error calculation run in parallel (::SetNThreads).                  //
+//                                                                     //
 // IMPORTANT:                                                          //
 //-----------                                                          //
 // With this approach, the efficiency map must be calculated           //
@@ -92,6 +97,10 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TRandom3.h"
+#include <vector>
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
 
 
 ClassImp(AliCFUnfolding)
@@ -130,7 +139,9 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fNThreads(0),
+  fDenseGrid(-1)
 {
   //
   // default constructor
@@ -174,7 +185,9 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fNThreads(0),
+  fDenseGrid(-1)
 {
   //
   // named constructor
@@ -353,7 +366,9 @@ void AliCFUnfolding::Unfold() {
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
-  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+  // the randomized unfoldings of the error calculation have their own dense version
+  if (fNCalcCorrErrors == 0 && UseDenseGrid()) UnfoldDense(iIterBayes,convergence);
+  else for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
 
     CreateEstMeasured(); // create measured estimate from prior
     CreateInvResponse(); // create inverse response  from prior
@@ -457,7 +472,12 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
 
 
   //Do fNRandomIterations = bayes iterations performed
-  for (int i=0; i<fNRandomIterations; i++) {
+  if (UseDenseGrid()) {
+    // the randomized unfoldings are independent : run them in parallel
+    UnfoldRandomizedDists();
+  }
+  else for (int i=0; i<fNRandomIterations; i++) {
+    // smoothing (possibly with a fit) is done on the THnSparse : stay serial
     
     // reset prior to original one
     if (fPrior) delete fPrior ;
@@ -575,6 +595,399 @@ void AliCFUnfolding::FillDeltaUnfoldedProfile() {
 
 //______________________________________________________________
 
+namespace {
+  //
+  // Flat copy of the unfolding inputs on dense cell grids of the measured and
+  // true spaces (cells include the under/overflow bins, as in THnSparse).
+  // The Bayesian iterations then run on contiguous arrays instead of THnSparse
+  // bin lookups; this also allows to run them concurrently, since THnSparse
+  // lookups are not thread-safe.
+  //
+  struct AliCFUnfoldingDenseInput {
+    std::vector<Int_t>    fSizeM;       // cells per dimension, measured space
+    std::vector<Int_t>    fSizeT;       // cells per dimension, true space
+    std::vector<Long_t>   fStrideM;
+    std::vector<Long_t>   fStrideT;
+    Long_t                fNMeasured;   // number of cells in measured space
+    Long_t                fNTrue;       // number of cells in true space
+    std::vector<Long_t>   fCondM;       // conditional matrix entries : measured cell
+    std::vector<Long_t>   fCondT;       //                              true cell
+    std::vector<Double_t> fCond;        //                              P(M|T)
+    std::vector<Double_t> fInvResponse; // inverse response, per conditional entry
+    std::vector<Long_t>   fPriorCell;   // filled prior bins : cell, value
+    std::vector<Double_t> fPriorValue;
+    std::vector<Long_t>   fEffCell;     // filled efficiency bins : cell, value, error
+    std::vector<Double_t> fEffValue;
+    std::vector<Double_t> fEffError;
+    std::vector<Long_t>   fMeasCell;    // filled measured bins : cell, value, error
+    std::vector<Double_t> fMeasValue;
+    std::vector<Double_t> fMeasError;
+  };
+
+  struct AliCFUnfoldingDenseScratch {
+    std::vector<Double_t> fPrior, fEfficiency, fMeasured, fEstMeasured, fUnfolded, fInvResponse;
+  };
+
+  const Long_t kMaxDenseCells = 10000000; // largest grid for which the dense iterations are used by default
+  const Double_t kMaxToyScratchBytes = 2.e9; // memory budget of the per-thread scratch of the randomized unfoldings
+
+  Long_t FlatCell(const Int_t* coord, const std::vector<Long_t>& stride, const std::vector<Int_t>& size) {
+    //
+    // cell index of the coordinates, -1 if outside of the grid
+    //
+    Long_t cell = 0;
+    for (UInt_t i=0; i<size.size(); i++) {
+      if (coord[i]<0 || coord[i]>=size[i]) return -1;
+      cell += coord[i]*stride[i];
+    }
+    return cell;
+  }
+
+  void CellCoordinates(Long_t cell, const std::vector<Int_t>& size, Int_t* coord) {
+    //
+    // coordinates of a cell
+    //
+    for (UInt_t i=0; i<size.size(); i++) {
+      coord[i] = cell % size[i];
+      cell /= size[i];
+    }
+  }
+
+  void FillBins(const THnSparse* hist, Int_t* coord, const std::vector<Long_t>& stride, const std::vector<Int_t>& size,
+                std::vector<Long_t>& cells, std::vector<Double_t>& values, std::vector<Double_t>* errors) {
+    //
+    // lists the filled bins of hist as (cell, value, error), in bin order
+    //
+    for (Long_t iBin=0; iBin<hist->GetNbins(); iBin++) {
+      Double_t val = hist->GetBinContent(iBin,coord);
+      Long_t cell = FlatCell(coord,stride,size);
+      if (cell<0) continue;
+      cells.push_back(cell);
+      values.push_back(val);
+      if (errors) errors->push_back(hist->GetBinError(iBin));
+    }
+  }
+
+  void BuildDenseInput(Int_t nVar, const THnSparse* conditional, const THnSparse* invResponse,
+                       const THnSparse* prior, const THnSparse* efficiency, const THnSparse* measured,
+                       AliCFUnfoldingDenseInput& in) {
+    //
+    // the grid is defined by the response axes : 0 -> N-1 measured, N -> 2N-1 true
+    //
+    in.fSizeM.resize(nVar); in.fSizeT.resize(nVar);
+    in.fStrideM.resize(nVar); in.fStrideT.resize(nVar);
+    in.fNMeasured = 1; in.fNTrue = 1;
+    for (Int_t iVar=0; iVar<nVar; iVar++) {
+      in.fSizeM[iVar] = conditional->GetAxis(iVar)     ->GetNbins()+2;
+      in.fSizeT[iVar] = conditional->GetAxis(iVar+nVar)->GetNbins()+2;
+      in.fStrideM[iVar] = in.fNMeasured; in.fNMeasured *= in.fSizeM[iVar];
+      in.fStrideT[iVar] = in.fNTrue;     in.fNTrue     *= in.fSizeT[iVar];
+    }
+
+    std::vector<Int_t> coord(2*nVar);
+    for (Long_t iBin=0; iBin<conditional->GetNbins(); iBin++) {
+      Double_t conditionalValue = conditional->GetBinContent(iBin,&coord[0]);
+      Long_t cellM = FlatCell(&coord[0],   in.fStrideM,in.fSizeM);
+      Long_t cellT = FlatCell(&coord[nVar],in.fStrideT,in.fSizeT);
+      if (cellM<0 || cellT<0) continue;
+      in.fCondM.push_back(cellM);
+      in.fCondT.push_back(cellT);
+      in.fCond.push_back(conditionalValue);
+      in.fInvResponse.push_back(invResponse->GetBinContent(&coord[0]));
+    }
+
+    FillBins(prior,     &coord[0],in.fStrideT,in.fSizeT,in.fPriorCell,in.fPriorValue,0x0);
+    FillBins(efficiency,&coord[0],in.fStrideT,in.fSizeT,in.fEffCell,  in.fEffValue,  &in.fEffError);
+    FillBins(measured,  &coord[0],in.fStrideM,in.fSizeM,in.fMeasCell, in.fMeasValue, &in.fMeasError);
+  }
+
+  void InitDenseScratch(const AliCFUnfoldingDenseInput& in, AliCFUnfoldingDenseScratch& s) {
+    //
+    // prior and inverse response from the input; efficiency and measured are filled by the caller
+    //
+    s.fPrior.assign(in.fNTrue,0.);
+    for (UInt_t i=0; i<in.fPriorCell.size(); i++) s.fPrior[in.fPriorCell[i]] = in.fPriorValue[i];
+    s.fInvResponse = in.fInvResponse;
+    s.fEfficiency.assign(in.fNTrue,0.);
+    s.fMeasured.assign(in.fNMeasured,0.);
+  }
+
+  void BayesIteration(const AliCFUnfoldingDenseInput& in, AliCFUnfoldingDenseScratch& s) {
+    //
+    // one Bayes iteration : same as CreateEstMeasured(), CreateInvResponse() and CreateUnfolded(),
+    // the unfolded spectrum is left in s.fUnfolded
+    //
+    const UInt_t nCond = in.fCond.size();
+
+    s.fEstMeasured.assign(in.fNMeasured,0.);
+    for (UInt_t k=0; k<nCond; k++) {
+      Double_t fill = in.fCond[k] * (s.fPrior[in.fCondT[k]]*s.fEfficiency[in.fCondT[k]]);
+      if (fill>0.) s.fEstMeasured[in.fCondM[k]] += fill;
+    }
+
+    for (UInt_t k=0; k<nCond; k++) {
+      Double_t estMeasuredValue = s.fEstMeasured[in.fCondM[k]];
+      Double_t fill = (estMeasuredValue>0. ? in.fCond[k] * (s.fPrior[in.fCondT[k]]*s.fEfficiency[in.fCondT[k]]) / estMeasuredValue : 0.);
+      if (fill>0. || s.fInvResponse[k]>0.) s.fInvResponse[k] = fill;
+    }
+
+    s.fUnfolded.assign(in.fNTrue,0.);
+    for (UInt_t k=0; k<nCond; k++) {
+      Double_t effValue = s.fEfficiency[in.fCondT[k]];
+      Double_t fill = (effValue>0. ? s.fInvResponse[k] * s.fMeasured[in.fCondM[k]] / effValue : 0.);
+      if (fill>0.) s.fUnfolded[in.fCondT[k]] += fill;
+    }
+  }
+
+  struct AliCFUnfoldingToys {
+    const AliCFUnfoldingDenseInput* fInput;  // original prior, efficiency and measured
+    Int_t                           fNIterations;
+    std::vector<Long_t>             fFinalCell;   // bins of the final unfolded spectrum : cell (-1 if outside), value
+    std::vector<Double_t>           fFinalValue;
+  };
+
+  void UnfoldToy(const AliCFUnfoldingToys& toys, TRandom3* random, AliCFUnfoldingDenseScratch& s, Double_t* delta) {
+    //
+    // Same steps as AliCFUnfolding::CreateRandomizedDist() followed by Unfold() and
+    // FillDeltaUnfoldedProfile(), on the dense grids
+    // The randomized response is not drawn : the conditional matrix is built once in Init()
+    //
+    const AliCFUnfoldingDenseInput& in = *toys.fInput;
+    InitDenseScratch(in,s);
+    for (UInt_t i=0; i<in.fEffCell.size(); i++)  s.fEfficiency[in.fEffCell[i]] = random->Gaus(in.fEffValue[i],in.fEffError[i]);
+    for (UInt_t i=0; i<in.fMeasCell.size(); i++) s.fMeasured[in.fMeasCell[i]]  = random->Gaus(in.fMeasValue[i],in.fMeasError[i]);
+
+    for (Int_t iIterBayes=0; iIterBayes<toys.fNIterations; iIterBayes++) {
+      BayesIteration(in,s);
+      s.fPrior.swap(s.fUnfolded); // update the prior distribution
+    }
+
+    // the last unfolded spectrum is now in s.fPrior
+    for (UInt_t i=0; i<toys.fFinalCell.size(); i++)
+      delta[i] = toys.fFinalValue[i] - (toys.fFinalCell[i]>=0 ? s.fPrior[toys.fFinalCell[i]] : 0.);
+  }
+
+  void UnfoldToys(const AliCFUnfoldingToys* toys, TRandom3** random, Int_t first, Int_t last, Int_t step,
+                  AliCFUnfoldingDenseScratch* s, Double_t* deltas) {
+    //
+    // runs the toys first, first+step, ... < last ; deltas holds one row per toy of the batch
+    //
+    const Long_t nFinal = toys->fFinalCell.size();
+    for (Int_t iToy=first; iToy<last; iToy+=step) UnfoldToy(*toys,random[iToy],*s,deltas+iToy*nFinal);
+  }
+}
+
+//______________________________________________________________
+Bool_t AliCFUnfolding::UseDenseGrid() const {
+  //
+  // whether the Bayes iterations run on dense grids (see SetDenseGrid)
+  //
+  if (fUseSmoothing)  return kFALSE; // smoothing works on the THnSparse
+  if (fDenseGrid>=0)  return fDenseGrid>0;
+
+  Long_t nMeasured = 1, nTrue = 1;
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+    nMeasured *= fConditional->GetAxis(iVar)            ->GetNbins()+2;
+    nTrue     *= fConditional->GetAxis(iVar+fNVariables)->GetNbins()+2;
+  }
+  return (nMeasured<=kMaxDenseCells && nTrue<=kMaxDenseCells);
+}
+
+//______________________________________________________________
+void AliCFUnfolding::UnfoldDense(Int_t &iIterBayes, Double_t &convergence) {
+  //
+  // Bayes iterations of Unfold() on dense grids.
+  // The results are written back to fUnfolded, fPrior, fMeasuredEstimate and fInverseResponse
+  // as if they had been obtained with the THnSparse.
+  //
+
+  iIterBayes  = 0;
+  convergence = 0.;
+  if (fMaxNumIterations<=0) return;
+
+  AliCFUnfoldingDenseInput in;
+  BuildDenseInput(fNVariables,fConditional,fInverseResponse,fPrior,fEfficiency,fMeasured,in);
+
+  AliCFUnfoldingDenseScratch s;
+  InitDenseScratch(in,s);
+  for (UInt_t i=0; i<in.fEffCell.size(); i++)  s.fEfficiency[in.fEffCell[i]] = in.fEffValue[i];
+  for (UInt_t i=0; i<in.fMeasCell.size(); i++) s.fMeasured[in.fMeasCell[i]]  = in.fMeasValue[i];
+
+  Bool_t converged = kFALSE;
+
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+
+    BayesIteration(in,s);
+
+    // GetConvergence() : loop on the filled prior bins, which are the given ones at the first
+    // iteration, then those of the previous unfolded spectrum (all positive)
+    convergence = 0.;
+    if (iIterBayes==0) {
+      for (UInt_t i=0; i<in.fPriorCell.size(); i++) {
+        Double_t priorValue   = s.fPrior[in.fPriorCell[i]];
+        Double_t currentValue = s.fUnfolded[in.fPriorCell[i]];
+        if (priorValue > 0.) convergence += ((priorValue-currentValue)/priorValue)*((priorValue-currentValue)/priorValue);
+        else AliWarning(Form("priorValue = %f. Adding 0 to convergence criterion.",priorValue));
+      }
+    }
+    else {
+      for (Long_t cell=0; cell<in.fNTrue; cell++) {
+        Double_t priorValue = s.fPrior[cell];
+        if (priorValue > 0.) convergence += ((priorValue-s.fUnfolded[cell])/priorValue)*((priorValue-s.fUnfolded[cell])/priorValue);
+      }
+    }
+    AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+
+    if (fMaxConvergence>0. && convergence<fMaxConvergence) {
+      fNRandomIterations = iIterBayes;
+      AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+      converged = kTRUE;
+      break;
+    }
+
+    // update the prior distribution
+    s.fPrior.swap(s.fUnfolded);
+  } // end bayes iteration
+
+  // back to THnSparse
+  if (!converged) s.fUnfolded = s.fPrior;
+  std::vector<Int_t> coord(2*fNVariables);
+
+  fUnfolded->Reset();
+  for (Long_t cell=0; cell<in.fNTrue; cell++) {
+    if (!(s.fUnfolded[cell]>0.)) continue;
+    CellCoordinates(cell,in.fSizeT,&coord[0]);
+    fUnfolded->SetBinError  (&coord[0],0.);
+    fUnfolded->AddBinContent(&coord[0],s.fUnfolded[cell]);
+  }
+
+  if (fPrior) delete fPrior ;
+  if (converged) {
+    fPrior = (THnSparse*)fUnfolded->Clone() ;
+    fPrior->Reset();
+    for (Long_t cell=0; cell<in.fNTrue; cell++) {
+      if (s.fPrior[cell]==0.) continue;
+      CellCoordinates(cell,in.fSizeT,&coord[0]);
+      fPrior->SetBinContent(&coord[0],s.fPrior[cell]);
+    }
+  }
+  else fPrior = (THnSparse*)fUnfolded->Clone() ;
+  fPrior->SetTitle("Prior");
+
+  fMeasuredEstimate->Reset();
+  for (Long_t cell=0; cell<in.fNMeasured; cell++) {
+    if (!(s.fEstMeasured[cell]>0.)) continue;
+    CellCoordinates(cell,in.fSizeM,&coord[0]);
+    fMeasuredEstimate->AddBinContent(&coord[0],s.fEstMeasured[cell]);
+    fMeasuredEstimate->SetBinError  (&coord[0],0.);
+  }
+
+  for (UInt_t k=0; k<in.fCond.size(); k++) {
+    if (s.fInvResponse[k]==in.fInvResponse[k]) continue;
+    CellCoordinates(in.fCondM[k],in.fSizeM,&coord[0]);
+    CellCoordinates(in.fCondT[k],in.fSizeT,&coord[fNVariables]);
+    fInverseResponse->SetBinContent(&coord[0],s.fInvResponse[k]);
+    fInverseResponse->SetBinError  (&coord[0],0.);
+  }
+}
+
+//______________________________________________________________
+void AliCFUnfolding::UnfoldRandomizedDists() {
+  //
+  // Parallel version of the randomized unfoldings of CalculateCorrelatedErrors(), on dense grids.
+  // Each toy has its own random number stream, seeded from one number drawn from fRandom3 and
+  // the toy number, so the result is reproducible for a given fRandomSeed and does not depend
+  // on the number of threads.
+  // Each thread holds its own copy of the prior, efficiency, measured, estimated measured and
+  // unfolded grids and of the inverse response : the number of threads is reduced if these
+  // exceed kMaxToyScratchBytes in total.
+  // The toys are run in batches; the deltas of a batch are added to fDeltaUnfoldedP in toy order.
+  //
+
+  AliCFUnfoldingDenseInput in;
+  BuildDenseInput(fNVariables,fConditional,fInverseResponse,fPriorOrig,fEfficiencyOrig,fMeasuredOrig,in);
+
+  AliCFUnfoldingToys toys;
+  toys.fInput      = &in;
+  toys.fNIterations = fMaxNumIterations;
+
+  // running mean and mean square of the deltas, per bin of the final spectrum
+  const Long_t nFinal = fUnfoldedFinal->GetNbins();
+  std::vector<Double_t> mean(nFinal,0.), meanx2(nFinal,0.), entries(nFinal,0.);
+  for (Long_t iBin=0; iBin<nFinal; iBin++) {
+    Double_t val = fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_T);
+    toys.fFinalCell.push_back(FlatCell(fCoordinatesN_T,in.fStrideT,in.fSizeT));
+    toys.fFinalValue.push_back(val);
+    mean[iBin]    = fDeltaUnfoldedP->GetBinContent(fCoordinatesN_T);
+    meanx2[iBin]  = fDeltaUnfoldedP->GetBinError(fCoordinatesN_T);
+    entries[iBin] = fDeltaUnfoldedN->GetBinContent(fCoordinatesN_T);
+  }
+
+  Int_t nThreads = fNThreads;
+#if __cplusplus >= 201103L
+  if (nThreads<=0) nThreads = std::thread::hardware_concurrency();
+#endif
+  if (nThreads<=0) nThreads = 1;
+  if (nThreads>fNRandomIterations) nThreads = TMath::Max(fNRandomIterations,1);
+  const Double_t scratchBytes = sizeof(Double_t) * (4.*in.fNTrue + 2.*in.fNMeasured + in.fCond.size());
+  const Int_t maxThreads = TMath::Max(1,(Int_t)TMath::Min(kMaxToyScratchBytes/scratchBytes,1.e6));
+  if (nThreads>maxThreads) {
+    AliWarning(Form("Scratch of %.0f MB per thread, limiting the number of threads from %d to %d",scratchBytes/1.e6,nThreads,maxThreads));
+    nThreads = maxThreads;
+  }
+  AliInfo(Form("Unfolding %d randomized distributions with %d thread(s)",fNRandomIterations,nThreads));
+
+  const Int_t batchSize = 4*nThreads;
+  std::vector<AliCFUnfoldingDenseScratch> scratch(nThreads);
+  std::vector<TRandom3*> random(batchSize,(TRandom3*)0x0);
+  std::vector<Double_t> deltas(batchSize*nFinal);
+
+  // base of the toy seeds, drawn once so that the toys are reproducible as the serial version
+  const UInt_t seedBase = fRandom3->Integer(kMaxUInt);
+
+  for (Int_t firstToy=0; firstToy<fNRandomIterations; firstToy+=batchSize) {
+    const Int_t nToys = TMath::Min(batchSize,fNRandomIterations-firstToy);
+
+    // the random streams are created here, outside of the threads
+    for (Int_t iToy=0; iToy<nToys; iToy++) {
+      delete random[iToy];
+      UInt_t seed = seedBase+firstToy+iToy;
+      random[iToy] = new TRandom3(seed ? seed : 1); // seed 0 would be time dependent
+    }
+
+#if __cplusplus >= 201103L
+    std::vector<std::thread> threads;
+    for (Int_t iThread=1; iThread<nThreads; iThread++)
+      threads.push_back(std::thread(UnfoldToys,&toys,&random[0],iThread,nToys,nThreads,&scratch[iThread],&deltas[0]));
+    UnfoldToys(&toys,&random[0],0,nToys,nThreads,&scratch[0],&deltas[0]);
+    for (UInt_t iThread=0; iThread<threads.size(); iThread++) threads[iThread].join();
+#else
+    UnfoldToys(&toys,&random[0],0,nToys,1,&scratch[0],&deltas[0]);
+#endif
+
+    // same update as FillDeltaUnfoldedProfile(), in toy order
+    for (Int_t iToy=0; iToy<nToys; iToy++) {
+      const Double_t* delta = &deltas[iToy*nFinal];
+      for (Long_t iBin=0; iBin<nFinal; iBin++) {
+        Double_t deltaInBin = delta[iBin];
+        mean[iBin]   = (mean[iBin]  *entries[iBin] + deltaInBin)            / (entries[iBin]+1);
+        meanx2[iBin] = (meanx2[iBin]*entries[iBin] + deltaInBin*deltaInBin) / (entries[iBin]+1);
+        entries[iBin] += 1;
+      }
+    }
+  }
+  for (UInt_t iToy=0; iToy<random.size(); iToy++) delete random[iToy];
+
+  for (Long_t iBin=0; iBin<nFinal; iBin++) {
+    fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_T);
+    fDeltaUnfoldedP->SetBinError  (fCoordinatesN_T,meanx2[iBin]);
+    fDeltaUnfoldedP->SetBinContent(fCoordinatesN_T,mean[iBin]);
+    fDeltaUnfoldedN->SetBinContent(fCoordinatesN_T,entries[iBin]);
+  }
+}
+
+//______________________________________________________________
+
 void AliCFUnfolding::GetCoordinates() {
   //
   // assign coordinates in Measured and True spaces (dim=N) from coordinates in global space (dim=2N)
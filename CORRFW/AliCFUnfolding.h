@@ -36,6 +36,10 @@ class AliCFUnfolding : public TNamed {
   }
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
+  void SetNThreads(Int_t n = 0) {fNThreads = n;} // threads used for the correlated errors; 0 means one per core
+                                                  // each thread needs its own 6 unfolding grids : limited to 2 GB in total
+  void SetDenseGrid(Int_t mode = 1) {fDenseGrid = mode;} // Bayes iterations on dense grids : 1 = always, 0 = never,
+                                                         // -1 = if the grids are not too large (default); never with smoothing
 
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
@@ -111,6 +115,8 @@ class AliCFUnfolding : public TNamed {
   THnSparse     *fDeltaUnfoldedN;    // Entries of the delta-unfolded distribution (count for each bin)
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
+  Int_t          fNThreads;          // Number of threads running the randomized unfoldings (0 = number of cores)
+  Int_t          fDenseGrid;         // Iterate on dense grids instead of THnSparse (1), never (0), depending on the grid size (-1)
 
 
   // functions
@@ -130,9 +136,12 @@ class AliCFUnfolding : public TNamed {
   void     CalculateCorrelatedErrors(); // Calculates correlated errors for the final unfolded spectrum
   void     CreateRandomizedDist();      // Create randomized dist from measured distribution
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
+  void     UnfoldRandomizedDists();     // Unfolds the fNRandomIterations randomized distributions in parallel and fills fDeltaUnfoldedP
+  Bool_t   UseDenseGrid() const;        // Whether the iterations run on dense grids
+  void     UnfoldDense(Int_t &iIterBayes, Double_t &convergence); // Bayes iterations of Unfold() on dense grids
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  ClassDef(AliCFUnfolding,3);
 };
 
 #endif
@@ -0,0 +1,104 @@
+//
+// Class AliMixClusterSnapshot
+//
+// AliMixClusterSnapshot is compact copy of calorimeter cluster
+// kept in memory by AliMixEventSnapshotBuffer
+//
+
+#include "AliMixClusterSnapshot.h"
+
+ClassImp(AliMixClusterSnapshot)
+
+//_________________________________________________________________________________________________
+AliMixClusterSnapshot::AliMixClusterSnapshot() : AliVCluster(),
+   fEnergy(0),
+   fType(kUndef),
+   fNCells(0),
+   fTOF(0),
+   fM02(0),
+   fM20(0),
+   fDispersion(0),
+   fID(-1),
+   fLabel(-1)
+{
+   //
+   // Default constructor.
+   //
+   fPosition[0] = fPosition[1] = fPosition[2] = 0;
+}
+
+//_________________________________________________________________________________________________
+AliMixClusterSnapshot::AliMixClusterSnapshot(const AliVCluster &clus) : AliVCluster(),
+   fEnergy(0),
+   fType(kUndef),
+   fNCells(0),
+   fTOF(0),
+   fM02(0),
+   fM20(0),
+   fDispersion(0),
+   fID(-1),
+   fLabel(-1)
+{
+   //
+   // Constructor from any cluster
+   //
+   Set(clus);
+}
+
+//_________________________________________________________________________________________________
+AliMixClusterSnapshot::AliMixClusterSnapshot(const AliMixClusterSnapshot &obj) : AliVCluster(obj),
+   fEnergy(obj.fEnergy),
+   fType(obj.fType),
+   fNCells(obj.fNCells),
+   fTOF(obj.fTOF),
+   fM02(obj.fM02),
+   fM20(obj.fM20),
+   fDispersion(obj.fDispersion),
+   fID(obj.fID),
+   fLabel(obj.fLabel)
+{
+   //
+   // Copy constructor
+   //
+   for (Int_t i = 0; i < 3; i++) fPosition[i] = obj.fPosition[i];
+}
+
+//_________________________________________________________________________________________________
+AliMixClusterSnapshot &AliMixClusterSnapshot::operator=(const AliMixClusterSnapshot &obj)
+{
+   //
+   // Assigned operator
+   //
+   if (&obj != this) {
+      AliVCluster::operator=(obj);
+      fEnergy = obj.fEnergy;
+      for (Int_t i = 0; i < 3; i++) fPosition[i] = obj.fPosition[i];
+      fType = obj.fType;
+      fNCells = obj.fNCells;
+      fTOF = obj.fTOF;
+      fM02 = obj.fM02;
+      fM20 = obj.fM20;
+      fDispersion = obj.fDispersion;
+      fID = obj.fID;
+      fLabel = obj.fLabel;
+   }
+   return *this;
+}
+
+//_________________________________________________________________________________________________
+void AliMixClusterSnapshot::Set(const AliVCluster &clus)
+{
+   //
+   // Copies cluster information used in mixing
+   //
+   fEnergy = clus.E();
+   clus.GetPosition(fPosition);
+   fType = clus.GetType();
+   fNCells = clus.GetNCells();
+   fTOF = clus.GetTOF();
+   fM02 = clus.GetM02();
+   fM20 = clus.GetM20();
+   fDispersion = clus.GetDispersion();
+   fID = clus.GetID();
+   fLabel = clus.GetLabel();
+}
@@ -0,0 +1,51 @@
+//
+// Class AliMixClusterSnapshot
+//
+// AliMixClusterSnapshot is compact copy of calorimeter cluster
+// kept in memory by AliMixEventSnapshotBuffer
+//
+
+#ifndef ALIMIXCLUSTERSNAPSHOT_H
+#define ALIMIXCLUSTERSNAPSHOT_H
+
+#include "AliVCluster.h"
+
+class AliMixClusterSnapshot : public AliVCluster {
+public:
+   AliMixClusterSnapshot();
+   AliMixClusterSnapshot(const AliVCluster &clus);
+   AliMixClusterSnapshot(const AliMixClusterSnapshot &obj);
+   AliMixClusterSnapshot &operator=(const AliMixClusterSnapshot &obj);
+   virtual ~AliMixClusterSnapshot() {}
+
+   void              Set(const AliVCluster &clus);
+
+   virtual Double_t  E() const { return fEnergy; }
+   virtual void      GetPosition(Float_t *x) const { x[0] = fPosition[0]; x[1] = fPosition[1]; x[2] = fPosition[2]; }
+   virtual Char_t    GetType() const { return fType; }
+   virtual Bool_t    IsEMCAL() const { return (fType == kEMCALClusterv1); }
+   virtual Bool_t    IsPHOS() const { return (fType == kPHOSNeutral || fType == kPHOSCharged); }
+   virtual Int_t     GetNCells() const { return fNCells; }
+   virtual Double_t  GetTOF() const { return fTOF; }
+   virtual Double_t  GetM02() const { return fM02; }
+   virtual Double_t  GetM20() const { return fM20; }
+   virtual Double_t  GetDispersion() const { return fDispersion; }
+   virtual Int_t     GetID() const { return fID; }
+   virtual Int_t     GetLabel() const { return fLabel; }
+
+private:
+   Float_t     fEnergy;       // cluster energy
+   Float_t     fPosition[3];  // cluster position (global)
+   Char_t      fType;         // cluster type (AliVCluster::VClu_t)
+   Int_t       fNCells;       // number of cells
+   Float_t     fTOF;          // time of flight
+   Float_t     fM02;          // shower shape long axis
+   Float_t     fM20;          // shower shape short axis
+   Float_t     fDispersion;   // dispersion
+   Int_t       fID;           // cluster ID in original event
+   Int_t       fLabel;        // MC label
+
+   ClassDef(AliMixClusterSnapshot, 1)
+};
+
+#endif
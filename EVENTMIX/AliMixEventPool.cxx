@@ -23,7 +23,8 @@ AliMixEventPool::AliMixEventPool(const char *name, const char *title) : TNamed(n
    fListOfEventCuts(),
    fBinNumber(0),
    fBufferSize(0),
-   fMixNumber(0)
+   fMixNumber(0),
+   fBinStrides()
 {
    //
    // Default constructor.
@@ -37,7 +38,8 @@ AliMixEventPool::AliMixEventPool(const AliMixEventPool &obj) : TNamed(obj),
    fListOfEventCuts(obj.fListOfEventCuts),
    fBinNumber(obj.fBinNumber),
    fBufferSize(obj.fBufferSize),
-   fMixNumber(obj.fMixNumber)
+   fMixNumber(obj.fMixNumber),
+   fBinStrides(obj.fBinStrides)
 {
    //
    // Copy constructor
@@ -59,6 +61,7 @@ AliMixEventPool &AliMixEventPool::operator=(const AliMixEventPool &obj)
       fBinNumber = obj.fBinNumber;
       fBufferSize = obj.fBufferSize;
       fMixNumber = obj.fMixNumber;
+      fBinStrides = obj.fBinStrides;
    }
    return *this;
 }
@@ -111,10 +114,30 @@ Int_t AliMixEventPool::Init()
    fBinNumber++;
    AliDebug(AliLog::kDebug, Form("fBinnumber = %d", fBinNumber));
    AddEntryList();
+   InitBinStrides();
    AliDebug(AliLog::kDebug + 5, "->");
    return 0;
 }
 
+//_________________________________________________________________________________________________
+void AliMixEventPool::InitBinStrides()
+{
+   //
+   // Creates table of strides of cuts in flat entry list index
+   // (first cut is running fastest, same as in SetCutValuesFromBinIndex)
+   //
+   Int_t numCuts = fListOfEventCuts.GetEntriesFast();
+   fBinStrides.Set(numCuts);
+   Int_t stride = 1;
+   AliMixEventCutObj *cut;
+   for (Int_t i = 0; i < numCuts; i++) {
+      cut = (AliMixEventCutObj *) fListOfEventCuts.UncheckedAt(i);
+      fBinStrides[i] = stride;
+      stride *= cut->GetNumberOfBins();
+      AliDebug(AliLog::kDebug + 1, Form("fBinStrides[%d] %d", i, fBinStrides[i]));
+   }
+}
+
 //_________________________________________________________________________________________________
 void AliMixEventPool::CreateEntryListsRecursivly(Int_t index)
 {
@@ -167,14 +190,26 @@ Bool_t AliMixEventPool::AddEntry(Long64_t entry, AliVEvent *ev)
    //
    // Adds entry to correct entry list
    //
-   AliDebug(AliLog::kDebug + 5, "<-");
    AliDebug(AliLog::kDebug + 5, Form("AddEntry(%lld,%p)", entry, (void *)ev));
    if (entry < 0) {
       AliDebug(AliLog::kDebug, Form("Entry %lld was NOT added !!!", entry));
       return kFALSE;
    }
-   Int_t idEntryList = -1;
-   TEntryList *el =  FindEntryList(ev, idEntryList);
+   return AddEntry(entry, GetEntryListIndex(ev));
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventPool::AddEntry(Long64_t entry, Int_t idEntryList)
+{
+   //
+   // Adds entry to entry list with index idEntryList (from GetEntryListIndex)
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   if (entry < 0) {
+      AliDebug(AliLog::kDebug, Form("Entry %lld was NOT added !!!", entry));
+      return kFALSE;
+   }
+   TEntryList *el = GetEntryList(idEntryList);
    if (el) {
       el->Enter(entry);
       AliDebug(AliLog::kDebug, Form("Entry %lld was added with idEntryList %d !!!", entry, idEntryList));
@@ -191,34 +226,50 @@ TEntryList *AliMixEventPool::FindEntryList(AliVEvent *ev, Int_t &idEntryList)
    //
    // Find entrlist in list of entrlist
    //
+   idEntryList = GetEntryListIndex(ev);
+   return GetEntryList(idEntryList);
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventPool::GetEntryListIndex(AliVEvent *ev)
+{
+   //
+   // Returns index of entry list (starting from 1) for event.
+   // Returns -1 when event is out of range of any cut.
+   // Index can be computed once per event and used in AddEntry and GetEntryList
+   //
    AliDebug(AliLog::kDebug + 5, "<-");
    Int_t num = fListOfEventCuts.GetEntriesFast();
-   if (num < 1) return 0;
-   Int_t *indexes = new Int_t[num] ;
-   Int_t *lenght = new Int_t[num];
-   Int_t i = 0;
-   TObjArrayIter next(&fListOfEventCuts);
+   if (num < 1) return -1;
+   if (fBinStrides.GetSize() != num) InitBinStrides();
+   Int_t idEntryList = 0;
+   Int_t index;
    AliMixEventCutObj *cut;
-   while ((cut = (AliMixEventCutObj *) next())) {
-      indexes[i] = cut->GetIndex(ev);
-      if (indexes[i] < 0) {
+   for (Int_t i = 0; i < num; i++) {
+      cut = (AliMixEventCutObj *) fListOfEventCuts.UncheckedAt(i);
+      index = cut->GetIndex(ev);
+      if (index < 0) {
          AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
-         delete [] indexes;
-         delete [] lenght;
-         return 0;
+         return -1;
       }
-      lenght[i] = cut->GetNumberOfBins();
-      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, indexes[i]));
-      i++;
+      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, index));
+      idEntryList += (index - 1) * fBinStrides[i];
    }
-   idEntryList = 0;
-   SearchIndexRecursive(fListOfEventCuts.GetEntries() - 1, &indexes[0], &lenght[0], idEntryList);
+   // index which start with 1 (idEntryList-1 is index in fListOfEntryList)
+   idEntryList++;
    AliDebug(AliLog::kDebug, Form("idEntryList %d", idEntryList - 1));
-   // index which start with 0 (idEntryList-1)
-   delete [] indexes;
-   delete [] lenght;
    AliDebug(AliLog::kDebug + 5, "->");
-   return (TEntryList *) fListOfEntryList.At(idEntryList - 1);
+   return idEntryList;
+}
+
+//_________________________________________________________________________________________________
+TEntryList *AliMixEventPool::GetEntryList(Int_t idEntryList) const
+{
+   //
+   // Returns entry list for index from GetEntryListIndex (0 if out of range)
+   //
+   if (idEntryList < 1 || idEntryList > fListOfEntryList.GetEntriesFast()) return 0;
+   return (TEntryList *) fListOfEntryList.UncheckedAt(idEntryList - 1);
 }
 
 //_________________________________________________________________________________________________
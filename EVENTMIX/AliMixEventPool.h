@@ -13,6 +13,7 @@
 
 #include <TObjArray.h>
 #include <TNamed.h>
+#include <TArrayI.h>
 
 class TEntryList;
 class AliMixEventCutObj;
@@ -35,7 +36,10 @@ public:
    TEntryList *AddEntryList();
 
    Bool_t      AddEntry(Long64_t entry, AliVEvent *ev);
+   Bool_t      AddEntry(Long64_t entry, Int_t idEntryList);
    TEntryList *FindEntryList(AliVEvent *ev, Int_t &idEntryList);
+   Int_t       GetEntryListIndex(AliVEvent *ev);
+   TEntryList *GetEntryList(Int_t idEntryList) const;
 
    void        AddCut(AliMixEventCutObj *cut);
 
@@ -58,7 +62,11 @@ private:
    Int_t       fBufferSize;            // buffer size
    Int_t       fMixNumber;             // mixing number
 
-   ClassDef(AliMixEventPool, 1)
+   TArrayI     fBinStrides;            //! stride of every cut in flat entry list index
+
+   void        InitBinStrides();
+
+   ClassDef(AliMixEventPool, 2)
 };
 
 #endif
@@ -0,0 +1,158 @@
+//
+// Class AliMixEventSnapshot
+//
+// AliMixEventSnapshot is reduced copy of event (tracks and calorimeter
+// clusters) kept in memory by AliMixEventSnapshotBuffer. It implements
+// AliVEvent interface, so mixing task can use it as mixed event without
+// reading input chain again
+//
+
+#include "AliLog.h"
+#include "AliVVertex.h"
+#include "AliVCluster.h"
+#include "AliAODVertex.h"
+#include "AliAODTrack.h"
+#include "AliCentrality.h"
+
+#include "AliMixTrackSnapshot.h"
+#include "AliMixClusterSnapshot.h"
+#include "AliMixEventSnapshot.h"
+
+ClassImp(AliMixEventSnapshot)
+
+//_________________________________________________________________________________________________
+AliMixEventSnapshot::AliMixEventSnapshot() : AliVEvent(),
+   fEntry(-1),
+   fRunNumber(0),
+   fMagneticField(0),
+   fCentrality(-1),
+   fPrimaryVertex(0),
+   fNTracks(0),
+   fTracks(0),
+   fNClusters(0),
+   fClusters(0)
+{
+   //
+   // Default constructor.
+   //
+   Double_t pos[3] = {0, 0, 0};
+   fPrimaryVertex = new AliAODVertex(pos);
+   fTracks = new TClonesArray("AliMixTrackSnapshot", 100);
+   fClusters = new TClonesArray("AliMixClusterSnapshot", 10);
+}
+
+//_________________________________________________________________________________________________
+AliMixEventSnapshot::~AliMixEventSnapshot()
+{
+   //
+   // Destructor
+   //
+   delete fPrimaryVertex;
+   if (fTracks) fTracks->Delete();
+   delete fTracks;
+   if (fClusters) fClusters->Delete();
+   delete fClusters;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventSnapshot::Reset()
+{
+   //
+   // Resets snapshot (objects in arrays are kept for reuse)
+   //
+   fEntry = -1;
+   fRunNumber = 0;
+   fMagneticField = 0;
+   fCentrality = -1;
+   fNTracks = 0;
+   fTracks->Clear();
+   fNClusters = 0;
+   fClusters->Clear();
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventSnapshot::Fill(AliVEvent *ev, Long64_t entry, UInt_t trackFilterMask)
+{
+   //
+   // Copies event information, tracks and clusters from ev.
+   // When trackFilterMask is set only AOD tracks passing one of its filter bits are kept
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   Reset();
+   if (!ev) return;
+
+   fEntry = entry;
+   fRunNumber = ev->GetRunNumber();
+   fMagneticField = ev->GetMagneticField();
+
+   Double_t pos[3] = {0, 0, 0};
+   Int_t nContributors = 0;
+   const AliVVertex *vtx = ev->GetPrimaryVertex();
+   if (vtx) {
+      vtx->GetXYZ(pos);
+      nContributors = vtx->GetNContributors();
+   }
+   fPrimaryVertex->SetPosition(pos);
+   fPrimaryVertex->SetNContributors(nContributors);
+
+   AliCentrality *centrality = ev->GetCentrality();
+   if (centrality) fCentrality = centrality->GetCentralityPercentile("V0M");
+
+   AliVParticle *part;
+   for (Int_t i = 0; i < ev->GetNumberOfTracks(); i++) {
+      part = ev->GetTrack(i);
+      if (!part) continue;
+      if (trackFilterMask) {
+         AliAODTrack *aodTrack = dynamic_cast<AliAODTrack *>(part);
+         if (aodTrack && !aodTrack->TestFilterBit(trackFilterMask)) continue;
+      }
+      ((AliMixTrackSnapshot *) fTracks->ConstructedAt(fNTracks++))->Set(*part);
+   }
+
+   AliVCluster *clus;
+   for (Int_t i = 0; i < ev->GetNumberOfCaloClusters(); i++) {
+      clus = ev->GetCaloCluster(i);
+      if (!clus) continue;
+      ((AliMixClusterSnapshot *) fClusters->ConstructedAt(fNClusters++))->Set(*clus);
+   }
+   AliDebug(AliLog::kDebug + 1, Form("entry=%lld tracks=%d clusters=%d", fEntry, fNTracks, fNClusters));
+   AliDebug(AliLog::kDebug + 5, "->");
+}
+
+//_________________________________________________________________________________________________
+AliVParticle *AliMixEventSnapshot::GetTrack(Int_t i) const
+{
+   //
+   // Returns track i
+   //
+   if (i < 0 || i >= fNTracks) return 0;
+   return (AliVParticle *) fTracks->UncheckedAt(i);
+}
+
+//_________________________________________________________________________________________________
+AliVCluster *AliMixEventSnapshot::GetCaloCluster(Int_t i) const
+{
+   //
+   // Returns calorimeter cluster i
+   //
+   if (i < 0 || i >= fNClusters) return 0;
+   return (AliVCluster *) fClusters->UncheckedAt(i);
+}
+
+//_________________________________________________________________________________________________
+const AliVVertex *AliMixEventSnapshot::GetPrimaryVertex() const
+{
+   //
+   // Returns primary vertex
+   //
+   return fPrimaryVertex;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventSnapshot::Print(Option_t *) const
+{
+   //
+   // Prints usefull information
+   //
+   AliInfo(Form("entry=%lld run=%d vz=%f centrality=%f tracks=%d clusters=%d", fEntry, fRunNumber, fPrimaryVertex->GetZ(), fCentrality, fNTracks, fNClusters));
+}
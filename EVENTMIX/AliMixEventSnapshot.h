@@ -0,0 +1,99 @@
+//
+// Class AliMixEventSnapshot
+//
+// AliMixEventSnapshot is reduced copy of event (tracks and calorimeter
+// clusters) kept in memory by AliMixEventSnapshotBuffer. It implements
+// AliVEvent interface, so mixing task can use it as mixed event without
+// reading input chain again
+//
+
+#ifndef ALIMIXEVENTSNAPSHOT_H
+#define ALIMIXEVENTSNAPSHOT_H
+
+#include <TClonesArray.h>
+
+#include "AliVEvent.h"
+
+class AliAODVertex;
+class AliMixEventSnapshot : public AliVEvent {
+public:
+   AliMixEventSnapshot();
+   virtual ~AliMixEventSnapshot();
+
+   void           Fill(AliVEvent *ev, Long64_t entry, UInt_t trackFilterMask = 0);
+   void           Reset();
+
+   Long64_t       GetEntry() const { return fEntry; }
+   Float_t        GetCentralityPercentile() const { return fCentrality; }
+
+   // tracks and clusters
+   virtual Int_t          GetNumberOfTracks() const { return fNTracks; }
+   virtual AliVParticle  *GetTrack(Int_t i) const;
+   virtual Int_t          GetNumberOfCaloClusters() const { return fNClusters; }
+   virtual AliVCluster   *GetCaloCluster(Int_t i) const;
+   virtual const AliVVertex *GetPrimaryVertex() const;
+
+   virtual Int_t          GetRunNumber() const { return fRunNumber; }
+   virtual void           SetRunNumber(Int_t n) { fRunNumber = n; }
+   virtual Double_t       GetMagneticField() const { return fMagneticField; }
+   virtual void           SetMagneticField(Double_t mf) { fMagneticField = mf; }
+
+   // not stored in snapshot
+   virtual AliVHeader    *GetHeader() const { return 0; }
+   virtual void           AddObject(TObject *) {}
+   virtual TObject       *FindListObject(const char *) const { return 0; }
+   virtual TList         *GetList() const { return 0; }
+   virtual void           CreateStdContent() {}
+   virtual void           GetStdContent() {}
+   virtual void           ReadFromTree(TTree *, Option_t * = "") {}
+   virtual void           WriteToTree(TTree *) const {}
+   virtual void           SetStdNames() {}
+   virtual void           Print(Option_t * = "") const;
+   virtual void           SetPeriodNumber(UInt_t) {}
+   virtual UInt_t         GetPeriodNumber() const { return 0; }
+   virtual void           SetOrbitNumber(UInt_t) {}
+   virtual void           SetBunchCrossNumber(UShort_t) {}
+   virtual void           SetEventType(UInt_t) {}
+   virtual void           SetTriggerMask(ULong64_t) {}
+   virtual void           SetTriggerCluster(UChar_t) {}
+   virtual UInt_t         GetOrbitNumber() const { return 0; }
+   virtual UShort_t       GetBunchCrossNumber() const { return 0; }
+   virtual UInt_t         GetEventType() const { return 0; }
+   virtual ULong64_t      GetTriggerMask() const { return 0; }
+   virtual UChar_t        GetTriggerCluster() const { return 0; }
+   virtual TString        GetFiredTriggerClasses() const { return TString(""); }
+   virtual Double_t       GetZDCN1Energy() const { return 0; }
+   virtual Double_t       GetZDCP1Energy() const { return 0; }
+   virtual Double_t       GetZDCN2Energy() const { return 0; }
+   virtual Double_t       GetZDCP2Energy() const { return 0; }
+   virtual Double_t       GetZDCEMEnergy(Int_t) const { return 0; }
+   virtual AliVVZERO     *GetVZEROData() const { return 0; }
+   virtual AliVZDC       *GetZDCData() const { return 0; }
+   virtual Int_t          GetNumberOfV0s() const { return 0; }
+   virtual Int_t          GetNumberOfCascades() const { return 0; }
+   virtual AliCentrality *GetCentrality() { return 0; }
+   virtual AliEventplane *GetEventplane() { return 0; }
+   virtual Int_t          EventIndex(Int_t) const { return 0; }
+   virtual Int_t          EventIndexForCaloCluster(Int_t) const { return 0; }
+   virtual Int_t          EventIndexForPHOSCell(Int_t) const { return 0; }
+   virtual Int_t          EventIndexForEMCALCell(Int_t) const { return 0; }
+   virtual EDataLayoutType GetDataLayoutType() const { return EDataLayoutType(); }
+
+private:
+   Long64_t       fEntry;           // entry number of original event
+   Int_t          fRunNumber;       // run number
+   Double_t       fMagneticField;   // magnetic field
+   Float_t        fCentrality;      // V0M centrality percentile (-1 if not available)
+   AliAODVertex  *fPrimaryVertex;   // primary vertex (position and number of contributors only)
+   Int_t          fNTracks;         // number of tracks
+   TClonesArray  *fTracks;          // tracks (AliMixTrackSnapshot)
+   Int_t          fNClusters;       // number of calorimeter clusters
+   TClonesArray  *fClusters;        // calorimeter clusters (AliMixClusterSnapshot)
+
+   AliMixEventSnapshot(const AliMixEventSnapshot &obj);
+   AliMixEventSnapshot &operator=(const AliMixEventSnapshot &obj);
+
+   ClassDef(AliMixEventSnapshot, 1)
+};
+
+#endif
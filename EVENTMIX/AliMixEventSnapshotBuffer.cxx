@@ -0,0 +1,118 @@
+//
+// Class AliMixEventSnapshotBuffer
+//
+// AliMixEventSnapshotBuffer keeps for every bin of AliMixEventPool
+// ring buffer of last N event snapshots (AliMixEventSnapshot).
+// Snapshots are reused, so no allocation is done after buffer is full
+//
+
+#include "AliLog.h"
+
+#include "AliMixEventSnapshot.h"
+#include "AliMixEventSnapshotBuffer.h"
+
+ClassImp(AliMixEventSnapshotBuffer)
+
+//_________________________________________________________________________________________________
+AliMixEventSnapshotBuffer::AliMixEventSnapshotBuffer(Int_t numBins, Int_t depth) : TObject(),
+   fNumBins(0),
+   fDepth(0),
+   fRings(),
+   fNext(),
+   fN()
+{
+   //
+   // Default constructor.
+   //
+   fRings.SetOwner(kTRUE);
+   Init(numBins, depth);
+}
+
+//_________________________________________________________________________________________________
+AliMixEventSnapshotBuffer::~AliMixEventSnapshotBuffer()
+{
+   //
+   // Destructor
+   //
+   fRings.Delete();
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventSnapshotBuffer::Init(Int_t numBins, Int_t depth)
+{
+   //
+   // Creates buffer with depth slots for every of numBins bins
+   // (snapshots themselves are created when slot is used first time)
+   //
+   fRings.Delete();
+   if (numBins < 1 || depth < 1) {
+      fNumBins = 0;
+      fDepth = 0;
+      fNext.Set(0);
+      fN.Set(0);
+      return;
+   }
+   fNumBins = numBins;
+   fDepth = depth;
+   fRings.Expand(fNumBins * fDepth);
+   for (Int_t i = 0; i < fNumBins * fDepth; i++) fRings.AddAt(0, i);
+   fNext.Set(fNumBins);
+   fNext.Reset();
+   fN.Set(fNumBins);
+   fN.Reset();
+   AliDebug(AliLog::kDebug, Form("numBins=%d depth=%d", fNumBins, fDepth));
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventSnapshotBuffer::Reset()
+{
+   //
+   // Marks all slots as empty (snapshots are kept for reuse)
+   //
+   fNext.Reset();
+   fN.Reset();
+}
+
+//_________________________________________________________________________________________________
+AliMixEventSnapshot *AliMixEventSnapshotBuffer::NextSlot(Int_t bin)
+{
+   //
+   // Returns snapshot which should be filled with current event in bin.
+   // Oldest snapshot is overwritten when ring is full
+   //
+   if (bin < 0 || bin >= fNumBins) {
+      AliError(Form("bin=%d is out of range [0,%d) !!!", bin, fNumBins));
+      return 0;
+   }
+   Int_t idx = bin * fDepth + fNext[bin];
+   AliMixEventSnapshot *snapshot = (AliMixEventSnapshot *) fRings.UncheckedAt(idx);
+   if (!snapshot) {
+      snapshot = new AliMixEventSnapshot();
+      fRings.AddAt(snapshot, idx);
+   }
+   fNext[bin] = (fNext[bin] + 1) % fDepth;
+   if (fN[bin] < fDepth) fN[bin]++;
+   return snapshot;
+}
+
+//_________________________________________________________________________________________________
+AliMixEventSnapshot *AliMixEventSnapshotBuffer::GetSnapshot(Int_t bin, Int_t i) const
+{
+   //
+   // Returns i-th last snapshot in bin (i=0 is most recent one)
+   //
+   if (bin < 0 || bin >= fNumBins) return 0;
+   if (i < 0 || i >= fN[bin]) return 0;
+   Int_t slot = (fNext[bin] - 1 - i + fDepth) % fDepth;
+   return (AliMixEventSnapshot *) fRings.UncheckedAt(bin * fDepth + slot);
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventSnapshotBuffer::GetN(Int_t bin) const
+{
+   //
+   // Returns number of filled snapshots in bin
+   //
+   if (bin < 0 || bin >= fNumBins) return 0;
+   return fN[bin];
+}
@@ -0,0 +1,45 @@
+//
+// Class AliMixEventSnapshotBuffer
+//
+// AliMixEventSnapshotBuffer keeps for every bin of AliMixEventPool
+// ring buffer of last N event snapshots (AliMixEventSnapshot).
+// Snapshots are reused, so no allocation is done after buffer is full
+//
+
+#ifndef ALIMIXEVENTSNAPSHOTBUFFER_H
+#define ALIMIXEVENTSNAPSHOTBUFFER_H
+
+#include <TObjArray.h>
+#include <TArrayI.h>
+
+class AliMixEventSnapshot;
+class AliMixEventSnapshotBuffer : public TObject {
+public:
+   AliMixEventSnapshotBuffer(Int_t numBins = 1, Int_t depth = 1);
+   virtual ~AliMixEventSnapshotBuffer();
+
+   void                 Init(Int_t numBins, Int_t depth);
+   void                 Reset();
+
+   AliMixEventSnapshot *NextSlot(Int_t bin);
+   AliMixEventSnapshot *GetSnapshot(Int_t bin, Int_t i) const;
+
+   Int_t                GetN(Int_t bin) const;
+   Int_t                GetNumberOfBins() const { return fNumBins; }
+   Int_t                GetDepth() const { return fDepth; }
+   Bool_t               IsInitialized() const { return (fNumBins > 0); }
+
+private:
+   Int_t       fNumBins;      // number of pool bins
+   Int_t       fDepth;        // number of snapshots per bin
+   TObjArray   fRings;        // snapshots (fDepth per bin, bin after bin)
+   TArrayI     fNext;         // next slot to be written per bin
+   TArrayI     fN;            // number of filled slots per bin
+
+   AliMixEventSnapshotBuffer(const AliMixEventSnapshotBuffer &obj);
+   AliMixEventSnapshotBuffer &operator=(const AliMixEventSnapshotBuffer &obj);
+
+   ClassDef(AliMixEventSnapshotBuffer, 1)
+};
+
+#endif
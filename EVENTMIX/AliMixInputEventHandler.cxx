@@ -11,12 +11,15 @@
 #include <TChain.h>
 #include <TChainElement.h>
 #include <TSystem.h>
+#include <TMath.h>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventSnapshot.h"
+#include "AliMixEventSnapshotBuffer.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
 
@@ -43,7 +46,12 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fUseSnapshots(kFALSE),
+   fSnapshotDepth(-1),
+   fSnapshotTrackFilterMask(0),
+   fSnapshotBuffer(0),
+   fCurrentSnapshot(0)
 {
    //
    // Default constructor.
@@ -59,6 +67,7 @@ AliMixInputEventHandler::~AliMixInputEventHandler() {
    // Destructor
    //
    fMixTrees.Clear();
+   delete fSnapshotBuffer;
 }
 
 //_____________________________________________________________________________
@@ -153,7 +162,7 @@ Bool_t AliMixInputEventHandler::Notify(const char *path)
    for (Int_t i = 0; i < fInputHandlers.GetEntries(); i++) {
       AliDebug(AliLog::kDebug + 5, Form("fInputHandlers[%d]", i));
       mixIHI = new AliMixInputHandlerInfo(fMixIntupHandlerInfoTmp->GetName(), fMixIntupHandlerInfoTmp->GetTitle());
-      if (doPrepareEntry) mixIHI->PrepareEntry(che, -1, (AliInputEventHandler *)InputEventHandler(i), fAnalysisType);
+      if (doPrepareEntry && !fUseSnapshots) mixIHI->PrepareEntry(che, -1, (AliInputEventHandler *)InputEventHandler(i), fAnalysisType);
       AliDebug(AliLog::kDebug + 5, Form("chain[%d]->GetEntries() = %lld", i, mixIHI->GetChain()->GetEntries()));
       fMixTrees.Add(mixIHI);
    }
@@ -192,7 +201,10 @@ Bool_t AliMixInputEventHandler::GetEntry()
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
 
-   if (!fEventPool) {
+   if (fUseSnapshots) {
+      MixSnapshots();
+   }
+   else if (!fEventPool) {
       MixStd();
    }
    // if buffer size is higher then 1
@@ -297,16 +309,18 @@ Bool_t AliMixInputEventHandler::MixBuffer()
    Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
    // fill entry
    Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
+   // pool bin is found once and used for adding and finding entry list
+   Int_t idEntryList = -1;
+   if (fEventPool) idEntryList = fEventPool->GetEntryListIndex(inEvHMain->GetEvent());
    // fills entry
-   if (fEventPool && inEvHMain) fEventPool->AddEntry(currentMainEntry, inEvHMain->GetEvent());
+   if (fEventPool) fEventPool->AddEntry(currentMainEntry, idEntryList);
    // start of
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
    // reset mix number
    fNumberMixed = 0;
    Long64_t elNum = 0;
    TEntryList *el = 0;
-   Int_t idEntryList = -1;
-   if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   if (fEventPool) el = fEventPool->GetEntryList(idEntryList);
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       AliDebug(AliLog::kDebug + 3, Form("-> fEntryCounter == 0"));
@@ -398,15 +412,17 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    Long64_t zeroChainEntries = fMixIntupHandlerInfoTmp->GetChain()->GetEntries() - inEvHMain->GetTree()->GetTree()->GetEntries();
    // fill entry
    Long64_t currentMainEntry = inEvHMain->GetTree()->GetTree()->GetReadEntry() + zeroChainEntries;
-   if (fEventPool && inEvHMain) fEventPool->AddEntry(currentMainEntry, inEvHMain->GetEvent());
+   // pool bin is found once and used for adding and finding entry list
+   Int_t idEntryList = -1;
+   if (fEventPool) idEntryList = fEventPool->GetEntryListIndex(inEvHMain->GetEvent());
+   if (fEventPool) fEventPool->AddEntry(currentMainEntry, idEntryList);
    // start of
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
    // reset mix number
    fNumberMixed = 0;
    Long64_t elNum = 0;
-   Int_t idEntryList = -1;
    TEntryList *el = 0;
-   if (fEventPool) el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+   if (fEventPool) el = fEventPool->GetEntryList(idEntryList);
    // return in case of 0 entry in full chain
    if (!fEntryCounter) {
       // runs UserExecMix for all tasks, if needed
@@ -495,6 +511,83 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithBuffer()
    return kFALSE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::MixSnapshots()
+{
+   //
+   // Mix with snapshots of previous events kept in memory (one event at time).
+   // Mixed event is available in UserExecMix() via GetMixedEventSnapshot().
+   // Current event is added to its pool bin after mixing
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   AliDebug(AliLog::kDebug + 1, "Mix method");
+   // get correct handler
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   AliMultiInputEventHandler *mh = dynamic_cast<AliMultiInputEventHandler *>(mgr->GetInputEventHandler());
+   AliInputEventHandler *inEvHMain = 0;
+   if (mh) inEvHMain = dynamic_cast<AliInputEventHandler *>(mh->GetFirstInputEventHandler());
+   else inEvHMain = dynamic_cast<AliInputEventHandler *>(mgr->GetInputEventHandler());
+   if (!inEvHMain) return kFALSE;
+
+   // check for PhysSelection
+   if (!IsEventCurrentSelected()) return kFALSE;
+
+   AliVEvent *ev = inEvHMain->GetEvent();
+   fCurrentSnapshot = 0;
+
+   // creates buffers (event pool is initialized in Notify)
+   Int_t numBins = 1;
+   if (fEventPool) numBins = fEventPool->GetListOfEntryLists()->GetEntries();
+   Int_t depth = (fSnapshotDepth > 0) ? fSnapshotDepth : fMixNumber;
+   if (depth < 1) depth = 1;
+   if (!fSnapshotBuffer) fSnapshotBuffer = new AliMixEventSnapshotBuffer(numBins, depth);
+   else if (fSnapshotBuffer->GetNumberOfBins() != numBins || fSnapshotBuffer->GetDepth() != depth) fSnapshotBuffer->Init(numBins, depth);
+
+   // no input chain entry is needed here, fEntryCounter identifies event
+   Long64_t currentMainEntry = fEntryCounter;
+
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   // reset mix number
+   fNumberMixed = 0;
+   Int_t idEntryList = 1;
+   if (fEventPool && fEventPool->GetListOfEventCuts()->GetEntries() > 0) {
+      idEntryList = fEventPool->GetEntryListIndex(ev);
+      if (!fEventPool->GetEntryList(idEntryList)) {
+         AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (el null) +++++++++++++++++++", fEntryCounter));
+         UserExecMixAllTasks(fEntryCounter, -1, currentMainEntry, -1, 0);
+         return kTRUE;
+      }
+   }
+   Int_t bin = idEntryList - 1;
+
+   Int_t nSnapshots = fSnapshotBuffer->GetN(bin);
+   Int_t mixNum = TMath::Min(fMixNumber, nSnapshots);
+   if (mixNum < 1 || (!fDoMixIfNotEnoughEvents && nSnapshots < fMixNumber)) {
+      // dont include it in main event counter (idEntryList = -1), when it is not wanted
+      if (!fDoMixIfNotEnoughEvents) idEntryList = -1;
+      UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, -1, 0);
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (%d) NOT ENOUGH SNAPSHOTS => NEED=%d +++++++++++++++++++", fEntryCounter, nSnapshots, fMixNumber));
+   } else {
+      for (Int_t counter = 0; counter < mixNum; counter++) {
+         fCurrentSnapshot = fSnapshotBuffer->GetSnapshot(bin, counter);
+         if (!fCurrentSnapshot) break;
+         // runs UserExecMix for all tasks
+         fNumberMixed++;
+         UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, fCurrentSnapshot->GetEntry(), fNumberMixed);
+      }
+      fCurrentSnapshot = 0;
+   }
+
+   // keeps current event for next events
+   AliMixEventSnapshot *snapshot = fSnapshotBuffer->NextSlot(bin);
+   if (snapshot) snapshot->Fill(ev, currentMainEntry, fSnapshotTrackFilterMask);
+
+   AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   AliDebug(AliLog::kDebug + 5, "->");
+   return kTRUE;
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::FinishEvent()
 {
@@ -565,6 +658,22 @@ void AliMixInputEventHandler::SetMixNumber(const Int_t mixNum)
    fMixNumber = mixNum;
 }
 
+//_____________________________________________________________________________
+void AliMixInputEventHandler::SetUseSnapshots(Bool_t useSnapshots, Int_t depth, UInt_t trackFilterMask)
+{
+   //
+   // Enables mixing with in-memory snapshots of last events in every pool bin.
+   // depth is number of snapshots kept per bin (-1 -> mix number).
+   // When trackFilterMask is set only AOD tracks passing one of its bits are stored
+   //
+   fUseSnapshots = useSnapshots;
+   fSnapshotDepth = depth;
+   fSnapshotTrackFilterMask = trackFilterMask;
+   if (fUseSnapshots && fBufferSize > 1) {
+      AliWarning(Form("BufferSize(%d) > 1 is not used with snapshots, events are mixed one by one (mix number %d)", fBufferSize, fMixNumber));
+   }
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::IsEventCurrentSelected()
 {
@@ -605,6 +714,11 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
    // (Should be used in UserExecMix() only)
    //
 
+   if (fUseSnapshots) {
+      AliError("Snapshot mixing is used, mixed event is available via GetMixedEventSnapshot()");
+      return kFALSE;
+   }
+
    AliMixInputHandlerInfo *mihi = (AliMixInputHandlerInfo *) fMixTrees.At(id);
 
    Long64_t entryMix = fCurrentMixEntry.GetEntry(fCurrentMixEntry.GetN()-id-1);
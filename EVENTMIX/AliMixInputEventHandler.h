@@ -22,6 +22,8 @@ class TChain;
 class TChainElement;
 class AliMixEventPool;
 class AliMixInputHandlerInfo;
+class AliMixEventSnapshot;
+class AliMixEventSnapshotBuffer;
 class AliInputEventHandler;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
 
@@ -73,6 +75,12 @@ public:
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
+
+   // in-memory mixing (snapshots of last events per pool bin instead of reading them again)
+   void                    SetUseSnapshots(Bool_t useSnapshots = kTRUE, Int_t depth = -1, UInt_t trackFilterMask = 0);
+   Bool_t                  IsUsingSnapshots() const { return fUseSnapshots; }
+   AliMixEventSnapshot    *GetMixedEventSnapshot() const { return fCurrentSnapshot; }
+   AliMixEventSnapshotBuffer *GetSnapshotBuffer() const { return fSnapshotBuffer; }
 protected:
 
    TObjArray               fMixTrees;              // buffer of input handlers
@@ -100,17 +108,24 @@ private:
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
 
+   Bool_t   fUseSnapshots;          // use in-memory snapshots for mixing
+   Int_t    fSnapshotDepth;         // number of snapshots per pool bin (-1 -> fMixNumber)
+   UInt_t   fSnapshotTrackFilterMask; // AOD filter mask of tracks stored in snapshots (0 -> all)
+   AliMixEventSnapshotBuffer *fSnapshotBuffer; //! snapshot ring buffers
+   AliMixEventSnapshot *fCurrentSnapshot;      //! snapshot currently mixed (user should touch)
+
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
+   virtual Bool_t          MixSnapshots();
 
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
@@ -0,0 +1,108 @@
+//
+// Class AliMixTrackSnapshot
+//
+// AliMixTrackSnapshot is compact copy of track
+// kept in memory by AliMixEventSnapshotBuffer
+//
+
+#include "AliVTrack.h"
+#include "AliAODTrack.h"
+
+#include "AliMixTrackSnapshot.h"
+
+ClassImp(AliMixTrackSnapshot)
+
+//_________________________________________________________________________________________________
+AliMixTrackSnapshot::AliMixTrackSnapshot() : AliVParticle(),
+   fPx(0),
+   fPy(0),
+   fPz(0),
+   fEta(0),
+   fPhi(0),
+   fCharge(0),
+   fLabel(-1),
+   fID(-1),
+   fFilterMap(0)
+{
+   //
+   // Default constructor.
+   //
+}
+
+//_________________________________________________________________________________________________
+AliMixTrackSnapshot::AliMixTrackSnapshot(const AliVParticle &part) : AliVParticle(),
+   fPx(0),
+   fPy(0),
+   fPz(0),
+   fEta(0),
+   fPhi(0),
+   fCharge(0),
+   fLabel(-1),
+   fID(-1),
+   fFilterMap(0)
+{
+   //
+   // Constructor from any particle
+   //
+   Set(part);
+}
+
+//_________________________________________________________________________________________________
+AliMixTrackSnapshot::AliMixTrackSnapshot(const AliMixTrackSnapshot &obj) : AliVParticle(obj),
+   fPx(obj.fPx),
+   fPy(obj.fPy),
+   fPz(obj.fPz),
+   fEta(obj.fEta),
+   fPhi(obj.fPhi),
+   fCharge(obj.fCharge),
+   fLabel(obj.fLabel),
+   fID(obj.fID),
+   fFilterMap(obj.fFilterMap)
+{
+   //
+   // Copy constructor
+   //
+}
+
+//_________________________________________________________________________________________________
+AliMixTrackSnapshot &AliMixTrackSnapshot::operator=(const AliMixTrackSnapshot &obj)
+{
+   //
+   // Assigned operator
+   //
+   if (&obj != this) {
+      AliVParticle::operator=(obj);
+      fPx = obj.fPx;
+      fPy = obj.fPy;
+      fPz = obj.fPz;
+      fEta = obj.fEta;
+      fPhi = obj.fPhi;
+      fCharge = obj.fCharge;
+      fLabel = obj.fLabel;
+      fID = obj.fID;
+      fFilterMap = obj.fFilterMap;
+   }
+   return *this;
+}
+
+//_________________________________________________________________________________________________
+void AliMixTrackSnapshot::Set(const AliVParticle &part)
+{
+   //
+   // Copies kinematics and identification of particle
+   //
+   fPx = part.Px();
+   fPy = part.Py();
+   fPz = part.Pz();
+   fEta = part.Eta();
+   fPhi = part.Phi();
+   fCharge = part.Charge();
+   fLabel = part.GetLabel();
+   fID = -1;
+   fFilterMap = 0;
+   const AliVTrack *track = dynamic_cast<const AliVTrack *>(&part);
+   if (track) fID = track->GetID();
+   const AliAODTrack *aodTrack = dynamic_cast<const AliAODTrack *>(&part);
+   if (aodTrack) fFilterMap = aodTrack->GetFilterMap();
+   SetUniqueID(part.GetUniqueID());
+}
@@ -0,0 +1,69 @@
+//
+// Class AliMixTrackSnapshot
+//
+// AliMixTrackSnapshot is compact copy of track
+// kept in memory by AliMixEventSnapshotBuffer
+//
+
+#ifndef ALIMIXTRACKSNAPSHOT_H
+#define ALIMIXTRACKSNAPSHOT_H
+
+#include <TMath.h>
+
+#include "AliVParticle.h"
+
+class AliMixTrackSnapshot : public AliVParticle {
+public:
+   AliMixTrackSnapshot();
+   AliMixTrackSnapshot(const AliVParticle &part);
+   AliMixTrackSnapshot(const AliMixTrackSnapshot &obj);
+   AliMixTrackSnapshot &operator=(const AliMixTrackSnapshot &obj);
+   virtual ~AliMixTrackSnapshot() {}
+
+   void              Set(const AliVParticle &part);
+
+   // kinematics
+   virtual Double_t  Px() const { return fPx; }
+   virtual Double_t  Py() const { return fPy; }
+   virtual Double_t  Pz() const { return fPz; }
+   virtual Double_t  Pt() const { return TMath::Sqrt(fPx * fPx + fPy * fPy); }
+   virtual Double_t  P() const { return TMath::Sqrt(fPx * fPx + fPy * fPy + fPz * fPz); }
+   virtual Bool_t    PxPyPz(Double_t p[3]) const { p[0] = fPx; p[1] = fPy; p[2] = fPz; return kTRUE; }
+
+   virtual Double_t  Xv() const { return 0.; }
+   virtual Double_t  Yv() const { return 0.; }
+   virtual Double_t  Zv() const { return 0.; }
+   virtual Bool_t    XvYvZv(Double_t x[3]) const { x[0] = 0.; x[1] = 0.; x[2] = 0.; return kFALSE; }
+
+   virtual Double_t  OneOverPt() const { Double_t pt = Pt(); return (pt > 0.) ? 1. / pt : -999.; }
+   virtual Double_t  Phi() const { return fPhi; }
+   virtual Double_t  Theta() const { return TMath::ATan2(Pt(), fPz); }
+   virtual Double_t  E() const { return -999.; }
+   virtual Double_t  M() const { return -999.; }
+   virtual Double_t  Eta() const { return fEta; }
+   virtual Double_t  Y() const { return -999.; }
+
+   virtual Short_t   Charge() const { return fCharge; }
+   virtual Int_t     GetLabel() const { return fLabel; }
+   virtual Int_t     PdgCode() const { return 0; }
+   virtual const Double_t *PID() const { return 0; }
+
+   Int_t             GetID() const { return fID; }
+   UInt_t            GetFilterMap() const { return fFilterMap; }
+   Bool_t            TestFilterBit(UInt_t filterBit) const { return (fFilterMap & filterBit) != 0; }
+
+private:
+   Float_t     fPx;           // px
+   Float_t     fPy;           // py
+   Float_t     fPz;           // pz
+   Float_t     fEta;          // eta (cached, expensive to compute)
+   Float_t     fPhi;          // phi (cached)
+   Short_t     fCharge;       // charge
+   Int_t       fLabel;        // MC label
+   Int_t       fID;           // track ID in original event
+   UInt_t      fFilterMap;    // AOD filter map (0 for ESD tracks)
+
+   ClassDef(AliMixTrackSnapshot, 1)
+};
+
+#endif
@@ -3,6 +3,11 @@
 #pragma link C++ class AliMixEventCutObj+;
 #pragma link C++ class AliMixEventPool+;
 
+#pragma link C++ class AliMixTrackSnapshot+;
+#pragma link C++ class AliMixClusterSnapshot+;
+#pragma link C++ class AliMixEventSnapshot+;
+#pragma link C++ class AliMixEventSnapshotBuffer+;
+
 #pragma link C++ class AliMixInfo+;
 #pragma link C++ class AliMixInputHandlerInfo+;
 #pragma link C++ class AliMixInputEventHandler+;
@@ -107,6 +107,130 @@
 #include "AliVZEROTriggerData.h"
 #include "AliITSOnlineCalibrationSPDhandler.h"
 #include "AliITSTriggerConditions.h"
+
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+//______________________________________________________________________________
+// Trigger classes and trigger logic of the current run, prepared once in
+// AliPhysicsSelection::Initialize. The class strings are split into the
+// required and rejected class names, and every online/offline logic is
+// translated into a postfix program over AliTriggerAnalysis::Trigger bits.
+// The per-event evaluation does not allocate, and each trigger bit is
+// evaluated only once per event, however many classes use it.
+class AliPhysicsSelectionTriggerProgram {
+public:
+  enum EOperation { kPushTrigger = 0, kPushConstant, kNot, kNegate, kMultiply, kDivide, kAdd, kSubtract,
+                    kLess, kGreater, kLessEqual, kGreaterEqual, kEqual, kNotEqual, kAnd, kOr };
+  
+  struct Instruction {
+    Int_t    fOperation; // EOperation
+    Int_t    fSlot;      // trigger slot for kPushTrigger
+    Double_t fValue;     // value for kPushConstant
+  };
+  
+  struct TriggerClass {
+    std::vector<std::vector<TString> > fRequired; // one class out of each group must have fired
+    std::vector<TString> fRejected;               // none of these classes may have fired
+    std::vector<Int_t>   fBunchCrossings;         // accepted bunch crossings (no requirement if empty)
+    UInt_t fReturnCode;                           // returned if the class is found
+    Int_t  fOnline;                               // index of the online logic in fLogic
+    Int_t  fOffline;                              // index of the offline logic in fLogic
+  };
+  
+  AliPhysicsSelectionTriggerProgram() : fClasses(), fLogic(), fLogicKeys(), fSlotBits(), fSlotValues(), fSlotEvent(), fStack(), fEvent(0) {}
+  
+  void Clear() {
+    fClasses.clear(); fLogic.clear(); fLogicKeys.clear();
+    fSlotBits.clear(); fSlotValues.clear(); fSlotEvent.clear(); fStack.clear();
+  }
+  
+  Int_t FindSlot(Int_t bit) {
+    // returns the memoization slot of the given trigger bit, adding it if needed
+    for (UInt_t i=0; i<fSlotBits.size(); i++) if (fSlotBits[i] == bit) return i;
+    fSlotBits.push_back(bit);
+    fSlotValues.push_back(0);
+    fSlotEvent.push_back(-1);
+    return fSlotBits.size() - 1;
+  }
+  
+  void NextEvent() { fEvent++; }
+  
+  UInt_t CheckTriggerClass(Int_t i, const AliVEvent* event, const TString& firedClasses) const {
+    // same as AliPhysicsSelection::CheckTriggerClass on the prepared class i
+    const TriggerClass& trigger = fClasses[i];
+    for (UInt_t j=0; j<trigger.fRequired.size(); j++) {
+      const std::vector<TString>& group = trigger.fRequired[j];
+      Bool_t found = kFALSE;
+      for (UInt_t k=0; k<group.size() && !found; k++) found = firedClasses.Contains(group[k]);
+      if (!found) return kFALSE;
+    }
+    for (UInt_t j=0; j<trigger.fRejected.size(); j++)
+      if (firedClasses.Contains(trigger.fRejected[j])) return kFALSE;
+    if (!trigger.fBunchCrossings.empty()) {
+      Int_t bc = event->GetBunchCrossNumber();
+      Bool_t found = kFALSE;
+      for (UInt_t j=0; j<trigger.fBunchCrossings.size() && !found; j++) found = (trigger.fBunchCrossings[j] == bc);
+      if (!found) return kFALSE;
+    }
+    return trigger.fReturnCode;
+  }
+  
+  Double_t Evaluate(Int_t logic, const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis) {
+    // runs the postfix program of the given logic; fStack is sized for the deepest program
+    const std::vector<Instruction>& code = fLogic[logic];
+    if (code.empty()) AliFatalGeneral("AliPhysicsSelection", "Could not evaluate empty trigger logic");
+    Double_t* stack = &fStack[0];
+    Int_t n = 0;
+    for (UInt_t i=0; i<code.size(); i++) {
+      const Instruction& instruction = code[i];
+      switch (instruction.fOperation) {
+        case kPushTrigger: {
+          Int_t slot = instruction.fSlot;
+          if (fSlotEvent[slot] != fEvent) {
+            fSlotValues[slot] = triggerAnalysis->EvaluateTrigger(event, (AliTriggerAnalysis::Trigger) fSlotBits[slot]);
+            fSlotEvent[slot] = fEvent;
+          }
+          stack[n++] = fSlotValues[slot];
+          break;
+        }
+        case kPushConstant: stack[n++] = instruction.fValue;   break;
+        case kNot:          stack[n-1] = !stack[n-1];          break;
+        case kNegate:       stack[n-1] = -stack[n-1];          break;
+        default: {
+          Double_t b = stack[--n];
+          Double_t& a = stack[n-1];
+          switch (instruction.fOperation) {
+            case kMultiply:     a = a * b;        break;
+            case kDivide:       a = a / b;        break;
+            case kAdd:          a = a + b;        break;
+            case kSubtract:     a = a - b;        break;
+            case kLess:         a = (a <  b);     break;
+            case kGreater:      a = (a >  b);     break;
+            case kLessEqual:    a = (a <= b);     break;
+            case kGreaterEqual: a = (a >= b);     break;
+            case kEqual:        a = (a == b);     break;
+            case kNotEqual:     a = (a != b);     break;
+            case kAnd:          a = (a && b);     break;
+            case kOr:           a = (a || b);     break;
+          }
+        }
+      }
+    }
+    return stack[0];
+  }
+  
+  std::vector<TriggerClass>               fClasses;    // prepared collision and background classes
+  std::vector<std::vector<Instruction> >  fLogic;      // postfix programs
+  std::vector<Int_t>                      fLogicKeys;  // 2*triggerLogic+offline for each program
+  std::vector<Int_t>                      fSlotBits;   // trigger bit (including kOfflineFlag) of each slot
+  std::vector<Int_t>                      fSlotValues; // EvaluateTrigger result of each slot
+  std::vector<Long64_t>                   fSlotEvent;  // event for which the slot value is valid
+  std::vector<Double_t>                   fStack;      // evaluation stack
+  Long64_t                                fEvent;      // current event counter
+};
 ClassImp(AliPhysicsSelection)
 
 AliPhysicsSelection::AliPhysicsSelection() :
@@ -128,7 +252,8 @@ fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
 fRegexp(new TPRegexp("([[:alpha:]]\\w*)")),
-fCashedTokens(NULL)
+fCashedTokens(NULL),
+fTriggerProgram(0)
 {
   // constructor
   fCollTrigClasses.SetOwner(1);
@@ -150,6 +275,7 @@ AliPhysicsSelection::~AliPhysicsSelection(){
   if (fTriggerOADB)  delete fTriggerOADB;
   delete fRegexp;
   delete fCashedTokens;
+  delete fTriggerProgram;
 }
 
 UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const {
@@ -245,19 +371,7 @@ Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event, AliTrig
     
     TString token(trigger(pos[0], pos[1]-pos[0]+1));
 
-    TParameter<Int_t>* param = dynamic_cast<TParameter<Int_t> *>(fCashedTokens->FindObject(token));
-    if (!param) {
-      TInterpreter::EErrorCode error;
-      Int_t bit = gInterpreter->ProcessLine(Form("AliTriggerAnalysis::k%s;", token.Data()), &error);
-      
-      if (error > 0) AliFatal(Form("Trigger token %s unknown", token.Data()));
-      
-      param = new TParameter<Int_t>(token, bit);
-      fCashedTokens->Add(param);
-      AliDebug(AliLog::kDebug, "Added token");
-    }
-    
-    Long64_t bit = param->GetVal();
+    Long64_t bit = GetTriggerBit(token);
     
     AliDebug(AliLog::kDebug, Form("Tok %d %d %s %lld", pos[0], pos[1], token.Data(), bit));
     
@@ -285,6 +399,198 @@ Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event, AliTrig
   return result;
 }
 
+//______________________________________________________________________________
+Int_t AliPhysicsSelection::GetTriggerBit(const TString& token){
+  // returns the AliTriggerAnalysis::Trigger value of the given token, e.g. V0A -> kV0A
+  TParameter<Int_t>* param = dynamic_cast<TParameter<Int_t> *>(fCashedTokens->FindObject(token));
+  if (!param) {
+    TInterpreter::EErrorCode error;
+    Int_t bit = gInterpreter->ProcessLine(Form("AliTriggerAnalysis::k%s;", token.Data()), &error);
+    
+    if (error > 0) AliFatal(Form("Trigger token %s unknown", token.Data()));
+    
+    param = new TParameter<Int_t>(token, bit);
+    fCashedTokens->Add(param);
+    AliDebug(AliLog::kDebug, "Added token");
+  }
+  return param->GetVal();
+}
+
+//______________________________________________________________________________
+void AliPhysicsSelection::CompileTriggerClasses(){
+  // prepares the collision and background trigger classes and their online/offline logic
+  // for IsCollisionCandidate (see CheckTriggerClass for the format of the class strings)
+  if (!fTriggerProgram) fTriggerProgram = new AliPhysicsSelectionTriggerProgram;
+  fTriggerProgram->Clear();
+  
+  Int_t nColl = fCollTrigClasses.GetEntries();
+  Int_t nBG   = fBGTrigClasses.GetEntries();
+  for (Int_t i=0; i<nColl+nBG; i++) {
+    const char* trigger = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
+    
+    AliPhysicsSelectionTriggerProgram::TriggerClass triggerClass;
+    triggerClass.fReturnCode = AliVEvent::kUserDefined;
+    Int_t triggerLogic = 0;
+    
+    TString str(trigger);
+    TObjArray* tokens = str.Tokenize(" ");
+    for (Int_t j=0; j < tokens->GetEntries(); j++) {
+      TString str2(((TObjString*) tokens->At(j))->String());
+      if (str2[0] == '+' || str2[0] == '-') {
+        Bool_t flag = (str2[0] == '+');
+        str2.Remove(0, 1);
+        std::vector<TString> group;
+        TObjArray* tokens2 = str2.Tokenize(",");
+        for (Int_t k=0; k < tokens2->GetEntries(); k++) group.push_back(((TObjString*) tokens2->At(k))->String());
+        delete tokens2;
+        if (flag) triggerClass.fRequired.push_back(group);
+        else      triggerClass.fRejected.insert(triggerClass.fRejected.end(), group.begin(), group.end());
+      }
+      else if (str2[0] == '#') { str2.Remove(0, 1); triggerClass.fBunchCrossings.push_back(str2.Atoi()); }
+      else if (str2[0] == '&') { str2.Remove(0, 1); triggerClass.fReturnCode = str2.Atoll(); }
+      else if (str2[0] == '*') { str2.Remove(0, 1); triggerLogic = str2.Atoi(); }
+      else AliFatal(Form("Invalid trigger syntax: %s", trigger));
+    }
+    delete tokens;
+    
+    triggerClass.fOnline  = CompileTriggerLogic(triggerLogic, kFALSE);
+    triggerClass.fOffline = CompileTriggerLogic(triggerLogic, kTRUE);
+    fTriggerProgram->fClasses.push_back(triggerClass);
+  }
+}
+
+//______________________________________________________________________________
+Int_t AliPhysicsSelection::CompileTriggerLogic(Int_t triggerLogic, Bool_t offline){
+  // translates the online or offline logic with the given index into a postfix program
+  // and returns its index. Supports the TFormula operators used in the OADB:
+  // || && == != < > <= >= + - * / ! and parentheses
+  Int_t key = 2*triggerLogic + (offline ? 1 : 0);
+  for (UInt_t i=0; i<fTriggerProgram->fLogicKeys.size(); i++) 
+    if (fTriggerProgram->fLogicKeys[i] == key) return i;
+  
+  typedef AliPhysicsSelectionTriggerProgram P;
+  const TString logic = offline ? fPSOADB->GetOfflineTrigger(triggerLogic) : fPSOADB->GetHardwareTrigger(triggerLogic);
+  const char* expr = logic.Data();
+  
+  // shunting-yard: binary operators have precedences 1 (||) to 6 (* /), unary ones 7
+  std::vector<P::Instruction> code;
+  std::vector<Int_t> operators;
+  Bool_t expectOperand = kTRUE;
+  Int_t depth = 0, maxDepth = 0;
+  
+  struct Local {
+    static Int_t Precedence(Int_t op) {
+      switch (op) {
+        case P::kOr:       return 1;
+        case P::kAnd:      return 2;
+        case P::kEqual:    case P::kNotEqual:     return 3;
+        case P::kLess:     case P::kGreater:      case P::kLessEqual: case P::kGreaterEqual: return 4;
+        case P::kAdd:      case P::kSubtract:     return 5;
+        case P::kMultiply: case P::kDivide:       return 6;
+        case P::kNot:      case P::kNegate:       return 7;
+      }
+      return 0; // opening parenthesis
+    }
+  };
+  const Int_t kParenthesis = -1;
+  
+  for (const char* c = expr; *c; ) {
+    if (isspace((unsigned char) *c)) { c++; continue; }
+    
+    if (expectOperand) {
+      P::Instruction instruction;
+      instruction.fSlot  = -1;
+      instruction.fValue = 0;
+      if (isdigit((unsigned char) *c) || *c == '.') {
+        char* end = 0;
+        instruction.fOperation = P::kPushConstant;
+        instruction.fValue = strtod(c, &end);
+        c = end;
+      } else if (isalpha((unsigned char) *c)) {
+        const char* begin = c;
+        while (isalnum((unsigned char) *c) || *c == '_') c++;
+        Int_t bit = GetTriggerBit(TString(begin, c - begin));
+        if (offline) bit |= AliTriggerAnalysis::kOfflineFlag;
+        instruction.fOperation = P::kPushTrigger;
+        instruction.fSlot = fTriggerProgram->FindSlot(bit);
+      } else if (*c == '!' || *c == '-' || *c == '+') {
+        if (*c != '+') operators.push_back(*c == '!' ? P::kNot : P::kNegate);
+        c++;
+        continue;
+      } else if (*c == '(') {
+        operators.push_back(kParenthesis);
+        c++;
+        continue;
+      } else {
+        AliFatal(Form("Could not evaluate trigger logic %s (unexpected '%c')", expr, *c));
+        return -1;
+      }
+      code.push_back(instruction);
+      if (++depth > maxDepth) maxDepth = depth;
+      expectOperand = kFALSE;
+      continue;
+    }
+    
+    if (*c == ')') {
+      while (!operators.empty() && operators.back() != kParenthesis) {
+        P::Instruction instruction = { operators.back(), -1, 0 };
+        if (instruction.fOperation != P::kNot && instruction.fOperation != P::kNegate) depth--;
+        code.push_back(instruction);
+        operators.pop_back();
+      }
+      if (operators.empty()) AliFatal(Form("Could not evaluate trigger logic %s (unbalanced parentheses)", expr));
+      operators.pop_back();
+      c++;
+      continue;
+    }
+    
+    Int_t op = -1;
+    if      (!strncmp(c, "||", 2)) { op = P::kOr;           c += 2; }
+    else if (!strncmp(c, "&&", 2)) { op = P::kAnd;          c += 2; }
+    else if (!strncmp(c, "==", 2)) { op = P::kEqual;        c += 2; }
+    else if (!strncmp(c, "!=", 2)) { op = P::kNotEqual;     c += 2; }
+    else if (!strncmp(c, "<=", 2)) { op = P::kLessEqual;    c += 2; }
+    else if (!strncmp(c, ">=", 2)) { op = P::kGreaterEqual; c += 2; }
+    else if (*c == '<')            { op = P::kLess;         c++;    }
+    else if (*c == '>')            { op = P::kGreater;      c++;    }
+    else if (*c == '+')            { op = P::kAdd;          c++;    }
+    else if (*c == '-')            { op = P::kSubtract;     c++;    }
+    else if (*c == '*')            { op = P::kMultiply;     c++;    }
+    else if (*c == '/')            { op = P::kDivide;       c++;    }
+    else {
+      AliFatal(Form("Could not evaluate trigger logic %s (unexpected '%c')", expr, *c));
+      return -1;
+    }
+    
+    // all binary operators are left associative
+    while (!operators.empty() && operators.back() != kParenthesis && Local::Precedence(operators.back()) >= Local::Precedence(op)) {
+      P::Instruction instruction = { operators.back(), -1, 0 };
+      if (instruction.fOperation != P::kNot && instruction.fOperation != P::kNegate) depth--;
+      code.push_back(instruction);
+      operators.pop_back();
+    }
+    operators.push_back(op);
+    expectOperand = kTRUE;
+  }
+  
+  // an empty logic is only an error if a class using it fires (see AliPhysicsSelectionTriggerProgram::Evaluate)
+  if (expectOperand && (!code.empty() || !operators.empty())) AliFatal(Form("Could not evaluate trigger logic %s (incomplete expression)", expr));
+  while (!operators.empty()) {
+    if (operators.back() == kParenthesis) AliFatal(Form("Could not evaluate trigger logic %s (unbalanced parentheses)", expr));
+    P::Instruction instruction = { operators.back(), -1, 0 };
+    if (instruction.fOperation != P::kNot && instruction.fOperation != P::kNegate) depth--;
+    code.push_back(instruction);
+    operators.pop_back();
+  }
+  
+  AliDebug(AliLog::kDebug, Form("Compiled trigger logic %s into %d instructions", expr, (Int_t) code.size()));
+  
+  if (fTriggerProgram->fStack.size() < (UInt_t) maxDepth) fTriggerProgram->fStack.resize(maxDepth);
+  fTriggerProgram->fLogic.push_back(code);
+  fTriggerProgram->fLogicKeys.push_back(key);
+  return fTriggerProgram->fLogic.size() - 1;
+}
+
 //______________________________________________________________________________
 UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
   // checks if the given event is a collision candidate
@@ -301,21 +607,26 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
     if (eventType != 7) return kFALSE;
   }
   
+  // the trigger classes and logic were compiled in Initialize; the EvaluateTrigger results
+  // are shared between the classes, as all AliTriggerAnalysis objects are configured alike
+  const TString firedClasses = event->GetFiredTriggerClasses();
+  AliDebug(AliLog::kDebug+1, Form("Processing event with triggers %s", firedClasses.Data()));
+  fTriggerProgram->NextEvent();
+  
   UInt_t accept = 0;
   Int_t nColl = fCollTrigClasses.GetEntries();
   Int_t nBG   = fBGTrigClasses.GetEntries();
   for (Int_t i=0; i<nColl+nBG; i++) {
-    const char* triggerClass = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
-    AliDebug(AliLog::kDebug+1, Form("Processing trigger class %s", triggerClass));
+    AliDebug(AliLog::kDebug+1, Form("Processing trigger class %s", i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName()));
     
     AliTriggerAnalysis* triggerAnalysis = static_cast<AliTriggerAnalysis*> (fTriggerAnalysis.At(i));
     triggerAnalysis->FillTriggerClasses(event);
     
-    Int_t triggerLogic = 0;
-    UInt_t singleTriggerResult = CheckTriggerClass(event, triggerClass, triggerLogic);
+    UInt_t singleTriggerResult = fTriggerProgram->CheckTriggerClass(i, event, firedClasses);
     if (!singleTriggerResult) continue;
-    Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetHardwareTrigger(triggerLogic), kFALSE);
-    Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetOfflineTrigger(triggerLogic), kTRUE);
+    const AliPhysicsSelectionTriggerProgram::TriggerClass& triggerClass = fTriggerProgram->fClasses[i];
+    Bool_t onlineDecision  = fTriggerProgram->Evaluate(triggerClass.fOnline,  event, triggerAnalysis);
+    Bool_t offlineDecision = fTriggerProgram->Evaluate(triggerClass.fOffline, event, triggerAnalysis);
     triggerAnalysis->FillHistograms(event,onlineDecision,offlineDecision);
     if (!onlineDecision) continue;
     if (!offlineDecision) continue;
@@ -490,6 +801,8 @@ Bool_t AliPhysicsSelection::Initialize(Int_t runNumber){
     fCashedTokens->SetOwner();
   }
   
+  CompileTriggerClasses();
+  
   fCurrentRun = runNumber;
 
   TH1::AddDirectory(oldStatus);
@@ -34,6 +34,7 @@ class AliOADBPhysicsSelection;
 class AliOADBFillingScheme;
 class AliOADBTriggerAnalysis;
 class TPRegexp;
+class AliPhysicsSelectionTriggerProgram;
 
 class AliPhysicsSelection : public AliAnalysisCuts{
 public:
@@ -87,6 +88,9 @@ public:
 protected:
   UInt_t CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const;
   Bool_t EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, const char* triggerLogic, Bool_t offline);
+  Int_t  GetTriggerBit(const TString& token);
+  void   CompileTriggerClasses();
+  Int_t  CompileTriggerLogic(Int_t triggerLogic, Bool_t offline);
   const char * GetTriggerString(TObjString * obj);
 
   TString fPassName;          // pass name for current run
@@ -109,6 +113,7 @@ protected:
 
   TPRegexp* fRegexp;        //! regular expression for trigger tokens
   TList* fCashedTokens;     //! trigger token lookup list
+  AliPhysicsSelectionTriggerProgram* fTriggerProgram; //! trigger classes and logic compiled for the current run
 
   ClassDef(AliPhysicsSelection, 22)
 private:
@@ -47,8 +47,101 @@
 #include "AliVCaloTrigger.h"
 #include "AliAODTZERO.h"
 #include "AliAODEvent.h"
+#include "AliAnalysisManager.h"
 ClassImp(AliTriggerAnalysis)
 
+//-------------------------------------------------------------------------------------------------
+// Detector decisions of the current event, shared by all AliTriggerAnalysis objects (e.g. the one
+// per trigger class in AliPhysicsSelection). Only decisions which do not depend on the object
+// configuration are stored as such; for the others either the raw detector quantities are stored
+// or the decision is stored together with the cut values it was computed with.
+// Calls filling histograms always bypass the cache.
+namespace {
+  enum EDecision { kDecV0 = 0, kDecAD, kDecT0, kDecSPDChips, kDecZDCTime, kDecV0PF, kDecSPDVtx, kDecSPDClsVsTkl, kNDecisions };
+  const char* gDecisionNames[kNDecisions] = { "V0Trigger", "ADTrigger", "T0Trigger", "SPDFiredChips", "ZDCTimeTrigger", "IsV0PFPileup", "IsSPDVtxPileup", "IsSPDClusterVsTrackletBG" };
+  
+  // first bit in fValid of each decision type
+  enum EValidBit { kBitV0 = 0, kBitAD = 4, kBitT0 = 8, kBitSPDChips = 12, kBitZDCTime = 18, kBitV0PF = 19, kBitSPDVtx = 20, kBitSPDClsVsTkl = 21 };
+  
+  struct AliTriggerAnalysisDecisionCache {
+    AliTriggerAnalysisDecisionCache() : fEnabled(kTRUE), fEvent(0), fRun(-1), fPeriod(0), fOrbit(0), fBC(0), fEventInFile(-1), fEntry(-1), fValid(0), fStatRun(-1) { ResetCounters(); }
+    
+    Bool_t Lookup(Int_t bit, Int_t decision) {
+      if (!(fValid & (1u << bit))) return kFALSE;
+      fSaved[decision]++;
+      return kTRUE;
+    }
+    void Store(Int_t bit, Int_t decision) {
+      fValid |= (1u << bit);
+      fComputed[decision]++;
+    }
+    void ResetCounters() {
+      for (Int_t i=0; i<kNDecisions; i++) fComputed[i] = fSaved[i] = 0;
+    }
+    
+    Bool_t              fEnabled;      // cache in use
+    
+    const AliVEvent*    fEvent;        // identity of the cached event
+    Int_t               fRun;          //
+    UInt_t              fPeriod;       //
+    UInt_t              fOrbit;        //
+    UShort_t            fBC;           //
+    Int_t               fEventInFile;  //
+    Long64_t            fEntry;        // analysis manager entry (-1 if none)
+    UInt_t              fValid;        // valid entries (see EValidBit)
+    
+    Int_t    fV0[2][2];                // V0Trigger decision [side][online]
+    Int_t    fAD[2][2];                // ADTrigger decision [side][online]
+    Int_t    fT0[2][2];                // T0Trigger decision [MC][online]
+    Int_t    fSPDChips[2][3];          // SPDFiredChips [origin][layer] without FO efficiency simulation
+    Bool_t   fZDCTime;                 // ZDCTimeTrigger decision ...
+    Bool_t   fZDCTimeMC;               // ... for MC or data
+    Float_t  fZDCTimeCuts[4];          // ... and these cuts
+    UChar_t  fPFFlags[21][4];          // V0 past-future BBA, BBC, BGA, BGC flag counts per bunch crossing
+    Bool_t   fSPDVtx;                  // IsPileupFromSPD decision ...
+    Int_t    fSPDVtxMinContributors;   // ... for these cuts
+    Float_t  fSPDVtxCuts[4];           //
+    Int_t    fNTracklets;              // SPD tracklets
+    Int_t    fNClusters;               // SPD clusters (both layers)
+    
+    Int_t    fStatRun;                 // run of the counters below
+    Long64_t fComputed[kNDecisions];   // decisions computed
+    Long64_t fSaved[kNDecisions];      // decisions served from the cache
+  };
+  
+  AliTriggerAnalysisDecisionCache gDecisionCache;
+  
+  AliTriggerAnalysisDecisionCache* DecisionCache(const AliVEvent* event){
+    // returns the cache for the given event (0 if disabled), which is cleared if the event changed
+    if (!gDecisionCache.fEnabled) return 0;
+    AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+    Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+    Int_t run = event->GetRunNumber();
+    if (event == gDecisionCache.fEvent && 
+        entry == gDecisionCache.fEntry &&
+        run   == gDecisionCache.fRun &&
+        event->GetPeriodNumber()      == gDecisionCache.fPeriod && 
+        event->GetOrbitNumber()       == gDecisionCache.fOrbit && 
+        event->GetBunchCrossNumber()  == gDecisionCache.fBC && 
+        event->GetEventNumberInFile() == gDecisionCache.fEventInFile) return &gDecisionCache;
+    
+    if (run != gDecisionCache.fStatRun) {
+      if (gDecisionCache.fStatRun >= 0) AliTriggerAnalysis::PrintDecisionCacheStatistics();
+      gDecisionCache.ResetCounters();
+      gDecisionCache.fStatRun = run;
+    }
+    gDecisionCache.fEvent       = event;
+    gDecisionCache.fEntry       = entry;
+    gDecisionCache.fRun         = run;
+    gDecisionCache.fPeriod      = event->GetPeriodNumber();
+    gDecisionCache.fOrbit       = event->GetOrbitNumber();
+    gDecisionCache.fBC          = event->GetBunchCrossNumber();
+    gDecisionCache.fEventInFile = event->GetEventNumberInFile();
+    gDecisionCache.fValid       = 0;
+    return &gDecisionCache;
+  }
+}
+
 AliTriggerAnalysis::AliTriggerAnalysis(TString name) :
 AliOADBTriggerAnalysis(name.Data()),
 fSPDGFOEfficiency(0),
@@ -182,6 +275,52 @@ AliTriggerAnalysis::~AliTriggerAnalysis(){
 }
 
 
+//-------------------------------------------------------------------------------------------------
+void AliTriggerAnalysis::SetDecisionCache(Bool_t flag){
+  // enables/disables the per-event cache of detector decisions shared by all objects of this class (on by default)
+  gDecisionCache.fEnabled = flag;
+  ResetDecisionCache();
+}
+
+
+//-------------------------------------------------------------------------------------------------
+void AliTriggerAnalysis::ResetDecisionCache(){
+  // forgets the cached decisions, e.g. if the event content was modified
+  gDecisionCache.fEvent = 0;
+  gDecisionCache.fValid = 0;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+Long64_t AliTriggerAnalysis::GetNDecisionsComputed(){
+  // number of detector decisions computed and stored in the cache in the current run
+  Long64_t n = 0;
+  for (Int_t i=0; i<kNDecisions; i++) n += gDecisionCache.fComputed[i];
+  return n;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+Long64_t AliTriggerAnalysis::GetNDecisionsSaved(){
+  // number of detector decisions served from the cache (i.e. recomputations saved) in the current run
+  Long64_t n = 0;
+  for (Int_t i=0; i<kNDecisions; i++) n += gDecisionCache.fSaved[i];
+  return n;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+void AliTriggerAnalysis::PrintDecisionCacheStatistics(){
+  // prints the number of computed and saved detector decisions for the current run
+  // (called automatically when the run changes)
+  AliInfoClass(Form("Decision cache for run %d: %lld computed, %lld recomputations saved", gDecisionCache.fStatRun, GetNDecisionsComputed(), GetNDecisionsSaved()));
+  for (Int_t i=0; i<kNDecisions; i++) {
+    if (!gDecisionCache.fComputed[i] && !gDecisionCache.fSaved[i]) continue;
+    AliInfoClass(Form("  %-25s %10lld computed %10lld saved", gDecisionNames[i], gDecisionCache.fComputed[i], gDecisionCache.fSaved[i]));
+  }
+}
+
+
 //-------------------------------------------------------------------------------------------------
 void AliTriggerAnalysis::EnableHistograms(Bool_t isLowFlux){
   // creates the monitoring histograms 
@@ -625,6 +764,22 @@ Bool_t AliTriggerAnalysis::IsOfflineTriggerFired(const AliVEvent* event, Trigger
 
 //-------------------------------------------------------------------------------------------------
 Int_t AliTriggerAnalysis::SPDFiredChips(const AliVEvent* event, Int_t origin, Int_t fillHists, Int_t layer){
+  // returns the number of fired chips in the SPD, see SPDFiredChipsUncached
+  // the FO efficiency simulation draws random numbers, so it is not cached
+  if (fillHists || fSPDGFOEfficiency || origin < 0 || origin > 1 || layer < 0 || layer > 2) 
+    return SPDFiredChipsUncached(event, origin, fillHists, layer);
+  AliTriggerAnalysisDecisionCache* cache = DecisionCache(event);
+  if (!cache) return SPDFiredChipsUncached(event, origin, fillHists, layer);
+  Int_t bit = kBitSPDChips + 3*origin + layer;
+  if (cache->Lookup(bit, kDecSPDChips)) return cache->fSPDChips[origin][layer];
+  cache->fSPDChips[origin][layer] = SPDFiredChipsUncached(event, origin, fillHists, layer);
+  cache->Store(bit, kDecSPDChips);
+  return cache->fSPDChips[origin][layer];
+}
+
+
+//-------------------------------------------------------------------------------------------------
+Int_t AliTriggerAnalysis::SPDFiredChipsUncached(const AliVEvent* event, Int_t origin, Int_t fillHists, Int_t layer){
   // returns the number of fired chips in the SPD
   //
   // origin = 0 --> event->GetMultiplicity()->GetNumberOfFiredChips() (filled from clusters)
@@ -668,6 +823,21 @@ Int_t AliTriggerAnalysis::SPDFiredChips(const AliVEvent* event, Int_t origin, In
 
 //-------------------------------------------------------------------------------------------------
 AliTriggerAnalysis::ADDecision AliTriggerAnalysis::ADTrigger(const AliVEvent* event, AliceSide side, Bool_t online, Int_t fillHists){
+  // Returns the AD trigger decision, see ADTriggerUncached
+  if (fillHists || (side != kASide && side != kCSide)) return ADTriggerUncached(event, side, online, fillHists);
+  AliTriggerAnalysisDecisionCache* cache = DecisionCache(event);
+  if (!cache) return ADTriggerUncached(event, side, online, fillHists);
+  Int_t iSide = (side == kASide) ? 0 : 1;
+  Int_t bit = kBitAD + 2*iSide + (online ? 1 : 0);
+  if (cache->Lookup(bit, kDecAD)) return (ADDecision) cache->fAD[iSide][online ? 1 : 0];
+  cache->fAD[iSide][online ? 1 : 0] = ADTriggerUncached(event, side, online, fillHists);
+  cache->Store(bit, kDecAD);
+  return (ADDecision) cache->fAD[iSide][online ? 1 : 0];
+}
+
+
+//-------------------------------------------------------------------------------------------------
+AliTriggerAnalysis::ADDecision AliTriggerAnalysis::ADTriggerUncached(const AliVEvent* event, AliceSide side, Bool_t online, Int_t fillHists){
   // Returns the AD trigger decision 
   // argument 'online' is used as a switch between online and offline trigger algorithms
   
@@ -709,6 +879,21 @@ AliTriggerAnalysis::ADDecision AliTriggerAnalysis::ADTrigger(const AliVEvent* ev
 
 //-------------------------------------------------------------------------------------------------
 AliTriggerAnalysis::V0Decision AliTriggerAnalysis::V0Trigger(const AliVEvent* event, AliceSide side, Bool_t online, Int_t fillHists){
+  // Returns the V0 trigger decision, see V0TriggerUncached
+  if (fillHists || (side != kASide && side != kCSide)) return V0TriggerUncached(event, side, online, fillHists);
+  AliTriggerAnalysisDecisionCache* cache = DecisionCache(event);
+  if (!cache) return V0TriggerUncached(event, side, online, fillHists);
+  Int_t iSide = (side == kASide) ? 0 : 1;
+  Int_t bit = kBitV0 + 2*iSide + (online ? 1 : 0);
+  if (cache->Lookup(bit, kDecV0)) return (V0Decision) cache->fV0[iSide][online ? 1 : 0];
+  cache->fV0[iSide][online ? 1 : 0] = V0TriggerUncached(event, side, online, fillHists);
+  cache->Store(bit, kDecV0);
+  return (V0Decision) cache->fV0[iSide][online ? 1 : 0];
+}
+
+
+//-------------------------------------------------------------------------------------------------
+AliTriggerAnalysis::V0Decision AliTriggerAnalysis::V0TriggerUncached(const AliVEvent* event, AliceSide side, Bool_t online, Int_t fillHists){
   // Returns the V0 trigger decision 
   // argument 'online' is used as a switch between online and offline trigger algorithms
   
@@ -798,6 +983,29 @@ Bool_t AliTriggerAnalysis::ZDCTDCTrigger(const AliVEvent* event, AliceSide side,
 
 //-------------------------------------------------------------------------------------------------
 Bool_t AliTriggerAnalysis::ZDCTimeTrigger(const AliVEvent* event, Int_t fillHists) const {
+  // Returns the ZDC timing decision, see ZDCTimeTriggerUncached
+  if (fillHists) return ZDCTimeTriggerUncached(event, fillHists);
+  AliTriggerAnalysisDecisionCache* cache = DecisionCache(event);
+  if (!cache) return ZDCTimeTriggerUncached(event, fillHists);
+  if (cache->fZDCTimeMC == fMC &&
+      cache->fZDCTimeCuts[0] == fZDCCutRefDeltaCorr &&
+      cache->fZDCTimeCuts[1] == fZDCCutSigmaDeltaCorr &&
+      cache->fZDCTimeCuts[2] == fZDCCutRefSumCorr &&
+      cache->fZDCTimeCuts[3] == fZDCCutSigmaSumCorr &&
+      cache->Lookup(kBitZDCTime, kDecZDCTime)) return cache->fZDCTime;
+  cache->fZDCTime        = ZDCTimeTriggerUncached(event, fillHists);
+  cache->fZDCTimeMC      = fMC;
+  cache->fZDCTimeCuts[0] = fZDCCutRefDeltaCorr;
+  cache->fZDCTimeCuts[1] = fZDCCutSigmaDeltaCorr;
+  cache->fZDCTimeCuts[2] = fZDCCutRefSumCorr;
+  cache->fZDCTimeCuts[3] = fZDCCutSigmaSumCorr;
+  cache->Store(kBitZDCTime, kDecZDCTime);
+  return cache->fZDCTime;
+}
+
+
+//-------------------------------------------------------------------------------------------------
+Bool_t AliTriggerAnalysis::ZDCTimeTriggerUncached(const AliVEvent* event, Int_t fillHists) const {
   // This method implements a selection based on the timing in both sides of zdcN
   // It can be used in order to eliminate parasitic collisions
   // usage of uncorrected timings is deprecated
@@ -982,6 +1190,21 @@ Bool_t AliTriggerAnalysis::FMDTrigger(const AliVEvent* event, AliceSide side){
 
 //-------------------------------------------------------------------------------------------------
 AliTriggerAnalysis::T0Decision AliTriggerAnalysis::T0Trigger(const AliVEvent* event, Bool_t online, Int_t fillHists){
+  // Returns the T0 TVDC trigger decision, see T0TriggerUncached
+  if (fillHists) return T0TriggerUncached(event, online, fillHists);
+  AliTriggerAnalysisDecisionCache* cache = DecisionCache(event);
+  if (!cache) return T0TriggerUncached(event, online, fillHists);
+  Int_t iMC = fMC ? 1 : 0;
+  Int_t bit = kBitT0 + 2*iMC + (online ? 1 : 0);
+  if (cache->Lookup(bit, kDecT0)) return (T0Decision) cache->fT0[iMC][online ? 1 : 0];
+  cache->fT0[iMC][online ? 1 : 0] = T0TriggerUncached(event, online, fillHists);
+  cache->Store(bit, kDecT0);
+  return (T0Decision) cache->fT0[iMC][online ? 1 : 0];
+}
+
+
+//-------------------------------------------------------------------------------------------------
+AliTriggerAnalysis::T0Decision AliTriggerAnalysis::T0TriggerUncached(const AliVEvent* event, Bool_t online, Int_t fillHists){
   // Returns the T0 TVDC trigger decision
   //  
   // argument 'online' is used as a switch between online and offline trigger algorithms
@@ -1188,6 +1411,9 @@ Bool_t AliTriggerAnalysis::IsSPDClusterVsTrackletBG(const AliVEvent* event, Int_
   // rejects BG based on the cluster vs tracklet correlation
   // returns true if the event is BG
   if (!fPileupCutsEnabled) return kFALSE;
+  AliTriggerAnalysisDecisionCache* cache = fillHists ? 0 : DecisionCache(event);
+  if (cache && cache->Lookup(kBitSPDClsVsTkl, kDecSPDClsVsTkl)) 
+    return cache->fNClusters > fSPDClsVsTklA + cache->fNTracklets*fSPDClsVsTklB;
   const AliVMultiplicity* mult = event->GetMultiplicity();
   if (!mult) { 
     AliError("No multiplicity object"); 
@@ -1195,6 +1421,11 @@ Bool_t AliTriggerAnalysis::IsSPDClusterVsTrackletBG(const AliVEvent* event, Int_
   }
   Int_t nTkl = mult->GetNumberOfTracklets();
   Int_t nCls = event->GetNumberOfITSClusters(0) + event->GetNumberOfITSClusters(1);
+  if (cache) {
+    cache->fNTracklets = nTkl;
+    cache->fNClusters  = nCls;
+    cache->Store(kBitSPDClsVsTkl, kDecSPDClsVsTkl);
+  }
   if      (fillHists==1) fHistSPDClsVsTklAll->Fill(nTkl,nCls);
   else if (fillHists==2) fHistSPDClsVsTklCln->Fill(nTkl,nCls);
   return nCls > fSPDClsVsTklA + nTkl*fSPDClsVsTklB;
@@ -1282,16 +1513,40 @@ Bool_t AliTriggerAnalysis::IsV0PFPileup(const AliVEvent* event, Int_t fillHists)
 
   Bool_t vir[21] = {0};
   UChar_t bcMod4 = event->GetBunchCrossNumber()%4;
+  
+  // the flag counts do not depend on the cuts: with the cache, all of them are counted once per event
+  AliTriggerAnalysisDecisionCache* cache = fillHists ? 0 : DecisionCache(event);
+  if (cache && !cache->Lookup(kBitV0PF, kDecV0PF)) {
+    for (Int_t bc=0;bc<=20;bc++) {
+      UChar_t* n = cache->fPFFlags[bc];
+      n[0] = n[1] = n[2] = n[3] = 0;
+      for (Int_t i=0;i<32;i++) {
+        n[0]+=vzero->GetPFBBFlag(i+32,bc);
+        n[1]+=vzero->GetPFBBFlag(i   ,bc);
+        n[2]+=vzero->GetPFBGFlag(i+32,bc);
+        n[3]+=vzero->GetPFBGFlag(i   ,bc);
+      }
+    }
+    cache->Store(kBitV0PF, kDecV0PF);
+  }
 
   for (Int_t bc=0;bc<=20;bc++) {
     UChar_t nBBA=0;
     UChar_t nBBC=0;
     UChar_t nBGA=0;
     UChar_t nBGC=0;
-    if (fVIRBBAflags<33) for (Int_t i=0;i<32;i++) nBBA+=vzero->GetPFBBFlag(i+32,bc);
-    if (fVIRBBCflags<33) for (Int_t i=0;i<32;i++) nBBC+=vzero->GetPFBBFlag(i   ,bc);
-    if (fVIRBGAflags<33) for (Int_t i=0;i<32;i++) nBGA+=vzero->GetPFBGFlag(i+32,bc);
-    if (fVIRBGCflags<33) for (Int_t i=0;i<32;i++) nBGC+=vzero->GetPFBGFlag(i   ,bc);
+    if (cache) {
+      // at most 32 flags are counted, so the counts of the disabled conditions (>=33 flags) never fire
+      nBBA = cache->fPFFlags[bc][0];
+      nBBC = cache->fPFFlags[bc][1];
+      nBGA = cache->fPFFlags[bc][2];
+      nBGC = cache->fPFFlags[bc][3];
+    } else {
+      if (fVIRBBAflags<33) for (Int_t i=0;i<32;i++) nBBA+=vzero->GetPFBBFlag(i+32,bc);
+      if (fVIRBBCflags<33) for (Int_t i=0;i<32;i++) nBBC+=vzero->GetPFBBFlag(i   ,bc);
+      if (fVIRBGAflags<33) for (Int_t i=0;i<32;i++) nBGA+=vzero->GetPFBGFlag(i+32,bc);
+      if (fVIRBGCflags<33) for (Int_t i=0;i<32;i++) nBGC+=vzero->GetPFBGFlag(i   ,bc);
+    }
     vir[bc] |= nBBA>=fVIRBBAflags;
     vir[bc] |= nBBC>=fVIRBBCflags;
     vir[bc] |= nBGA>=fVIRBGAflags;
@@ -1329,7 +1584,24 @@ Bool_t AliTriggerAnalysis::IsV0PFPileup(const AliVEvent* event, Int_t fillHists)
 //-------------------------------------------------------------------------------------------------
 Bool_t AliTriggerAnalysis::IsSPDVtxPileup(const AliVEvent* event, Int_t fillHists) {
   if (!fPileupCutsEnabled) return kFALSE;
+  AliTriggerAnalysisDecisionCache* cache = fillHists ? 0 : DecisionCache(event);
+  if (cache && 
+      cache->fSPDVtxMinContributors == fVtxMinContributors &&
+      cache->fSPDVtxCuts[0] == fVtxMinZdist &&
+      cache->fSPDVtxCuts[1] == fVtxNSigmaZdist &&
+      cache->fSPDVtxCuts[2] == fVtxNSigmaDiamXY &&
+      cache->fSPDVtxCuts[3] == fVtxNSigmaDiamZ &&
+      cache->Lookup(kBitSPDVtx, kDecSPDVtx)) return cache->fSPDVtx;
   Bool_t pileup = event->IsPileupFromSPD(fVtxMinContributors,fVtxMinZdist,fVtxNSigmaZdist,fVtxNSigmaDiamXY,fVtxNSigmaDiamZ);
+  if (cache) {
+    cache->fSPDVtx                = pileup;
+    cache->fSPDVtxMinContributors = fVtxMinContributors;
+    cache->fSPDVtxCuts[0]         = fVtxMinZdist;
+    cache->fSPDVtxCuts[1]         = fVtxNSigmaZdist;
+    cache->fSPDVtxCuts[2]         = fVtxNSigmaDiamXY;
+    cache->fSPDVtxCuts[3]         = fVtxNSigmaDiamZ;
+    cache->Store(kBitSPDVtx, kDecSPDVtx);
+  }
   if      (fillHists==1) fHistSPDVtxPileupAll->Fill(pileup);
   else if (fillHists==2) fHistSPDVtxPileupCln->Fill(pileup);
   return pileup;
@@ -96,9 +96,21 @@ public:
   void SaveHistograms() const;
   void PrintTriggerClasses() const;
   void Browse(TBrowser *b);
+  
+  // detector decisions shared by all AliTriggerAnalysis objects within one event
+  static void SetDecisionCache(Bool_t flag = kTRUE);
+  static void ResetDecisionCache();
+  static Long64_t GetNDecisionsComputed();
+  static Long64_t GetNDecisionsSaved();
+  static void PrintDecisionCacheStatistics();
 
 protected:
   Int_t FMDHitCombinations(const AliESDEvent* aEsd, AliceSide side, Int_t fillHists = 0);
+  ADDecision ADTriggerUncached   (const AliVEvent* event, AliceSide side, Bool_t online, Int_t fillHists);
+  V0Decision V0TriggerUncached   (const AliVEvent* event, AliceSide side, Bool_t online, Int_t fillHists);
+  T0Decision T0TriggerUncached   (const AliVEvent* event, Bool_t online, Int_t fillHists);
+  Int_t SPDFiredChipsUncached    (const AliVEvent* event, Int_t origin, Int_t fillHists, Int_t layer);
+  Bool_t ZDCTimeTriggerUncached  (const AliVEvent* event, Int_t fillHists) const;
   
   TH1F* fSPDGFOEfficiency;   //! FO efficiency applied in SPDFiredChips. function of chip number (bin 1..400: first layer; 401..1200: second layer)
   
@@ -57,7 +57,9 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter() // All data members
   fEvtCuts(0),
   fTrkCuts(0),
   fSetter(0),
-  fSaveCutsFlag(0)
+  fSaveCutsFlag(0),
+  fColumnarTracks(0),
+  fVarPrecision("")
 {
   // Dummy constructor ALWAYS needed for I/O.
 }
@@ -71,7 +73,9 @@ AliAnalysisTaskNanoAODFilter::AliAnalysisTaskNanoAODFilter(const char *name, Boo
    fEvtCuts(0),
    fTrkCuts(0),
    fSetter(0),
-   fSaveCutsFlag(saveCutsFlag)
+   fSaveCutsFlag(saveCutsFlag),
+   fColumnarTracks(0),
+   fVarPrecision("")
      
 {
   // Constructor
@@ -125,6 +129,8 @@ void AliAnalysisTaskNanoAODFilter::AddFilteredAOD(const char* aodfilename, const
      
   cout<<"rep: "<<rep<<endl;
   rep->SetCustomSetter(fSetter);
+  rep->SetColumnarTracks(fColumnarTracks);
+  if (fVarPrecision.Length()) rep->SetVarPrecision(fVarPrecision);
   std::cout << "SETTER: " << fSetter << " " << rep->GetCustomSetter() << std::endl;
   
   ext->DropUnspecifiedBranches(); // all branches not part of a FilterBranch call (below) will be dropped
@@ -0,0 +1,94 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Lossy quantization of a nanoAOD track variable
+//     See the header for the definition of the codes and the spec format
+//-------------------------------------------------------------------------
+
+#include "TMath.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include "TString.h"
+#include "AliLog.h"
+
+#include "AliNanoAODQuantization.h"
+
+
+//______________________________________________________________________________
+AliNanoAODQuantization::AliNanoAODQuantization(Int_t nbits, Double_t min, Double_t max, ERounding_t rounding) :
+  fNBits(nbits),
+  fMin(min),
+  fMax(max),
+  fStep(0),
+  fRounding(rounding)
+{
+  // constructor
+  if (nbits < 1 || nbits > 32) AliFatalGeneral("AliNanoAODQuantization", Form("Invalid number of bits %d (1-32)", nbits));
+  if (!(max > min)) AliFatalGeneral("AliNanoAODQuantization", Form("Invalid range [%g,%g]", min, max));
+  fStep = (max - min) / (TMath::Power(2., nbits) - 1);
+}
+
+//______________________________________________________________________________
+UInt_t AliNanoAODQuantization::Encode(Double_t value) const
+{
+  // Code of the value, clamped to the range (NaN is stored as the minimum)
+
+  if (!(value > fMin)) return 0;
+  const Double_t maxCode = TMath::Power(2., fNBits) - 1;
+  if (value >= fMax) return UInt_t(maxCode);
+
+  Double_t code = (value - fMin) / fStep;
+  switch (fRounding) {
+  case kDown: code = TMath::Floor(code);       break;
+  case kUp:   code = TMath::Ceil(code);        break;
+  default:    code = TMath::Floor(code + 0.5); break;
+  }
+  return UInt_t(TMath::Min(code, maxCode));
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODQuantization::ParseSpec(const TString & spec, TString & var, AliNanoAODQuantization & quantization)
+{
+  // Parse a single spec var:nbits:min:max[:rounding]
+  // Returns kFALSE if the spec is malformed
+
+  TObjArray * fields = spec.Tokenize(":");
+  const Int_t nfields = fields->GetEntries();
+  Bool_t ok = nfields == 4 || nfields == 5;
+  TString tokens[5];
+  for (Int_t ifield = 0; ok && ifield < nfields; ifield++) {
+    tokens[ifield] = static_cast<TObjString*>(fields->At(ifield))->String().Strip(TString::kBoth);
+  }
+  delete fields;
+  if (!ok) return kFALSE;
+
+  if (!tokens[1].IsDigit() || !tokens[2].IsFloat() || !tokens[3].IsFloat()) return kFALSE;
+  ERounding_t rounding = kNearest;
+  if (nfields == 5) {
+    if      (tokens[4] == "nearest") rounding = kNearest;
+    else if (tokens[4] == "down")    rounding = kDown;
+    else if (tokens[4] == "up")      rounding = kUp;
+    else return kFALSE;
+  }
+  const Int_t nbits = tokens[1].Atoi();
+  const Double_t min = tokens[2].Atof(), max = tokens[3].Atof();
+  if (nbits < 1 || nbits > 32 || !(max > min)) return kFALSE;
+
+  var = tokens[0];
+  quantization = AliNanoAODQuantization(nbits, min, max, rounding);
+  return kTRUE;
+}
@@ -0,0 +1,56 @@
+#ifndef AliNanoAODQuantization_H
+#define AliNanoAODQuantization_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Lossy quantization of a nanoAOD track variable
+//
+//     A value is stored as an integer code of nbits bits, representing
+//     min + code * (max - min) / (2^nbits - 1). Values outside [min,max]
+//     are clamped. The rounding mode decides which code a value between
+//     two representable values gets (nearest, down or up).
+//
+//     The precision is configured per variable with a comma separated
+//     list of specs var:nbits:min:max[:rounding], for instance
+//       "cstNSigmaTPCPi:10:-10:10,TPCncls:8:0:255:down,posDCAx:12:-3.2:3.2"
+//     with rounding one of "nearest" (default), "down", "up"
+//     (see AliAnalysisTaskNanoAODFilter::SetVarPrecision).
+//-------------------------------------------------------------------------
+
+#include "Rtypes.h"
+
+class TString;
+
+class AliNanoAODQuantization {
+
+public:
+
+  enum ERounding_t { kNearest, kDown, kUp };
+
+  AliNanoAODQuantization() : fNBits(0), fMin(0), fMax(0), fStep(0), fRounding(kNearest) {}
+  AliNanoAODQuantization(Int_t nbits, Double_t min, Double_t max, ERounding_t rounding = kNearest);
+
+  Bool_t      IsActive()    const { return fNBits > 0; }
+  Int_t       GetNBits()    const { return fNBits; }
+  Double_t    GetMin()      const { return fMin; }
+  Double_t    GetMax()      const { return fMax; }
+  ERounding_t GetRounding() const { return fRounding; }
+
+  UInt_t   Encode(Double_t value) const;
+  Double_t Decode(UInt_t code) const { return fMin + code * fStep; }
+  Double_t Round(Double_t value) const { return Decode(Encode(value)); }
+
+  static Bool_t ParseSpec(const TString & spec, TString & var, AliNanoAODQuantization & quantization);
+
+private:
+
+  Int_t       fNBits;    // number of bits of the codes (0: not quantized)
+  Double_t    fMin;      // value of code 0
+  Double_t    fMax;      // value of the largest code
+  Double_t    fStep;     // difference between the values of consecutive codes
+  ERounding_t fRounding; // rounding mode
+};
+
+#endif
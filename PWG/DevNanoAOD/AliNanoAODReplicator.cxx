@@ -50,6 +50,7 @@ class AliAODRecoDecay;
 #include <cassert>
 #include "AliESDtrack.h"
 #include "TObjArray.h"
+#include "TObjString.h"
 #include "AliAnalysisFilter.h"
 #include "AliNanoAODTrack.h"
 
@@ -74,6 +75,7 @@ class AliAODRecoDecay;
 #include "TCanvas.h"
 #include "AliNanoAODHeader.h"
 #include "AliNanoAODCustomSetter.h"
+#include "AliNanoAODTrackColumns.h"
 
 using std::cout;
 using std::endl;
@@ -93,7 +95,11 @@ AliAODBranchReplicator(),
   fParticleSelected(),
   fVarList(""),
   fVarListHeader(""),
-  fCustomSetter(0){
+  fCustomSetter(0),
+  fColumnarTracks(kFALSE),
+  fTrackColumns(0x0),
+  fVarPrecision(""),
+  fQuantization(){
   // Default ctor. we need it to avoid instantiating a wrong mapping when reading from file 
   }
 
@@ -114,7 +120,11 @@ AliNanoAODReplicator::AliNanoAODReplicator(const char* name, const char* title,
   fParticleSelected(),
   fVarList(varlist),
   fVarListHeader(""),// FIXME: this should be set to a meaningful value: add an arg to the constructor
-  fCustomSetter(0)
+  fCustomSetter(0),
+  fColumnarTracks(kFALSE),
+  fTrackColumns(0x0),
+  fVarPrecision(""),
+  fQuantization()
 {
   // default ctor
   AliNanoAODTrackMapping * tm =new AliNanoAODTrackMapping(fVarList);
@@ -127,9 +137,41 @@ AliNanoAODReplicator::~AliNanoAODReplicator()
 {
   // dtor
   delete fTrackCut;
+  if (fTrackColumns) delete fTracks; // not in fList in columnar mode
   delete fList;
 }
 
+//_____________________________________________________________________________
+void AliNanoAODReplicator::SetVarPrecision(const char * specs)
+{
+  // Store the listed variables with reduced precision. The values written
+  // to the nanoAOD tracks are the reconstructed quantized values, which
+  // compress much better than the full precision ones. In columnar mode
+  // the codes themselves are written (see AliNanoAODTrackColumns).
+
+  fVarPrecision = specs;
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  fQuantization.assign(mapping->GetSize(), AliNanoAODQuantization());
+
+  TObjArray * specList = fVarPrecision.Tokenize(",");
+  TIter next(specList);
+  TObjString * spec = 0;
+  while ((spec = static_cast<TObjString*>(next()))) {
+    TString var;
+    AliNanoAODQuantization quantization;
+    if (!AliNanoAODQuantization::ParseSpec(spec->String(), var, quantization)) {
+      AliFatal(Form("Malformed precision spec \"%s\" (expected var:nbits:min:max[:nearest|down|up])", spec->String().Data()));
+    }
+    Int_t index = mapping->GetVarIndex(var);
+    if (index < 0 || index >= mapping->GetSize()) {
+      AliFatal(Form("Variable %s of the precision spec is not in the variable list", var.Data()));
+    }
+    fQuantization[index] = quantization;
+    AliInfo(Form("%s stored with %d bits in [%g,%g]", var.Data(), quantization.GetNBits(), quantization.GetMin(), quantization.GetMax()));
+  }
+  delete specList;
+}
+
 //_____________________________________________________________________________
 void AliNanoAODReplicator::SelectParticle(Int_t i)
 {
@@ -407,7 +449,17 @@ TList* AliNanoAODReplicator::GetList() const
 
       fTracks = new TClonesArray("AliNanoAODTrack");      
       fTracks->SetName("tracks"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
-      fList->Add(fTracks);    
+      if (fColumnarTracks) {
+	// the track objects are still built (custom setter, MC filtering), but only the columns are written
+	fTrackColumns = new AliNanoAODTrackColumns("nanotracks");
+	fList->Add(fTrackColumns);
+	fTrackColumns->CreateColumns(fList);
+	for (UInt_t index = 0; index < fQuantization.size(); index++) {
+	  if (fQuantization[index].IsActive()) fTrackColumns->SetQuantization(index, fQuantization[index]);
+	}
+      } else {
+	fList->Add(fTracks);    
+      }
 
       fHeader = new AliNanoAODHeader(3);// TODO: to be customized
       fHeader->SetName("header"); // TODO: consider the possibility to use a different name to distinguish in AliAODEvent
@@ -445,6 +497,7 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   
 
   fTracks->Clear("C");			
+  if (fTrackColumns) fTrackColumns->Clear();
   assert(fVertices!=0x0);
   fVertices->Clear("C");
   if (fMCMode > 0){
@@ -482,6 +535,13 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
     AliNanoAODTrack * special = new((*fTracks)[ntracks++]) AliNanoAODTrack (aodtrack, fVarList);
     
     if(fCustomSetter) fCustomSetter->SetNanoAODTrack(aodtrack, special);
+
+    // Reduced precision. In columnar mode the columns quantize the original values
+    if(!fColumnarTracks) {
+      for (UInt_t index = 0; index < fQuantization.size(); index++) {
+	if (fQuantization[index].IsActive()) special->SetVar(index, fQuantization[index].Round(special->GetVar(index)));
+      }
+    }
   }  
   //----------------------------------------------------------
   
@@ -509,6 +569,11 @@ void AliNanoAODReplicator::ReplicateAndFilter(const AliAODEvent& source)
   if ( fMCMode > 0 ) {
     FilterMC(source);      
   }
+
+  // Columnar tracks, after the MC label remapping
+  if ( fTrackColumns ) {
+    fTrackColumns->Fill(fTracks);
+  }
   
 
 }
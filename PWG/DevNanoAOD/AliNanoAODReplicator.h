@@ -15,6 +15,8 @@
 #endif
 
 #include <iostream>
+#include <vector>
+#include "AliNanoAODQuantization.h"
 
 /* #ifndef AliAOD3LH_H */
 /* #include "AliAOD3LH.h" */
@@ -54,6 +56,7 @@ class AliAODHeader;
 class AliNanoAODHeader;
 class AliAnalysisTaskSE;
 class AliNanoAODTrack;
+class AliNanoAODTrackColumns;
 class AliAODTrack;
 class AliNanoAODCustomSetter;
 
@@ -88,6 +91,14 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
   AliNanoAODCustomSetter * GetCustomSetter() { return fCustomSetter; }
   void  SetCustomSetter (AliNanoAODCustomSetter * var) { fCustomSetter = var;  }
 
+  // Reduced precision for some variables, comma separated list of var:nbits:min:max[:rounding] (see AliNanoAODQuantization)
+  const char * GetVarPrecision() { return fVarPrecision; }
+  void  SetVarPrecision (const char * specs);
+
+  // Write the tracks as one branch per variable (AliNanoAODTrackColumns) instead of the "tracks" array
+  Bool_t GetColumnarTracks() const { return fColumnarTracks; }
+  void  SetColumnarTracks (Bool_t var = kTRUE) { fColumnarTracks = var; }
+
 
  private:
 
@@ -121,13 +132,19 @@ class AliNanoAODReplicator : public AliAODBranchReplicator
 
   AliNanoAODCustomSetter * fCustomSetter;  // Setter class for custom variables
 
+  Bool_t fColumnarTracks; // write the tracks in columnar format
+  mutable AliNanoAODTrackColumns* fTrackColumns; //! columnar tracks (in fList)
+
+  TString fVarPrecision; // precision of the quantized variables
+  std::vector<AliNanoAODQuantization> fQuantization; //! quantization per variable (index of the track mapping)
+
  private:
 
   
   AliNanoAODReplicator(const AliNanoAODReplicator&);
   AliNanoAODReplicator& operator=(const AliNanoAODReplicator&);
   
-  ClassDef(AliNanoAODReplicator,1) // Branch replicator for ESD to muon AOD.
+  ClassDef(AliNanoAODReplicator,3) // Branch replicator for ESD to muon AOD.
 };
 
 #endif
@@ -0,0 +1,308 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Columnar storage of the NanoAOD tracks of one event
+//     See the header for the layout and an example
+//-------------------------------------------------------------------------
+
+#include "TClonesArray.h"
+#include "TList.h"
+#include "TMath.h"
+#include "TObjArray.h"
+#include "TObjString.h"
+#include "TTree.h"
+#include "AliLog.h"
+#include "AliAODEvent.h"
+
+#include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackMapping.h"
+#include "AliNanoAODTrackColumns.h"
+
+ClassImp(AliNanoAODTrackColumn)
+ClassImp(AliNanoAODTrackColumns)
+
+
+//______________________________________________________________________________
+AliNanoAODTrackColumn::AliNanoAODTrackColumn() :
+  TNamed(),
+  fValues(),
+  fPacked(),
+  fNCodes(0),
+  fNBits(0),
+  fMin(0),
+  fMax(0),
+  fQuantization()
+{
+  // default constructor
+}
+
+//______________________________________________________________________________
+AliNanoAODTrackColumn::AliNanoAODTrackColumn(const char * name) :
+  TNamed(name, name),
+  fValues(),
+  fPacked(),
+  fNCodes(0),
+  fNBits(0),
+  fMin(0),
+  fMax(0),
+  fQuantization()
+{
+  // constructor
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumn::Clear(Option_t * /*opt*/)
+{
+  // Remove the values of the previous event, keeping the allocated memory
+  // (TNamed::Clear would reset the name, which is the branch name)
+  fValues.clear();
+  fPacked.clear();
+  fNCodes = 0;
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumn::SetQuantization(const AliNanoAODQuantization & quantization)
+{
+  // Store the values of this column as codes with reduced precision
+  fQuantization = quantization;
+  fNBits = quantization.GetNBits();
+  fMin = quantization.GetMin();
+  fMax = quantization.GetMax();
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumn::Decode()
+{
+  // Reconstruct the values from the codes read from file
+  if (!fNBits) return;
+  AliNanoAODQuantization quantization(fNBits, fMin, fMax);
+  fValues.resize(fNCodes);
+  for (Int_t i = 0; i < fNCodes; i++) fValues[i] = quantization.Decode(UnpackCode(i));
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumn::PackCode(UInt_t code)
+{
+  // Append the fNBits lowest bits of the code to the packed codes
+  Int_t bit = fNCodes * fNBits;
+  const Int_t nbytes = (bit + fNBits + 7) / 8;
+  if ((Int_t) fPacked.size() < nbytes) fPacked.resize(nbytes, 0);
+  for (Int_t done = 0; done < fNBits; ) {
+    const Int_t shift = bit % 8;
+    const Int_t n = TMath::Min(8 - shift, fNBits - done);
+    fPacked[bit / 8] |= UChar_t(((code >> done) & ((1u << n) - 1)) << shift);
+    done += n;
+    bit += n;
+  }
+  fNCodes++;
+}
+
+//______________________________________________________________________________
+UInt_t AliNanoAODTrackColumn::UnpackCode(Int_t i) const
+{
+  // Code of the i-th track
+  Int_t bit = i * fNBits;
+  UInt_t code = 0;
+  for (Int_t done = 0; done < fNBits; ) {
+    const Int_t shift = bit % 8;
+    const Int_t n = TMath::Min(8 - shift, fNBits - done);
+    code |= UInt_t((fPacked[bit / 8] >> shift) & ((1u << n) - 1)) << done;
+    done += n;
+    bit += n;
+  }
+  return code;
+}
+
+
+//______________________________________________________________________________
+AliNanoAODTrackColumns::AliNanoAODTrackColumns() :
+  TNamed(),
+  fLabel(),
+  fCharge(),
+  fColumns()
+{
+  // default constructor
+  for (Int_t icolumn = 0; icolumn < kNStdColumns; icolumn++) fStdColumns[icolumn] = 0;
+}
+
+//______________________________________________________________________________
+AliNanoAODTrackColumns::AliNanoAODTrackColumns(const char * name) :
+  TNamed(name, name),
+  fLabel(),
+  fCharge(),
+  fColumns()
+{
+  // constructor
+  for (Int_t icolumn = 0; icolumn < kNStdColumns; icolumn++) fStdColumns[icolumn] = 0;
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::Clear(Option_t * /*opt*/)
+{
+  // Remove the tracks of the previous event from all columns
+  fLabel.clear();
+  fCharge.clear();
+  for (UInt_t icolumn = 0; icolumn < fColumns.size(); icolumn++) {
+    if (fColumns[icolumn]) fColumns[icolumn]->Clear();
+  }
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::CreateColumns(TList * list)
+{
+  // Create one column per variable of the track mapping and add them to
+  // the list of objects written to the nanoAOD (which owns them)
+
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  fColumns.clear();
+  for (Int_t index = 0; index < mapping->GetSize(); index++) {
+    TString columnName = TString::Format("%s_", GetName());
+    columnName += mapping->GetVarName(index);
+    AliNanoAODTrackColumn * column = new AliNanoAODTrackColumn(columnName);
+    list->Add(column);
+    fColumns.push_back(column);
+  }
+  SetStdColumns();
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::SetQuantization(Int_t index, const AliNanoAODQuantization & quantization)
+{
+  // Reduced precision for the column of the variable with the given mapping index
+  if (index < 0 || index >= GetNColumns()) AliFatal(Form("No column for variable %d", index));
+  fColumns[index]->SetQuantization(quantization);
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::Fill(const TClonesArray * tracks)
+{
+  // Copy the tracks of the event into the columns
+
+  Clear();
+  const Int_t ntracks = tracks->GetEntriesFast();
+  fLabel.reserve(ntracks);
+  fCharge.reserve(ntracks);
+  for (UInt_t icolumn = 0; icolumn < fColumns.size(); icolumn++) fColumns[icolumn]->Reserve(ntracks);
+
+  for (Int_t itrack = 0; itrack < ntracks; itrack++) {
+    AddTrack(static_cast<const AliNanoAODTrack*>(tracks->UncheckedAt(itrack)));
+  }
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::AddTrack(const AliNanoAODTrack * track)
+{
+  // Append a track to all columns
+  for (UInt_t icolumn = 0; icolumn < fColumns.size(); icolumn++) {
+    fColumns[icolumn]->Add(track->GetVar(icolumn));
+  }
+  fLabel.push_back(track->GetLabel());
+  fCharge.push_back(track->Charge());
+}
+
+//______________________________________________________________________________
+Bool_t AliNanoAODTrackColumns::Connect(const AliAODEvent * event)
+{
+  // Find the columns of all variables of the track mapping in the event.
+  // Columns which are not stored or not read (see SelectColumns) are not
+  // available: GetValues returns NULL and the corresponding getters of
+  // AliNanoAODTrackView are fatal. Columns with reduced precision are decoded.
+  // Returns kFALSE if none of the columns is available.
+
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  fColumns.assign(mapping->GetSize(), 0);
+  Bool_t found = kFALSE;
+  for (Int_t index = 0; index < mapping->GetSize(); index++) {
+    TString columnName = TString::Format("%s_", GetName());
+    columnName += mapping->GetVarName(index);
+    fColumns[index] = dynamic_cast<AliNanoAODTrackColumn*>(event->FindListObject(columnName));
+    if (!fColumns[index]) continue;
+    found = kTRUE;
+    if (fColumns[index]->IsQuantized()) fColumns[index]->Decode();
+  }
+  SetStdColumns();
+  return found;
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::SelectColumns(TTree * tree, const char * vars, const char * name)
+{
+  // Only read the columns of the comma separated list of variables (plus
+  // labels and charges). All other columns are neither read nor decompressed.
+
+  tree->SetBranchStatus(Form("%s_*", name), 0);
+  TObjArray * varList = TString(vars).Tokenize(",");
+  TIter next(varList);
+  TObjString * var = 0;
+  while ((var = static_cast<TObjString*>(next()))) {
+    TString varName = var->String().Strip(TString::kBoth);
+    tree->SetBranchStatus(Form("%s_%s*", name, varName.Data()), 1);
+  }
+  delete varList;
+}
+
+//______________________________________________________________________________
+const Double32_t * AliNanoAODTrackColumns::GetValues(Int_t index) const
+{
+  // Values of the variable with the given mapping index for all tracks of
+  // the event, NULL if the column is not available for this event
+  const AliNanoAODTrackColumn * column = GetColumn(index);
+  if (!column || column->GetSize() != GetNTracks()) return 0;
+  return column->GetArray();
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::SetStdColumns()
+{
+  // Cache the columns used by AliNanoAODTrackView, to avoid the mapping
+  // lookup for every track
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  Int_t indices[kNStdColumns];
+  indices[kPt]         = mapping->GetPt();
+  indices[kPhi]        = mapping->GetPhi();
+  indices[kTheta]      = mapping->GetTheta();
+  indices[kChi2PerNDF] = mapping->GetChi2PerNDF();
+  indices[kTPCncls]    = mapping->GetTPCncls();
+  for (Int_t icolumn = 0; icolumn < kNStdColumns; icolumn++) {
+    const AliNanoAODTrackColumn * column = GetColumn(indices[icolumn]);
+    fStdColumns[icolumn] = (column && column->GetSize() == GetNTracks()) ? column : 0;
+  }
+}
+
+
+//______________________________________________________________________________
+Double_t AliNanoAODTrackView::Eta() const
+{
+  // same as AliNanoAODTrack::Eta
+  return -TMath::Log(TMath::Tan(0.5 * Theta()));
+}
+
+//______________________________________________________________________________
+Double_t AliNanoAODTrackView::GetVar(Int_t index) const
+{
+  // Value of the variable with the given mapping index
+  const Double32_t * values = fColumns->GetValues(index);
+  if (!values) AliFatalGeneral("AliNanoAODTrackView", Form("Variable %d not available", index));
+  return values[fIndex];
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackView::MissingColumn(AliNanoAODTrackColumns::EStdColumn_t column)
+{
+  static const char * names[AliNanoAODTrackColumns::kNStdColumns] = { "pt", "phi", "theta", "chi2perNDF", "TPCncls" };
+  AliFatalGeneral("AliNanoAODTrackView", Form("Variable %s not available", names[column]));
+}
@@ -0,0 +1,186 @@
+#ifndef AliNanoAODTrackColumns_H
+#define AliNanoAODTrackColumns_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Columnar storage of the NanoAOD tracks of one event
+//
+//     Instead of one AliNanoAODTrack object per track, each carrying
+//     its own variable vector, the tracks of an event are stored as
+//     one contiguous array per variable (AliNanoAODTrackColumn). Each
+//     column is a separate object in the event, and therefore a
+//     separate branch of the nanoAOD tree. The label and the charge
+//     are stored in the AliNanoAODTrackColumns object itself.
+//
+//     Columns are named <name>_<variable>, where <name> is the name of
+//     the AliNanoAODTrackColumns object ("nanotracks" by default) and
+//     <variable> the name of the variable in AliNanoAODTrackMapping.
+//
+//     Columns of variables with a reduced precision (see
+//     AliNanoAODQuantization) store the integer codes packed at their bit
+//     width, nbits bits per track, which are decoded by Connect.
+//
+//     Writing: enabled with AliAnalysisTaskNanoAODFilter::SetColumnarTracks
+//
+//     Reading:
+//       AliNanoAODTrackColumns::SelectColumns(tree, "pt,phi,theta");  // optional, before the first event
+//       ...
+//       AliNanoAODTrackColumns * columns = (AliNanoAODTrackColumns*) aodEvent->FindListObject("nanotracks");
+//       columns->Connect(aodEvent);  // every event
+//       const Double32_t * pt = columns->GetValues(AliNanoAODTrackMapping::GetInstance()->GetPt());
+//       for (Int_t itrack = 0; itrack < columns->GetNTracks(); itrack++) { ... pt[itrack] ... }
+//     or, track by track, through AliNanoAODTrackView:
+//       AliNanoAODTrackView track = columns->GetTrack(itrack);
+//       track.Pt(); track.Eta(); track.Charge(); ...
+//-------------------------------------------------------------------------
+
+#include <vector>
+#include "TNamed.h"
+#include "AliNanoAODQuantization.h"
+
+class TList;
+class TTree;
+class TClonesArray;
+class AliAODEvent;
+class AliNanoAODTrack;
+class AliNanoAODTrackView;
+
+class AliNanoAODTrackColumn : public TNamed {
+
+public:
+
+  AliNanoAODTrackColumn();
+  AliNanoAODTrackColumn(const char * name);
+  virtual ~AliNanoAODTrackColumn() {}
+
+  virtual void Clear(Option_t * opt = "");
+
+  Int_t GetSize() const { return fValues.size(); }
+  void Reserve(Int_t n) { if (fNBits) fPacked.reserve((n * fNBits + 7) / 8); else fValues.reserve(n); }
+  void Add(Double_t value) { if (fNBits) PackCode(fQuantization.Encode(value)); else fValues.push_back(value); }
+
+  // reduced precision
+  void   SetQuantization(const AliNanoAODQuantization & quantization);
+  Bool_t IsQuantized() const { return fNBits > 0; }
+  void   Decode();
+
+  Double_t At(Int_t itrack) const { return fValues[itrack]; }
+  const Double32_t * GetArray() const { return fValues.empty() ? 0 : &fValues[0]; }
+
+private:
+
+  void   PackCode(UInt_t code);
+  UInt_t UnpackCode(Int_t i) const;
+
+  std::vector<Double32_t> fValues; // value of the variable for all tracks of the event (empty on file if quantized)
+  std::vector<UChar_t> fPacked;    // quantized values, fNBits bits per track, least significant bit first (reduced precision only)
+  Int_t    fNCodes;                // number of codes in fPacked
+  Int_t    fNBits;                 // number of bits of the codes (0: full precision)
+  Double_t fMin;                   // value of code 0
+  Double_t fMax;                   // value of the largest code
+
+  AliNanoAODQuantization fQuantization; //! encoder used when writing
+
+  ClassDef(AliNanoAODTrackColumn, 3);
+};
+
+
+class AliNanoAODTrackColumns : public TNamed {
+
+public:
+
+  // Columns with dedicated getters in AliNanoAODTrackView
+  enum EStdColumn_t { kPt, kPhi, kTheta, kChi2PerNDF, kTPCncls, kNStdColumns };
+
+  AliNanoAODTrackColumns();
+  AliNanoAODTrackColumns(const char * name);
+  virtual ~AliNanoAODTrackColumns() {}
+
+  virtual void Clear(Option_t * opt = "");
+
+  // writing
+  void CreateColumns(TList * list);
+  void SetQuantization(Int_t index, const AliNanoAODQuantization & quantization);
+  void Fill(const TClonesArray * tracks);
+  void AddTrack(const AliNanoAODTrack * track);
+
+  // reading
+  Bool_t Connect(const AliAODEvent * event);
+  static void SelectColumns(TTree * tree, const char * vars, const char * name = "nanotracks");
+
+  Int_t GetNTracks() const { return fLabel.size(); }
+  Int_t GetNColumns() const { return fColumns.size(); }
+
+  const AliNanoAODTrackColumn * GetColumn(Int_t index) const { return (index >= 0 && index < GetNColumns()) ? fColumns[index] : 0; }
+  const Double32_t * GetValues(Int_t index) const;
+  const AliNanoAODTrackColumn * GetStdColumn(EStdColumn_t column) const { return fStdColumns[column]; }
+
+  Int_t   GetLabel(Int_t itrack) const { return fLabel[itrack]; }
+  Short_t GetCharge(Int_t itrack) const { return fCharge[itrack]; }
+  const Int_t * GetLabels() const { return fLabel.empty() ? 0 : &fLabel[0]; }
+  const Short_t * GetCharges() const { return fCharge.empty() ? 0 : &fCharge[0]; }
+
+  AliNanoAODTrackView GetTrack(Int_t itrack) const;
+
+private:
+
+  AliNanoAODTrackColumns(const AliNanoAODTrackColumns&); // not implemented
+  AliNanoAODTrackColumns& operator=(const AliNanoAODTrackColumns&); // not implemented
+
+  void SetStdColumns();
+
+  std::vector<Int_t>   fLabel;  // track labels, point back to MC tracks
+  std::vector<Short_t> fCharge; // track charges
+
+  std::vector<AliNanoAODTrackColumn*> fColumns; //! columns, in the order of the variables in AliNanoAODTrackMapping (not owned)
+  const AliNanoAODTrackColumn * fStdColumns[kNStdColumns]; //! columns used by AliNanoAODTrackView, if read for the event (not owned)
+
+  ClassDef(AliNanoAODTrackColumns, 1);
+};
+
+
+//-------------------------------------------------------------------------
+//     Lightweight read-only view of one track in AliNanoAODTrackColumns.
+//     Only valid for the event the columns were connected to.
+//-------------------------------------------------------------------------
+class AliNanoAODTrackView {
+
+public:
+
+  AliNanoAODTrackView(const AliNanoAODTrackColumns * columns, Int_t index) : fColumns(columns), fIndex(index) {}
+
+  Int_t    GetIndex() const { return fIndex; }
+
+  Double_t Pt()         const { return Value(AliNanoAODTrackColumns::kPt); }
+  Double_t Phi()        const { return Value(AliNanoAODTrackColumns::kPhi); }
+  Double_t Theta()      const { return Value(AliNanoAODTrackColumns::kTheta); }
+  Double_t Eta()        const;
+  Double_t Chi2perNDF() const { return Value(AliNanoAODTrackColumns::kChi2PerNDF); }
+  UShort_t GetTPCNcls() const { return Value(AliNanoAODTrackColumns::kTPCncls); }
+  Short_t  Charge()     const { return fColumns->GetCharge(fIndex); }
+  Int_t    GetLabel()   const { return fColumns->GetLabel(fIndex); }
+
+  Double_t GetVar(Int_t index) const;
+
+private:
+
+  Double_t Value(AliNanoAODTrackColumns::EStdColumn_t column) const;
+  static void MissingColumn(AliNanoAODTrackColumns::EStdColumn_t column);
+
+  const AliNanoAODTrackColumns * fColumns; // columns of the event
+  Int_t fIndex;                            // index of the track in the columns
+};
+
+inline AliNanoAODTrackView AliNanoAODTrackColumns::GetTrack(Int_t itrack) const {
+  return AliNanoAODTrackView(this, itrack);
+}
+
+inline Double_t AliNanoAODTrackView::Value(AliNanoAODTrackColumns::EStdColumn_t column) const {
+  const AliNanoAODTrackColumn * values = fColumns->GetStdColumn(column);
+  if (!values) MissingColumn(column);
+  return values->At(fIndex);
+}
+
+#endif
@@ -120,7 +120,7 @@ AliVCluster* AliClusterContainer::GetAcceptCluster(Int_t i) const
   if (!vc) return 0;
 
   UInt_t rejectionReason = 0;
-  if (AcceptCluster(vc, rejectionReason))
+  if (AcceptObjectShared(i, rejectionReason))
     return vc;
   else {
     AliDebug(2,"Cluster not accepted.");
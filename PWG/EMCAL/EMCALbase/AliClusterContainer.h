@@ -38,6 +38,8 @@ class AliClusterContainer : public AliEmcalContainer {
 
   virtual Bool_t              AcceptObject(Int_t i, UInt_t &rejectionReason) const              { return AcceptCluster(i, rejectionReason);}
   virtual Bool_t              AcceptObject(const TObject* obj, UInt_t &rejectionReason) const   { return AcceptCluster(dynamic_cast<const AliVCluster*>(obj), rejectionReason);}
+  virtual Bool_t              IsAcceptanceShareable() const                                     { return IsA() == AliClusterContainer::Class(); }
+  virtual Bool_t              IsSelectionVertexDependent() const                                { return kTRUE                                ; }
   virtual Bool_t              AcceptCluster(Int_t i, UInt_t &rejectionReason)                 const;
   virtual Bool_t              AcceptCluster(const AliVCluster* vp, UInt_t &rejectionReason)   const;
   virtual Bool_t              ApplyClusterCuts(const AliVCluster* clus, UInt_t &rejectionReason) const;
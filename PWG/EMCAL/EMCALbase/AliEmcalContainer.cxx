@@ -12,12 +12,15 @@
  * about the suitability of this software for any purpose. It is          *
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
+#include <TBufferFile.h>
 #include <TClonesArray.h>
+#include <TMD5.h>
 #include "AliVEvent.h"
 #include "AliLog.h"
 #include "AliNamedArrayI.h"
 #include "AliVParticle.h"
 #include "AliTLorentzVector.h"
+#include "AliEmcalContainerAcceptanceCache.h"
 
 #include "AliEmcalContainer.h"
 
@@ -48,11 +51,16 @@ AliEmcalContainer::AliEmcalContainer():
   fMinMCLabel(-1),
   fMaxMCLabel(-1),
   fMassHypothesis(-1),
+  fShareAcceptance(kFALSE),
   fClArray(0),
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
-  fClassName()
+  fInputEvent(0),
+  fClassName(),
+  fAcceptanceSlot(-1),
+  fAcceptanceSerial(0),
+  fAcceptanceCheck(kFALSE)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -84,11 +92,16 @@ AliEmcalContainer::AliEmcalContainer(const char *name):
   fMinMCLabel(-1),
   fMaxMCLabel(-1),
   fMassHypothesis(-1),
+  fShareAcceptance(kFALSE),
   fClArray(0),
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
-  fClassName()
+  fInputEvent(0),
+  fClassName(),
+  fAcceptanceSlot(-1),
+  fAcceptanceSerial(0),
+  fAcceptanceCheck(kFALSE)
 {
   fVertex[0] = 0;
   fVertex[1] = 0;
@@ -130,6 +143,7 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
 {
   const AliVVertex *vertex = event->GetPrimaryVertex();
   if (vertex) vertex->GetXYZ(fVertex);
+  fInputEvent = event;
 
   if (!fClArrayName.IsNull() && !fClArray) {
     fClArray = dynamic_cast<TClonesArray*>(event->FindListObject(fClArrayName));
@@ -160,6 +174,9 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
  * @return Number of accepted events in the container
  */
 Int_t AliEmcalContainer::GetNAcceptEntries() const{
+  const std::vector<Int_t> *shared = GetAcceptIndicesShared();
+  if (shared) return shared->size();
+
   Int_t result = 0;
   for(int index = 0; index < GetNEntries(); index++){
     UInt_t rejectionReason = 0;
@@ -168,6 +185,113 @@ Int_t AliEmcalContainer::GetNAcceptEntries() const{
   return result;
 }
 
+/**
+ * Preparation for the next event. The slot of the container in the
+ * acceptance cache is checked again at the first shared access.
+ */
+void AliEmcalContainer::NextEvent()
+{
+  fAcceptanceCheck = kTRUE;
+}
+
+/**
+ * Configuration key of the container in the acceptance cache. It is made of
+ * the class name, the name of the array and a checksum of the streamed (persistent)
+ * configuration of the container. The name of the container and the TObject
+ * bits are not part of the selection and are cleared in the streamed copy,
+ * so that containers with the same cuts in different wagons share a slot.
+ * The event vertex (fVertex) is not part of the key either: the slot is booked
+ * once for the run, while the vertex is taken from the event in SetArray. For
+ * containers whose selection depends on it, the vertex is compared in every
+ * event by the acceptance cache, see IsSelectionVertexDependent.
+ * @return Configuration key
+ */
+std::string AliEmcalContainer::GetAcceptanceKey() const
+{
+  AliEmcalContainer *config = static_cast<AliEmcalContainer*>(Clone());
+  config->SetName("");
+  config->SetUniqueID(0);
+  config->ResetBit(kBitMask);
+
+  TBufferFile buffer(TBuffer::kWrite);
+  buffer.WriteObject(config);
+  delete config;
+  TMD5 md5;
+  md5.Update(reinterpret_cast<UChar_t*>(buffer.Buffer()), buffer.Length());
+  md5.Final();
+
+  return std::string(Form("%s/%s/%s", IsA()->GetName(), fClArrayName.Data(), md5.AsString()));
+}
+
+/**
+ * Check whether the accept mask and the momenta are available from the
+ * acceptance cache in the current event. At the first call after NextEvent
+ * the slot of the container is booked (if not done yet) and filled, if no
+ * container with the same configuration did it before in this event. The
+ * slot is not used in this event if it was filled with another vertex and
+ * the selection of the container depends on the vertex.
+ * @return True if the shared accept mask and momenta can be used
+ */
+Bool_t AliEmcalContainer::HasSharedAcceptance() const
+{
+  if (!fShareAcceptance || !fClArray || !fInputEvent) return kFALSE;
+
+  AliEmcalContainerAcceptanceCache *cache = AliEmcalContainerAcceptanceCache::Instance();
+  if (fAcceptanceCheck) {
+    fAcceptanceCheck = kFALSE;
+    if (fAcceptanceSlot == -1) {
+      fAcceptanceSlot = IsAcceptanceShareable() ? cache->GetSlot(GetAcceptanceKey()) : -2;
+    }
+    if (fAcceptanceSlot < 0) return kFALSE;
+    Bool_t usable = cache->Update(fInputEvent, fAcceptanceSlot, this, IsSelectionVertexDependent() ? fVertex : 0);
+    fAcceptanceSerial = usable ? cache->GetEventSerial() : 0;
+  }
+
+  return fAcceptanceSlot >= 0 && fAcceptanceSerial > 0 && fAcceptanceSerial == cache->GetEventSerial() &&
+      cache->GetNEntries(fAcceptanceSlot) == GetNEntries();
+}
+
+/**
+ * Selection of the \f$ i^{th} \f$ entry, taken from the acceptance cache if
+ * the container shares it, from AcceptObject otherwise.
+ * @param[in] i Index of the entry
+ * @param[out] rejectionReason Bitmap with the reason why the entry was rejected
+ * @return True if the entry is accepted
+ */
+Bool_t AliEmcalContainer::AcceptObjectShared(Int_t i, UInt_t &rejectionReason) const
+{
+  if (i >= 0 && i < GetNEntries() && HasSharedAcceptance()) {
+    return AliEmcalContainerAcceptanceCache::Instance()->AcceptObject(fAcceptanceSlot, i, rejectionReason);
+  }
+  return AcceptObject(i, rejectionReason);
+}
+
+/**
+ * Momentum of the \f$ i^{th} \f$ entry, taken from the acceptance cache if
+ * the container shares it, from GetMomentum otherwise.
+ * @param[out] mom Momentum vector of the entry
+ * @param[in] i Index of the entry
+ * @return True if the momentum could be obtained
+ */
+Bool_t AliEmcalContainer::GetMomentumShared(TLorentzVector &mom, Int_t i) const
+{
+  if (i >= 0 && i < GetNEntries() && HasSharedAcceptance()) {
+    return AliEmcalContainerAcceptanceCache::Instance()->GetMomentum(fAcceptanceSlot, i, mom);
+  }
+  return GetMomentum(mom, i);
+}
+
+/**
+ * Indices of the accepted entries in the current event, if the
+ * container shares them.
+ * @return Indices of the accepted entries (NULL if not shared)
+ */
+const std::vector<Int_t> *AliEmcalContainer::GetAcceptIndicesShared() const
+{
+  if (!HasSharedAcceptance()) return 0;
+  return &(AliEmcalContainerAcceptanceCache::Instance()->GetAcceptIndices(fAcceptanceSlot));
+}
+
 /**
  * Get the index in the container from a given label
  * @param lab Label to check
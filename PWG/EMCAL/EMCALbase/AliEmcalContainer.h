@@ -11,6 +11,8 @@ class AliVEvent;
 class AliNamedArrayI;
 class AliVParticle;
 
+#include <string>
+#include <vector>
 #include <TNamed.h>
 #include <TClonesArray.h>
 
@@ -70,6 +72,15 @@ typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterabl
  * }
  * ~~~
  *
+ * Containers with the same configuration (cuts, independent of the container name),
+ * connected to the same array, can share the accept mask and the momenta of the entries
+ * within the event (see SetShareAcceptance).
+ * The first container using them in an event computes them and stores them in the
+ * AliEmcalContainerAcceptanceCache, all other containers (e.g. of other wagons in the
+ * same train) reuse them. This is switched off by default: it must not be used for
+ * containers connected to arrays whose content is modified in the event after the
+ * container was used (e.g. by the EMCAL correction framework or the hadronic correction).
+ *
  * The usage of EMCAL containers is described under \subpage EMCALcontainers
  */
 class AliEmcalContainer : public TObject {
@@ -147,6 +158,13 @@ class AliEmcalContainer : public TObject {
   virtual Bool_t              AcceptObject(Int_t i, UInt_t &rejectionReason) const = 0;
   virtual Bool_t              AcceptObject(const TObject* obj, UInt_t &rejectionReason) const = 0;
   Int_t                       GetNAcceptEntries() const;
+  Bool_t                      AcceptObjectShared(Int_t i, UInt_t &rejectionReason) const;
+  Bool_t                      GetMomentumShared(TLorentzVector &mom, Int_t i) const;
+  const std::vector<Int_t>   *GetAcceptIndicesShared() const;
+  virtual Bool_t              IsAcceptanceShareable()         const { return kFALSE                     ; }
+  virtual Bool_t              IsSelectionVertexDependent()    const { return kFALSE                     ; }
+  Bool_t                      GetShareAcceptance()            const { return fShareAcceptance           ; }
+  void                        SetShareAcceptance(Bool_t b)          { fShareAcceptance = b              ; }
   void                        ResetCurrentID(Int_t i=-1)            { fCurrentID = i                    ; }
   virtual void                SetArray(const AliVEvent *event);
   void                        SetArrayName(const char *n)           { fClArrayName = n                  ; }
@@ -155,7 +173,7 @@ class AliEmcalContainer : public TObject {
   void                        SortArray()                           { fClArray->Sort()                  ; }
 
   TClass*                     GetLoadedClass()                      { return fLoadedClass               ; }
-  virtual void                NextEvent() {;}
+  virtual void                NextEvent();
   void                        SetMinMCLabel(Int_t s)                            { fMinMCLabel      = s   ; }
   void                        SetMaxMCLabel(Int_t s)                            { fMaxMCLabel      = s   ; }
   void                        SetMCLabelRange(Int_t min, Int_t max)             { SetMinMCLabel(min)     ; SetMaxMCLabel(max)    ; }
@@ -202,20 +220,28 @@ class AliEmcalContainer : public TObject {
   Int_t                       fMinMCLabel;              ///< minimum MC label
   Int_t                       fMaxMCLabel;              ///< maximum MC label
   Double_t                    fMassHypothesis;          ///< if < 0 it will use a PID mass when available
+  Bool_t                      fShareAcceptance;         ///< share accept mask and momenta with containers of the same configuration in the event
   TClonesArray               *fClArray;                 //!<! Pointer to array in input event
   Int_t                       fCurrentID;               //!<! current ID for automatic loops
   AliNamedArrayI             *fLabelMap;                //!<! Label-Index map
   Double_t                    fVertex[3];               //!<! event vertex array
   TClass                     *fLoadedClass;             //!<! Class of the objects contained in the TClonesArray
+  const AliVEvent            *fInputEvent;              //!<! input event the array was taken from
+
+  Bool_t                      HasSharedAcceptance() const;
+  std::string                 GetAcceptanceKey() const;
 
  private:
   TString                     fClassName;               ///< name of the class in the TClonesArray
+  mutable Int_t               fAcceptanceSlot;          //!<! slot in the acceptance cache (-1 = not booked, -2 = not shareable)
+  mutable ULong64_t           fAcceptanceSerial;        //!<! event serial of the acceptance cache for which the slot was checked
+  mutable Bool_t              fAcceptanceCheck;         //!<! NextEvent was called, slot not yet checked in this event
 
   AliEmcalContainer(const AliEmcalContainer& obj); // copy constructor
   AliEmcalContainer& operator=(const AliEmcalContainer& other); // assignment
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalContainer,8);
+  ClassDef(AliEmcalContainer,9);
   /// \endcond
 };
 #endif
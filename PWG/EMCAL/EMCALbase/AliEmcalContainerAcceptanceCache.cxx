@@ -0,0 +1,176 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <TLorentzVector.h>
+#include "AliAnalysisManager.h"
+#include "AliVEvent.h"
+#include "AliTLorentzVector.h"
+#include "AliEmcalContainer.h"
+
+#include "AliEmcalContainerAcceptanceCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalContainerAcceptanceCache)
+/// \endcond
+
+AliEmcalContainerAcceptanceCache *AliEmcalContainerAcceptanceCache::fgInstance = nullptr;
+
+/**
+ * Constructor, only used by Instance
+ */
+AliEmcalContainerAcceptanceCache::AliEmcalContainerAcceptanceCache() :
+  TObject(),
+  fSlotIndex(),
+  fSlots(),
+  fEventSerial(0),
+  fEvent(nullptr),
+  fEntry(-1),
+  fRun(-1),
+  fPeriod(0),
+  fOrbit(0),
+  fBC(0),
+  fEventInFile(-1),
+  fNFilled(0),
+  fNReused(0),
+  fNVertexMismatch(0)
+{
+}
+
+AliEmcalContainerAcceptanceCache *AliEmcalContainerAcceptanceCache::Instance(){
+  if(!fgInstance) {
+    fgInstance = new AliEmcalContainerAcceptanceCache;
+  }
+  return fgInstance;
+}
+
+/**
+ * Get the slot for a container configuration. Slots are created at
+ * the first call for a key and kept for the whole run.
+ * @param[in] key Configuration key of the container
+ * @return Slot in the cache
+ */
+Int_t AliEmcalContainerAcceptanceCache::GetSlot(const std::string &key)
+{
+  std::map<std::string, Int_t>::const_iterator it = fSlotIndex.find(key);
+  if (it != fSlotIndex.end()) return it->second;
+
+  Int_t slot = fSlots.size();
+  fSlots.push_back(Slot());
+  fSlotIndex[key] = slot;
+  return slot;
+}
+
+/**
+ * Check whether the event changed since the last call. In this case
+ * the event serial is incremented, which invalidates all slots.
+ * @param[in] event Input event
+ */
+void AliEmcalContainerAcceptanceCache::CheckEvent(const AliVEvent *event)
+{
+  AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+  Long64_t entry = mgr ? mgr->GetCurrentEntry() : -1;
+  if (fEventSerial > 0 &&
+      event == fEvent &&
+      entry == fEntry &&
+      event->GetRunNumber()         == fRun &&
+      event->GetPeriodNumber()      == fPeriod &&
+      event->GetOrbitNumber()       == fOrbit &&
+      event->GetBunchCrossNumber()  == fBC &&
+      event->GetEventNumberInFile() == fEventInFile) return;
+
+  fEventSerial++;
+  fEvent       = event;
+  fEntry       = entry;
+  fRun         = event->GetRunNumber();
+  fPeriod      = event->GetPeriodNumber();
+  fOrbit       = event->GetOrbitNumber();
+  fBC          = event->GetBunchCrossNumber();
+  fEventInFile = event->GetEventNumberInFile();
+}
+
+/**
+ * Make sure the slot holds the selection and the momenta of the entries of the
+ * container for the current event. If the slot was not yet filled in this event,
+ * AcceptObject and GetMomentum of the container are run over all entries.
+ * @param[in] event Input event
+ * @param[in] slot Slot of the container configuration
+ * @param[in] cont Container
+ * @param[in] vertex Vertex of the container if its selection depends on it, 0 otherwise
+ * @return True if the slot holds the selection of the container in this event, false
+ * if it was filled by another container with a different vertex
+ */
+Bool_t AliEmcalContainerAcceptanceCache::Update(const AliVEvent *event, Int_t slot, const AliEmcalContainer *cont, const Double_t *vertex)
+{
+  CheckEvent(event);
+
+  Slot &s = fSlots[slot];
+  if (s.fSerial == fEventSerial) {
+    if (vertex && (vertex[0] != s.fVertex[0] || vertex[1] != s.fVertex[1] || vertex[2] != s.fVertex[2])) {
+      fNVertexMismatch++;
+      return kFALSE;
+    }
+    fNReused++;
+    return kTRUE;
+  }
+
+  const Int_t n = cont->GetNEntries();
+  s.fAcceptIndices.clear();
+  s.fRejectionReasons.resize(n);
+  s.fMomenta.resize(4*n);
+  s.fHasMomentum.resize(n);
+  AliTLorentzVector mom;
+  for (Int_t i = 0; i < n; i++) {
+    UInt_t rejectionReason = 0;
+    if (cont->AcceptObject(i, rejectionReason)) s.fAcceptIndices.push_back(i);
+    s.fRejectionReasons[i] = rejectionReason;
+    s.fHasMomentum[i] = cont->GetMomentum(mom, i);
+    s.fMomenta[4*i]   = mom.Px();
+    s.fMomenta[4*i+1] = mom.Py();
+    s.fMomenta[4*i+2] = mom.Pz();
+    s.fMomenta[4*i+3] = mom.E();
+  }
+  for (Int_t k = 0; k < 3; k++) s.fVertex[k] = vertex ? vertex[k] : 0;
+  s.fSerial = fEventSerial;
+  fNFilled++;
+  return kTRUE;
+}
+
+/**
+ * Selection of the \f$ i^{th} \f$ entry, as AcceptObject of the container.
+ * @param[in] slot Slot of the container configuration
+ * @param[in] i Index of the entry (within 0 and GetNEntries(slot)-1)
+ * @param[out] rejectionReason Bitmap with the reason why the entry was rejected.
+ * Note: The value is not set to 0 in the function, as in AcceptObject.
+ * @return True if the entry is accepted
+ */
+Bool_t AliEmcalContainerAcceptanceCache::AcceptObject(Int_t slot, Int_t i, UInt_t &rejectionReason) const
+{
+  UInt_t reason = fSlots[slot].fRejectionReasons[i];
+  rejectionReason |= reason;
+  return reason == 0;
+}
+
+/**
+ * Momentum of the \f$ i^{th} \f$ entry, as GetMomentum of the container.
+ * @param[in] slot Slot of the container configuration
+ * @param[in] i Index of the entry (within 0 and GetNEntries(slot)-1)
+ * @param[out] mom Momentum vector of the entry
+ * @return Return value of GetMomentum of the container
+ */
+Bool_t AliEmcalContainerAcceptanceCache::GetMomentum(Int_t slot, Int_t i, TLorentzVector &mom) const
+{
+  const Slot &s = fSlots[slot];
+  mom.SetPxPyPzE(s.fMomenta[4*i], s.fMomenta[4*i+1], s.fMomenta[4*i+2], s.fMomenta[4*i+3]);
+  return s.fHasMomentum[i];
+}
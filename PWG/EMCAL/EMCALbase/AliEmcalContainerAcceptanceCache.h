@@ -0,0 +1,139 @@
+#ifndef ALIEMCALCONTAINERACCEPTANCECACHE_H
+#define ALIEMCALCONTAINERACCEPTANCECACHE_H
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <map>
+#include <string>
+#include <vector>
+#include <TObject.h>
+
+class TLorentzVector;
+class AliVEvent;
+class AliEmcalContainer;
+
+/**
+ * @class AliEmcalContainerAcceptanceCache
+ * @brief Accept masks and momenta of EMCAL containers, shared among wagons within the event
+ * @ingroup EMCALCOREFW
+ *
+ * In a train the same arrays (tracks, caloClusters, ...) are selected with the same
+ * cuts by many wagons. The cache stores, for each configuration key of a container
+ * (see AliEmcalContainer::GetAcceptanceKey), the result of AcceptObject and GetMomentum
+ * for all entries of the array. The first container of a given configuration filling
+ * its slot in an event computes them, all other containers with the same key reuse them.
+ * All slots are invalidated when a new event is detected, from the event pointer, the
+ * analysis manager entry and the event header, as for the detector decisions of
+ * AliTriggerAnalysis. For containers whose selection depends on the event vertex
+ * (see AliEmcalContainer::IsSelectionVertexDependent) the vertex the slot was filled
+ * with is stored, and a container with another vertex does not use the slot.
+ *
+ * The class is used as singleton, via the Instance function. Containers access it
+ * through AliEmcalContainer::AcceptObjectShared, GetMomentumShared and
+ * GetAcceptIndicesShared; it is not meant to be used directly by the user.
+ */
+class AliEmcalContainerAcceptanceCache : public TObject {
+public:
+
+  /**
+   * Get instance of the acceptance cache. If called for the
+   * first time a new object is created
+   * @return Acceptance cache
+   */
+  static AliEmcalContainerAcceptanceCache *Instance();
+
+  /**
+   * Destructor
+   */
+  virtual ~AliEmcalContainerAcceptanceCache() {}
+
+  Int_t                       GetSlot(const std::string &key);
+  Bool_t                      Update(const AliVEvent *event, Int_t slot, const AliEmcalContainer *cont, const Double_t *vertex = 0);
+
+  /**
+   * Get the serial number of the current event, incremented
+   * whenever a new event is detected in Update
+   * @return Serial number of the current event
+   */
+  ULong64_t                   GetEventSerial()                          const { return fEventSerial; }
+
+  Bool_t                      AcceptObject(Int_t slot, Int_t i, UInt_t &rejectionReason) const;
+  Bool_t                      GetMomentum(Int_t slot, Int_t i, TLorentzVector &mom) const;
+
+  /**
+   * Get the number of entries of the array of the slot in the current event
+   * @param[in] slot Slot in the cache
+   * @return Number of entries
+   */
+  Int_t                       GetNEntries(Int_t slot)                   const { return fSlots[slot].fRejectionReasons.size(); }
+
+  /**
+   * Get the indices of the accepted entries of the slot in the current event
+   * @param[in] slot Slot in the cache
+   * @return Indices of the accepted entries
+   */
+  const std::vector<Int_t>   &GetAcceptIndices(Int_t slot)              const { return fSlots[slot].fAcceptIndices; }
+
+  /**
+   * Get the number of times a slot was filled
+   * @return Number of times selections and momenta were computed
+   */
+  Long64_t                    GetNFilled()                              const { return fNFilled; }
+
+  /**
+   * Get the number of times a filled slot was found by another container
+   * @return Number of times selections and momenta were reused
+   */
+  Long64_t                    GetNReused()                              const { return fNReused; }
+
+  /**
+   * Get the number of times a filled slot was not used by another container
+   * because of a different vertex
+   * @return Number of times selections and momenta were not reused
+   */
+  Long64_t                    GetNVertexMismatch()                      const { return fNVertexMismatch; }
+
+private:
+  /**
+   * @struct Slot
+   * @brief Accept mask and momenta of the entries of one container configuration
+   */
+  struct Slot {
+    Slot() : fSerial(0), fVertex(), fAcceptIndices(), fRejectionReasons(), fMomenta(), fHasMomentum() {}
+
+    ULong64_t                 fSerial;                  ///< event serial for which the slot is filled (0 = never)
+    Double_t                  fVertex[3];               ///< vertex of the container which filled the slot
+    std::vector<Int_t>        fAcceptIndices;           ///< indices of accepted entries
+    std::vector<UInt_t>       fRejectionReasons;        ///< rejection reason of each entry (0 = accepted)
+    std::vector<Double_t>     fMomenta;                 ///< px, py, pz, E of each entry
+    std::vector<Char_t>       fHasMomentum;             ///< return value of GetMomentum of each entry
+  };
+
+  AliEmcalContainerAcceptanceCache();
+  AliEmcalContainerAcceptanceCache(const AliEmcalContainerAcceptanceCache &ref);
+  AliEmcalContainerAcceptanceCache &operator=(const AliEmcalContainerAcceptanceCache &ref);
+
+  void                        CheckEvent(const AliVEvent *event);
+
+  static AliEmcalContainerAcceptanceCache *fgInstance;  ///< Singleton instance
+
+  std::map<std::string, Int_t> fSlotIndex;              //!<! slot of each configuration key
+  std::vector<Slot>           fSlots;                   //!<! slots
+  ULong64_t                   fEventSerial;             //!<! serial number of the current event
+  const AliVEvent            *fEvent;                   //!<! identity of the current event
+  Long64_t                    fEntry;                   //!<! analysis manager entry (-1 if none)
+  Int_t                       fRun;                     //!<! run number
+  UInt_t                      fPeriod;                  //!<! period number
+  UInt_t                      fOrbit;                   //!<! orbit number
+  UShort_t                    fBC;                      //!<! bunch crossing number
+  Int_t                       fEventInFile;             //!<! event number in file
+  Long64_t                    fNFilled;                 //!<! number of slots filled
+  Long64_t                    fNReused;                 //!<! number of filled slots found by another container
+  Long64_t                    fNVertexMismatch;         //!<! number of filled slots not used by another container because of the vertex
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalContainerAcceptanceCache, 2);
+  /// \endcond
+};
+
+#endif
@@ -150,7 +150,7 @@ public:
       }
       else {
         this->fCurrentElement.second = (*fkData)[fCurrent];
-        fkData->GetContainer()->GetMomentum(this->fCurrentElement.first, fkData->GetInternalIndex(fCurrent));
+        fkData->GetContainer()->GetMomentumShared(this->fCurrentElement.first, fkData->GetInternalIndex(fCurrent));
       }
     }
   };
@@ -327,17 +327,25 @@ T *AliEmcalIterableContainerT<T, STAR>::operator[](int index) const {
 
 /**
  * Build list of accepted indices inside the container.
- * For this all objects inside the container are checked
- * for being accepted or not.
+ * The indices are taken from the accept mask shared in the
+ * event, if the container shares it. Otherwise all objects
+ * inside the container are checked for being accepted or not.
  */
 template <typename T, typename STAR>
 void AliEmcalIterableContainerT<T, STAR>::BuildAcceptIndices(){
-  fAcceptIndices.Set(fkContainer->GetNAcceptEntries());
-  int acceptCounter = 0;
+  const std::vector<Int_t> *shared = fkContainer->GetAcceptIndicesShared();
+  if (shared) {
+    fAcceptIndices.Set(shared->size(), shared->empty() ? 0 : &(shared->front()));
+    return;
+  }
+
+  std::vector<Int_t> accepted;
+  accepted.reserve(fkContainer->GetNEntries());
   for(int index = 0; index < fkContainer->GetNEntries(); index++){
     UInt_t rejectionReason = 0;
-    if(fkContainer->AcceptObject(index, rejectionReason)) fAcceptIndices[acceptCounter++] = index;
+    if(fkContainer->AcceptObject(index, rejectionReason)) accepted.push_back(index);
   }
+  fAcceptIndices.Set(accepted.size(), accepted.empty() ? 0 : &(accepted.front()));
 }
 
 ///////////////////////////////////////////////////////////////////////
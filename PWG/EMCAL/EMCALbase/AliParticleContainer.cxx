@@ -111,7 +111,7 @@ AliVParticle* AliParticleContainer::GetAcceptParticle(Int_t i) const
 {
   UInt_t rejectionReason = 0;
   if (i == -1) i = fCurrentID;
-  if (AcceptParticle(i, rejectionReason)) {
+  if (AcceptObjectShared(i, rejectionReason)) {
       return GetParticle(i);
   }
   else {
@@ -45,6 +45,7 @@ class AliParticleContainer : public AliEmcalContainer {
   virtual Bool_t              ApplyKinematicCuts(const AliTLorentzVector& mom, UInt_t &rejectionReason) const;
   virtual Bool_t              AcceptObject(Int_t i, UInt_t &rejectionReason) const              { return AcceptParticle(i, rejectionReason);}
   virtual Bool_t              AcceptObject(const TObject* obj, UInt_t &rejectionReason) const   { return AcceptParticle(dynamic_cast<const AliVParticle*>(obj), rejectionReason);}
+  virtual Bool_t              IsAcceptanceShareable() const                                     { return IsA() == AliParticleContainer::Class(); }
   virtual Bool_t              AcceptParticle(const AliVParticle* vp, UInt_t &rejectionReason) const        ;
   virtual Bool_t              AcceptParticle(Int_t i, UInt_t &rejectionReason) const                       ;
   Double_t                    GetParticlePtCut()                        const   { return GetMinPt()     ; }
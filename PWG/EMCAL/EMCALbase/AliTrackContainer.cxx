@@ -149,6 +149,8 @@ void AliTrackContainer::SetArray(const AliVEvent *event)
  */
 void AliTrackContainer::NextEvent()
 {
+  AliParticleContainer::NextEvent();
+
   fTrackTypes.Reset(kUndefined);
   if (fEmcalTrackSelection) {
     fFilteredTracks = fEmcalTrackSelection->GetAcceptedTracks(fClArray);
@@ -207,7 +209,7 @@ AliVTrack* AliTrackContainer::GetAcceptTrack(Int_t i) const
 {
   UInt_t rejectionReason;
   if (i == -1) i = fCurrentID;
-  if (AcceptTrack(i, rejectionReason)) {
+  if (AcceptObjectShared(i, rejectionReason)) {
       return GetTrack(i);
   }
   else {
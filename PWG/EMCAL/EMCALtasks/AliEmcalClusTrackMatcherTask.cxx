@@ -37,7 +37,9 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask() :
   fNEmcalTracks(0),
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
-  fHistMatchPhiAll(0)
+  fHistMatchPhiAll(0),
+  fClusterGrid(),
+  fCandidates()
 {
   // Constructor.
 
@@ -67,7 +69,9 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask(const char *name, Boo
   fNEmcalTracks(0),
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
-  fHistMatchPhiAll(0)
+  fHistMatchPhiAll(0),
+  fClusterGrid(),
+  fCandidates()
 {
   // Standard constructor.
 
@@ -280,14 +284,20 @@ void AliEmcalClusTrackMatcherTask::GenerateEmcalParticles()
 void AliEmcalClusTrackMatcherTask::DoMatching() 
 {
   // Set the links between tracks and clusters.
+  // Each track is only compared with the clusters in its cell of the eta-phi grid and the
+  // neighbouring cells, in increasing order of the cluster index as in a loop over all clusters.
 
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  fClusterGrid.Build(fEmcalClusters, fNEmcalClusters, fMaxDistance);
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    fClusterGrid.GetCandidates(track, fCandidates);
+    for (UInt_t icand = 0; icand < fCandidates.size(); icand++) {
+      Int_t icluster = fCandidates[icand];
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
 
@@ -1,7 +1,10 @@
 #ifndef ALIEMCALCLUSTRACKMATCHERTASK_H
 #define ALIEMCALCLUSTRACKMATCHERTASK_H
 
+#include <vector>
+
 #include "AliAnalysisTaskEmcal.h"
+#include "AliEmcalClusterEtaPhiGrid.h"
 
 class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
  public:
@@ -46,11 +49,13 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   TH1          *fHistMatchPhiAll;       //!dphi distribution
   TH1          *fHistMatchEta[8][9][2]; //!deta distribution
   TH1          *fHistMatchPhi[8][9][2]; //!dphi distribution
+  AliEmcalClusterEtaPhiGrid fClusterGrid; //!eta-phi grid of the emcal clusters
+  std::vector<Int_t> fCandidates;       //!clusters close to the current track
   
  private:
   AliEmcalClusTrackMatcherTask(const AliEmcalClusTrackMatcherTask&);            // not implemented
   AliEmcalClusTrackMatcherTask &operator=(const AliEmcalClusTrackMatcherTask&); // not implemented
 
-  ClassDef(AliEmcalClusTrackMatcherTask, 7) // Cluster-Track matching task
+  ClassDef(AliEmcalClusTrackMatcherTask, 8) // Cluster-Track matching task
 };
 #endif
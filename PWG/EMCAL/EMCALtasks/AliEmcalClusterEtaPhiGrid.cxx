@@ -0,0 +1,164 @@
+// AliEmcalClusterEtaPhiGrid
+//
+
+#include "AliEmcalClusterEtaPhiGrid.h"
+
+#include <algorithm>
+
+#include <TClonesArray.h>
+#include <TMath.h>
+#include <TVector2.h>
+#include <TVector3.h>
+
+#include "AliVCluster.h"
+#include "AliVTrack.h"
+#include "AliEmcalParticle.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalClusterEtaPhiGrid);
+/// \endcond
+
+namespace {
+  const Double_t kCellMargin = 1e-6; // relative margin of the cell size w.r.t. the maximum distance
+  const Int_t    kMaxNEta    = 256;  // maximum number of cells in eta
+  const Int_t    kMaxNPhi    = 1024; // maximum number of cells in phi
+}
+
+//________________________________________________________________________
+AliEmcalClusterEtaPhiGrid::AliEmcalClusterEtaPhiGrid() :
+  fNClusters(0),
+  fUseGrid(kFALSE),
+  fEtaMin(0),
+  fEtaCellSize(0),
+  fPhiCellSize(0),
+  fNEta(0),
+  fNPhi(0),
+  fCellFirst(),
+  fCellClusters(),
+  fClusterCell(),
+  fAlwaysCandidates()
+{
+  // Default constructor
+}
+
+/**
+ * Sort the clusters of the event in the grid.
+ * @param[in] emcalClusters AliEmcalParticle objects of the clusters
+ * @param[in] nClusters Number of clusters
+ * @param[in] maxDistance Maximum distance to match clusters and tracks
+ */
+void AliEmcalClusterEtaPhiGrid::Build(const TClonesArray *emcalClusters, Int_t nClusters, Double_t maxDistance)
+{
+  fNClusters = nClusters;
+  fUseGrid = kFALSE;
+  fNEta = 0;
+  fNPhi = 0;
+  fCellFirst.clear();
+  fCellClusters.clear();
+  fClusterCell.assign(nClusters, -1);
+  fAlwaysCandidates.clear();
+
+  if (!(maxDistance > 0) || !TMath::Finite(maxDistance)) return;
+
+  const Double_t cellSize = maxDistance * (1 + kCellMargin);
+  if (cellSize * 3 > TMath::TwoPi()) return;
+  fNPhi = TMath::Min(static_cast<Int_t>(TMath::TwoPi() / cellSize), kMaxNPhi);
+  fPhiCellSize = TMath::TwoPi() / fNPhi;
+
+  // Cluster coordinates as in GetEtaPhiDiff
+  std::vector<Double_t> eta(nClusters, 0);
+  std::vector<Double_t> phi(nClusters, 0);
+  Double_t etaMax = 0;
+  Bool_t hasFinite = kFALSE;
+  for (Int_t icluster = 0; icluster < nClusters; icluster++) {
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(emcalClusters->At(icluster));
+    AliVCluster* cluster = emcalCluster->GetCluster();
+    if (!cluster) continue; // never matched
+
+    Float_t pos[3] = {0};
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    eta[icluster] = cpos.Eta();
+    phi[icluster] = cpos.Phi();
+    if (!TMath::Finite(eta[icluster]) || !TMath::Finite(phi[icluster])) {
+      fAlwaysCandidates.push_back(icluster);
+      continue;
+    }
+
+    fClusterCell[icluster] = 0;
+    if (!hasFinite || eta[icluster] < fEtaMin) fEtaMin = eta[icluster];
+    if (!hasFinite || eta[icluster] > etaMax) etaMax = eta[icluster];
+    hasFinite = kTRUE;
+  }
+
+  fUseGrid = kTRUE;
+  if (!hasFinite) return;
+
+  fEtaCellSize = TMath::Max(cellSize, (etaMax - fEtaMin) / kMaxNEta);
+  fNEta = static_cast<Int_t>((etaMax - fEtaMin) / fEtaCellSize) + 1;
+
+  // Counting sort of the clusters in the cells, keeping the cluster order within a cell
+  const Int_t nCells = fNEta * fNPhi;
+  fCellFirst.assign(nCells + 1, 0);
+  for (Int_t icluster = 0; icluster < nClusters; icluster++) {
+    if (fClusterCell[icluster] < 0) continue;
+    Int_t ieta = TMath::Min(static_cast<Int_t>((eta[icluster] - fEtaMin) / fEtaCellSize), fNEta - 1);
+    fClusterCell[icluster] = ieta * fNPhi + GetPhiCell(phi[icluster]);
+    fCellFirst[fClusterCell[icluster] + 1]++;
+  }
+  for (Int_t icell = 0; icell < nCells; icell++) fCellFirst[icell + 1] += fCellFirst[icell];
+
+  fCellClusters.resize(fCellFirst[nCells]);
+  std::vector<Int_t> next(fCellFirst.begin(), fCellFirst.end() - 1);
+  for (Int_t icluster = 0; icluster < nClusters; icluster++) {
+    if (fClusterCell[icluster] < 0) continue;
+    fCellClusters[next[fClusterCell[icluster]]++] = icluster;
+  }
+}
+
+/**
+ * Clusters which can be matched to a track: the clusters in the cell of the
+ * track on the EMCal surface and in the neighbouring cells.
+ * @param[in] track Track
+ * @param[out] candidates Indices of the candidate clusters, in increasing order
+ */
+void AliEmcalClusterEtaPhiGrid::GetCandidates(const AliVTrack *track, std::vector<Int_t> &candidates) const
+{
+  candidates.clear();
+
+  Double_t veta = track ? track->GetTrackEtaOnEMCal() : 0;
+  Double_t vphi = track ? track->GetTrackPhiOnEMCal() : 0;
+  if (!fUseGrid || !track || !TMath::Finite(veta) || !TMath::Finite(vphi)) {
+    for (Int_t icluster = 0; icluster < fNClusters; icluster++) candidates.push_back(icluster);
+    return;
+  }
+
+  candidates.insert(candidates.end(), fAlwaysCandidates.begin(), fAlwaysCandidates.end());
+
+  if (fNEta > 0) {
+    Double_t x = (veta - fEtaMin) / fEtaCellSize;
+    if (x >= -1 && x < fNEta + 1) {
+      Int_t ieta = static_cast<Int_t>(TMath::Floor(x));
+      Int_t iphi = GetPhiCell(vphi);
+      for (Int_t jeta = TMath::Max(ieta - 1, 0); jeta <= TMath::Min(ieta + 1, fNEta - 1); jeta++) {
+        for (Int_t dphi = -1; dphi <= 1; dphi++) {
+          Int_t icell = jeta * fNPhi + (iphi + dphi + fNPhi) % fNPhi;
+          candidates.insert(candidates.end(), fCellClusters.begin() + fCellFirst[icell], fCellClusters.begin() + fCellFirst[icell + 1]);
+        }
+      }
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+}
+
+/**
+ * Cell in \f$\phi\f$, periodic over \f$2\pi\f$.
+ * @param[in] phi Azimuth (finite)
+ * @return Cell index within 0 and fNPhi-1
+ */
+Int_t AliEmcalClusterEtaPhiGrid::GetPhiCell(Double_t phi) const
+{
+  Int_t iphi = static_cast<Int_t>(TVector2::Phi_0_2pi(phi) / fPhiCellSize);
+  return iphi >= fNPhi ? iphi - fNPhi : iphi;
+}
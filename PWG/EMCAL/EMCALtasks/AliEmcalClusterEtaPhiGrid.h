@@ -0,0 +1,60 @@
+#ifndef ALIEMCALCLUSTERETAPHIGRID_H
+#define ALIEMCALCLUSTERETAPHIGRID_H
+
+#include <vector>
+#include <Rtypes.h>
+
+class TClonesArray;
+class AliVTrack;
+
+/**
+ * @class AliEmcalClusterEtaPhiGrid
+ * @ingroup EMCALCOREFW
+ * @brief Grid of EMCal clusters in \f$\eta\f$-\f$\phi\f$, used to find the clusters close to a track.
+ *
+ * The clusters (AliEmcalParticle objects of the track-cluster matchers) are sorted in cells
+ * in \f$\eta\f$ and \f$\phi\f$ of their position, as used in GetEtaPhiDiff. The cells are at
+ * least as large as the maximum matching distance, therefore all clusters which can be matched
+ * to a track are found in the cell of the track on the EMCal surface and its neighbours.
+ * The candidates are returned in increasing order of the cluster index, so that the matching
+ * is done in the same order as in a loop over all clusters.
+ *
+ * Tracks or clusters with non-finite coordinates are tested against all clusters or all tracks.
+ * If the maximum distance is too large for a grid (more than a third of the azimuth), all clusters
+ * are returned as candidates.
+ *
+ * Used by AliEmcalCorrectionClusterTrackMatcher and AliEmcalClusTrackMatcherTask.
+ */
+class AliEmcalClusterEtaPhiGrid {
+ public:
+  AliEmcalClusterEtaPhiGrid();
+  virtual ~AliEmcalClusterEtaPhiGrid() {}
+
+  void          Build(const TClonesArray *emcalClusters, Int_t nClusters, Double_t maxDistance);
+  void          GetCandidates(const AliVTrack *track, std::vector<Int_t> &candidates) const;
+
+ protected:
+  Int_t         GetPhiCell(Double_t phi) const;
+
+  Int_t                 fNClusters;           ///< number of clusters in the grid
+  Bool_t                fUseGrid;             ///< false if all clusters are candidates
+  Double_t              fEtaMin;              ///< lower edge of the first cell in \f$\eta\f$
+  Double_t              fEtaCellSize;         ///< cell size in \f$\eta\f$
+  Double_t              fPhiCellSize;         ///< cell size in \f$\phi\f$
+  Int_t                 fNEta;                ///< number of cells in \f$\eta\f$
+  Int_t                 fNPhi;                ///< number of cells in \f$\phi\f$ (over \f$2\pi\f$)
+  std::vector<Int_t>    fCellFirst;           ///< first entry of each cell in fCellClusters (size fNEta*fNPhi+1)
+  std::vector<Int_t>    fCellClusters;        ///< cluster indices, sorted by cell
+  std::vector<Int_t>    fClusterCell;         ///< cell of each cluster (-1 if not in the grid)
+  std::vector<Int_t>    fAlwaysCandidates;    ///< clusters with non-finite coordinates
+
+ private:
+  AliEmcalClusterEtaPhiGrid(const AliEmcalClusterEtaPhiGrid &);            // Not implemented
+  AliEmcalClusterEtaPhiGrid &operator=(const AliEmcalClusterEtaPhiGrid &); // Not implemented
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalClusterEtaPhiGrid, 1); // Eta-phi grid of EMCal clusters for the track matching
+  /// \endcond
+};
+
+#endif /* ALIEMCALCLUSTERETAPHIGRID_H */
@@ -37,7 +37,9 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fNEmcalTracks(0),
   fNEmcalClusters(0),
   fHistMatchEtaAll(0),
-  fHistMatchPhiAll(0)
+  fHistMatchPhiAll(0),
+  fClusterGrid(),
+  fCandidates()
 {
   // Default constructor
   AliDebug(3, Form("%s", __PRETTY_FUNCTION__));
@@ -245,13 +247,19 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   // Set the links between tracks and clusters.
+  // Each track is only compared with the clusters in its cell of the eta-phi grid and the
+  // neighbouring cells, in increasing order of the cluster index as in a loop over all clusters.
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  fClusterGrid.Build(fEmcalClusters, fNEmcalClusters, fMaxDistance);
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    fClusterGrid.GetCandidates(track, fCandidates);
+    for (UInt_t icand = 0; icand < fCandidates.size(); icand++) {
+      Int_t icluster = fCandidates[icand];
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
       
@@ -1,7 +1,10 @@
 #ifndef ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
+#include <vector>
+
 #include "AliEmcalCorrectionComponent.h"
+#include "AliEmcalClusterEtaPhiGrid.h"
 
 class TH1;
 class TClonesArray;
@@ -84,6 +87,8 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[8][9][2]; //!<!deta distribution
   TH1          *fHistMatchPhi[8][9][2]; //!<!dphi distribution
+  AliEmcalClusterEtaPhiGrid fClusterGrid; //!<!eta-phi grid of the emcal clusters
+  std::vector<Int_t> fCandidates;       //!<!clusters close to the current track
 
  private:
   AliEmcalCorrectionClusterTrackMatcher(const AliEmcalCorrectionClusterTrackMatcher &);               // Not implemented
@@ -93,7 +98,7 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 1); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 2); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
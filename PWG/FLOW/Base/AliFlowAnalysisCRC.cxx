@@ -45,6 +45,8 @@
 #include "AliFlowVector.h"
 #include "AliFlowTrackSimple.h"
 #include "AliFlowAnalysisCRC.h"
+#include "AliFlowQVectorBuilder.h"
+#include "AliFlowDiffQVectorsEBE.h"
 #include "AliLog.h"
 #include "TRandom.h"
 #include "TF1.h"
@@ -145,6 +147,7 @@ fUseQvectorTerms(kFALSE),
 fReQ(NULL),
 fImQ(NULL),
 fSpk(NULL),
+fQVectorBuilder(NULL),
 fIntFlowCorrelationsEBE(NULL),
 fIntFlowEventWeightsForCorrelationsEBE(NULL),
 fIntFlowCorrelationsAllEBE(NULL),
@@ -383,6 +386,8 @@ AliFlowAnalysisCRC::~AliFlowAnalysisCRC()
   // destructor
   delete fHistList;
   delete fTempList;
+  delete fQVectorBuilder;
+  delete fDiffQVectorsEBE;
   delete fCRCQVecWeightsList;
   delete fCRCZDCCalibList;
   delete fCRCZDCResList;
@@ -532,6 +537,9 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
   anEvent->GetVertexPosition(fVtxPos);
   
   Double_t ptEta[2] = {0.,0.}; // 0 = dPt, 1 = dEta
+  Double_t dCosH[5] = {0.}; // cos(m*n*dPhi), m = 0,...,4, for differential flow
+  Double_t dSinH[5] = {0.}; // sin(m*n*dPhi), m = 0,...,4, for differential flow
+  Double_t dWk[9] = {0.}; // (wPhiEta*wPhi*wPt*wEta*wTrack)^k, k = 0,...,8, for differential flow
   Int_t dCharge = 0; // charge
   
   // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
@@ -701,6 +709,7 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
   
   // loop over particles **********************************************************************************************
   
+  fQVectorBuilder->Reset();
   for(Int_t i=0;i<nPrim;i++) {
     if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
     aftsTrack=anEvent->GetTrack(i);
@@ -766,87 +775,42 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
           //          wPhiEta *= 1./fEtaWeightsHist[fCenBin][ptbin][cw]->GetBinContent(fEtaWeightsHist[fCenBin][ptbin][cw]->FindBin(dEta));
         }
         
-        // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-        for(Int_t m=0;m<12;m++) // to be improved - hardwired 6
-        {
-          for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-          {
-            (*fReQ)(m,k)+=pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi);
-            (*fImQ)(m,k)+=pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi);
-          }
-        }
-        // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-        for(Int_t p=0;p<8;p++)
-        {
-          for(Int_t k=0;k<9;k++)
-          {
-            (*fSpk)(p,k)+=pow(wPhiEta*wPhi*wPt*wEta*wTrack,k);
-          }
-        }
+        // Re[Q_{m*n,k}], Im[Q_{m*n,k}] and S_{p,k} for this event are calculated after the loop over data bellow:
+        fQVectorBuilder->AddTrack(dPhi,wPhiEta*wPhi*wPt*wEta*wTrack);
         // Differential flow:
         if(fCalculateDiffFlow || fCalculate2DDiffFlow)
         {
           ptEta[0] = dPt;
           ptEta[1] = dEta;
+          AliFlowQVectorBuilder::CosSinHarmonics(n*dPhi,4,dCosH,dSinH);
+          AliFlowQVectorBuilder::WeightPowers(wPhiEta*wPhi*wPt*wEta*wTrack,9,dWk);
           // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs):
-          for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+          if(fCalculateDiffFlow)
           {
-            for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+            for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
             {
-              if(fCalculateDiffFlow)
-              {
-                for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-                {
-                  fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                  fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
-                  if(m==0) // s_{p,k} does not depend on index m
-                  {
-                    fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
-                  } // end of if(m==0) // s_{p,k} does not depend on index m
-                } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-              } // end of if(fCalculateDiffFlow)
-              if(fCalculate2DDiffFlow)
-              {
-                fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
-                if(m==0) // s_{p,k} does not depend on index m
-                {
-                  fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
-                } // end of if(m==0) // s_{p,k} does not depend on index m
-              } // end of if(fCalculate2DDiffFlow)
-            } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-          } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+              fDiffQVectorsEBE->Fill1D(0,pe,ptEta[pe],dCosH,dSinH,dWk);
+            } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+          } // end of if(fCalculateDiffFlow)
+          if(fCalculate2DDiffFlow)
+          {
+            fDiffQVectorsEBE->Fill2D(0,dPt,dEta,dCosH,dSinH,dWk);
+          } // end of if(fCalculate2DDiffFlow)
           // Checking if RP particle is also POI particle:
           if(aftsTrack->InPOISelection())
           {
             // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs):
-            for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+            if(fCalculateDiffFlow)
             {
-              for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+              for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
               {
-                if(fCalculateDiffFlow)
-                {
-                  for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-                  {
-                    fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                    fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
-                    if(m==0) // s_{p,k} does not depend on index m
-                    {
-                      fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
-                    } // end of if(m==0) // s_{p,k} does not depend on index m
-                  } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-                } // end of if(fCalculateDiffFlow)
-                if(fCalculate2DDiffFlow)
-                {
-                  fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                  fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
-                  if(m==0) // s_{p,k} does not depend on index m
-                  {
-                    fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k),1.);
-                  } // end of if(m==0) // s_{p,k} does not depend on index m
-                } // end of if(fCalculate2DDiffFlow)
-              } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-            } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+                fDiffQVectorsEBE->Fill1D(2,pe,ptEta[pe],dCosH,dSinH,dWk);
+              } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+            } // end of if(fCalculateDiffFlow)
+            if(fCalculate2DDiffFlow)
+            {
+              fDiffQVectorsEBE->Fill2D(2,dPt,dEta,dCosH,dSinH,dWk);
+            } // end of if(fCalculate2DDiffFlow)
           } // end of if(aftsTrack->InPOISelection())
         } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)
         
@@ -940,26 +904,20 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
         
         ptEta[0] = dPt;
         ptEta[1] = dEta;
+        AliFlowQVectorBuilder::CosSinHarmonics(n*dPhi,4,dCosH,dSinH);
+        AliFlowQVectorBuilder::WeightPowers(wPhiEta*wPhi*wPt*wEta*wTrack,9,dWk);
         // Calculate p_{m*n,k} ('p-vector' for POIs):
-        for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+        if(fCalculateDiffFlow)
         {
-          for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
+          for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
           {
-            if(fCalculateDiffFlow)
-            {
-              for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-              {
-                fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-                fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
-              } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-            } // end of if(fCalculateDiffFlow)
-            if(fCalculate2DDiffFlow)
-            {
-              fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-              fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhiEta*wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);
-            } // end of if(fCalculate2DDiffFlow)
-          } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-        } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+            fDiffQVectorsEBE->Fill1D(1,pe,ptEta[pe],dCosH,dSinH,dWk);
+          } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+        } // end of if(fCalculateDiffFlow)
+        if(fCalculate2DDiffFlow)
+        {
+          fDiffQVectorsEBE->Fill2D(1,dPt,dEta,dCosH,dSinH,dWk);
+        } // end of if(fCalculate2DDiffFlow)
         
         // Charge-Rapidity Correlations
         for (Int_t h=0;h<fCRCnHar;h++) {
@@ -1116,6 +1074,24 @@ void AliFlowAnalysisCRC::Make(AliFlowEventSimple* anEvent)
     }
   } // end of for(Int_t i=0;i<nPrim;i++)
   
+  // Re[Q_{m*n,k}] and Im[Q_{m*n,k}] (m = 1,2,...,12, k = 0,1,...,8) and S_{p,k} before the final calculation:
+  fQVectorBuilder->Build(n);
+  for(Int_t m=0;m<12;m++) // to be improved - hardwired 12
+  {
+    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+    {
+      (*fReQ)(m,k)+=fQVectorBuilder->ReQ(m+1,k);
+      (*fImQ)(m,k)+=fQVectorBuilder->ImQ(m+1,k);
+    }
+  }
+  for(Int_t p=0;p<8;p++)
+  {
+    for(Int_t k=0;k<9;k++)
+    {
+      (*fSpk)(p,k)+=fQVectorBuilder->SumOfWeights(k);
+    }
+  }
+  
   // ************************************************************************************************************
   
   
@@ -2500,6 +2476,9 @@ void AliFlowAnalysisCRC::BookEverythingForIntegratedFlow()
   fReQ = new TMatrixD(12,9);
   fImQ = new TMatrixD(12,9);
   fSpk = new TMatrixD(8,9);
+  fQVectorBuilder = new AliFlowQVectorBuilder(12,9);
+  // r_{m*n,k}, p_{m*n,k} and q_{m*n,k} (binning booked with differential flow):
+  fDiffQVectorsEBE = new AliFlowDiffQVectorsEBE();
   // average correlations <2>, <4>, <6> and <8> for single event (bining is the same as in fIntFlowCorrelationsPro and fIntFlowCorrelationsHist):
   TString intFlowCorrelationsEBEName = "fIntFlowCorrelationsEBE";
   intFlowCorrelationsEBEName += fAnalysisLabel->Data();
@@ -16022,22 +16001,7 @@ void AliFlowAnalysisCRC::InitializeArraysForDiffFlow()
   } // enf of for(Int_t t=0;t<2;t++) // type (RP, POI)
   
   // c) Initialize event-by-event quantities:
-  // 1D:
-  for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
-  {
-    for(Int_t pe=0;pe<2;pe++) // pt or eta
-    {
-      for(Int_t m=0;m<4;m++) // multiple of harmonic
-      {
-        for(Int_t k=0;k<9;k++) // power of weight
-        {
-          fReRPQ1dEBE[t][pe][m][k] = NULL;
-          fImRPQ1dEBE[t][pe][m][k] = NULL;
-          fs1dEBE[t][pe][k] = NULL; // to be improved (this doesn't need to be within loop over m)
-        }
-      }
-    }
-  }
+  fDiffQVectorsEBE = NULL;
   // 1D:
   for(Int_t t=0;t<2;t++) // type (RP or POI)
   {
@@ -16052,19 +16016,6 @@ void AliFlowAnalysisCRC::InitializeArraysForDiffFlow()
       }
     }
   }
-  // 2D:
-  for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
-  {
-    for(Int_t m=0;m<4;m++) // multiple of harmonic
-    {
-      for(Int_t k=0;k<9;k++) // power of weight
-      {
-        fReRPQ2dEBE[t][m][k] = NULL;
-        fImRPQ2dEBE[t][m][k] = NULL;
-        fs2dEBE[t][k] = NULL; // to be improved (this doesn't need to be within loop over m)
-      }
-    }
-  }
   
   // d) Initialize profiles:
   for(Int_t t=0;t<2;t++) // type: RP or POI
@@ -18280,41 +18231,31 @@ void AliFlowAnalysisCRC::CalculateDiffFlowCorrelations(TString type, TString ptO
     if(type == "POI")
     {
       // q_{m*n,0}:
-      q1n0kRe = fReRPQ1dEBE[2][pe][0][0]->GetBinContent(fReRPQ1dEBE[2][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(fReRPQ1dEBE[2][pe][0][0]->GetBin(b));
-      q1n0kIm = fImRPQ1dEBE[2][pe][0][0]->GetBinContent(fImRPQ1dEBE[2][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][0][0]->GetBinEntries(fImRPQ1dEBE[2][pe][0][0]->GetBin(b));
-      q2n0kRe = fReRPQ1dEBE[2][pe][1][0]->GetBinContent(fReRPQ1dEBE[2][pe][1][0]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][1][0]->GetBinEntries(fReRPQ1dEBE[2][pe][1][0]->GetBin(b));
-      q2n0kIm = fImRPQ1dEBE[2][pe][1][0]->GetBinContent(fImRPQ1dEBE[2][pe][1][0]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][1][0]->GetBinEntries(fImRPQ1dEBE[2][pe][1][0]->GetBin(b));
+      q1n0kRe = fDiffQVectorsEBE->ReQ1D(2,pe,0,0,b);
+      q1n0kIm = fDiffQVectorsEBE->ImQ1D(2,pe,0,0,b);
+      q2n0kRe = fDiffQVectorsEBE->ReQ1D(2,pe,1,0,b);
+      q2n0kIm = fDiffQVectorsEBE->ImQ1D(2,pe,1,0,b);
       
-      mq = fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(fReRPQ1dEBE[2][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mq = fDiffQVectorsEBE->Entries1D(2,pe,b); // to be improved (cross-checked by accessing other profiles here)
     }
     else if(type == "RP")
     {
       // q_{m*n,0}:
-      q1n0kRe = fReRPQ1dEBE[0][pe][0][0]->GetBinContent(fReRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      q1n0kIm = fImRPQ1dEBE[0][pe][0][0]->GetBinContent(fImRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][0][0]->GetBinEntries(fImRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      q2n0kRe = fReRPQ1dEBE[0][pe][1][0]->GetBinContent(fReRPQ1dEBE[0][pe][1][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][1][0]->GetBinEntries(fReRPQ1dEBE[0][pe][1][0]->GetBin(b));
-      q2n0kIm = fImRPQ1dEBE[0][pe][1][0]->GetBinContent(fImRPQ1dEBE[0][pe][1][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][1][0]->GetBinEntries(fImRPQ1dEBE[0][pe][1][0]->GetBin(b));
+      q1n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,0,0,b);
+      q1n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,0,0,b);
+      q2n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,1,0,b);
+      q2n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,1,0,b);
       
-      mq = fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mq = fDiffQVectorsEBE->Entries1D(0,pe,b); // to be improved (cross-checked by accessing other profiles here)
     }
     
     if(type == "POI")
     {
       // p_{m*n,0}:
-      p1n0kRe = fReRPQ1dEBE[1][pe][0][0]->GetBinContent(fReRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b));
-      p1n0kIm = fImRPQ1dEBE[1][pe][0][0]->GetBinContent(fImRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[1][pe][0][0]->GetBinEntries(fImRPQ1dEBE[1][pe][0][0]->GetBin(b));
+      p1n0kRe = fDiffQVectorsEBE->ReQ1D(1,pe,0,0,b);
+      p1n0kIm = fDiffQVectorsEBE->ImQ1D(1,pe,0,0,b);
       
-      mp = fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mp = fDiffQVectorsEBE->Entries1D(1,pe,b); // to be improved (cross-checked by accessing other profiles here)
       //t = 1; // typeFlag = RP or POI
     }
     else if(type == "RP")
@@ -21568,49 +21509,35 @@ void AliFlowAnalysisCRC::CalculateOtherDiffCorrelators(TString type, TString ptO
     if(type == "POI")
     {
       // q_{m*n,0}:
-      q1n0kRe = fReRPQ1dEBE[2][pe][0][0]->GetBinContent(fReRPQ1dEBE[2][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(fReRPQ1dEBE[2][pe][0][0]->GetBin(b));
-      q1n0kIm = fImRPQ1dEBE[2][pe][0][0]->GetBinContent(fImRPQ1dEBE[2][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][0][0]->GetBinEntries(fImRPQ1dEBE[2][pe][0][0]->GetBin(b));
-      q2n0kRe = fReRPQ1dEBE[2][pe][1][0]->GetBinContent(fReRPQ1dEBE[2][pe][1][0]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][1][0]->GetBinEntries(fReRPQ1dEBE[2][pe][1][0]->GetBin(b));
-      q2n0kIm = fImRPQ1dEBE[2][pe][1][0]->GetBinContent(fImRPQ1dEBE[2][pe][1][0]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][1][0]->GetBinEntries(fImRPQ1dEBE[2][pe][1][0]->GetBin(b));
-      q3n0kRe = fReRPQ1dEBE[2][pe][2][0]->GetBinContent(fReRPQ1dEBE[2][pe][2][0]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][2][0]->GetBinEntries(fReRPQ1dEBE[2][pe][2][0]->GetBin(b));
-      q3n0kIm = fImRPQ1dEBE[2][pe][2][0]->GetBinContent(fImRPQ1dEBE[2][pe][2][0]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][2][0]->GetBinEntries(fImRPQ1dEBE[2][pe][2][0]->GetBin(b));
-      
-      mq = fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(fReRPQ1dEBE[2][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      q1n0kRe = fDiffQVectorsEBE->ReQ1D(2,pe,0,0,b);
+      q1n0kIm = fDiffQVectorsEBE->ImQ1D(2,pe,0,0,b);
+      q2n0kRe = fDiffQVectorsEBE->ReQ1D(2,pe,1,0,b);
+      q2n0kIm = fDiffQVectorsEBE->ImQ1D(2,pe,1,0,b);
+      q3n0kRe = fDiffQVectorsEBE->ReQ1D(2,pe,2,0,b);
+      q3n0kIm = fDiffQVectorsEBE->ImQ1D(2,pe,2,0,b);
+      
+      mq = fDiffQVectorsEBE->Entries1D(2,pe,b); // to be improved (cross-checked by accessing other profiles here)
     }
     else if(type == "RP")
     {
       // q_{m*n,0}:
-      q1n0kRe = fReRPQ1dEBE[0][pe][0][0]->GetBinContent(fReRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      q1n0kIm = fImRPQ1dEBE[0][pe][0][0]->GetBinContent(fImRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][0][0]->GetBinEntries(fImRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      q2n0kRe = fReRPQ1dEBE[0][pe][1][0]->GetBinContent(fReRPQ1dEBE[0][pe][1][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][1][0]->GetBinEntries(fReRPQ1dEBE[0][pe][1][0]->GetBin(b));
-      q2n0kIm = fImRPQ1dEBE[0][pe][1][0]->GetBinContent(fImRPQ1dEBE[0][pe][1][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][1][0]->GetBinEntries(fImRPQ1dEBE[0][pe][1][0]->GetBin(b));
-      q3n0kRe = fReRPQ1dEBE[0][pe][2][0]->GetBinContent(fReRPQ1dEBE[0][pe][2][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][2][0]->GetBinEntries(fReRPQ1dEBE[0][pe][2][0]->GetBin(b));
-      q3n0kIm = fImRPQ1dEBE[0][pe][2][0]->GetBinContent(fImRPQ1dEBE[0][pe][2][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][2][0]->GetBinEntries(fImRPQ1dEBE[0][pe][2][0]->GetBin(b));
-      
-      mq = fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      q1n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,0,0,b);
+      q1n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,0,0,b);
+      q2n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,1,0,b);
+      q2n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,1,0,b);
+      q3n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,2,0,b);
+      q3n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,2,0,b);
+      
+      mq = fDiffQVectorsEBE->Entries1D(0,pe,b); // to be improved (cross-checked by accessing other profiles here)
     }
     
     if(type == "POI")
     {
       // p_{m*n,0}:
-      p1n0kRe = fReRPQ1dEBE[1][pe][0][0]->GetBinContent(fReRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b));
-      p1n0kIm = fImRPQ1dEBE[1][pe][0][0]->GetBinContent(fImRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[1][pe][0][0]->GetBinEntries(fImRPQ1dEBE[1][pe][0][0]->GetBin(b));
+      p1n0kRe = fDiffQVectorsEBE->ReQ1D(1,pe,0,0,b);
+      p1n0kIm = fDiffQVectorsEBE->ImQ1D(1,pe,0,0,b);
       
-      mp = fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mp = fDiffQVectorsEBE->Entries1D(1,pe,b); // to be improved (cross-checked by accessing other profiles here)
       
       t = 1; // typeFlag = RP or POI
     }
@@ -21707,40 +21634,30 @@ void AliFlowAnalysisCRC::Calculate2DDiffFlowCorrelations(TString type)
       if(type == "POI")
       {
         // q_{m*n,0}:
-        q1n0kRe = fReRPQ2dEBE[2][0][0]->GetBinContent(fReRPQ2dEBE[2][0][0]->GetBin(p,e))
-        * fReRPQ2dEBE[2][0][0]->GetBinEntries(fReRPQ2dEBE[2][0][0]->GetBin(p,e));
-        q1n0kIm = fImRPQ2dEBE[2][0][0]->GetBinContent(fImRPQ2dEBE[2][0][0]->GetBin(p,e))
-        * fImRPQ2dEBE[2][0][0]->GetBinEntries(fImRPQ2dEBE[2][0][0]->GetBin(p,e));
-        q2n0kRe = fReRPQ2dEBE[2][1][0]->GetBinContent(fReRPQ2dEBE[2][1][0]->GetBin(p,e))
-        * fReRPQ2dEBE[2][1][0]->GetBinEntries(fReRPQ2dEBE[2][1][0]->GetBin(p,e));
-        q2n0kIm = fImRPQ2dEBE[2][1][0]->GetBinContent(fImRPQ2dEBE[2][1][0]->GetBin(p,e))
-        * fImRPQ2dEBE[2][1][0]->GetBinEntries(fImRPQ2dEBE[2][1][0]->GetBin(p,e));
+        q1n0kRe = fDiffQVectorsEBE->ReQ2D(2,0,0,p,e);
+        q1n0kIm = fDiffQVectorsEBE->ImQ2D(2,0,0,p,e);
+        q2n0kRe = fDiffQVectorsEBE->ReQ2D(2,1,0,p,e);
+        q2n0kIm = fDiffQVectorsEBE->ImQ2D(2,1,0,p,e);
         // m_{q}:
-        mq = fReRPQ2dEBE[2][0][0]->GetBinEntries(fReRPQ2dEBE[2][0][0]->GetBin(p,e)); // to be improved (cross-checked by accessing other profiles here)
+        mq = fDiffQVectorsEBE->Entries2D(2,p,e); // to be improved (cross-checked by accessing other profiles here)
       } // end of if(type == "POI")
       else if(type == "RP")
       {
         // q_{m*n,0}:
-        q1n0kRe = fReRPQ2dEBE[0][0][0]->GetBinContent(fReRPQ2dEBE[0][0][0]->GetBin(p,e))
-        * fReRPQ2dEBE[0][0][0]->GetBinEntries(fReRPQ2dEBE[0][0][0]->GetBin(p,e));
-        q1n0kIm = fImRPQ2dEBE[0][0][0]->GetBinContent(fImRPQ2dEBE[0][0][0]->GetBin(p,e))
-        * fImRPQ2dEBE[0][0][0]->GetBinEntries(fImRPQ2dEBE[0][0][0]->GetBin(p,e));
-        q2n0kRe = fReRPQ2dEBE[0][1][0]->GetBinContent(fReRPQ2dEBE[0][1][0]->GetBin(p,e))
-        * fReRPQ2dEBE[0][1][0]->GetBinEntries(fReRPQ2dEBE[0][1][0]->GetBin(p,e));
-        q2n0kIm = fImRPQ2dEBE[0][1][0]->GetBinContent(fImRPQ2dEBE[0][1][0]->GetBin(p,e))
-        * fImRPQ2dEBE[0][1][0]->GetBinEntries(fImRPQ2dEBE[0][1][0]->GetBin(p,e));
+        q1n0kRe = fDiffQVectorsEBE->ReQ2D(0,0,0,p,e);
+        q1n0kIm = fDiffQVectorsEBE->ImQ2D(0,0,0,p,e);
+        q2n0kRe = fDiffQVectorsEBE->ReQ2D(0,1,0,p,e);
+        q2n0kIm = fDiffQVectorsEBE->ImQ2D(0,1,0,p,e);
         // m_{q}:
-        mq = fReRPQ2dEBE[0][0][0]->GetBinEntries(fReRPQ2dEBE[0][0][0]->GetBin(p,e)); // to be improved (cross-checked by accessing other profiles here)
+        mq = fDiffQVectorsEBE->Entries2D(0,p,e); // to be improved (cross-checked by accessing other profiles here)
       } // end of else if(type == "RP")
       if(type == "POI")
       {
         // p_{m*n,0}:
-        p1n0kRe = fReRPQ2dEBE[1][0][0]->GetBinContent(fReRPQ2dEBE[1][0][0]->GetBin(p,e))
-        * fReRPQ2dEBE[1][0][0]->GetBinEntries(fReRPQ2dEBE[1][0][0]->GetBin(p,e));
-        p1n0kIm = fImRPQ2dEBE[1][0][0]->GetBinContent(fImRPQ2dEBE[1][0][0]->GetBin(p,e))
-        * fImRPQ2dEBE[1][0][0]->GetBinEntries(fImRPQ2dEBE[1][0][0]->GetBin(p,e));
+        p1n0kRe = fDiffQVectorsEBE->ReQ2D(1,0,0,p,e);
+        p1n0kIm = fDiffQVectorsEBE->ImQ2D(1,0,0,p,e);
         // m_{p}
-        mp = fReRPQ2dEBE[1][0][0]->GetBinEntries(fReRPQ2dEBE[1][0][0]->GetBin(p,e)); // to be improved (cross-checked by accessing other profiles here)
+        mp = fDiffQVectorsEBE->Entries2D(1,p,e); // to be improved (cross-checked by accessing other profiles here)
         
         t = 1; // typeFlag = RP or POI
       } // end of if(type == "POI")
@@ -21847,23 +21764,10 @@ void AliFlowAnalysisCRC::CalculateDiffFlowSumOfEventWeights(TString type, TStrin
   //Double_t maxPtEta[2] = {fPtMax,fEtaMax};
   Double_t binWidthPtEta[2] = {fPtBinWidth,fEtaBinWidth};
   
-  for(Int_t rpq=0;rpq<3;rpq++)
+  if(!fDiffQVectorsEBE)
   {
-    for(Int_t m=0;m<4;m++)
-    {
-      for(Int_t k=0;k<9;k++)
-      {
-        if(!fReRPQ1dEBE[rpq][pe][m][k])
-        {
-          cout<<"WARNING: fReRPQ1dEBE[rpq][pe][m][k] is NULL in AFAWQC::CSAPOEWFDF() !!!!"<<endl;
-          cout<<"pe  = "<<pe<<endl;
-          cout<<"rpq = "<<rpq<<endl;
-          cout<<"m   = "<<m<<endl;
-          cout<<"k   = "<<k<<endl;
-          exit(0);
-        }
-      }
-    }
+    cout<<"WARNING: fDiffQVectorsEBE is NULL in AFAWQC::CSAPOEWFDF() !!!!"<<endl;
+    exit(0);
   }
   
   // multiplicities:
@@ -21883,12 +21787,12 @@ void AliFlowAnalysisCRC::CalculateDiffFlowSumOfEventWeights(TString type, TStrin
   {
     if(type == "RP")
     {
-      mq = fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(b);
+      mq = fDiffQVectorsEBE->Entries1D(0,pe,b);
       mp = mq; // trick to use the very same Eqs. below both for RP's and POI's diff. flow
     } else if(type == "POI")
     {
-      mp = fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(b);
-      mq = fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(b);
+      mp = fDiffQVectorsEBE->Entries1D(1,pe,b);
+      mq = fDiffQVectorsEBE->Entries1D(2,pe,b);
     }
     
     // event weight for <2'>:
@@ -21960,23 +21864,10 @@ void AliFlowAnalysisCRC::CalculateDiffFlowSumOfProductOfEventWeights(TString typ
   Double_t binWidthPtEta[2] = {fPtBinWidth,fEtaBinWidth};
   
   // protection:
-  for(Int_t rpq=0;rpq<3;rpq++)
+  if(!fDiffQVectorsEBE)
   {
-    for(Int_t m=0;m<4;m++)
-    {
-      for(Int_t k=0;k<9;k++)
-      {
-        if(!fReRPQ1dEBE[rpq][pe][m][k])
-        {
-          cout<<"WARNING: fReRPQ1dEBE[rpq][pe][m][k] is NULL in AFAWQC::CSAPOEWFDF() !!!!"<<endl;
-          cout<<"pe  = "<<pe<<endl;
-          cout<<"rpq = "<<rpq<<endl;
-          cout<<"m   = "<<m<<endl;
-          cout<<"k   = "<<k<<endl;
-          exit(0);
-        }
-      }
-    }
+    cout<<"WARNING: fDiffQVectorsEBE is NULL in AFAWQC::CSAPOEWFDF() !!!!"<<endl;
+    exit(0);
   }
   
   // multiplicities:
@@ -22002,12 +21893,12 @@ void AliFlowAnalysisCRC::CalculateDiffFlowSumOfProductOfEventWeights(TString typ
   {
     if(type == "RP")
     {
-      mq = fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(b);
+      mq = fDiffQVectorsEBE->Entries1D(0,pe,b);
       mp = mq; // trick to use the very same Eqs. bellow both for RP's and POI's diff. flow
     } else if(type == "POI")
     {
-      mp = fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(b);
-      mq = fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(b);
+      mp = fDiffQVectorsEBE->Entries1D(1,pe,b);
+      mq = fDiffQVectorsEBE->Entries1D(2,pe,b);
     }
     
     // event weight for <2'>:
@@ -25240,12 +25131,12 @@ void AliFlowAnalysisCRC::CalculateDiffFlowProductOfCorrelations(TString type, TS
      // to be improved (I should not do this here again)
      if(type == "RP")
      {
-     mq = fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(b);
+     mq = fDiffQVectorsEBE->Entries1D(0,pe,b);
      mp = mq; // trick to use the very same Eqs. bellow both for RP's and POI's diff. flow
      } else if(type == "POI")
      {
-     mp = fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(b);
-     mq = fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(b);
+     mp = fDiffQVectorsEBE->Entries1D(1,pe,b);
+     mq = fDiffQVectorsEBE->Entries1D(2,pe,b);
      }
      
      // event weights for reduced correlations:
@@ -28088,28 +27979,8 @@ void AliFlowAnalysisCRC::BookEverythingFor2DDifferentialFlow()
   TString differentialFlowIndex[4] = {"v'{2}","v'{4}","v'{6}","v'{8}"};
   
   // b) Book e-b-e quantities:
-  TProfile2D styleRe("typeMultiplePowerRe","typeMultiplePowerRe",fnBinsPt,fPtMin,fPtMax,fnBinsEta,fEtaMin,fEtaMax);
-  TProfile2D styleIm("typeMultiplePowerIm","typeMultiplePowerIm",fnBinsPt,fPtMin,fPtMax,fnBinsEta,fEtaMin,fEtaMax);
-  for(Int_t t=0;t<3;t++) // typeFlag (0 = RP, 1 = POI, 2 = RP&&POI )
-  {
-    for(Int_t m=0;m<4;m++)
-    {
-      for(Int_t k=0;k<9;k++)
-      {
-        fReRPQ2dEBE[t][m][k] = (TProfile2D*)styleRe.Clone(Form("typeFlag%dmultiple%dpower%dRe",t,m,k));
-        fImRPQ2dEBE[t][m][k] = (TProfile2D*)styleIm.Clone(Form("typeFlag%dmultiple%dpower%dIm",t,m,k));
-      }
-    }
-  }
-  TProfile2D styleS("typePower","typePower",fnBinsPt,fPtMin,fPtMax,fnBinsEta,fEtaMin,fEtaMax);
-  for(Int_t t=0;t<3;t++) // typeFlag (0 = RP, 1 = POI, 2 = RP&&POI )
-  {
-    for(Int_t k=0;k<9;k++)
-    {
-      fs2dEBE[t][k] = (TProfile2D*)styleS.Clone(Form("typeFlag%dpower%d",t,k));
-    }
-  }
-  
+  fDiffQVectorsEBE->Book2D(fnBinsPt,fPtMin,fPtMax,fnBinsEta,fEtaMin,fEtaMax);
+
   // c) Book 2D profiles:
   TString s2DDiffFlowCorrelationsProName = "f2DDiffFlowCorrelationsPro";
   s2DDiffFlowCorrelationsProName += fAnalysisLabel->Data();
@@ -28206,34 +28077,9 @@ void AliFlowAnalysisCRC::BookEverythingForDifferentialFlow()
   //                          (i-th RP&&POI is weighted with w_i^k)
   
   // 1D:
-  for(Int_t t=0;t<3;t++) // typeFlag (0 = RP, 1 = POI, 2 = RP && POI )
+  for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
   {
-    for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-    {
-      for(Int_t m=0;m<4;m++) // multiple of harmonic
-      {
-        for(Int_t k=0;k<9;k++) // power of particle weight
-        {
-          fReRPQ1dEBE[t][pe][m][k] = new TProfile(Form("TypeFlag%dpteta%dmultiple%dpower%dRe",t,pe,m,k),
-                                                  Form("TypeFlag%dpteta%dmultiple%dpower%dRe",t,pe,m,k),nBinsPtEta[pe],minPtEta[pe],maxPtEta[pe]);
-          fImRPQ1dEBE[t][pe][m][k] = new TProfile(Form("TypeFlag%dpteta%dmultiple%dpower%dIm",t,pe,m,k),
-                                                  Form("TypeFlag%dpteta%dmultiple%dpower%dIm",t,pe,m,k),nBinsPtEta[pe],minPtEta[pe],maxPtEta[pe]);
-        }
-      }
-    }
-  }
-  
-  // to be improved (add explanation of fs1dEBE[t][pe][k]):
-  for(Int_t t=0;t<3;t++) // typeFlag (0 = RP, 1 = POI, 2 = RP&&POI )
-  {
-    for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-    {
-      for(Int_t k=0;k<9;k++) // power of particle weight
-      {
-        fs1dEBE[t][pe][k] = new TProfile(Form("TypeFlag%dpteta%dmultiple%d",t,pe,k),
-                                         Form("TypeFlag%dpteta%dmultiple%d",t,pe,k),nBinsPtEta[pe],minPtEta[pe],maxPtEta[pe]);
-      }
-    }
+    fDiffQVectorsEBE->Book1D(pe,nBinsPtEta[pe],minPtEta[pe],maxPtEta[pe]);
   }
   // correction terms for nua:
   for(Int_t t=0;t<2;t++) // typeFlag (0 = RP, 1 = POI)
@@ -30797,29 +30643,23 @@ void AliFlowAnalysisCRC::CalculateDiffFlowCorrelationsUsingParticleWeights(TStri
     
     if(type == "POI")
     {
-      p1n0kRe = fReRPQ1dEBE[1][pe][0][0]->GetBinContent(fReRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b));
-      p1n0kIm = fImRPQ1dEBE[1][pe][0][0]->GetBinContent(fImRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[1][pe][0][0]->GetBinEntries(fImRPQ1dEBE[1][pe][0][0]->GetBin(b));
+      p1n0kRe = fDiffQVectorsEBE->ReQ1D(1,pe,0,0,b);
+      p1n0kIm = fDiffQVectorsEBE->ImQ1D(1,pe,0,0,b);
       
-      mp = fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mp = fDiffQVectorsEBE->Entries1D(1,pe,b); // to be improved (cross-checked by accessing other profiles here)
       
       t = 1; // typeFlag = RP or POI
       
       // q_{m*n,k}: (Remark: m=1 is 0, k=0 iz zero (to be improved!))
-      q1n2kRe = fReRPQ1dEBE[2][pe][0][2]->GetBinContent(fReRPQ1dEBE[2][pe][0][2]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][0][2]->GetBinEntries(fReRPQ1dEBE[2][pe][0][2]->GetBin(b));
-      q1n2kIm = fImRPQ1dEBE[2][pe][0][2]->GetBinContent(fImRPQ1dEBE[2][pe][0][2]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][0][2]->GetBinEntries(fImRPQ1dEBE[2][pe][0][2]->GetBin(b));
-      q2n1kRe = fReRPQ1dEBE[2][pe][1][1]->GetBinContent(fReRPQ1dEBE[2][pe][1][1]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][1][1]->GetBinEntries(fReRPQ1dEBE[2][pe][1][1]->GetBin(b));
-      q2n1kIm = fImRPQ1dEBE[2][pe][1][1]->GetBinContent(fImRPQ1dEBE[2][pe][1][1]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][1][1]->GetBinEntries(fImRPQ1dEBE[2][pe][1][1]->GetBin(b));
+      q1n2kRe = fDiffQVectorsEBE->ReQ1D(2,pe,0,2,b);
+      q1n2kIm = fDiffQVectorsEBE->ImQ1D(2,pe,0,2,b);
+      q2n1kRe = fDiffQVectorsEBE->ReQ1D(2,pe,1,1,b);
+      q2n1kIm = fDiffQVectorsEBE->ImQ1D(2,pe,1,1,b);
       
       // s_{1,1}, s_{1,2} and s_{1,3} // to be improved (add explanation)
-      s1p1k = pow(fs1dEBE[2][pe][1]->GetBinContent(b)*fs1dEBE[2][pe][1]->GetBinEntries(b),1.);
-      s1p2k = pow(fs1dEBE[2][pe][2]->GetBinContent(b)*fs1dEBE[2][pe][2]->GetBinEntries(b),1.);
-      s1p3k = pow(fs1dEBE[2][pe][3]->GetBinContent(b)*fs1dEBE[2][pe][3]->GetBinEntries(b),1.);
+      s1p1k = pow(fDiffQVectorsEBE->S1D(2,pe,1,b),1.);
+      s1p2k = pow(fDiffQVectorsEBE->S1D(2,pe,2,b),1.);
+      s1p3k = pow(fDiffQVectorsEBE->S1D(2,pe,3,b),1.);
       
       // M0111 from Eq. (118) in QC2c (to be improved (notation)):
       dM0111 = mp*(dSM3p1k-3.*dSM1p1k*dSM1p2k+2.*dSM1p3k)
@@ -30829,27 +30669,21 @@ void AliFlowAnalysisCRC::CalculateDiffFlowCorrelationsUsingParticleWeights(TStri
     else if(type == "RP")
     {
       // q_{m*n,k}: (Remark: m=1 is 0, k=0 iz zero (to be improved!))
-      q1n2kRe = fReRPQ1dEBE[0][pe][0][2]->GetBinContent(fReRPQ1dEBE[0][pe][0][2]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][0][2]->GetBinEntries(fReRPQ1dEBE[0][pe][0][2]->GetBin(b));
-      q1n2kIm = fImRPQ1dEBE[0][pe][0][2]->GetBinContent(fImRPQ1dEBE[0][pe][0][2]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][0][2]->GetBinEntries(fImRPQ1dEBE[0][pe][0][2]->GetBin(b));
-      q2n1kRe = fReRPQ1dEBE[0][pe][1][1]->GetBinContent(fReRPQ1dEBE[0][pe][1][1]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][1][1]->GetBinEntries(fReRPQ1dEBE[0][pe][1][1]->GetBin(b));
-      q2n1kIm = fImRPQ1dEBE[0][pe][1][1]->GetBinContent(fImRPQ1dEBE[0][pe][1][1]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][1][1]->GetBinEntries(fImRPQ1dEBE[0][pe][1][1]->GetBin(b));
+      q1n2kRe = fDiffQVectorsEBE->ReQ1D(0,pe,0,2,b);
+      q1n2kIm = fDiffQVectorsEBE->ImQ1D(0,pe,0,2,b);
+      q2n1kRe = fDiffQVectorsEBE->ReQ1D(0,pe,1,1,b);
+      q2n1kIm = fDiffQVectorsEBE->ImQ1D(0,pe,1,1,b);
       
       // s_{1,1}, s_{1,2} and s_{1,3} // to be improved (add explanation)
-      s1p1k = pow(fs1dEBE[0][pe][1]->GetBinContent(b)*fs1dEBE[0][pe][1]->GetBinEntries(b),1.);
-      s1p2k = pow(fs1dEBE[0][pe][2]->GetBinContent(b)*fs1dEBE[0][pe][2]->GetBinEntries(b),1.);
-      s1p3k = pow(fs1dEBE[0][pe][3]->GetBinContent(b)*fs1dEBE[0][pe][3]->GetBinEntries(b),1.);
+      s1p1k = pow(fDiffQVectorsEBE->S1D(0,pe,1,b),1.);
+      s1p2k = pow(fDiffQVectorsEBE->S1D(0,pe,2,b),1.);
+      s1p3k = pow(fDiffQVectorsEBE->S1D(0,pe,3,b),1.);
       
       // to be improved (cross-checked):
-      p1n0kRe = fReRPQ1dEBE[0][pe][0][0]->GetBinContent(fReRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      p1n0kIm = fImRPQ1dEBE[0][pe][0][0]->GetBinContent(fImRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][0][0]->GetBinEntries(fImRPQ1dEBE[0][pe][0][0]->GetBin(b));
+      p1n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,0,0,b);
+      p1n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,0,0,b);
       
-      mp = fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mp = fDiffQVectorsEBE->Entries1D(0,pe,b); // to be improved (cross-checked by accessing other profiles here)
       
       t = 0; // typeFlag = RP or POI
       
@@ -30973,32 +30807,9 @@ void AliFlowAnalysisCRC::ResetEventByEventQuantities()
   }
   
   // Differential flow:
+  fDiffQVectorsEBE->Reset();
   if(fCalculateDiffFlow)
   {
-    for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
-    {
-      for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // 1D in pt or eta
-      {
-        for(Int_t m=0;m<4;m++) // multiple of harmonic
-        {
-          for(Int_t k=0;k<9;k++) // power of weight
-          {
-            if(fReRPQ1dEBE[t][pe][m][k]) fReRPQ1dEBE[t][pe][m][k]->Reset();
-            if(fImRPQ1dEBE[t][pe][m][k]) fImRPQ1dEBE[t][pe][m][k]->Reset();
-          }
-        }
-      }
-    }
-    for(Int_t t=0;t<3;t++) // type (0 = RP, 1 = POI, 2 = RP&&POI )
-    {
-      for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // 1D in pt or eta
-      {
-        for(Int_t k=0;k<9;k++)
-        {
-          if(fs1dEBE[t][pe][k]) fs1dEBE[t][pe][k]->Reset();
-        }
-      }
-    }
     // e-b-e reduced correlations:
     for(Int_t t=0;t<2;t++) // type (0 = RP, 1 = POI)
     {
@@ -31027,30 +30838,6 @@ void AliFlowAnalysisCRC::ResetEventByEventQuantities()
     }
   } // end of if(fCalculateDiffFlow)
   
-  
-  // 2D (pt,eta)
-  if(fCalculate2DDiffFlow)
-  {
-    for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
-    {
-      for(Int_t m=0;m<4;m++) // multiple of harmonic
-      {
-        for(Int_t k=0;k<9;k++) // power of weight
-        {
-          if(fReRPQ2dEBE[t][m][k]){fReRPQ2dEBE[t][m][k]->Reset();}
-          if(fImRPQ2dEBE[t][m][k]){fImRPQ2dEBE[t][m][k]->Reset();}
-        }
-      }
-    }
-    for(Int_t t=0;t<3;t++) // type (0 = RP, 1 = POI, 2 = RP&&POI )
-    {
-      for(Int_t k=0;k<9;k++)
-      {
-        if(fs2dEBE[t][k]){fs2dEBE[t][k]->Reset();}
-      }
-    }
-  } // end of if(fCalculate2DDiffFlow)
-  
   // CRC
   if(fCalculateCRC) {
     for(Int_t c=0;c<2;c++) {
@@ -31228,40 +31015,30 @@ void AliFlowAnalysisCRC::CalculateDiffFlowCorrectionsForNUASinTerms(TString type
     if(type == "POI")
     {
       // q_{m*n,0}:
-      q1n0kRe = fReRPQ1dEBE[2][pe][0][0]->GetBinContent(fReRPQ1dEBE[2][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(fReRPQ1dEBE[2][pe][0][0]->GetBin(b));
-      q1n0kIm = fImRPQ1dEBE[2][pe][0][0]->GetBinContent(fImRPQ1dEBE[2][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][0][0]->GetBinEntries(fImRPQ1dEBE[2][pe][0][0]->GetBin(b));
-      q2n0kRe = fReRPQ1dEBE[2][pe][1][0]->GetBinContent(fReRPQ1dEBE[2][pe][1][0]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][1][0]->GetBinEntries(fReRPQ1dEBE[2][pe][1][0]->GetBin(b));
-      q2n0kIm = fImRPQ1dEBE[2][pe][1][0]->GetBinContent(fImRPQ1dEBE[2][pe][1][0]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][1][0]->GetBinEntries(fImRPQ1dEBE[2][pe][1][0]->GetBin(b));
+      q1n0kRe = fDiffQVectorsEBE->ReQ1D(2,pe,0,0,b);
+      q1n0kIm = fDiffQVectorsEBE->ImQ1D(2,pe,0,0,b);
+      q2n0kRe = fDiffQVectorsEBE->ReQ1D(2,pe,1,0,b);
+      q2n0kIm = fDiffQVectorsEBE->ImQ1D(2,pe,1,0,b);
       
-      mq = fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(fReRPQ1dEBE[2][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mq = fDiffQVectorsEBE->Entries1D(2,pe,b); // to be improved (cross-checked by accessing other profiles here)
     }
     else if(type == "RP")
     {
       // q_{m*n,0}:
-      q1n0kRe = fReRPQ1dEBE[0][pe][0][0]->GetBinContent(fReRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      q1n0kIm = fImRPQ1dEBE[0][pe][0][0]->GetBinContent(fImRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][0][0]->GetBinEntries(fImRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      q2n0kRe = fReRPQ1dEBE[0][pe][1][0]->GetBinContent(fReRPQ1dEBE[0][pe][1][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][1][0]->GetBinEntries(fReRPQ1dEBE[0][pe][1][0]->GetBin(b));
-      q2n0kIm = fImRPQ1dEBE[0][pe][1][0]->GetBinContent(fImRPQ1dEBE[0][pe][1][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][1][0]->GetBinEntries(fImRPQ1dEBE[0][pe][1][0]->GetBin(b));
+      q1n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,0,0,b);
+      q1n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,0,0,b);
+      q2n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,1,0,b);
+      q2n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,1,0,b);
       
-      mq = fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mq = fDiffQVectorsEBE->Entries1D(0,pe,b); // to be improved (cross-checked by accessing other profiles here)
     }
     if(type == "POI")
     {
       // p_{m*n,0}:
-      p1n0kRe = fReRPQ1dEBE[1][pe][0][0]->GetBinContent(fReRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b));
-      p1n0kIm = fImRPQ1dEBE[1][pe][0][0]->GetBinContent(fImRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[1][pe][0][0]->GetBinEntries(fImRPQ1dEBE[1][pe][0][0]->GetBin(b));
+      p1n0kRe = fDiffQVectorsEBE->ReQ1D(1,pe,0,0,b);
+      p1n0kIm = fDiffQVectorsEBE->ImQ1D(1,pe,0,0,b);
       
-      mp = fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mp = fDiffQVectorsEBE->Entries1D(1,pe,b); // to be improved (cross-checked by accessing other profiles here)
       
       t = 1; // typeFlag = RP or POI
     }
@@ -31405,40 +31182,30 @@ void AliFlowAnalysisCRC::CalculateDiffFlowCorrectionsForNUACosTerms(TString type
     if(type == "POI")
     {
       // q_{m*n,0}:
-      q1n0kRe = fReRPQ1dEBE[2][pe][0][0]->GetBinContent(fReRPQ1dEBE[2][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(fReRPQ1dEBE[2][pe][0][0]->GetBin(b));
-      q1n0kIm = fImRPQ1dEBE[2][pe][0][0]->GetBinContent(fImRPQ1dEBE[2][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][0][0]->GetBinEntries(fImRPQ1dEBE[2][pe][0][0]->GetBin(b));
-      q2n0kRe = fReRPQ1dEBE[2][pe][1][0]->GetBinContent(fReRPQ1dEBE[2][pe][1][0]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][1][0]->GetBinEntries(fReRPQ1dEBE[2][pe][1][0]->GetBin(b));
-      q2n0kIm = fImRPQ1dEBE[2][pe][1][0]->GetBinContent(fImRPQ1dEBE[2][pe][1][0]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][1][0]->GetBinEntries(fImRPQ1dEBE[2][pe][1][0]->GetBin(b));
+      q1n0kRe = fDiffQVectorsEBE->ReQ1D(2,pe,0,0,b);
+      q1n0kIm = fDiffQVectorsEBE->ImQ1D(2,pe,0,0,b);
+      q2n0kRe = fDiffQVectorsEBE->ReQ1D(2,pe,1,0,b);
+      q2n0kIm = fDiffQVectorsEBE->ImQ1D(2,pe,1,0,b);
       
-      mq = fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(fReRPQ1dEBE[2][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mq = fDiffQVectorsEBE->Entries1D(2,pe,b); // to be improved (cross-checked by accessing other profiles here)
     }
     else if(type == "RP")
     {
       // q_{m*n,0}:
-      q1n0kRe = fReRPQ1dEBE[0][pe][0][0]->GetBinContent(fReRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      q1n0kIm = fImRPQ1dEBE[0][pe][0][0]->GetBinContent(fImRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][0][0]->GetBinEntries(fImRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      q2n0kRe = fReRPQ1dEBE[0][pe][1][0]->GetBinContent(fReRPQ1dEBE[0][pe][1][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][1][0]->GetBinEntries(fReRPQ1dEBE[0][pe][1][0]->GetBin(b));
-      q2n0kIm = fImRPQ1dEBE[0][pe][1][0]->GetBinContent(fImRPQ1dEBE[0][pe][1][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][1][0]->GetBinEntries(fImRPQ1dEBE[0][pe][1][0]->GetBin(b));
+      q1n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,0,0,b);
+      q1n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,0,0,b);
+      q2n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,1,0,b);
+      q2n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,1,0,b);
       
-      mq = fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mq = fDiffQVectorsEBE->Entries1D(0,pe,b); // to be improved (cross-checked by accessing other profiles here)
     }
     if(type == "POI")
     {
       // p_{m*n,0}:
-      p1n0kRe = fReRPQ1dEBE[1][pe][0][0]->GetBinContent(fReRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b));
-      p1n0kIm = fImRPQ1dEBE[1][pe][0][0]->GetBinContent(fImRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[1][pe][0][0]->GetBinEntries(fImRPQ1dEBE[1][pe][0][0]->GetBin(b));
+      p1n0kRe = fDiffQVectorsEBE->ReQ1D(1,pe,0,0,b);
+      p1n0kIm = fDiffQVectorsEBE->ImQ1D(1,pe,0,0,b);
       
-      mp = fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      mp = fDiffQVectorsEBE->Entries1D(1,pe,b); // to be improved (cross-checked by accessing other profiles here)
       
       t = 1; // typeFlag = RP or POI
     }
@@ -34165,45 +33932,37 @@ void AliFlowAnalysisCRC::CalculateDiffFlowCorrectionsForNUACosTermsUsingParticle
     if(type == "POI")
     {
       // q_{m*n,k}:
-      q1n2kRe = fReRPQ1dEBE[2][pe][0][2]->GetBinContent(fReRPQ1dEBE[2][pe][0][2]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][0][2]->GetBinEntries(fReRPQ1dEBE[2][pe][0][2]->GetBin(b));
+      q1n2kRe = fDiffQVectorsEBE->ReQ1D(2,pe,0,2,b);
       //q1n2kIm = fImRPQ1dEBE[2][pe][0][2]->GetBinContent(fImRPQ1dEBE[2][pe][0][2]->GetBin(b))
-      //        * fImRPQ1dEBE[2][pe][0][2]->GetBinEntries(fImRPQ1dEBE[2][pe][0][2]->GetBin(b));
-      q2n1kRe = fReRPQ1dEBE[2][pe][1][1]->GetBinContent(fReRPQ1dEBE[2][pe][1][1]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][1][1]->GetBinEntries(fReRPQ1dEBE[2][pe][1][1]->GetBin(b));
-      q2n1kIm = fImRPQ1dEBE[2][pe][1][1]->GetBinContent(fImRPQ1dEBE[2][pe][1][1]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][1][1]->GetBinEntries(fImRPQ1dEBE[2][pe][1][1]->GetBin(b));
-      //mq = fReRPQ1dEBE[2][pe][1][1]->GetBinEntries(fReRPQ1dEBE[2][pe][1][1]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
-      
-      s1p1k = pow(fs1dEBE[2][pe][1]->GetBinContent(b)*fs1dEBE[2][pe][1]->GetBinEntries(b),1.);
-      s1p2k = pow(fs1dEBE[2][pe][2]->GetBinContent(b)*fs1dEBE[2][pe][2]->GetBinEntries(b),1.);
+      //        * fDiffQVectorsEBE->Entries1D(2,pe,b);
+      q2n1kRe = fDiffQVectorsEBE->ReQ1D(2,pe,1,1,b);
+      q2n1kIm = fDiffQVectorsEBE->ImQ1D(2,pe,1,1,b);
+      //mq = fDiffQVectorsEBE->Entries1D(2,pe,b); // to be improved (cross-checked by accessing other profiles here)
+      
+      s1p1k = pow(fDiffQVectorsEBE->S1D(2,pe,1,b),1.);
+      s1p2k = pow(fDiffQVectorsEBE->S1D(2,pe,2,b),1.);
     }else if(type == "RP")
     {
       // q_{m*n,k}: (Remark: m=1 is 0, k=0 iz zero (to be improved!))
-      q1n2kRe = fReRPQ1dEBE[0][pe][0][2]->GetBinContent(fReRPQ1dEBE[0][pe][0][2]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][0][2]->GetBinEntries(fReRPQ1dEBE[0][pe][0][2]->GetBin(b));
+      q1n2kRe = fDiffQVectorsEBE->ReQ1D(0,pe,0,2,b);
       //q1n2kIm = fImRPQ1dEBE[0][pe][0][2]->GetBinContent(fImRPQ1dEBE[0][pe][0][2]->GetBin(b))
-      //        * fImRPQ1dEBE[0][pe][0][2]->GetBinEntries(fImRPQ1dEBE[0][pe][0][2]->GetBin(b));
-      q2n1kRe = fReRPQ1dEBE[0][pe][1][1]->GetBinContent(fReRPQ1dEBE[0][pe][1][1]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][1][1]->GetBinEntries(fReRPQ1dEBE[0][pe][1][1]->GetBin(b));
-      q2n1kIm = fImRPQ1dEBE[0][pe][1][1]->GetBinContent(fImRPQ1dEBE[0][pe][1][1]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][1][1]->GetBinEntries(fImRPQ1dEBE[0][pe][1][1]->GetBin(b));
+      //        * fDiffQVectorsEBE->Entries1D(0,pe,b);
+      q2n1kRe = fDiffQVectorsEBE->ReQ1D(0,pe,1,1,b);
+      q2n1kIm = fDiffQVectorsEBE->ImQ1D(0,pe,1,1,b);
       // s_{1,1}, s_{1,2} and s_{1,3} // to be improved (add explanation)
-      s1p1k = pow(fs1dEBE[0][pe][1]->GetBinContent(b)*fs1dEBE[0][pe][1]->GetBinEntries(b),1.);
-      s1p2k = pow(fs1dEBE[0][pe][2]->GetBinContent(b)*fs1dEBE[0][pe][2]->GetBinEntries(b),1.);
-      //s1p3k = pow(fs1dEBE[0][pe][3]->GetBinContent(b)*fs1dEBE[0][pe][3]->GetBinEntries(b),1.);
+      s1p1k = pow(fDiffQVectorsEBE->S1D(0,pe,1,b),1.);
+      s1p2k = pow(fDiffQVectorsEBE->S1D(0,pe,2,b),1.);
+      //s1p3k = pow(fDiffQVectorsEBE->S1D(0,pe,3,b),1.);
       
-      //mq = fReRPQ1dEBE[0][pe][1][1]->GetBinEntries(fReRPQ1dEBE[0][pe][1][1]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      //mq = fDiffQVectorsEBE->Entries1D(0,pe,b); // to be improved (cross-checked by accessing other profiles here)
     }
     
     if(type == "POI")
     {
       // p_{m*n,k}:
-      p1n0kRe = fReRPQ1dEBE[1][pe][0][0]->GetBinContent(fReRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b));
-      p1n0kIm = fImRPQ1dEBE[1][pe][0][0]->GetBinContent(fImRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[1][pe][0][0]->GetBinEntries(fImRPQ1dEBE[1][pe][0][0]->GetBin(b));
-      mp = fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      p1n0kRe = fDiffQVectorsEBE->ReQ1D(1,pe,0,0,b);
+      p1n0kIm = fDiffQVectorsEBE->ImQ1D(1,pe,0,0,b);
+      mp = fDiffQVectorsEBE->Entries1D(1,pe,b); // to be improved (cross-checked by accessing other profiles here)
       // M01 from Eq. (118) in QC2c (to be improved (notation)):
       dM01 = mp*dSM1p1k-s1p1k;
       dM011 = mp*(dSM2p1k-dSM1p2k)
@@ -34214,11 +33973,9 @@ void AliFlowAnalysisCRC::CalculateDiffFlowCorrectionsForNUACosTermsUsingParticle
     } else if(type == "RP")
     {
       // to be improved (cross-checked):
-      p1n0kRe = fReRPQ1dEBE[0][pe][0][0]->GetBinContent(fReRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      p1n0kIm = fImRPQ1dEBE[0][pe][0][0]->GetBinContent(fImRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][0][0]->GetBinEntries(fImRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      mp = fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      p1n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,0,0,b);
+      p1n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,0,0,b);
+      mp = fDiffQVectorsEBE->Entries1D(0,pe,b); // to be improved (cross-checked by accessing other profiles here)
       // M01 from Eq. (118) in QC2c (to be improved (notation)):
       dM01 = mp*dSM1p1k-s1p1k;
       dM011 = mp*(dSM2p1k-dSM1p2k)
@@ -34372,42 +34129,34 @@ void AliFlowAnalysisCRC::CalculateDiffFlowCorrectionsForNUASinTermsUsingParticle
     {
       // q_{m*n,k}:
       //q1n2kRe = fReRPQ1dEBE[2][pe][0][2]->GetBinContent(fReRPQ1dEBE[2][pe][0][2]->GetBin(b))
-      //        * fReRPQ1dEBE[2][pe][0][2]->GetBinEntries(fReRPQ1dEBE[2][pe][0][2]->GetBin(b));
-      q1n2kIm = fImRPQ1dEBE[2][pe][0][2]->GetBinContent(fImRPQ1dEBE[2][pe][0][2]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][0][2]->GetBinEntries(fImRPQ1dEBE[2][pe][0][2]->GetBin(b));
-      q2n1kRe = fReRPQ1dEBE[2][pe][1][1]->GetBinContent(fReRPQ1dEBE[2][pe][1][1]->GetBin(b))
-      * fReRPQ1dEBE[2][pe][1][1]->GetBinEntries(fReRPQ1dEBE[2][pe][1][1]->GetBin(b));
-      q2n1kIm = fImRPQ1dEBE[2][pe][1][1]->GetBinContent(fImRPQ1dEBE[2][pe][1][1]->GetBin(b))
-      * fImRPQ1dEBE[2][pe][1][1]->GetBinEntries(fImRPQ1dEBE[2][pe][1][1]->GetBin(b));
-      //mq = fReRPQ1dEBE[2][pe][0][0]->GetBinEntries(fReRPQ1dEBE[2][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
-      
-      s1p1k = pow(fs1dEBE[2][pe][1]->GetBinContent(b)*fs1dEBE[2][pe][1]->GetBinEntries(b),1.);
-      s1p2k = pow(fs1dEBE[2][pe][2]->GetBinContent(b)*fs1dEBE[2][pe][2]->GetBinEntries(b),1.);
+      //        * fDiffQVectorsEBE->Entries1D(2,pe,b);
+      q1n2kIm = fDiffQVectorsEBE->ImQ1D(2,pe,0,2,b);
+      q2n1kRe = fDiffQVectorsEBE->ReQ1D(2,pe,1,1,b);
+      q2n1kIm = fDiffQVectorsEBE->ImQ1D(2,pe,1,1,b);
+      //mq = fDiffQVectorsEBE->Entries1D(2,pe,b); // to be improved (cross-checked by accessing other profiles here)
+      
+      s1p1k = pow(fDiffQVectorsEBE->S1D(2,pe,1,b),1.);
+      s1p2k = pow(fDiffQVectorsEBE->S1D(2,pe,2,b),1.);
     }else if(type == "RP")
     {
       // q_{m*n,k}: (Remark: m=1 is 0, k=0 iz zero (to be improved!))
       //q1n2kRe = fReRPQ1dEBE[0][pe][0][2]->GetBinContent(fReRPQ1dEBE[0][pe][0][2]->GetBin(b))
-      //        * fReRPQ1dEBE[0][pe][0][2]->GetBinEntries(fReRPQ1dEBE[0][pe][0][2]->GetBin(b));
-      q1n2kIm = fImRPQ1dEBE[0][pe][0][2]->GetBinContent(fImRPQ1dEBE[0][pe][0][2]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][0][2]->GetBinEntries(fImRPQ1dEBE[0][pe][0][2]->GetBin(b));
-      q2n1kRe = fReRPQ1dEBE[0][pe][1][1]->GetBinContent(fReRPQ1dEBE[0][pe][1][1]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][1][1]->GetBinEntries(fReRPQ1dEBE[0][pe][1][1]->GetBin(b));
-      q2n1kIm = fImRPQ1dEBE[0][pe][1][1]->GetBinContent(fImRPQ1dEBE[0][pe][1][1]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][1][1]->GetBinEntries(fImRPQ1dEBE[0][pe][1][1]->GetBin(b));
+      //        * fDiffQVectorsEBE->Entries1D(0,pe,b);
+      q1n2kIm = fDiffQVectorsEBE->ImQ1D(0,pe,0,2,b);
+      q2n1kRe = fDiffQVectorsEBE->ReQ1D(0,pe,1,1,b);
+      q2n1kIm = fDiffQVectorsEBE->ImQ1D(0,pe,1,1,b);
       // s_{1,1}, s_{1,2} and s_{1,3} // to be improved (add explanation)
-      s1p1k = pow(fs1dEBE[0][pe][1]->GetBinContent(b)*fs1dEBE[0][pe][1]->GetBinEntries(b),1.);
-      s1p2k = pow(fs1dEBE[0][pe][2]->GetBinContent(b)*fs1dEBE[0][pe][2]->GetBinEntries(b),1.);
-      //s1p3k = pow(fs1dEBE[0][pe][3]->GetBinContent(b)*fs1dEBE[0][pe][3]->GetBinEntries(b),1.);
+      s1p1k = pow(fDiffQVectorsEBE->S1D(0,pe,1,b),1.);
+      s1p2k = pow(fDiffQVectorsEBE->S1D(0,pe,2,b),1.);
+      //s1p3k = pow(fDiffQVectorsEBE->S1D(0,pe,3,b),1.);
     }
     
     if(type == "POI")
     {
       // p_{m*n,k}:
-      p1n0kRe = fReRPQ1dEBE[1][pe][0][0]->GetBinContent(fReRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b));
-      p1n0kIm = fImRPQ1dEBE[1][pe][0][0]->GetBinContent(fImRPQ1dEBE[1][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[1][pe][0][0]->GetBinEntries(fImRPQ1dEBE[1][pe][0][0]->GetBin(b));
-      mp = fReRPQ1dEBE[1][pe][0][0]->GetBinEntries(fReRPQ1dEBE[1][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      p1n0kRe = fDiffQVectorsEBE->ReQ1D(1,pe,0,0,b);
+      p1n0kIm = fDiffQVectorsEBE->ImQ1D(1,pe,0,0,b);
+      mp = fDiffQVectorsEBE->Entries1D(1,pe,b); // to be improved (cross-checked by accessing other profiles here)
       // M01 from Eq. (118) in QC2c (to be improved (notation)):
       dM01 = mp*dSM1p1k-s1p1k;
       dM011 = mp*(dSM2p1k-dSM1p2k)
@@ -34417,11 +34166,9 @@ void AliFlowAnalysisCRC::CalculateDiffFlowCorrectionsForNUASinTermsUsingParticle
     } else if(type == "RP")
     {
       // to be improved (cross-checked):
-      p1n0kRe = fReRPQ1dEBE[0][pe][0][0]->GetBinContent(fReRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      p1n0kIm = fImRPQ1dEBE[0][pe][0][0]->GetBinContent(fImRPQ1dEBE[0][pe][0][0]->GetBin(b))
-      * fImRPQ1dEBE[0][pe][0][0]->GetBinEntries(fImRPQ1dEBE[0][pe][0][0]->GetBin(b));
-      mp = fReRPQ1dEBE[0][pe][0][0]->GetBinEntries(fReRPQ1dEBE[0][pe][0][0]->GetBin(b)); // to be improved (cross-checked by accessing other profiles here)
+      p1n0kRe = fDiffQVectorsEBE->ReQ1D(0,pe,0,0,b);
+      p1n0kIm = fDiffQVectorsEBE->ImQ1D(0,pe,0,0,b);
+      mp = fDiffQVectorsEBE->Entries1D(0,pe,b); // to be improved (cross-checked by accessing other profiles here)
       // M01 from Eq. (118) in QC2c (to be improved (notation)):
       dM01 = mp*dSM1p1k-s1p1k;
       dM011 = mp*(dSM2p1k-dSM1p2k)
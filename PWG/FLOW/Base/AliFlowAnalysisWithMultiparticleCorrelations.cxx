@@ -24,6 +24,8 @@
 #define AliFlowAnalysisWithMultiparticleCorrelations_cxx
 
 #include "AliFlowAnalysisWithMultiparticleCorrelations.h"
+#include "AliFlowQVectorBuilder.h"
+#include "AliFlowCorrelatorCache.h"
 
 using std::endl;
 using std::cout;
@@ -64,6 +66,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::AliFlowAnalysisWithMultiparticleCo
  fQvectorFlagsPro(NULL),
  fCalculateQvector(kFALSE),
  fCalculateDiffQvectors(kFALSE),
+ fCorrelatorCache(NULL),
  // 3.) Correlations:
  fCorrelationsList(NULL),
  fCorrelationsFlagsPro(NULL),
@@ -169,6 +172,7 @@ AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleC
  // Destructor.
  
  delete fHistList;
+ delete fCorrelatorCache;
 
 } // end of AliFlowAnalysisWithMultiparticleCorrelations::~AliFlowAnalysisWithMultiparticleCorrelations()
 
@@ -1998,7 +2002,9 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
  Double_t dPhi = 0., wPhi = 1.; // azimuthal angle and corresponding phi weight
  Double_t dPt = 0., wPt = 1.; // transverse momentum and corresponding pT weight
  Double_t dEta = 0., wEta = 1.; // pseudorapidity and corresponding eta weight
- Double_t wToPowerP = 1.; // weight raised to power p
+ Double_t dCosH[49] = {0.}, dSinH[49] = {0.}; // cos(h*dPhi) and sin(h*dPhi) [fMaxHarmonic*fMaxCorrelator+1]
+ Double_t wToPowerP[9] = {0.}; // weight raised to power p [fMaxCorrelator+1]
+ Double_t wToPowerPq[9] = {0.}; // the same for q-vector (RP and POI weights) [fMaxCorrelator+1]
  Int_t nCounterRPs = 0;
  for(Int_t t=0;t<nTracks;t++) // loop over all tracks
  {
@@ -2023,7 +2029,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
    nCounterRPs++;
    if(fSelectRandomlyRPs && nCounterRPs == fnSelectedRandomlyRPs){break;} // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
 
-   wPhi = 1.; wPt = 1.; wEta = 1.; wToPowerP = 1.; // TBI this shall go somewhere else, for performance sake
+   wPhi = 1.; wPt = 1.; wEta = 1.; // TBI this shall go somewhere else, for performance sake
 
    // Access kinematic variables for RP and corresponding weights:
    dPhi = pTrack->Phi(); // azimuthal angle
@@ -2035,13 +2041,14 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
    dEta = pTrack->Eta();
    if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
 
-   // Calculate Q-vector components:
+   // Calculate Q-vector components (cos and sin of all harmonics by recursion, see AliFlowQVectorBuilder):
+   AliFlowQVectorBuilder::CosSinHarmonics(dPhi,fMaxHarmonic*fMaxCorrelator,dCosH,dSinH);
+   AliFlowQVectorBuilder::WeightPowers(wPhi*wPt*wEta,fMaxCorrelator+1,wToPowerP); // all 1 without weights
    for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
    {
     for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
     {
-     if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fQvector[h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
+     fQvector[h][wp] += TComplex(wToPowerP[wp]*dCosH[h],wToPowerP[wp]*dSinH[h]);
     } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
    } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
   } // if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
@@ -2050,7 +2057,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
   if(!fCalculateDiffQvectors){continue;}
   if(pTrack->InPOISelection()) 
   {
-   wPhi = 1.; wPt = 1.; wEta = 1.; wToPowerP = 1.; // TBI this shall go somewhere else, for performance sake
+   wPhi = 1.; wPt = 1.; wEta = 1.; // TBI this shall go somewhere else, for performance sake
 
    // Access kinematic variables for POI and corresponding weights:
    dPhi = pTrack->Phi(); // azimuthal angle
@@ -2072,38 +2079,58 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
       binNo = fDiffCorrelationsPro[0][0]->FindBin(dEta); // TBI: hardwired [0][0]
      }
    // Calculate p-vector components:
+   AliFlowQVectorBuilder::CosSinHarmonics(dPhi,fMaxHarmonic*fMaxCorrelator,dCosH,dSinH);
+   AliFlowQVectorBuilder::WeightPowers(wPhi*wPt*wEta,fMaxCorrelator+1,wToPowerP); // all 1 without weights
+   if(pTrack->InRPSelection()) 
+   {
+    // Weights for q-vector components:
+    wPhi = 1.; wPt = 1.; wEta = 1.; // TBI this shall go somewhere else, for performance sake
+
+    if(fUseWeights[0][0]){wPhi = Weight(dPhi,"RP","phi");} // corresponding phi weight
+    //if(dPhi < 0.){dPhi += TMath::TwoPi();} TBI
+    //if(dPhi > TMath::TwoPi()){dPhi -= TMath::TwoPi();} TBI
+    if(fUseWeights[0][1]){wPt = Weight(dPt,"RP","pt");} // corresponding pT weight
+    if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
+    if(fUseWeights[1][0]){wPhi = Weight(dPhi,"POI","phi");} // corresponding phi weight
+    //if(dPhi < 0.){dPhi += TMath::TwoPi();} TBI
+    //if(dPhi > TMath::TwoPi()){dPhi -= TMath::TwoPi();} TBI
+    if(fUseWeights[1][1]){wPt = Weight(dPt,"POI","pt");} // corresponding pT weight
+    if(fUseWeights[1][2]){wEta = Weight(dEta,"POI","eta");} // corresponding eta weight
+    AliFlowQVectorBuilder::WeightPowers(wPhi*wPt*wEta,fMaxCorrelator+1,wToPowerPq); // all 1 without weights
+   } // if(pTrack->InRPSelection()) 
    for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
    {
     for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
     {
-     if(fUseWeights[1][0]||fUseWeights[1][1]||fUseWeights[1][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fpvector[binNo-1][h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
-
+     Double_t wToPowerPp = wToPowerP[wp];
      if(pTrack->InRPSelection()) 
      {
-      // Fill q-vector components:
-      wPhi = 1.; wPt = 1.; wEta = 1.; wToPowerP = 1.; // TBI this shall go somewhere else, for performance sake
-
-      if(fUseWeights[0][0]){wPhi = Weight(dPhi,"RP","phi");} // corresponding phi weight
-      //if(dPhi < 0.){dPhi += TMath::TwoPi();} TBI
-      //if(dPhi > TMath::TwoPi()){dPhi -= TMath::TwoPi();} TBI
-      if(fUseWeights[0][1]){wPt = Weight(dPt,"RP","pt");} // corresponding pT weight
-      if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
-      if(fUseWeights[1][0]){wPhi = Weight(dPhi,"POI","phi");} // corresponding phi weight
-      //if(dPhi < 0.){dPhi += TMath::TwoPi();} TBI
-      //if(dPhi > TMath::TwoPi()){dPhi -= TMath::TwoPi();} TBI
-      if(fUseWeights[1][1]){wPt = Weight(dPt,"POI","pt");} // corresponding pT weight
-      if(fUseWeights[1][2]){wEta = Weight(dEta,"POI","eta");} // corresponding eta weight
-      if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]||fUseWeights[1][0]||fUseWeights[1][1]||fUseWeights[1][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-      fqvector[binNo-1][h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
+      // For POIs which are also RPs the p-vector takes the weight of the q-vector: with POI weights
+      // raised to the same power, otherwise as filled in the previous (h,wp) step
+      if(fUseWeights[1][0]||fUseWeights[1][1]||fUseWeights[1][2]){wToPowerPp = wToPowerPq[wp];}
+      else if(h>0||wp>0){wToPowerPp = wToPowerPq[wp>0 ? wp-1 : fMaxCorrelator];}
      } // if(pTrack->InRPSelection()) 
-
+     fpvector[binNo-1][h][wp] += TComplex(wToPowerPp*dCosH[h],wToPowerPp*dSinH[h]);
     } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
    } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+
+   if(pTrack->InRPSelection()) 
+   {
+    // Fill q-vector components:
+    for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+    {
+     for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
+     {
+      fqvector[binNo-1][h][wp] += TComplex(wToPowerPq[wp]*dCosH[h],wToPowerPq[wp]*dSinH[h]);
+     } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
+    } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+   } // if(pTrack->InRPSelection()) 
   } // if(pTrack->InPOISelection()) 
 
  } // for(Int_t t=0;t<nTracks;t++) // loop over all tracks
 
+ if(fCorrelatorCache){fCorrelatorCache->Reset();} // cached correlators are re-evaluated from the new Q-vector
+
 } // void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimple *anEvent)
 
 //=======================================================================================================================
@@ -2641,7 +2668,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForQvector()
  // Book all the stuff for Q-vector.
 
  // a) Book the profile holding all the flags for Q-vector;
- // ...
+ // b) Book the cache for the sub-terms of the generic correlators evaluated with recursion.
 
  // a) Book the profile holding all the flags for Q-vector:
  fQvectorFlagsPro = new TProfile("fQvectorFlagsPro","Flags for Q-vectors",2,0,2);
@@ -2656,7 +2683,9 @@ void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForQvector()
  fQvectorFlagsPro->GetXaxis()->SetBinLabel(2,"fCalculateDiffQvectors"); fQvectorFlagsPro->Fill(1.5,fCalculateDiffQvectors); 
  fQvectorList->Add(fQvectorFlagsPro);
 
- // ...
+ // b) Book the cache for the sub-terms of the generic correlators evaluated with recursion:
+ fCorrelatorCache = new AliFlowCorrelatorCache();
+ fCorrelatorCache->SetQvector(&fQvector[0][0],fMaxHarmonic*fMaxCorrelator+1,fMaxCorrelator+1);
 
 } // void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForQvector()
 
@@ -2869,6 +2898,8 @@ void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForCorrelations
           else if(fCalculateOnlySin && 0==cs){continue;}
           if(fCorrelationsPro[cs][6]){fCorrelationsPro[cs][6]->GetXaxis()->SetBinLabel(binNo[cs][6]++,Form("%s(%d,%d,%d,%d,%d,%d,%d)",sCosSin[cs].Data(),n1,n2,n3,n4,n5,n6,n7));}
          } // for(Int_t cs=0;cs<2;cs++) 
+         Int_t harmonic[7] = {n1,n2,n3,n4,n5,n6,n7};
+         if(fCorrelatorCache){fCorrelatorCache->Add(7,harmonic);} // sub-terms shared with all other 7-p and 8-p correlators
          nToBeFilled[6]++; 
         }
         if(7==fDontGoBeyond){continue;}
@@ -2890,6 +2921,8 @@ void AliFlowAnalysisWithMultiparticleCorrelations::BookEverythingForCorrelations
            else if(fCalculateOnlySin && 0==cs){continue;}
            if(fCorrelationsPro[cs][7]){fCorrelationsPro[cs][7]->GetXaxis()->SetBinLabel(binNo[cs][7]++,Form("%s(%d,%d,%d,%d,%d,%d,%d,%d)",sCosSin[cs].Data(),n1,n2,n3,n4,n5,n6,n7,n8));}
           } // for(Int_t cs=0;cs<2;cs++) 
+          Int_t harmonic[8] = {n1,n2,n3,n4,n5,n6,n7,n8};
+          if(fCorrelatorCache){fCorrelatorCache->Add(8,harmonic);}
           nToBeFilled[7]++; 
          }
         } // for(Int_t n8=n7;n8<=fMaxHarmonic;n8++)
@@ -3875,6 +3908,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::ResetQvector()
    }
   } 
  } 
+ if(fCorrelatorCache){fCorrelatorCache->Reset();}
 
 } // void AliFlowAnalysisWithMultiparticleCorrelations::ResetQvector()
 
@@ -4129,7 +4163,7 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Seven(Int_t n1, Int_t n2,
 
  Int_t harmonic[7] = {n1,n2,n3,n4,n5,n6,n7};
 
- TComplex seven = Recursion(7,harmonic); 
+ TComplex seven = CachedRecursion(7,harmonic); 
 
  return seven;
 
@@ -4143,7 +4177,7 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Eight(Int_t n1, Int_t n2,
 
  Int_t harmonic[8] = {n1,n2,n3,n4,n5,n6,n7,n8};
 
- TComplex eight = Recursion(8,harmonic); 
+ TComplex eight = CachedRecursion(8,harmonic); 
 
  return eight;
 
@@ -5061,6 +5095,21 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Recursion(Int_t n, Int_t*
 
 //=======================================================================================================================
 
+TComplex AliFlowAnalysisWithMultiparticleCorrelations::CachedRecursion(Int_t n, Int_t* harmonic)
+{
+ // Same as Recursion(n,harmonic), but with the sub-terms shared between all correlators in fCorrelatorCache and
+ // evaluated only once per event. Correlators not booked in Init() are added to the cache at the first call.
+ // Falls back to Recursion(n,harmonic) when the cache is not booked or the Q-vector components needed are not available.
+
+ Int_t id = fCorrelatorCache ? fCorrelatorCache->Add(n,harmonic) : -1;
+ if(id<0){return Recursion(n,harmonic);}
+
+ return fCorrelatorCache->Value(id);
+
+} // TComplex AliFlowAnalysisWithMultiparticleCorrelations::CachedRecursion(Int_t n, Int_t* harmonic)
+
+//=======================================================================================================================
+
 TComplex AliFlowAnalysisWithMultiparticleCorrelations::OneDiff(Int_t n1)
 {
  // Generic differential one-particle correlation <exp[i(n1*psi1)]>.
@@ -5635,9 +5684,9 @@ Double_t AliFlowAnalysisWithMultiparticleCorrelations::CorrelationPsi2nPsi1n(Int
  } // switch(k)
 
  // Calculate weight and correlators:
- Double_t dWeight = Recursion(order,harmonics0.GetArray()).Re(); // weight is 'number of combinations' by default
- TComplex cNum1 = Recursion(order,harmonics1.GetArray())/dWeight;
- TComplex cNum2 = Recursion(order,harmonics2.GetArray())/dWeight;
+ Double_t dWeight = CachedRecursion(order,harmonics0.GetArray()).Re(); // weight is 'number of combinations' by default
+ TComplex cNum1 = CachedRecursion(order,harmonics1.GetArray())/dWeight;
+ TComplex cNum2 = CachedRecursion(order,harmonics2.GetArray())/dWeight;
  ratio = cNum1.Re()/cNum2.Re();
 
  return ratio;
@@ -0,0 +1,193 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include <algorithm>
+#include "AliFlowCorrelatorCache.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowCorrelatorCache:                                           *
+// generic n-particle correlators from Q-vector components, with the *
+// sub-terms of the recursion shared and evaluated once per event,   *
+// see the header.                                                   *
+//********************************************************************
+
+ClassImp(AliFlowCorrelatorCache)
+
+//________________________________________________________________________
+
+AliFlowCorrelatorCache::AliFlowCorrelatorCache():
+  TObject(),
+  fQvector(NULL),
+  fNHarmonics(0),
+  fNPowers(0),
+  fKeys(),
+  fQIndex(),
+  fQConjugate(),
+  fProduct(),
+  fFirstTerm(),
+  fNTerms(),
+  fMult(),
+  fTerms(),
+  fRe(),
+  fIm(),
+  fNEvaluated(0)
+{
+  // constructor
+}
+
+//________________________________________________________________________
+
+AliFlowCorrelatorCache::~AliFlowCorrelatorCache()
+{
+  // destructor, fQvector is not owned
+}
+
+//________________________________________________________________________
+
+void AliFlowCorrelatorCache::SetQvector(const TComplex *qvector, Int_t nHarmonics, Int_t nPowers)
+{
+  // Q_{h,p} = qvector[h*nPowers+p] for h = 0,...,nHarmonics-1, Q_{-h,p} = Q_{h,p}^*
+
+  fQvector = qvector;
+  fNHarmonics = nHarmonics;
+  fNPowers = nPowers;
+  fNEvaluated = 0;
+}
+
+//________________________________________________________________________
+
+Int_t AliFlowCorrelatorCache::Add(Int_t n, const Int_t *harmonic)
+{
+  // Node of the n-particle correlator <exp[i(h_1*phi_1+...+h_n*phi_n)]> (numerator),
+  // booked at the first call. -1 if the Q-vector components needed are not available.
+
+  if(!fQvector || n<1 || n>=fNPowers){return -1;}
+  Int_t sumOfHarmonics = 0;
+  for(Int_t i=0;i<n;i++){sumOfHarmonics += TMath::Abs(harmonic[i]);}
+  if(sumOfHarmonics>=fNHarmonics){return -1;}
+
+  std::vector<Int_t> h(harmonic,harmonic+n);
+  return Node(n,&h[0],1,0);
+}
+
+//________________________________________________________________________
+
+Int_t AliFlowCorrelatorCache::Node(Int_t n, Int_t *harmonic, Int_t mult, Int_t skip)
+{
+  // Node of Recursion(n,harmonic,mult,skip) of AliFlowAnalysisWithMultiparticleCorrelations,
+  // with the nodes it depends on booked before it
+
+  std::vector<Int_t> sorted;
+  if(mult==1 && skip==0)
+  {
+   sorted.assign(harmonic,harmonic+n);
+   std::sort(sorted.begin(),sorted.end());
+   harmonic = &sorted[0];
+  }
+
+  std::vector<Int_t> key(3+n);
+  key[0] = n;
+  key[1] = mult;
+  key[2] = skip;
+  for(Int_t i=0;i<n;i++){key[3+i] = harmonic[i];}
+  std::map<std::vector<Int_t>,Int_t>::const_iterator it = fKeys.find(key);
+  if(it!=fKeys.end()){return it->second;}
+
+  Int_t nm1 = n-1;
+  Int_t product = -1;
+  std::vector<Int_t> terms;
+  if(nm1>0)
+  {
+   product = Node(nm1,harmonic,1,0);
+   if(nm1!=skip)
+   {
+    // same permutations of the harmonics as in the recursion
+    Int_t multp1 = mult+1;
+    Int_t nm2 = n-2;
+    Int_t counter1 = 0;
+    Int_t hhold = harmonic[counter1];
+    harmonic[counter1] = harmonic[nm2];
+    harmonic[nm2] = hhold + harmonic[nm1];
+    terms.push_back(Node(nm1,harmonic,multp1,nm2));
+    Int_t counter2 = n-3;
+    while(counter2>=skip)
+    {
+     harmonic[nm2] = harmonic[counter1];
+     harmonic[counter1] = hhold;
+     ++counter1;
+     hhold = harmonic[counter1];
+     harmonic[counter1] = harmonic[nm2];
+     harmonic[nm2] = hhold + harmonic[nm1];
+     terms.push_back(Node(nm1,harmonic,multp1,counter2));
+     --counter2;
+    }
+    harmonic[nm2] = harmonic[counter1];
+    harmonic[counter1] = hhold;
+   } // end of if(nm1!=skip)
+  } // end of if(nm1>0)
+
+  Int_t id = GetNNodes();
+  fQIndex.push_back(TMath::Abs(harmonic[nm1])*fNPowers+mult);
+  fQConjugate.push_back(harmonic[nm1]<0);
+  fProduct.push_back(product);
+  fFirstTerm.push_back((Int_t)fTerms.size());
+  fNTerms.push_back((Int_t)terms.size());
+  fMult.push_back((Double_t)mult);
+  fTerms.insert(fTerms.end(),terms.begin(),terms.end());
+  fRe.push_back(0.);
+  fIm.push_back(0.);
+  fKeys[key] = id;
+  return id;
+}
+
+//________________________________________________________________________
+
+void AliFlowCorrelatorCache::Evaluate()
+{
+  // Evaluate the nodes not evaluated yet in the event, in the order in which they were booked
+
+  Int_t nNodes = GetNNodes();
+  for(Int_t i=fNEvaluated;i<nNodes;i++)
+  {
+   const TComplex &q = fQvector[fQIndex[i]];
+   Double_t re = q.Re();
+   Double_t im = fQConjugate[i] ? -q.Im() : q.Im();
+   Int_t product = fProduct[i];
+   if(product>=0)
+   {
+    Double_t reProduct = re*fRe[product]-im*fIm[product];
+    im = re*fIm[product]+im*fRe[product];
+    re = reProduct;
+   }
+   Int_t nTerms = fNTerms[i];
+   if(nTerms>0)
+   {
+    const Int_t *terms = &fTerms[fFirstTerm[i]];
+    Double_t reTerms = 0.;
+    Double_t imTerms = 0.;
+    for(Int_t t=0;t<nTerms;t++)
+    {
+     reTerms += fRe[terms[t]];
+     imTerms += fIm[terms[t]];
+    }
+    re -= fMult[i]*reTerms;
+    im -= fMult[i]*imTerms;
+   }
+   fRe[i] = re;
+   fIm[i] = im;
+  } // end of for(Int_t i=fNEvaluated;i<nNodes;i++)
+  fNEvaluated = nNodes;
+}
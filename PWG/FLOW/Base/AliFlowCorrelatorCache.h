@@ -0,0 +1,72 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWCORRELATORCACHE_H
+#define ALIFLOWCORRELATORCACHE_H
+
+#include <map>
+#include <vector>
+#include "TObject.h"
+#include "TComplex.h"
+
+//********************************************************************
+// AliFlowCorrelatorCache:                                           *
+// Generic n-particle correlators from Q-vector components Q_{n,p},  *
+// with the recursion of the multi-particle correlations analysis     *
+// (K. Gulbrandsen) unrolled into a graph of sub-terms.               *
+//                                                                    *
+// Each call of the recursion, Recursion(n,harmonic,mult,skip), is a  *
+// node: Q(h,mult)*product - mult*(sum of terms). Nodes are shared    *
+// between all correlators added to the cache (full correlators are   *
+// symmetric in the harmonics, so these are keyed on the sorted       *
+// harmonics) and are stored in the order in which they have to be    *
+// evaluated. For each event all nodes are evaluated once, in one     *
+// pass, at the first call of Value(...) after Reset().               *
+//                                                                    *
+// Usage:                                                             *
+//   cache->SetQvector(&fQvector[0][0],49,9); // Q_{h,p} = q[h*9+p]   *
+//   Int_t id = cache->Add(n,harmonic); // once, -1 if out of range   *
+//   ... for each event, after the Q-vector is filled:                *
+//   cache->Reset(); cache->Value(id);                                *
+//********************************************************************
+
+class AliFlowCorrelatorCache : public TObject {
+ public:
+  AliFlowCorrelatorCache();
+  virtual ~AliFlowCorrelatorCache();
+
+  void SetQvector(const TComplex *qvector, Int_t nHarmonics, Int_t nPowers);
+  Int_t Add(Int_t n, const Int_t *harmonic);
+  Int_t GetNNodes() const {return (Int_t)fProduct.size();}
+
+  // event
+  void Reset() {fNEvaluated = 0;}
+  TComplex Value(Int_t id) {if(fNEvaluated<GetNNodes()){Evaluate();} return TComplex(fRe[id],fIm[id]);}
+
+ private:
+  AliFlowCorrelatorCache(const AliFlowCorrelatorCache& cache);
+  AliFlowCorrelatorCache& operator=(const AliFlowCorrelatorCache& cache);
+
+  Int_t Node(Int_t n, Int_t *harmonic, Int_t mult, Int_t skip);
+  void Evaluate();
+
+  const TComplex *fQvector;                 //! Q-vector components, [h*fNPowers+p] for h >= 0
+  Int_t fNHarmonics;                        // number of harmonics h = 0,...,fNHarmonics-1 in fQvector
+  Int_t fNPowers;                           // number of weight powers p = 0,...,fNPowers-1 in fQvector
+  std::map<std::vector<Int_t>,Int_t> fKeys; //! node of (n,mult,skip,harmonics)
+  std::vector<Int_t> fQIndex;               //! Q_{|h|,p} of each node, [|h|*fNPowers+p]
+  std::vector<Bool_t> fQConjugate;          //! h < 0
+  std::vector<Int_t> fProduct;              //! node multiplying Q, -1 if none
+  std::vector<Int_t> fFirstTerm;            //! first of the terms in fTerms
+  std::vector<Int_t> fNTerms;               //! number of terms
+  std::vector<Double_t> fMult;              //! factor of the sum of the terms
+  std::vector<Int_t> fTerms;                //! nodes subtracted
+  std::vector<Double_t> fRe;                //! real part of each node in the event
+  std::vector<Double_t> fIm;                //! imaginary part of each node in the event
+  Int_t fNEvaluated;                        //! number of nodes evaluated in the event
+
+  ClassDef(AliFlowCorrelatorCache, 1)
+};
+
+#endif
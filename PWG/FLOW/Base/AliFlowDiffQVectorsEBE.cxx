@@ -0,0 +1,175 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowDiffQVectorsEBE.h"
+
+//********************************************************************
+// AliFlowDiffQVectorsEBE:                                           *
+// event-by-event differential Q-vectors of the QC and CRC flow      *
+// analyses in flat arrays, see the header.                          *
+//********************************************************************
+
+ClassImp(AliFlowDiffQVectorsEBE)
+
+//________________________________________________________________________
+
+AliFlowDiffQVectorsEBE::AliFlowDiffQVectorsEBE():
+  TObject()
+{
+  // constructor
+  for(Int_t pe=0;pe<2;pe++)
+  {
+   fNBins[pe] = 0;
+   fMin[pe] = 0.;
+   fMax[pe] = 0.;
+   fNBins2D[pe] = 0;
+   fMin2D[pe] = 0.;
+   fMax2D[pe] = 0.;
+  }
+}
+
+//________________________________________________________________________
+
+AliFlowDiffQVectorsEBE::~AliFlowDiffQVectorsEBE()
+{
+  // destructor
+}
+
+//________________________________________________________________________
+
+void AliFlowDiffQVectorsEBE::Book1D(Int_t pe, Int_t nBins, Double_t min, Double_t max)
+{
+  // Binning in pt (pe = 0) or eta (pe = 1), as in the TProfile of the e-b-e quantities
+
+  fNBins[pe] = nBins;
+  fMin[pe] = min;
+  fMax[pe] = max;
+  Book(pe,nBins);
+}
+
+//________________________________________________________________________
+
+void AliFlowDiffQVectorsEBE::Book2D(Int_t nBinsPt, Double_t ptMin, Double_t ptMax, Int_t nBinsEta, Double_t etaMin, Double_t etaMax)
+{
+  // Binning in (pt,eta), as in the TProfile2D of the e-b-e quantities
+
+  fNBins2D[0] = nBinsPt;
+  fMin2D[0] = ptMin;
+  fMax2D[0] = ptMax;
+  fNBins2D[1] = nBinsEta;
+  fMin2D[1] = etaMin;
+  fMax2D[1] = etaMax;
+  Book(2,nBinsPt*nBinsEta);
+}
+
+//________________________________________________________________________
+
+void AliFlowDiffQVectorsEBE::Book(Int_t slot, Int_t nCells)
+{
+  // Allocate the arrays of all types for one binning
+
+  for(Int_t t=0;t<kNTypes;t++)
+  {
+   fReQ[t][slot].assign(nCells*kNMultiples*kNPowers,0.);
+   fImQ[t][slot].assign(nCells*kNMultiples*kNPowers,0.);
+   fS[t][slot].assign(nCells*kNPowers,0.);
+   fEntries[t][slot].assign(nCells,0.);
+   fFilledCells[t][slot].clear();
+   fFilledCells[t][slot].reserve(nCells);
+  }
+}
+
+//________________________________________________________________________
+
+void AliFlowDiffQVectorsEBE::Reset()
+{
+  // Clear the bins filled in the event
+
+  for(Int_t t=0;t<kNTypes;t++)
+  {
+   for(Int_t slot=0;slot<3;slot++)
+   {
+    std::vector<Int_t> &cells = fFilledCells[t][slot];
+    for(UInt_t c=0;c<cells.size();c++)
+    {
+     Int_t cell = cells[c];
+     for(Int_t mk=0;mk<kNMultiples*kNPowers;mk++)
+     {
+      fReQ[t][slot][cell*kNMultiples*kNPowers+mk] = 0.;
+      fImQ[t][slot][cell*kNMultiples*kNPowers+mk] = 0.;
+     }
+     for(Int_t k=0;k<kNPowers;k++){fS[t][slot][cell*kNPowers+k] = 0.;}
+     fEntries[t][slot][cell] = 0.;
+    }
+    cells.clear();
+   } // end of for(Int_t slot=0;slot<3;slot++)
+  } // end of for(Int_t t=0;t<kNTypes;t++)
+}
+
+//________________________________________________________________________
+
+Int_t AliFlowDiffQVectorsEBE::FindBin(Int_t nBins, Double_t min, Double_t max, Double_t x)
+{
+  // Bin index 0,...,nBins-1 as TAxis::FindBin with fixed bins, -1 outside the range
+
+  if(nBins<=0 || x<min || !(x<max)){return -1;}
+  Int_t bin = (Int_t)(nBins*(x-min)/(max-min));
+  return (bin<nBins) ? bin : -1;
+}
+
+//________________________________________________________________________
+
+void AliFlowDiffQVectorsEBE::Fill1D(Int_t t, Int_t pe, Double_t ptOrEta, const Double_t *cosH, const Double_t *sinH, const Double_t *wk)
+{
+  // Add a particle of type t in its pt (pe = 0) or eta (pe = 1) bin
+
+  Int_t cell = FindBin(fNBins[pe],fMin[pe],fMax[pe],ptOrEta);
+  if(cell<0){return;}
+  Fill(t,pe,cell,cosH,sinH,wk);
+}
+
+//________________________________________________________________________
+
+void AliFlowDiffQVectorsEBE::Fill2D(Int_t t, Double_t pt, Double_t eta, const Double_t *cosH, const Double_t *sinH, const Double_t *wk)
+{
+  // Add a particle of type t in its (pt,eta) bin
+
+  Int_t p = FindBin(fNBins2D[0],fMin2D[0],fMax2D[0],pt);
+  Int_t e = FindBin(fNBins2D[1],fMin2D[1],fMax2D[1],eta);
+  if(p<0 || e<0){return;}
+  Fill(t,2,p*fNBins2D[1]+e,cosH,sinH,wk);
+}
+
+//________________________________________________________________________
+
+void AliFlowDiffQVectorsEBE::Fill(Int_t t, Int_t slot, Int_t cell, const Double_t *cosH, const Double_t *sinH, const Double_t *wk)
+{
+  // Sums of w^k*cos((m+1)*n*phi), w^k*sin((m+1)*n*phi) and w^k in one cell
+
+  if(fEntries[t][slot][cell]==0.){fFilledCells[t][slot].push_back(cell);}
+  fEntries[t][slot][cell] += 1.;
+  Double_t *re = &fReQ[t][slot][Index(0,0,cell)];
+  Double_t *im = &fImQ[t][slot][Index(0,0,cell)];
+  for(Int_t m=0;m<kNMultiples;m++)
+  {
+   for(Int_t k=0;k<kNPowers;k++)
+   {
+    re[m*kNPowers+k] += wk[k]*cosH[m+1];
+    im[m*kNPowers+k] += wk[k]*sinH[m+1];
+   }
+  }
+  Double_t *s = &fS[t][slot][cell*kNPowers];
+  for(Int_t k=0;k<kNPowers;k++){s[k] += wk[k];}
+}
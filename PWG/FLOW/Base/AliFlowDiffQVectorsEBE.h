@@ -0,0 +1,79 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWDIFFQVECTORSEBE_H
+#define ALIFLOWDIFFQVECTORSEBE_H
+
+#include <vector>
+#include "TObject.h"
+
+//********************************************************************
+// AliFlowDiffQVectorsEBE:                                           *
+// Event-by-event r_{m*n,k}, p_{m*n,k} and q_{m*n,k} (type t = 0, 1,  *
+// 2 = RP, POI, RP&&POI) and s_{k} in pt, eta and (pt,eta) bins,      *
+// for the multiples m = 1,...,4 and the weight powers k = 0,...,8.   *
+//                                                                    *
+// Replaces the e-b-e TProfile and TProfile2D objects of the QC and   *
+// CRC differential flow: the sums are kept in flat arrays indexed    *
+// by [bin][m][k], with the number of entries per bin, and only the   *
+// bins filled in the event are cleared in Reset().                   *
+//                                                                    *
+// Bins are numbered as in TProfile (1,...,nBins, 2D: (pt,eta)),      *
+// tracks outside the range are not counted.                          *
+// ReQ(...) = GetBinContent(...)*GetBinEntries(...) of the profiles.  *
+//********************************************************************
+
+class AliFlowDiffQVectorsEBE : public TObject {
+ public:
+  AliFlowDiffQVectorsEBE();
+  virtual ~AliFlowDiffQVectorsEBE();
+
+  enum {kNTypes=3, kNMultiples=4, kNPowers=9};
+
+  void Book1D(Int_t pe, Int_t nBins, Double_t min, Double_t max);
+  void Book2D(Int_t nBinsPt, Double_t ptMin, Double_t ptMax, Int_t nBinsEta, Double_t etaMin, Double_t etaMax);
+  void Reset();
+
+  // cosH[m] = cos(m*n*phi) for m = 0,...,4 (sinH idem), wk[k] = w^k for k = 0,...,8
+  void Fill1D(Int_t t, Int_t pe, Double_t ptOrEta, const Double_t *cosH, const Double_t *sinH, const Double_t *wk);
+  void Fill2D(Int_t t, Double_t pt, Double_t eta, const Double_t *cosH, const Double_t *sinH, const Double_t *wk);
+
+  // 1D, pe = 0 (pt) or 1 (eta), m = 0,...,3 for the multiple m+1:
+  Double_t ReQ1D(Int_t t, Int_t pe, Int_t m, Int_t k, Int_t b) const {return fReQ[t][pe][Index(m,k,b-1)];}
+  Double_t ImQ1D(Int_t t, Int_t pe, Int_t m, Int_t k, Int_t b) const {return fImQ[t][pe][Index(m,k,b-1)];}
+  Double_t S1D(Int_t t, Int_t pe, Int_t k, Int_t b) const {return fS[t][pe][(b-1)*kNPowers+k];}
+  Double_t Entries1D(Int_t t, Int_t pe, Int_t b) const {return fEntries[t][pe][b-1];}
+  // 2D:
+  Double_t ReQ2D(Int_t t, Int_t m, Int_t k, Int_t p, Int_t e) const {return fReQ[t][2][Index(m,k,Cell(p,e))];}
+  Double_t ImQ2D(Int_t t, Int_t m, Int_t k, Int_t p, Int_t e) const {return fImQ[t][2][Index(m,k,Cell(p,e))];}
+  Double_t S2D(Int_t t, Int_t k, Int_t p, Int_t e) const {return fS[t][2][Cell(p,e)*kNPowers+k];}
+  Double_t Entries2D(Int_t t, Int_t p, Int_t e) const {return fEntries[t][2][Cell(p,e)];}
+
+ private:
+  AliFlowDiffQVectorsEBE(const AliFlowDiffQVectorsEBE& vectors);
+  AliFlowDiffQVectorsEBE& operator=(const AliFlowDiffQVectorsEBE& vectors);
+
+  static Int_t Index(Int_t m, Int_t k, Int_t cell) {return (cell*kNMultiples+m)*kNPowers+k;}
+  Int_t Cell(Int_t p, Int_t e) const {return (p-1)*fNBins2D[1]+(e-1);}
+  static Int_t FindBin(Int_t nBins, Double_t min, Double_t max, Double_t x);
+  void Book(Int_t slot, Int_t nCells);
+  void Fill(Int_t t, Int_t slot, Int_t cell, const Double_t *cosH, const Double_t *sinH, const Double_t *wk);
+
+  // slot 0 = pt, 1 = eta, 2 = (pt,eta)
+  Int_t fNBins[2];                             // number of bins in pt and eta
+  Double_t fMin[2];                            // lower edge in pt and eta
+  Double_t fMax[2];                            // upper edge in pt and eta
+  Int_t fNBins2D[2];                           // number of pt and eta bins of the 2D binning
+  Double_t fMin2D[2];                          // lower edges of the 2D binning
+  Double_t fMax2D[2];                          // upper edges of the 2D binning
+  std::vector<Double_t> fReQ[kNTypes][3];      //! [t][slot][cell][m][k]
+  std::vector<Double_t> fImQ[kNTypes][3];      //! [t][slot][cell][m][k]
+  std::vector<Double_t> fS[kNTypes][3];        //! [t][slot][cell][k]
+  std::vector<Double_t> fEntries[kNTypes][3];  //! [t][slot][cell]
+  std::vector<Int_t> fFilledCells[kNTypes][3]; //! cells with entries in the event
+
+  ClassDef(AliFlowDiffQVectorsEBE, 1)
+};
+
+#endif
@@ -0,0 +1,182 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowQVectorBuilder.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowQVectorBuilder:                                            *
+// Q-vector components of one event for all harmonics and weight     *
+// powers, see the header.                                           *
+//********************************************************************
+
+ClassImp(AliFlowQVectorBuilder)
+
+//________________________________________________________________________
+
+AliFlowQVectorBuilder::AliFlowQVectorBuilder(Int_t maxHarmonic, Int_t maxPower):
+  TObject(),
+  fMaxHarmonic(0),
+  fMaxPower(0),
+  fPhi(),
+  fWeight(),
+  fCos1(),
+  fSin1(),
+  fCosH(),
+  fSinH(),
+  fPowers(),
+  fReQ(),
+  fImQ()
+{
+  // constructor
+  Setup(maxHarmonic,maxPower);
+}
+
+//________________________________________________________________________
+
+AliFlowQVectorBuilder::~AliFlowQVectorBuilder()
+{
+  // destructor
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::Setup(Int_t maxHarmonic, Int_t maxPower)
+{
+  // Harmonics h = 0,...,maxHarmonic and weight powers k = 0,...,maxPower-1
+
+  fMaxHarmonic = maxHarmonic;
+  fMaxPower = maxPower;
+  fReQ.assign((fMaxHarmonic+1)*fMaxPower,0.);
+  fImQ.assign((fMaxHarmonic+1)*fMaxPower,0.);
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::Reset()
+{
+  // Remove the tracks of the previous event and its Q-vector components
+
+  fPhi.clear();
+  fWeight.clear();
+  fReQ.assign(fReQ.size(),0.);
+  fImQ.assign(fImQ.size(),0.);
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::Build(Double_t harmonic)
+{
+  // Q_{h*n,k} of the tracks added since the last Reset, n = harmonic
+
+  Int_t nTracks = GetNTracks();
+  fReQ.assign(fReQ.size(),0.);
+  fImQ.assign(fImQ.size(),0.);
+  if(nTracks==0){return;}
+
+  fCos1.resize(nTracks);
+  fSin1.resize(nTracks);
+  fCosH.resize(nTracks);
+  fSinH.resize(nTracks);
+  fPowers.resize(fMaxPower*nTracks);
+
+  const Double_t *phi = &fPhi[0];
+  const Double_t *weight = &fWeight[0];
+  Double_t *cos1 = &fCos1[0];
+  Double_t *sin1 = &fSin1[0];
+  Double_t *cosH = &fCosH[0];
+  Double_t *sinH = &fSinH[0];
+  Double_t *powers = &fPowers[0];
+
+  // Harmonic n and weight powers:
+  for(Int_t i=0;i<nTracks;i++)
+  {
+   cos1[i] = TMath::Cos(harmonic*phi[i]);
+   sin1[i] = TMath::Sin(harmonic*phi[i]);
+   cosH[i] = 1.;
+   sinH[i] = 0.;
+   powers[i] = 1.;
+  }
+  for(Int_t k=1;k<fMaxPower;k++)
+  {
+   const Double_t *previous = powers+(k-1)*nTracks;
+   Double_t *current = powers+k*nTracks;
+   for(Int_t i=0;i<nTracks;i++){current[i] = previous[i]*weight[i];}
+  }
+
+  // Sums, with four partial sums to allow vectorization:
+  for(Int_t h=0;h<=fMaxHarmonic;h++)
+  {
+   if(h>0)
+   {
+    for(Int_t i=0;i<nTracks;i++)
+    {
+     Double_t c = cosH[i]*cos1[i]-sinH[i]*sin1[i];
+     sinH[i] = sinH[i]*cos1[i]+cosH[i]*sin1[i];
+     cosH[i] = c;
+    }
+   }
+   for(Int_t k=0;k<fMaxPower;k++)
+   {
+    const Double_t *w = powers+k*nTracks;
+    Double_t re[4] = {0.,0.,0.,0.};
+    Double_t im[4] = {0.,0.,0.,0.};
+    Int_t i = 0;
+    for(;i+3<nTracks;i+=4)
+    {
+     for(Int_t l=0;l<4;l++)
+     {
+      re[l] += w[i+l]*cosH[i+l];
+      im[l] += w[i+l]*sinH[i+l];
+     }
+    }
+    for(;i<nTracks;i++)
+    {
+     re[0] += w[i]*cosH[i];
+     im[0] += w[i]*sinH[i];
+    }
+    fReQ[h*fMaxPower+k] = (re[0]+re[1])+(re[2]+re[3]);
+    fImQ[h*fMaxPower+k] = (im[0]+im[1])+(im[2]+im[3]);
+   } // end of for(Int_t k=0;k<fMaxPower;k++)
+  } // end of for(Int_t h=0;h<=fMaxHarmonic;h++)
+
+} // end of void AliFlowQVectorBuilder::Build(Double_t harmonic)
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::CosSinHarmonics(Double_t angle, Int_t maxHarmonic, Double_t *cosH, Double_t *sinH)
+{
+  // cosH[h] = cos(h*angle) and sinH[h] = sin(h*angle) for h = 0,...,maxHarmonic
+
+  Double_t c1 = TMath::Cos(angle);
+  Double_t s1 = TMath::Sin(angle);
+  cosH[0] = 1.;
+  sinH[0] = 0.;
+  for(Int_t h=1;h<=maxHarmonic;h++)
+  {
+   cosH[h] = cosH[h-1]*c1-sinH[h-1]*s1;
+   sinH[h] = sinH[h-1]*c1+cosH[h-1]*s1;
+  }
+}
+
+//________________________________________________________________________
+
+void AliFlowQVectorBuilder::WeightPowers(Double_t weight, Int_t maxPower, Double_t *weightPowers)
+{
+  // weightPowers[k] = weight^k for k = 0,...,maxPower-1
+
+  weightPowers[0] = 1.;
+  for(Int_t k=1;k<maxPower;k++){weightPowers[k] = weightPowers[k-1]*weight;}
+}
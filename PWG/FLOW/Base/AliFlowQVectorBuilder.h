@@ -0,0 +1,76 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORBUILDER_H
+#define ALIFLOWQVECTORBUILDER_H
+
+#include <vector>
+#include "TObject.h"
+
+//********************************************************************
+// AliFlowQVectorBuilder:                                            *
+// Q-vector components Q_{h*n,k} = sum_i w_i^k exp(i*h*n*phi_i)       *
+// for all harmonics h = 0,...,maxHarmonic and weight powers          *
+// k = 0,...,maxPower-1 of one event.                                 *
+//                                                                    *
+// cos(h*n*phi) and sin(h*n*phi) are obtained from cos(n*phi) and     *
+// sin(n*phi) by complex multiplication, and w^k by multiplication,   *
+// so that only one cos and one sin are computed per track. Tracks    *
+// are stored in arrays (phi, weight), and the sums run over the      *
+// tracks in the innermost loop, which the compiler can vectorize.    *
+//                                                                    *
+// Usage, for each event:                                             *
+//   builder->Reset();                                                *
+//   ... builder->AddTrack(phi,weight); for each RP                   *
+//   builder->Build(n);                                               *
+//   builder->ReQ(h,k), builder->ImQ(h,k)                             *
+// ReQ(0,k) is the sum of weights to power k.                         *
+//                                                                    *
+// The static methods CosSinHarmonics and WeightPowers do the same    *
+// for a single track (p- and q-vectors in pt and eta bins).          *
+//********************************************************************
+
+class AliFlowQVectorBuilder : public TObject {
+ public:
+  AliFlowQVectorBuilder(Int_t maxHarmonic=12, Int_t maxPower=9);
+  virtual ~AliFlowQVectorBuilder();
+
+  void Setup(Int_t maxHarmonic, Int_t maxPower);
+  Int_t GetMaxHarmonic() const {return fMaxHarmonic;}
+  Int_t GetMaxPower() const {return fMaxPower;}
+
+  // event
+  void Reset();
+  void AddTrack(Double_t phi, Double_t weight=1.) {fPhi.push_back(phi); fWeight.push_back(weight);}
+  Int_t GetNTracks() const {return (Int_t)fPhi.size();}
+  void Build(Double_t harmonic=1.);
+
+  Double_t ReQ(Int_t h, Int_t k) const {return fReQ[h*fMaxPower+k];} // sum_i w_i^k cos(h*n*phi_i)
+  Double_t ImQ(Int_t h, Int_t k) const {return fImQ[h*fMaxPower+k];} // sum_i w_i^k sin(h*n*phi_i)
+  Double_t SumOfWeights(Int_t k) const {return fReQ[k];}             // sum_i w_i^k
+
+  // single track
+  static void CosSinHarmonics(Double_t angle, Int_t maxHarmonic, Double_t *cosH, Double_t *sinH);
+  static void WeightPowers(Double_t weight, Int_t maxPower, Double_t *weightPowers);
+
+ private:
+  AliFlowQVectorBuilder(const AliFlowQVectorBuilder& builder);
+  AliFlowQVectorBuilder& operator=(const AliFlowQVectorBuilder& builder);
+
+  Int_t fMaxHarmonic;            // largest harmonic h
+  Int_t fMaxPower;               // number of weight powers k
+  std::vector<Double_t> fPhi;    //! azimuthal angles of the tracks
+  std::vector<Double_t> fWeight; //! weights of the tracks
+  std::vector<Double_t> fCos1;   //! cos(n*phi) of each track
+  std::vector<Double_t> fSin1;   //! sin(n*phi) of each track
+  std::vector<Double_t> fCosH;   //! cos(h*n*phi) of each track, current harmonic
+  std::vector<Double_t> fSinH;   //! sin(h*n*phi) of each track, current harmonic
+  std::vector<Double_t> fPowers; //! w^k of each track, [k*nTracks+i]
+  std::vector<Double_t> fReQ;    //! Re[Q_{h*n,k}], [h*fMaxPower+k]
+  std::vector<Double_t> fImQ;    //! Im[Q_{h*n,k}], [h*fMaxPower+k]
+
+  ClassDef(AliFlowQVectorBuilder, 1)
+};
+
+#endif
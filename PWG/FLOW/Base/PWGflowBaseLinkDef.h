@@ -44,5 +44,8 @@
 #pragma link C++ class AliFlowAnalysisWithNestedLoops+;
 #pragma link C++ class AliFlowOnTheFlyEventGenerator+;
 #pragma link C++ class AliFlowAnalysisWithMultiparticleCorrelations+;
+#pragma link C++ class AliFlowQVectorBuilder+;
+#pragma link C++ class AliFlowDiffQVectorsEBE+;
+#pragma link C++ class AliFlowCorrelatorCache+;
 
 #endif
@@ -28,6 +28,12 @@
 // the derivation from THnSparse is obviously against many OO rules. correct would be a common baseclass of THnSparse and THn.
 //
 // Templated version allows also the use of double as storage container
+//
+// Concurrent filling (SetConcurrentFill): several threads may call Fill on the same object, e.g. to
+// parallelize a pair loop without one full container per thread. The bins are then updated with atomic
+// adds, the bin caching is not used and the containers are created under a lock. As the weights are only
+// known at fill time, the sumw2 containers have to be requested when switching concurrent filling on.
+// FillParent, Merge etc. must not be called while filling. The stored format is unchanged.
 // 
 // Author: Jan Fiete Grosse-Oetringhaus
 
@@ -39,9 +45,33 @@
 #include "TArrayD.h"
 #include "THnSparse.h"
 #include "TMath.h"
+#if __cplusplus >= 201103L
+#include <mutex>
+#endif
 
 templateClassImp(AliTHnT)
 
+namespace {
+#if __cplusplus >= 201103L
+  std::mutex gAliTHnContainerMutex; // protects the creation of containers during concurrent filling
+#endif
+
+  template <typename TemplateType>
+  inline void AtomicAdd(TemplateType* target, TemplateType value)
+  {
+    // adds value to *target atomically (compare-and-swap loop, no lock for 4 and 8 byte types)
+#if defined(__GNUC__) || defined(__clang__)
+    TemplateType expected;
+    __atomic_load(target, &expected, __ATOMIC_RELAXED);
+    TemplateType desired = expected + value;
+    while (!__atomic_compare_exchange(target, &expected, &desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      desired = expected + value;
+#else
+    *target += value;
+#endif
+  }
+}
+
 template <class TemplateArray, typename TemplateType>
 AliTHnT<TemplateArray, TemplateType>::AliTHnT() : 
   AliTHnBase(),
@@ -53,7 +83,9 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fConcurrentFill(kFALSE),
+  fConcurrentSumw2(kFALSE)
 {
   // Constructor
 }
@@ -69,7 +101,9 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fConcurrentFill(kFALSE),
+  fConcurrentSumw2(kFALSE)
 {
   // Constructor
 
@@ -106,7 +140,9 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fConcurrentFill(kFALSE),
+  fConcurrentSumw2(kFALSE)
 {
   //
   // AliTHnT copy constructor
@@ -286,27 +322,15 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 {
   // fills an entry
 
-  // fill axis cache
-  if (!axisCache)
+  if (fConcurrentFill)
   {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
-    
-    fLastVars = new Double_t[fNVars];
-    fLastBins = new Int_t[fNVars];
-    
-    // initial values to prevent checking for 0 below
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      fLastBins[i] = axisCache[i]->FindBin(var[i]);
-      fLastVars[i] = var[i];
-    }
+    FillConcurrent(var, istep, weight);
+    return;
   }
+
+  // fill axis cache
+  if (!axisCache)
+    InitCache();
   
   // calculate global bin index
   Long64_t bin = 0;
@@ -360,6 +384,108 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::InitCache()
+{
+  // fills the axis cache and resets the cache of the last used bins
+  
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
+  }
+  
+  fLastVars = new Double_t[fNVars];
+  fLastBins = new Int_t[fNVars];
+  
+  // NaN never compares equal, so the first Fill looks up all bins
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    fLastBins[i] = 0;
+    fLastVars[i] = TMath::QuietNaN();
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetConcurrentFill(Bool_t concurrent, Bool_t sumw2)
+{
+  // switches concurrent filling on or off; must be called before the threads start filling
+  // if sumw2 is set, the sumw2 containers are kept for all steps (needed if weights != 1 are used)
+  
+#if __cplusplus < 201103L
+  if (concurrent)
+  {
+    AliError("Concurrent filling needs C++11");
+    return;
+  }
+#endif
+
+  fConcurrentFill = concurrent;
+  fConcurrentSumw2 = sumw2;
+  if (!fConcurrentFill)
+    return;
+  
+  if (!axisCache)
+    InitCache();
+
+  // containers already filled with weight 1 get their sumw2 now, as in Fill
+  if (fConcurrentSumw2)
+    for (Int_t i=0; i<fNSteps; i++)
+      if (fValues[i] && !fSumw2[i])
+        fSumw2[i] = new TemplateArray(*fValues[i]);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillConcurrent(const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry; may be called from several threads at the same time
+  
+  // calculate global bin index, without the (shared) cache of the last bins
+  Long64_t bin = 0;
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    bin *= fNbinsCache[i];
+    
+    Int_t tmpBin = axisCache[i]->FindFixBin(var[i]);
+
+    // under/overflow not supported
+    if (tmpBin < 1 || tmpBin > fNbinsCache[i])
+      return;
+    
+    bin += tmpBin - 1;
+  }
+
+  TemplateArray* values = 0;
+  TemplateArray* sumw2 = 0;
+#if __cplusplus >= 201103L
+  values = __atomic_load_n(&fValues[istep], __ATOMIC_ACQUIRE);
+  if (!values)
+  {
+    std::lock_guard<std::mutex> lock(gAliTHnContainerMutex);
+    values = fValues[istep];
+    if (!values)
+    {
+      values = new TemplateArray(fNBins);
+      if (fConcurrentSumw2 && !fSumw2[istep])
+        fSumw2[istep] = new TemplateArray(fNBins);
+      // sumw2 is published before values, so any thread seeing values sees sumw2
+      __atomic_store_n(&fValues[istep], values, __ATOMIC_RELEASE);
+      AliInfo(Form("Created values container for step %d", istep));
+    }
+  }
+  sumw2 = fSumw2[istep];
+#endif
+
+  if (weight != 1 && !sumw2)
+    AliFatal("Filling with weight != 1 needs the sumw2 containers, see SetConcurrentFill");
+
+  AtomicAdd<TemplateType>(values->GetArray() + bin, weight);
+  if (sumw2)
+    AtomicAdd<TemplateType>(sumw2->GetArray() + bin, weight * weight);
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
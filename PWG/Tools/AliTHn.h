@@ -9,6 +9,8 @@
 // Use AliTHn instead of AliCFContainer and your memory consumption will be drastically reduced
 // As AliTHn derives from AliCFContainer, you can just replace your current AliCFContainer object by AliTHn
 // Once you have the merged output, call FillParent() and you can use AliCFContainer as usual
+//
+// After SetConcurrentFill(kTRUE) one object can be filled from several threads at the same time
 
 #include "TObject.h"
 #include "TString.h"
@@ -34,6 +36,8 @@ public:
 
   virtual void DeleteContainers() = 0;
   virtual void ReduceAxis() = 0;  
+
+  virtual void SetConcurrentFill(Bool_t concurrent, Bool_t sumw2=kTRUE) = 0;
   
   ClassDef(AliTHnBase, 1) // AliTHn base class
 };
@@ -56,6 +60,9 @@ class AliTHnT : public AliTHnBase
   
   virtual void DeleteContainers();
   virtual void ReduceAxis();
+
+  virtual void SetConcurrentFill(Bool_t concurrent, Bool_t sumw2=kTRUE);
+  Bool_t GetConcurrentFill() const { return fConcurrentFill; }
   
   AliTHnT(const AliTHnT &c);
   AliTHnT& operator=(const AliTHnT& corr);
@@ -65,6 +72,8 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitCache();
+  void FillConcurrent(const Double_t *var, Int_t istep, Double_t weight);
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
   
   Long64_t fNBins;   // number of total bins
@@ -77,6 +86,8 @@ protected:
   Int_t* fNbinsCache; //! cache Nbins per axis
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
+  Bool_t fConcurrentFill; //! Fill may be called from several threads (no bin caching, atomic adds)
+  Bool_t fConcurrentSumw2; //! sumw2 containers are created together with the value containers in concurrent mode
   
   ClassDef(AliTHnT, 5) // THn like container
 };
@@ -20,6 +20,11 @@
 #pragma link C++ class AliTHnT<TArrayF, Float_t>+;
 #pragma link C++ class AliTHnT<TArrayD, Double_t>+;
 #pragma link C++ class THistManager+;
+#pragma link C++ class THistManager::TH1Handle+;
+#pragma link C++ class THistManager::TH2Handle+;
+#pragma link C++ class THistManager::TH3Handle+;
+#pragma link C++ class THistManager::THnSparseHandle+;
+#pragma link C++ class THistManager::TProfileHandle+;
 #pragma link C++ class AliJSONReader+;
 #pragma link C++ class AliJSONData+;
 #pragma link C++ class AliJSONValue+;
@@ -37,4 +42,8 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ function TestTHistManager::TestRunFillHandles();
+#pragma link C++ function TestTHistManager::TestRunFillBuffered();
+#pragma link C++ function TestTHistManager::TestRunFillWeightOptions();
+#pragma link C++ function TestTHistManager::BenchmarkFillHandles(int);
 #endif
@@ -12,13 +12,16 @@
  * about the suitability of this software for any purpose. It is          *
  * provided "as is" without express or implied warranty.                  *
  **************************************************************************/
+#include <algorithm>
 #include <cfloat>
 #include <cstring>
 #include <iostream>   // for unit tests
 #include <sstream>
 #include <string>
 #include <exception>
+#include <utility>
 #include <vector>
+#include <RVersion.h>
 #include <TArrayD.h>
 #include <TAxis.h>
 #include <TH1.h>
@@ -28,8 +31,11 @@
 #include <THashList.h>
 #include <TMath.h>
 #include <TObjArray.h>
+#include <TList.h>
 #include <TObjString.h>
 #include <TProfile.h>
+#include <TRandom3.h>
+#include <TStopwatch.h>
 #include <TString.h>
 
 #include "TBinning.h"
@@ -42,14 +48,18 @@ ClassImp(THistManager)
 THistManager::THistManager():
 		TNamed(),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fFillBufferSize(0),
+		fFillBuffers(NULL)
 {
 }
 
 THistManager::THistManager(const char *name):
 		TNamed(name, Form("Histogram container %s", name)),
 		fHistos(NULL),
-		fIsOwner(true)
+		fIsOwner(true),
+		fFillBufferSize(0),
+		fFillBuffers(NULL)
 {
 	fHistos = new THashList();
 	fHistos->SetName(Form("histos%s", name));
@@ -57,9 +67,22 @@ THistManager::THistManager(const char *name):
 }
 
 THistManager::~THistManager(){
+  if(fFillBuffers){
+    // without ownership the histograms might already be gone
+    if(fHistos && fIsOwner) FlushFillBuffers();
+    delete fFillBuffers;
+  }
 	if(fHistos && fIsOwner) delete fHistos;
 }
 
+void THistManager::SetFillBufferSize(Int_t size){
+  fFillBufferSize = size > 0 ? size : 0;
+  if(fFillBufferSize && !fFillBuffers){
+    fFillBuffers = new TList;
+    fFillBuffers->SetOwner();
+  }
+}
+
 THashList* THistManager::CreateHistoGroup(const char *groupname) {
   // At first step check whether the group already exists.
   THashList *foundgroup = FindGroup(groupname);
@@ -387,6 +410,7 @@ void THistManager::FillTH1(const char *name, double x, double weight, Option_t *
 		Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
 		return;
 	}
+	if(fFillBuffers) FlushFillBuffer(hist);
 	TString optionstring(opt);
 	if(optionstring.Contains("w")){
 	  // use bin width as weight
@@ -410,6 +434,7 @@ void THistManager::FillTH1(const char *name, const char *label, double weight, O
     Fatal("THistManager::FillTH1", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
     return;
   }
+  if(fFillBuffers) FlushFillBuffer(hist);
 	TString optionstring(opt);
 	if(optionstring.Contains("w")){
 	  // use bin width as weight
@@ -434,6 +459,7 @@ void THistManager::FillTH2(const char *name, double x, double y, double weight,
 		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
 		return;
 	}
+	if(fFillBuffers) FlushFillBuffer(hist);
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -459,6 +485,7 @@ void THistManager::FillTH2(const char *name, double *point, double weight, Optio
 		Fatal("THistManager::FillTH2", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
 		return;
 	}
+	if(fFillBuffers) FlushFillBuffer(hist);
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -469,7 +496,7 @@ void THistManager::FillTH2(const char *name, double *point, double weight, Optio
 	  Int_t biny = hist->GetYaxis()->FindBin(point[1]);
 	  if(biny != 0 && biny != hist->GetYaxis()->GetNbins()) myweight *= 1./hist->GetYaxis()->GetBinWidth(biny);
 	}
-	hist->Fill(point[0], point[1], weight);
+	hist->Fill(point[0], point[1], myweight);
 }
 
 void THistManager::FillTH3(const char* name, double x, double y, double z, double weight, Option_t *opt) {
@@ -484,6 +511,7 @@ void THistManager::FillTH3(const char* name, double x, double y, double z, doubl
 		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
 		return;
 	}
+	if(fFillBuffers) FlushFillBuffer(hist);
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -498,7 +526,7 @@ void THistManager::FillTH3(const char* name, double x, double y, double z, doubl
 	  Int_t binz = hist->GetZaxis()->FindBin(z);
 	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
 	}
-	hist->Fill(x, y, z, weight);
+	hist->Fill(x, y, z, myweight);
 }
 
 void THistManager::FillTH3(const char* name, const double* point, double weight, Option_t *opt) {
@@ -513,6 +541,7 @@ void THistManager::FillTH3(const char* name, const double* point, double weight,
 		Fatal("THistManager::FillTH3", "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
 		return;
 	}
+	if(fFillBuffers) FlushFillBuffer(hist);
 	TString optstring(opt);
 	Double_t myweight = optstring.Contains("w") ? 1. : weight;
 	if(optstring.Contains("wx")){
@@ -527,7 +556,7 @@ void THistManager::FillTH3(const char* name, const double* point, double weight,
 	  Int_t binz = hist->GetZaxis()->FindBin(point[2]);
 	  if(binz != 0 && binz != hist->GetZaxis()->GetNbins()) myweight *= 1./hist->GetZaxis()->GetBinWidth(binz);
 	}
-	hist->Fill(point[0], point[1], point[2], weight);
+	hist->Fill(point[0], point[1], point[2], myweight);
 }
 
 void THistManager::FillTHnSparse(const char *name, const double *x, double weight, Option_t *opt) {
@@ -549,11 +578,11 @@ void THistManager::FillTHnSparse(const char *name, const double *x, double weigh
 	  weighthandler << "w" << iaxis;
 	  if(optstring.Contains(weighthandler.str().c_str())){
 	    Int_t bin = hist->GetAxis(iaxis)->FindBin(x[iaxis]);
-	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= hist->GetAxis(iaxis)->GetBinWidth(bin);
+	    if(bin != 0 && bin != hist->GetAxis(iaxis)->GetNbins()) myweight *= 1./hist->GetAxis(iaxis)->GetBinWidth(bin);
 	  }
 	}
 
-	hist->Fill(x, weight);
+	hist->Fill(x, myweight);
 }
 
 void THistManager::FillProfile(const char* name, double x, double y, double weight){
@@ -567,7 +596,84 @@ void THistManager::FillProfile(const char* name, double x, double y, double weig
   hist->Fill(x, y, weight);
 }
 
+THistManager::TH1Handle THistManager::GetTH1Handle(const char *name, Option_t *opt) const {
+  TH1 *hist = dynamic_cast<TH1 *>(FindHistogramForHandle(name, "THistManager::GetTH1Handle"));
+  if(!hist) Fatal("THistManager::GetTH1Handle", "Object %s is not a 1D histogram", name);
+  return TH1Handle(hist, opt, GetFillBuffer(hist, 1));
+}
+
+THistManager::TH2Handle THistManager::GetTH2Handle(const char *name, Option_t *opt) const {
+  TH2 *hist = dynamic_cast<TH2 *>(FindHistogramForHandle(name, "THistManager::GetTH2Handle"));
+  if(!hist) Fatal("THistManager::GetTH2Handle", "Object %s is not a 2D histogram", name);
+  return TH2Handle(hist, opt, GetFillBuffer(hist, 2));
+}
+
+THistManager::TH3Handle THistManager::GetTH3Handle(const char *name, Option_t *opt) const {
+  TH3 *hist = dynamic_cast<TH3 *>(FindHistogramForHandle(name, "THistManager::GetTH3Handle"));
+  if(!hist) Fatal("THistManager::GetTH3Handle", "Object %s is not a 3D histogram", name);
+  return TH3Handle(hist, opt, GetFillBuffer(hist, 3));
+}
+
+THistManager::THnSparseHandle THistManager::GetTHnSparseHandle(const char *name, Option_t *opt) const {
+  THnSparse *hist = dynamic_cast<THnSparse *>(FindHistogramForHandle(name, "THistManager::GetTHnSparseHandle"));
+  if(!hist) Fatal("THistManager::GetTHnSparseHandle", "Object %s is not a THnSparse", name);
+  return THnSparseHandle(hist, opt);
+}
+
+THistManager::TProfileHandle THistManager::GetTProfileHandle(const char *name) const {
+  TProfile *hist = dynamic_cast<TProfile *>(FindHistogramForHandle(name, "THistManager::GetTProfileHandle"));
+  if(!hist) Fatal("THistManager::GetTProfileHandle", "Object %s is not a profile histogram", name);
+  return TProfileHandle(hist);
+}
+
+TObject *THistManager::FindHistogramForHandle(const char *name, const char *method) const {
+  TString dirname(basename(name)), hname(histname(name));
+  THashList *parent(FindGroup(dirname));
+  if(!parent){
+    Fatal(method, "Parent group %s does not exist", dirname.Data());
+    return nullptr;
+  }
+  TObject *hist = parent->FindObject(hname);
+  if(!hist) Fatal(method, "Histogram %s not found in parent group %s", hname.Data(), dirname.Data());
+  return hist;
+}
+
+THistManager::FillBuffer *THistManager::GetFillBuffer(TH1 *hist, Int_t ndim) const {
+  if(!fFillBufferSize || !hist) return nullptr;
+  // profiles have different fill semantics and statistics
+  if(hist->GetDimension() != ndim || hist->InheritsFrom(TProfile::Class()) || hist->InheritsFrom("TProfile2D") || hist->InheritsFrom("TProfile3D"))
+    return nullptr;
+  // histograms filled via several handles share the buffer
+  TIter nextbuffer(fFillBuffers);
+  FillBuffer *buffer(nullptr);
+  while((buffer = static_cast<FillBuffer *>(nextbuffer()))){
+    if(buffer->GetHistogram() == hist) return buffer;
+  }
+  buffer = new FillBuffer(hist, fFillBufferSize);
+  fFillBuffers->Add(buffer);
+  return buffer;
+}
+
+void THistManager::FlushFillBuffer(const TObject *hist) const {
+  TIter nextbuffer(fFillBuffers);
+  FillBuffer *buffer(nullptr);
+  while((buffer = static_cast<FillBuffer *>(nextbuffer()))){
+    if(buffer->GetHistogram() == hist){
+      buffer->Flush();
+      return;
+    }
+  }
+}
+
+void THistManager::FlushFillBuffers() const {
+  if(!fFillBuffers) return;
+  TIter nextbuffer(fFillBuffers);
+  FillBuffer *buffer(nullptr);
+  while((buffer = static_cast<FillBuffer *>(nextbuffer()))) buffer->Flush();
+}
+
 TObject *THistManager::FindObject(const char *name) const {
+  FlushFillBuffers();
 	TString dirname(basename(name)), hname(histname(name));
 	THashList *parent(FindGroup(dirname));
 	if(!parent) return NULL;
@@ -601,6 +707,294 @@ TString THistManager::histname(const TString &path) const {
 	return TString(path(index+1, path.Length() - (index+1)));
 }
 
+//////////////////////////////////////////////////////////
+///                                                    ///
+/// Implementation of the THistManager handles         ///
+///                                                    ///
+//////////////////////////////////////////////////////////
+
+namespace {
+  /// Inverse bin width used by the "w" fill options, 1 for underflow and overflow
+  /// (same bin range check as in THistManager::FillTH1)
+  inline double InverseBinWidth(const TAxis *axis, double x){
+    Int_t bin = axis->FindBin(x);
+    if(bin != 0 && bin != axis->GetNbins()) return 1./axis->GetBinWidth(bin);
+    return 1.;
+  }
+}
+
+/**
+ * @class THistManager::FillBuffer
+ * @brief Pending fills of a 1D, 2D or 3D histogram in buffered fill mode
+ *
+ * The entries are stored as structure of arrays. At flush the bins of all entries
+ * are computed in one pass, the bin contents (and sum of squared weights) are updated
+ * in bin order - entries of the same bin in the order they were filled - and the
+ * statistics in fill order. The result is identical to TH1::Fill called for every
+ * entry. Histograms for which this cannot be guaranteed (ROOT fill buffer, extendable
+ * axes, user range on an axis) are filled entry by entry at flush.
+ */
+class THistManager::FillBuffer : public TObject {
+public:
+  FillBuffer(TH1 *hist, Int_t size);
+  virtual ~FillBuffer() { }
+
+  TH1 *GetHistogram() const { return fHist; }
+
+  void Add(double x, double y, double z, double weight){
+    fX[fN] = x;
+    fY[fN] = y;
+    fZ[fN] = z;
+    fW[fN] = weight;
+    if(++fN == fSize) Flush();
+  }
+
+  void Flush();
+
+private:
+  FillBuffer(const FillBuffer &);
+  FillBuffer &operator=(const FillBuffer &);
+
+  bool CanAccumulate() const;
+  void FillEntries();
+
+  TH1 *fHist;                                   ///< Histogram (not owned)
+  Int_t fNdim;                                  ///< Histogram dimension
+  Int_t fSize;                                  ///< Maximum number of buffered entries
+  Int_t fN;                                     ///< Number of buffered entries
+  std::vector<double> fX;                       ///< x-coordinates
+  std::vector<double> fY;                       ///< y-coordinates (unused in 1D)
+  std::vector<double> fZ;                       ///< z-coordinates (unused in 1D and 2D)
+  std::vector<double> fW;                       ///< Weights
+  std::vector<std::pair<Int_t, Int_t> > fBins;  ///< Global bin and index of the entries, sorted at flush
+  std::vector<char> fInStats;                   ///< Entry contributes to the statistics
+};
+
+THistManager::FillBuffer::FillBuffer(TH1 *hist, Int_t size):
+    TObject(),
+    fHist(hist),
+    fNdim(hist->GetDimension()),
+    fSize(size),
+    fN(0),
+    fX(size),
+    fY(size),
+    fZ(size),
+    fW(size),
+    fBins(size),
+    fInStats(size)
+{
+}
+
+bool THistManager::FillBuffer::CanAccumulate() const {
+  if(fHist->GetBuffer()) return false;
+  const TAxis *axes[3] = {fHist->GetXaxis(), fHist->GetYaxis(), fHist->GetZaxis()};
+  for(Int_t idim = 0; idim < fNdim; idim++){
+    if(axes[idim]->TestBit(TAxis::kAxisRange)) return false;
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+    if(axes[idim]->CanExtend()) return false;
+#endif
+  }
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,0,0)
+  if(fHist->TestBit(TH1::kCanRebin)) return false;
+#endif
+  return true;
+}
+
+void THistManager::FillBuffer::FillEntries(){
+  for(Int_t ientry = 0; ientry < fN; ientry++){
+    switch(fNdim){
+    case 1: fHist->Fill(fX[ientry], fW[ientry]); break;
+    case 2: static_cast<TH2 *>(fHist)->Fill(fX[ientry], fY[ientry], fW[ientry]); break;
+    case 3: static_cast<TH3 *>(fHist)->Fill(fX[ientry], fY[ientry], fZ[ientry], fW[ientry]); break;
+    };
+  }
+}
+
+void THistManager::FillBuffer::Flush(){
+  if(!fN) return;
+  Double_t stats[TH1::kNstat];
+  Double_t entries = 0.;
+  bool accumulate = CanAccumulate();
+  if(accumulate){
+    fHist->GetStats(stats);
+    entries = fHist->GetEntries();
+    // GetStats recomputes the statistics from the bin contents in this case
+    if(stats[0] == 0. && entries > 0.) accumulate = false;
+  }
+  if(!accumulate){
+    FillEntries();
+    fN = 0;
+    return;
+  }
+
+  // bins of the whole batch, as in TH1::Fill for non-extendable axes
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+  const bool statoverflows = fHist->GetStatOverflowsBehaviour();
+#else
+  const bool statoverflows = TH1::GetStatOverflows();
+#endif
+  const TAxis *xaxis = fHist->GetXaxis(), *yaxis = fHist->GetYaxis(), *zaxis = fHist->GetZaxis();
+  const Int_t nbinsx = xaxis->GetNbins(), nbinsy = yaxis->GetNbins(), nbinsz = zaxis->GetNbins();
+  for(Int_t ientry = 0; ientry < fN; ientry++){
+    Int_t binx = xaxis->FindFixBin(fX[ientry]), biny = 0, binz = 0;
+    bool inrange = binx != 0 && binx <= nbinsx;
+    if(fNdim > 1){
+      biny = yaxis->FindFixBin(fY[ientry]);
+      inrange = inrange && biny != 0 && biny <= nbinsy;
+    }
+    if(fNdim > 2){
+      binz = zaxis->FindFixBin(fZ[ientry]);
+      inrange = inrange && binz != 0 && binz <= nbinsz;
+    }
+    fBins[ientry] = std::make_pair(fHist->GetBin(binx, biny, binz), ientry);
+    fInStats[ientry] = inrange || statoverflows;
+  }
+
+  // TH1::Fill switches on the sum of squared weights at the first weight != 1
+  if(!fHist->GetSumw2N() && !fHist->TestBit(TH1::kIsNotW)){
+    for(Int_t ientry = 0; ientry < fN; ientry++){
+      if(fW[ientry] != 1.){
+        fHist->Sumw2();
+        break;
+      }
+    }
+  }
+
+  // bin contents in bin order, entries of the same bin keep their order
+  std::sort(fBins.begin(), fBins.begin() + fN);
+  Double_t *sumw2 = fHist->GetSumw2N() ? fHist->GetSumw2()->GetArray() : nullptr;
+  for(Int_t ientry = 0; ientry < fN; ientry++){
+    Int_t bin = fBins[ientry].first;
+    double w = fW[fBins[ientry].second];
+    if(sumw2) sumw2[bin] += w*w;
+    fHist->AddBinContent(bin, w);
+  }
+
+  // statistics in fill order, same expressions as in TH1/TH2/TH3::Fill
+  for(Int_t ientry = 0; ientry < fN; ientry++){
+    entries++;
+    if(!fInStats[ientry]) continue;
+    double w = fW[ientry], x = fX[ientry], y = fY[ientry], z = fZ[ientry];
+    stats[0] += w;
+    stats[1] += w*w;
+    stats[2] += w*x;
+    stats[3] += w*x*x;
+    if(fNdim > 1){
+      stats[4] += w*y;
+      stats[5] += w*y*y;
+      stats[6] += w*x*y;
+    }
+    if(fNdim > 2){
+      stats[7] += w*z;
+      stats[8] += w*z*z;
+      stats[9] += w*x*z;
+      stats[10] += w*y*z;
+    }
+  }
+  fHist->PutStats(stats);
+  fHist->SetEntries(entries);
+  fN = 0;
+}
+
+THistManager::TH1Handle::TH1Handle(TH1 *hist, Option_t *opt, FillBuffer *buffer):
+    fHist(hist),
+    fWeightMode(0),
+    fBuffer(buffer)
+{
+  if(TString(opt).Contains("w")) fWeightMode = 1;
+}
+
+void THistManager::TH1Handle::Fill(double x, double weight) const {
+  if(fWeightMode){
+    Int_t bin = fHist->GetXaxis()->FindBin(x);
+    if(bin != 0 && bin != fHist->GetXaxis()->GetNbins()) weight = 1./fHist->GetXaxis()->GetBinWidth(bin);
+  }
+  if(fBuffer) fBuffer->Add(x, 0., 0., weight);
+  else fHist->Fill(x, weight);
+}
+
+void THistManager::TH1Handle::Fill(const char *label, double weight) const {
+  // label fills might extend the axis, they are not buffered
+  if(fBuffer) fBuffer->Flush();
+  if(fWeightMode){
+    Int_t bin = fHist->GetXaxis()->FindBin(label);
+    if(bin != 0 && bin != fHist->GetXaxis()->GetNbins()) weight = 1./fHist->GetXaxis()->GetBinWidth(bin);
+  }
+  fHist->Fill(label, weight);
+}
+
+THistManager::TH2Handle::TH2Handle(TH2 *hist, Option_t *opt, FillBuffer *buffer):
+    fHist(hist),
+    fWeightMode(0),
+    fBuffer(buffer)
+{
+  TString optstring(opt);
+  // any "w" option replaces the weight by 1, as in THistManager::FillTH2
+  if(optstring.Contains("w")) fWeightMode |= 0x80;
+  if(optstring.Contains("wx")) fWeightMode |= 1;
+  if(optstring.Contains("wy")) fWeightMode |= 2;
+}
+
+void THistManager::TH2Handle::Fill(double x, double y, double weight) const {
+  if(fWeightMode){
+    weight = 1.;
+    if(fWeightMode & 1) weight *= InverseBinWidth(fHist->GetXaxis(), x);
+    if(fWeightMode & 2) weight *= InverseBinWidth(fHist->GetYaxis(), y);
+  }
+  if(fBuffer) fBuffer->Add(x, y, 0., weight);
+  else fHist->Fill(x, y, weight);
+}
+
+THistManager::TH3Handle::TH3Handle(TH3 *hist, Option_t *opt, FillBuffer *buffer):
+    fHist(hist),
+    fWeightMode(0),
+    fBuffer(buffer)
+{
+  TString optstring(opt);
+  // any "w" option replaces the weight by 1, as in THistManager::FillTH3
+  if(optstring.Contains("w")) fWeightMode |= 0x80;
+  if(optstring.Contains("wx")) fWeightMode |= 1;
+  if(optstring.Contains("wy")) fWeightMode |= 2;
+  if(optstring.Contains("wz")) fWeightMode |= 4;
+}
+
+void THistManager::TH3Handle::Fill(double x, double y, double z, double weight) const {
+  if(fWeightMode){
+    weight = 1.;
+    if(fWeightMode & 1) weight *= InverseBinWidth(fHist->GetXaxis(), x);
+    if(fWeightMode & 2) weight *= InverseBinWidth(fHist->GetYaxis(), y);
+    if(fWeightMode & 4) weight *= InverseBinWidth(fHist->GetZaxis(), z);
+  }
+  if(fBuffer) fBuffer->Add(x, y, z, weight);
+  else fHist->Fill(x, y, z, weight);
+}
+
+THistManager::THnSparseHandle::THnSparseHandle(THnSparse *hist, Option_t *opt):
+    fHist(hist),
+    fWeightMode(0)
+{
+  TString optstring(opt);
+  // any "w" option replaces the weight by 1, as in THistManager::FillTHnSparse
+  if(optstring.Contains("w")) fWeightMode |= (1ULL << 63);
+  for(Int_t iaxis = 0; iaxis < hist->GetNdimensions() && iaxis < 63; iaxis++){
+    if(optstring.Contains(Form("w%d", iaxis))) fWeightMode |= (1ULL << iaxis);
+  }
+}
+
+void THistManager::THnSparseHandle::Fill(const double *x, double weight) const {
+  if(fWeightMode){
+    weight = 1.;
+    for(Int_t iaxis = 0; iaxis < fHist->GetNdimensions() && iaxis < 63; iaxis++){
+      if(fWeightMode & (1ULL << iaxis)) weight *= InverseBinWidth(fHist->GetAxis(iaxis), x[iaxis]);
+    }
+  }
+  fHist->Fill(x, weight);
+}
+
+void THistManager::TProfileHandle::Fill(double x, double y, double weight) const {
+  fHist->Fill(x, y, weight);
+}
+
 //////////////////////////////////////////////////////////
 ///                                                    ///
 /// Implementation of THistManager::iterator           ///
@@ -972,6 +1366,223 @@ namespace TestTHistManager {
     return success ? 0 : 1;
   }
 
+  int THistManagerTestSuite::TestFillHandles(){
+    THistManager testmgr("testmgr");
+
+    testmgr.CreateTH1("Group1/Test1D", "Test 1D", 1, 0., 1.);
+    testmgr.CreateTH2("Group1/Test2D", "Test 2D", 1, 0., 1., 1, 0., 1.);
+    testmgr.CreateTH3("Group2/Test3D", "Test 3D", 1, 0., 1., 1, 0., 1., 1, 0., 1.);
+    int nbins[3] = {1, 1, 1}; double min[3] = {0., 0., 0.}, max[3] = {1., 1., 1.};
+    testmgr.CreateTHnSparse("Group2/TestNSparse", "Test NSparse", 3, nbins, min, max);
+    testmgr.CreateTProfile("Group3/Subgroup1/TestProfile", "Test profile", 1, 0., 1.);
+
+    THistManager::TH1Handle h1 = testmgr.GetTH1Handle("Group1/Test1D");
+    THistManager::TH2Handle h2 = testmgr.GetTH2Handle("Group1/Test2D");
+    THistManager::TH3Handle h3 = testmgr.GetTH3Handle("Group2/Test3D");
+    THistManager::THnSparseHandle hn = testmgr.GetTHnSparseHandle("Group2/TestNSparse");
+    THistManager::TProfileHandle hp = testmgr.GetTProfileHandle("Group3/Subgroup1/TestProfile");
+
+    bool success(true);
+    if(h1.GetHistogram() != testmgr.FindObject("Group1/Test1D")){
+      std::cout << "Handle mismatch: Group1/Test1D" << std::endl;
+      success = false;
+    }
+    if(h2.GetHistogram() != testmgr.FindObject("Group1/Test2D")){
+      std::cout << "Handle mismatch: Group1/Test2D" << std::endl;
+      success = false;
+    }
+    if(h3.GetHistogram() != testmgr.FindObject("Group2/Test3D")){
+      std::cout << "Handle mismatch: Group2/Test3D" << std::endl;
+      success = false;
+    }
+    if(hn.GetHistogram() != testmgr.FindObject("Group2/TestNSparse")){
+      std::cout << "Handle mismatch: Group2/TestNSparse" << std::endl;
+      success = false;
+    }
+    if(hp.GetHistogram() != testmgr.FindObject("Group3/Subgroup1/TestProfile")){
+      std::cout << "Handle mismatch: Group3/Subgroup1/TestProfile" << std::endl;
+      success = false;
+    }
+    if(!success) return 1;
+
+    double point[3] = {0.5, 0.5, 0.5};
+    for(int i = 0; i < 100; i++){
+      h1.Fill(0.5);
+      h2.Fill(0.5, 0.5);
+      h3.Fill(point);
+      hn.Fill(point);
+      hp.Fill(0.5, 1.);
+    }
+
+    if(TMath::Abs(h1.GetHistogram()->GetBinContent(1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test1D: Value mismatch: expected 100, found " << h1.GetHistogram()->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h2.GetHistogram()->GetBinContent(1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group1/Test2D: Value mismatch: expected 100, found " << h2.GetHistogram()->GetBinContent(1, 1) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(h3.GetHistogram()->GetBinContent(1, 1, 1) - 100) > DBL_EPSILON){
+      std::cout << "Group2/Test3D: Value mismatch: expected 100, found " << h3.GetHistogram()->GetBinContent(1, 1, 1) << std::endl;
+      success = false;
+    }
+    int coord[3] = {1, 1, 1};
+    if(TMath::Abs(hn.GetHistogram()->GetBinContent(coord) - 100) > DBL_EPSILON){
+      std::cout << "Group2/TestNSparse: Value mismatch: expected 100, found " << hn.GetHistogram()->GetBinContent(coord) << std::endl;
+      success = false;
+    }
+    if(TMath::Abs(hp.GetHistogram()->GetBinContent(1) - 1) > DBL_EPSILON){
+      std::cout << "Group3/Subgroup1/TestProfile: Value mismatch: expected 1, found " << hp.GetHistogram()->GetBinContent(1) << std::endl;
+      success = false;
+    }
+    return success ? 0 : 1;
+  }
+
+  int THistManagerTestSuite::TestFillBuffered(){
+    THistManager directmgr("directmgr"), bufferedmgr("bufferedmgr");
+    bufferedmgr.SetFillBufferSize(17);
+
+    THistManager *managers[2] = {&directmgr, &bufferedmgr};
+    double xbins[6] = {0., 0.1, 0.3, 0.6, 0.8, 1.};
+    for(int imgr = 0; imgr < 2; imgr++){
+      managers[imgr]->CreateTH1("Group1/Test1D", "Test 1D", 5, xbins);
+      managers[imgr]->CreateTH1("Group1/Test1DWeighted", "Test 1D weighted", 10, 0., 1.);
+      managers[imgr]->CreateTH2("Group1/Test2D", "Test 2D", 5, xbins, 5, xbins);
+      managers[imgr]->CreateTH3("Group2/Test3D", "Test 3D", 5, xbins, 5, xbins, 5, xbins);
+    }
+    THistManager::TH1Handle h1[2], h1w[2];
+    THistManager::TH2Handle h2[2];
+    THistManager::TH3Handle h3[2];
+    for(int imgr = 0; imgr < 2; imgr++){
+      h1[imgr] = managers[imgr]->GetTH1Handle("Group1/Test1D");
+      h1w[imgr] = managers[imgr]->GetTH1Handle("Group1/Test1DWeighted");
+      h2[imgr] = managers[imgr]->GetTH2Handle("Group1/Test2D", "wx");
+      h3[imgr] = managers[imgr]->GetTH3Handle("Group2/Test3D");
+    }
+
+    TRandom3 rand(42);
+    for(int i = 0; i < 1000; i++){
+      double x = rand.Uniform(-0.2, 1.2), y = rand.Uniform(-0.2, 1.2), z = rand.Uniform(-0.2, 1.2);
+      // first weighted entry in the middle of a buffer
+      double w = i < 100 ? 1. : rand.Uniform(0.5, 2.);
+      for(int imgr = 0; imgr < 2; imgr++){
+        h1[imgr].Fill(x);
+        h1w[imgr].Fill(x, w);
+        h2[imgr].Fill(x, y);
+        h3[imgr].Fill(x, y, z, w);
+      }
+      // name-based fill in between buffered ones
+      if(i == 500) for(int imgr = 0; imgr < 2; imgr++) managers[imgr]->FillTH1("Group1/Test1DWeighted", 0.5, 3.);
+    }
+
+    bool success(true);
+    const char *histnames[4] = {"Group1/Test1D", "Group1/Test1DWeighted", "Group1/Test2D", "Group2/Test3D"};
+    for(int ihist = 0; ihist < 4; ihist++){
+      TH1 *direct = static_cast<TH1 *>(directmgr.FindObject(histnames[ihist])),
+          *buffered = static_cast<TH1 *>(bufferedmgr.FindObject(histnames[ihist]));
+      for(int ibin = 0; ibin < direct->GetNcells(); ibin++){
+        if(direct->GetBinContent(ibin) != buffered->GetBinContent(ibin) || direct->GetBinError(ibin) != buffered->GetBinError(ibin)){
+          std::cout << histnames[ihist] << ": Bin " << ibin << " mismatch: expected " << direct->GetBinContent(ibin) << " +- " << direct->GetBinError(ibin)
+                    << ", found " << buffered->GetBinContent(ibin) << " +- " << buffered->GetBinError(ibin) << std::endl;
+          success = false;
+          break;
+        }
+      }
+      if(direct->GetEntries() != buffered->GetEntries()){
+        std::cout << histnames[ihist] << ": Entries mismatch: expected " << direct->GetEntries() << ", found " << buffered->GetEntries() << std::endl;
+        success = false;
+      }
+      double directstats[TH1::kNstat], bufferedstats[TH1::kNstat];
+      direct->GetStats(directstats);
+      buffered->GetStats(bufferedstats);
+      for(int istat = 0; istat < 11; istat++){
+        if(directstats[istat] != bufferedstats[istat]){
+          std::cout << histnames[ihist] << ": Statistics " << istat << " mismatch: expected " << directstats[istat] << ", found " << bufferedstats[istat] << std::endl;
+          success = false;
+        }
+      }
+    }
+    return success ? 0 : 1;
+  }
+
+  int THistManagerTestSuite::TestFillWeightOptions(){
+    THistManager namemgr("namemgr"), handlemgr("handlemgr");
+
+    THistManager *managers[2] = {&namemgr, &handlemgr};
+    double xbins[6] = {0., 0.1, 0.3, 0.6, 0.8, 1.};
+    int nbins[3] = {5, 4, 10}; double min[3] = {0., 0., 0.}, max[3] = {1., 2., 1.};
+    const char *names2D[3] = {"Group1/Test2Dw", "Group1/Test2Dwx", "Group1/Test2Dwxwy"},
+               *opts2D[3] = {"w", "wx", "wxwy"},
+               *names3D[2] = {"Group2/Test3Dw", "Group2/Test3Dwxwywz"},
+               *opts3D[2] = {"w", "wxwywz"},
+               *namesN[2] = {"Group3/TestNSparsew", "Group3/TestNSparsew0w2"},
+               *optsN[2] = {"w", "w0w2"};
+    for(int imgr = 0; imgr < 2; imgr++){
+      for(int ihist = 0; ihist < 3; ihist++) managers[imgr]->CreateTH2(names2D[ihist], "Test 2D", 5, xbins, 5, xbins);
+      for(int ihist = 0; ihist < 2; ihist++) managers[imgr]->CreateTH3(names3D[ihist], "Test 3D", 5, xbins, 5, xbins, 5, xbins);
+      for(int ihist = 0; ihist < 2; ihist++) managers[imgr]->CreateTHnSparse(namesN[ihist], "Test NSparse", 3, nbins, min, max);
+    }
+    THistManager::TH2Handle h2[3];
+    THistManager::TH3Handle h3[2];
+    THistManager::THnSparseHandle hn[2];
+    for(int ihist = 0; ihist < 3; ihist++) h2[ihist] = handlemgr.GetTH2Handle(names2D[ihist], opts2D[ihist]);
+    for(int ihist = 0; ihist < 2; ihist++){
+      h3[ihist] = handlemgr.GetTH3Handle(names3D[ihist], opts3D[ihist]);
+      hn[ihist] = handlemgr.GetTHnSparseHandle(namesN[ihist], optsN[ihist]);
+    }
+
+    // entries in- and outside the histogram range, with weights different from 1
+    TRandom3 rng(1234);
+    double point[3];
+    for(int i = 0; i < 1000; i++){
+      for(int idim = 0; idim < 3; idim++) point[idim] = rng.Uniform(-0.1, 1.1);
+      double weight = rng.Uniform(0.5, 2.);
+      for(int ihist = 0; ihist < 3; ihist++){
+        if(i % 2) namemgr.FillTH2(names2D[ihist], point[0], point[1], weight, opts2D[ihist]);
+        else namemgr.FillTH2(names2D[ihist], point, weight, opts2D[ihist]);
+        h2[ihist].Fill(point[0], point[1], weight);
+      }
+      for(int ihist = 0; ihist < 2; ihist++){
+        if(i % 2) namemgr.FillTH3(names3D[ihist], point[0], point[1], point[2], weight, opts3D[ihist]);
+        else namemgr.FillTH3(names3D[ihist], point, weight, opts3D[ihist]);
+        h3[ihist].Fill(point, weight);
+        namemgr.FillTHnSparse(namesN[ihist], point, weight, optsN[ihist]);
+        hn[ihist].Fill(point, weight);
+      }
+    }
+
+    bool success(true);
+    const char *namesTH[5] = {names2D[0], names2D[1], names2D[2], names3D[0], names3D[1]};
+    for(int ihist = 0; ihist < 5; ihist++){
+      TH1 *byname = static_cast<TH1 *>(namemgr.FindObject(namesTH[ihist])),
+          *byhandle = static_cast<TH1 *>(handlemgr.FindObject(namesTH[ihist]));
+      for(int icell = 0; icell < byname->GetNcells(); icell++){
+        if(TMath::Abs(byname->GetBinContent(icell) - byhandle->GetBinContent(icell)) > 1e-12 * TMath::Abs(byname->GetBinContent(icell))){
+          std::cout << namesTH[ihist] << ": Bin " << icell << " mismatch: by name " << byname->GetBinContent(icell) << ", by handle " << byhandle->GetBinContent(icell) << std::endl;
+          success = false;
+        }
+      }
+    }
+    for(int ihist = 0; ihist < 2; ihist++){
+      THnSparse *byname = static_cast<THnSparse *>(namemgr.FindObject(namesN[ihist])),
+                *byhandle = static_cast<THnSparse *>(handlemgr.FindObject(namesN[ihist]));
+      if(byname->GetNbins() != byhandle->GetNbins()){
+        std::cout << namesN[ihist] << ": Number of filled bins mismatch: by name " << byname->GetNbins() << ", by handle " << byhandle->GetNbins() << std::endl;
+        success = false;
+        continue;
+      }
+      int coord[3];
+      for(Long64_t ibin = 0; ibin < byname->GetNbins(); ibin++){
+        double content = byname->GetBinContent(ibin, coord);
+        if(TMath::Abs(content - byhandle->GetBinContent(coord)) > 1e-12 * TMath::Abs(content)){
+          std::cout << namesN[ihist] << ": Bin " << ibin << " mismatch: by name " << content << ", by handle " << byhandle->GetBinContent(coord) << std::endl;
+          success = false;
+        }
+      }
+    }
+    return success ? 0 : 1;
+  }
+
   int TestRunAll(){
     int testresult(0);
     THistManagerTestSuite testsuite;
@@ -992,6 +1603,18 @@ namespace TestTHistManager {
     testresult += testsuite.TestFillGroupedHistograms();
     std::cout << "Result after test: " << testresult << std::endl;
 
+    std::cout << "Running test: Fill Handles" << std::endl;
+    testresult += testsuite.TestFillHandles();
+    std::cout << "Result after test: " << testresult << std::endl;
+
+    std::cout << "Running test: Fill Buffered" << std::endl;
+    testresult += testsuite.TestFillBuffered();
+    std::cout << "Result after test: " << testresult << std::endl;
+
+    std::cout << "Running test: Fill Weight Options" << std::endl;
+    testresult += testsuite.TestFillWeightOptions();
+    std::cout << "Result after test: " << testresult << std::endl;
+
     return testresult;
   }
 
@@ -1014,4 +1637,77 @@ namespace TestTHistManager {
     THistManagerTestSuite testsuite;
     return testsuite.TestFillGroupedHistograms();
   }
+
+  int TestRunFillHandles(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillHandles();
+  }
+
+  int TestRunFillBuffered(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillBuffered();
+  }
+
+  int TestRunFillWeightOptions(){
+    THistManagerTestSuite testsuite;
+    return testsuite.TestFillWeightOptions();
+  }
+
+  void BenchmarkFillHandles(int nfills){
+    THistManager testmgr("benchmgr"), buffermgr("benchbuffermgr");
+    buffermgr.SetFillBufferSize(1000);
+
+    // group depth and number of histograms per group as in the jet and trigger QA tasks
+    const int kNHists = 20;
+    for(int ihist = 0; ihist < kNHists; ihist++){
+      testmgr.CreateTH1(Form("EventQA/Trigger/hist1D_%d", ihist), "Benchmark 1D", 100, 0., 100.);
+      testmgr.CreateTH2(Form("EventQA/Trigger/hist2D_%d", ihist), "Benchmark 2D", 100, 0., 100., 100, 0., 100.);
+      buffermgr.CreateTH1(Form("EventQA/Trigger/hist1D_%d", ihist), "Benchmark 1D", 100, 0., 100.);
+      buffermgr.CreateTH2(Form("EventQA/Trigger/hist2D_%d", ihist), "Benchmark 2D", 100, 0., 100., 100, 0., 100.);
+    }
+    const char *name1D = "EventQA/Trigger/hist1D_10", *name2D = "EventQA/Trigger/hist2D_10";
+    TH1 *direct1D = static_cast<TH1 *>(testmgr.FindObject(name1D));
+    TH2 *direct2D = static_cast<TH2 *>(testmgr.FindObject(name2D));
+    THistManager::TH1Handle handle1D = testmgr.GetTH1Handle(name1D);
+    THistManager::TH2Handle handle2D = testmgr.GetTH2Handle(name2D);
+    THistManager::TH1Handle buffered1D = buffermgr.GetTH1Handle(name1D);
+    THistManager::TH2Handle buffered2D = buffermgr.GetTH2Handle(name2D);
+
+    TStopwatch watch;
+    double t[4][2];
+
+    watch.Start();
+    for(int i = 0; i < nfills; i++) testmgr.FillTH1(name1D, i % 100);
+    t[0][0] = watch.RealTime();
+    watch.Start();
+    for(int i = 0; i < nfills; i++) handle1D.Fill(i % 100);
+    t[1][0] = watch.RealTime();
+    watch.Start();
+    for(int i = 0; i < nfills; i++) direct1D->Fill(i % 100);
+    t[2][0] = watch.RealTime();
+    watch.Start();
+    for(int i = 0; i < nfills; i++) buffered1D.Fill(i % 100);
+    buffermgr.FlushFillBuffers();
+    t[3][0] = watch.RealTime();
+
+    watch.Start();
+    for(int i = 0; i < nfills; i++) testmgr.FillTH2(name2D, i % 100, (i / 100) % 100);
+    t[0][1] = watch.RealTime();
+    watch.Start();
+    for(int i = 0; i < nfills; i++) handle2D.Fill(i % 100, (i / 100) % 100);
+    t[1][1] = watch.RealTime();
+    watch.Start();
+    for(int i = 0; i < nfills; i++) direct2D->Fill(i % 100, (i / 100) % 100);
+    t[2][1] = watch.RealTime();
+    watch.Start();
+    for(int i = 0; i < nfills; i++) buffered2D.Fill(i % 100, (i / 100) % 100);
+    buffermgr.FlushFillBuffers();
+    t[3][1] = watch.RealTime();
+
+    const char *modes[4] = {"by name ", "handle  ", "direct  ", "buffered"};
+    std::cout << "Time per fill (ns) for " << nfills << " fills:" << std::endl;
+    std::cout << "            TH1      TH2" << std::endl;
+    for(int imode = 0; imode < 4; imode++)
+      std::cout << modes[imode] << " " << Form("%8.1f %8.1f", t[imode][0] / nfills * 1e9, t[imode][1] / nfills * 1e9) << std::endl;
+  }
 }
@@ -161,6 +161,159 @@ public:
     iterator();
   };
 
+  class FillBuffer;
+
+  /**
+   * @class TH1Handle
+   * @brief Handle to a 1D histogram in the histogram manager
+   * @ingroup Histmanager
+   *
+   * Lightweight reference to a histogram inside the manager, obtained once via
+   * THistManager::GetTH1Handle (typically in UserCreateOutputObjects). Filling
+   * through the handle avoids the path parsing, the group and histogram lookup,
+   * the type check and the option parsing done by THistManager::FillTH1 in every call.
+   * The fill options are interpreted when the handle is created. The handle is only
+   * valid as long as the histogram manager is alive.
+   *
+   * If the manager is in buffered fill mode (see THistManager::SetFillBufferSize) when
+   * the handle is created, the fills of 1D, 2D and 3D histograms are collected in a
+   * buffer and added to the histogram in batches.
+   */
+  class TH1Handle {
+  public:
+    TH1Handle(): fHist(nullptr), fWeightMode(0), fBuffer(nullptr) { }
+    TH1Handle(TH1 *hist, Option_t *opt = "", FillBuffer *buffer = nullptr);
+
+    bool IsValid() const { return fHist != nullptr; }
+    TH1 *GetHistogram() const { return fHist; }
+
+    /**
+     * Fill the histogram, same as THistManager::FillTH1
+     * @param[in] x x-coordinate
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(double x, double weight = 1.) const;
+
+    /**
+     * Fill the bin with the given label, same as THistManager::FillTH1
+     * @param[in] label bin label
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(const char *label, double weight = 1.) const;
+
+  private:
+    TH1 *fHist;                 ///< Histogram (not owned)
+    UChar_t fWeightMode;        ///< Weight with the inverse bin width (option "w")
+    FillBuffer *fBuffer;        //!<! Fill buffer of the histogram in buffered fill mode (owned by the manager)
+  };
+
+  /**
+   * @class TH2Handle
+   * @brief Handle to a 2D histogram in the histogram manager, see TH1Handle
+   * @ingroup Histmanager
+   */
+  class TH2Handle {
+  public:
+    TH2Handle(): fHist(nullptr), fWeightMode(0), fBuffer(nullptr) { }
+    TH2Handle(TH2 *hist, Option_t *opt = "", FillBuffer *buffer = nullptr);
+
+    bool IsValid() const { return fHist != nullptr; }
+    TH2 *GetHistogram() const { return fHist; }
+
+    /**
+     * Fill the histogram, same as THistManager::FillTH2
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(double x, double y, double weight = 1.) const;
+    void Fill(const double *point, double weight = 1.) const { Fill(point[0], point[1], weight); }
+
+  private:
+    TH2 *fHist;                 ///< Histogram (not owned)
+    UChar_t fWeightMode;        ///< Bit i: weight with the inverse bin width in dimension i (options "wx", "wy"), bit 7: unit weight (any "w" option)
+    FillBuffer *fBuffer;        //!<! Fill buffer of the histogram in buffered fill mode (owned by the manager)
+  };
+
+  /**
+   * @class TH3Handle
+   * @brief Handle to a 3D histogram in the histogram manager, see TH1Handle
+   * @ingroup Histmanager
+   */
+  class TH3Handle {
+  public:
+    TH3Handle(): fHist(nullptr), fWeightMode(0), fBuffer(nullptr) { }
+    TH3Handle(TH3 *hist, Option_t *opt = "", FillBuffer *buffer = nullptr);
+
+    bool IsValid() const { return fHist != nullptr; }
+    TH3 *GetHistogram() const { return fHist; }
+
+    /**
+     * Fill the histogram, same as THistManager::FillTH3
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     * @param[in] z z-coordinate
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(double x, double y, double z, double weight = 1.) const;
+    void Fill(const double *point, double weight = 1.) const { Fill(point[0], point[1], point[2], weight); }
+
+  private:
+    TH3 *fHist;                 ///< Histogram (not owned)
+    UChar_t fWeightMode;        ///< Bit i: weight with the inverse bin width in dimension i (options "wx", "wy", "wz"), bit 7: unit weight (any "w" option)
+    FillBuffer *fBuffer;        //!<! Fill buffer of the histogram in buffered fill mode (owned by the manager)
+  };
+
+  /**
+   * @class THnSparseHandle
+   * @brief Handle to a THnSparse in the histogram manager, see TH1Handle
+   * @ingroup Histmanager
+   */
+  class THnSparseHandle {
+  public:
+    THnSparseHandle(): fHist(nullptr), fWeightMode(0) { }
+    THnSparseHandle(THnSparse *hist, Option_t *opt = "");
+
+    bool IsValid() const { return fHist != nullptr; }
+    THnSparse *GetHistogram() const { return fHist; }
+
+    /**
+     * Fill the histogram, same as THistManager::FillTHnSparse
+     * @param[in] x coordinates of the data
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(const double *x, double weight = 1.) const;
+
+  private:
+    THnSparse *fHist;           ///< Histogram (not owned)
+    ULong64_t fWeightMode;      ///< Bit i: weight with the inverse bin width in dimension i (options "w0", "w1", ...), bit 63: unit weight (any "w" option)
+  };
+
+  /**
+   * @class TProfileHandle
+   * @brief Handle to a TProfile in the histogram manager, see TH1Handle
+   * @ingroup Histmanager
+   */
+  class TProfileHandle {
+  public:
+    TProfileHandle(): fHist(nullptr) { }
+    TProfileHandle(TProfile *hist): fHist(hist) { }
+
+    bool IsValid() const { return fHist != nullptr; }
+    TProfile *GetHistogram() const { return fHist; }
+
+    /**
+     * Fill the profile, same as THistManager::FillProfile
+     * @param[in] x x-coordinate
+     * @param[in] y y-coordinate
+     * @param[in] weight optional weight of the entry (default 1)
+     */
+    void Fill(double x, double y, double weight = 1.) const;
+
+  private:
+    TProfile *fHist;            ///< Profile (not owned)
+  };
+
   /**
    * Default constructor, only initialising pointers with 0
    */
@@ -179,6 +332,31 @@ public:
 
 	void ReleaseOwner() { fIsOwner = kFALSE; };
 
+	/**
+	 * Switch on the buffered fill mode for handles created afterwards (see GetTH1Handle).
+	 * Fills of 1D, 2D and 3D histograms through these handles are stored in a buffer
+	 * per histogram and added to the histogram when size entries are collected. The
+	 * bins of the whole batch are computed in one go and the bin contents are updated
+	 * in bin order, the histograms end up identical to the ones filled entry by entry.
+	 * Pending entries are added by FlushFillBuffers, which is called by FindObject,
+	 * GetListOfHistograms, by name-based fills of the same histogram and in the destructor.
+	 * Tasks posting the list of histograms in UserCreateOutputObjects have to call
+	 * FlushFillBuffers in FinishTaskOutput (before the output is merged).
+	 * @param[in] size Number of entries buffered per histogram (0: no buffering)
+	 */
+	void SetFillBufferSize(Int_t size);
+
+	/**
+	 * Get the buffer size used for handles created in buffered fill mode
+	 * @return Buffer size (0 if fills are not buffered)
+	 */
+	Int_t GetFillBufferSize() const { return fFillBufferSize; }
+
+	/**
+	 * Add all buffered entries to their histograms
+	 */
+	void FlushFillBuffers() const;
+
 	/**
 	 * Create a new group of histograms within a parent group. Groups are represented as list. The default parent is
 	 * always the top list. List name structure accouding to unix paths (i.e. top list /, hirarchies separated by /).
@@ -418,6 +596,7 @@ public:
 	 * @param[in] x x-coordinate
 	 * @param[in] y y-coordinate
 	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] opt any option containing "w" replaces the weight by 1; "wx", "wy": weight with the inverse bin width in x, y
 	 */
 	void FillTH2(const char *hname, double x, double y, double weight = 1., Option_t *opt = "");
 
@@ -427,6 +606,7 @@ public:
 	 * @param[in] name Name of the histogram
 	 * @param[in] point coordinates of the data
 	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] opt options as in FillTH2(const char *, double, double, double, Option_t *)
 	 */
 	void FillTH2(const char *hname, double *point, double weight = 1., Option_t *opt = "");
 
@@ -438,6 +618,7 @@ public:
 	 * @param[in] y y-coordinate
 	 * @param[in] z z-coordinate
 	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] opt any option containing "w" replaces the weight by 1; "wx", "wy", "wz": weight with the inverse bin width in x, y, z
 	 */
 	void FillTH3(const char *hname, double x, double y, double z, double weight = 1., Option_t *opt = "");
 
@@ -447,6 +628,7 @@ public:
 	 * @param[in] name Name of the histogram
 	 * @param[in] point 3D-coordinate (x,y,z) of the point to be filled
 	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] opt options as in FillTH3(const char *, double, double, double, double, Option_t *)
 	 */
 	void FillTH3(const char *hname, const double *point, double weight = 1., Option_t *opt = "");
 
@@ -456,6 +638,7 @@ public:
 	 * @param[in] name Name of the histogram
 	 * @param[in] x coordinates of the data
 	 * @param[in] weight optional weight of the entry (default 1)
+	 * @param[in] opt any option containing "w" replaces the weight by 1; "w<i>": weight with the inverse bin width in dimension i
 	 */
 	void FillTHnSparse(const char *name, const double *x, double weight = 1., Option_t *opt = "");
 
@@ -469,6 +652,46 @@ public:
 	 */
   void FillProfile(const char *name, double x, double y, double weight = 1.);
 
+  /**
+   * Get a handle to a 1D histogram within the container, for fills without lookup. The histogram
+   * name also contains the parent group(s) according to the common group notation.
+   * @param[in] name Name of the histogram
+   * @param[in] opt Fill options, as for FillTH1
+   * @return Handle to the histogram
+   */
+  TH1Handle GetTH1Handle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * Get a handle to a 2D histogram within the container, see GetTH1Handle
+   * @param[in] name Name of the histogram
+   * @param[in] opt Fill options, as for FillTH2
+   * @return Handle to the histogram
+   */
+  TH2Handle GetTH2Handle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * Get a handle to a 3D histogram within the container, see GetTH1Handle
+   * @param[in] name Name of the histogram
+   * @param[in] opt Fill options, as for FillTH3
+   * @return Handle to the histogram
+   */
+  TH3Handle GetTH3Handle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * Get a handle to a THnSparse within the container, see GetTH1Handle
+   * @param[in] name Name of the histogram
+   * @param[in] opt Fill options, as for FillTHnSparse
+   * @return Handle to the histogram
+   */
+  THnSparseHandle GetTHnSparseHandle(const char *name, Option_t *opt = "") const;
+
+  /**
+   * Get a handle to a profile histogram within the container, see GetTH1Handle
+   * @param[in] name Name of the profile histogram
+   * @return Handle to the profile
+   */
+  TProfileHandle GetTProfileHandle(const char *name) const;
+
   /**
    * Create forward iterator starting at the beginning of the
    * container
@@ -501,7 +724,7 @@ public:
    * Get the list of histograms
    * @return The list of histograms
    */
-	THashList *GetListOfHistograms() const { return fHistos; }
+	THashList *GetListOfHistograms() const { FlushFillBuffers(); return fHistos; }
 
 	/**
 	 * Find an object inside the container. The object can also be within a
@@ -531,6 +754,29 @@ private:
 	 */
 	THashList *FindGroup(const char *dirname) const;
 
+	/**
+	 * Find a histogram for a handle. Fatal if the histogram or its parent group does not exist.
+	 * @param[in] name Path of the histogram
+	 * @param[in] method Calling method, for the error message
+	 * @return the histogram
+	 */
+	TObject *FindHistogramForHandle(const char *name, const char *method) const;
+
+	/**
+	 * Get the fill buffer for a histogram, creating it if needed. Only in buffered
+	 * fill mode and for histograms of the given dimension which are not profiles.
+	 * @param[in] hist Histogram to be filled via the buffer
+	 * @param[in] ndim Number of coordinates of the fills
+	 * @return the fill buffer (NULL if the fills are not buffered)
+	 */
+	FillBuffer *GetFillBuffer(TH1 *hist, Int_t ndim) const;
+
+	/**
+	 * Add the buffered entries of a histogram before it is filled directly
+	 * @param[in] hist Histogram
+	 */
+	void FlushFillBuffer(const TObject *hist) const;
+
 	/**
 	 * Helper function extracting the basename from a given histogram path.
 	 * @param[in] path histogram path
@@ -547,6 +793,8 @@ private:
 
 	THashList *fHistos;                   ///< List of histograms
 	bool fIsOwner;                        ///< Set the ownership
+	Int_t fFillBufferSize;                //!<! Buffer size for handles in buffered fill mode (0: no buffering)
+	TList *fFillBuffers;                  //!<! Fill buffers of the histograms in buffered fill mode
 
   /// \cond CLASSIMP
 	ClassDef(THistManager, 1);  // Container for histograms
@@ -671,6 +919,45 @@ public:
    * @return 0 if test is passed, 1 if it failed
    */
   int TestFillGroupedHistograms();
+
+  /**
+   * Purpose of the test: Check whether fills through handles give the same result as the
+   * string-based fills
+   * Relies on: TestFillGroupedHistograms
+   *
+   * Creating histograms of all types in groups, and filling each 100 times via the handle
+   *
+   * Test passed:
+   * - All handles are valid and point to the histograms in the groups
+   * - All histograms have the expected value (100 for histograms, 1 for profile)
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillHandles();
+
+  /**
+   * Purpose of the test: Check whether the bin-width weight options give the same result
+   * in the string-based fills and in the handles
+   *
+   * Filling the same entries with options "w", "wx", "wxwywz" and "w0w2" via the name
+   * in one manager and via handles in another one
+   *
+   * Test passed:
+   * - Bin contents of all 2D, 3D and sparse histograms are identical
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillWeightOptions();
+
+  /**
+   * Test filling histograms through handles in buffered fill mode
+   *
+   * Filling the same random entries (in- and outside the histogram range, with
+   * different weights) into 1D, 2D and 3D histograms with and without buffering
+   *
+   * Test passed:
+   * - Bin contents, bin errors, number of entries and statistics are identical
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestFillBuffered();
 };
 
 /**
@@ -708,5 +995,34 @@ int TestRunFillSimple();
  */
 int TestRunFillGrouped();
 
+/**
+ * Run the test for filling histograms through handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillHandles();
+
+/**
+ * Run the test for buffered fills through handles. See @ref THistManagerTestSuite
+ * for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillBuffered();
+
+/**
+ * Run the test for the weight options of string-based fills and handles. See
+ * @ref THistManagerTestSuite for details.
+ * @return 0 if test is passed, 1 if failed
+ */
+int TestRunFillWeightOptions();
+
+/**
+ * Compare the time needed to fill histograms via their name, via handles and via
+ * handles in buffered fill mode, for histograms in a group hierarchy of typical
+ * depth. Prints the time per fill.
+ * @param[in] nfills Number of fills per histogram type
+ */
+void BenchmarkFillHandles(int nfills = 1000000);
+
 }
 #endif
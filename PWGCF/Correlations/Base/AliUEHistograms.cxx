@@ -35,6 +35,11 @@
 #include "TH3F.h"
 #include "TMath.h"
 #include "TLorentzVector.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TArrayI.h"
+#include "TArrayS.h"
 
 ClassImp(AliUEHistograms)
 
@@ -546,6 +551,12 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   //
   // if mixed is non-0, mixed events are filled, the trigger particle is from particles, the associated from mixed
   // if weight < 0, then the pt of the associated particle is filled as weight
+  //
+  // the kinematics of the input is unpacked once per call into contiguous arrays (see UnpackParticles).
+  // For each trigger particle the cheap pair cuts (pT ordering, charge, eta ordering, resonance daughters) are 
+  // evaluated in one tight loop over these arrays, which produces the list of candidate associated particles.
+  // The expensive cuts (conversions, resonances, two-track efficiency) and the filling are then only done 
+  // for these candidates, in the same order as before, such that the filled histograms are unchanged.
   
   Bool_t fillpT = kFALSE;
   if (weight < 0)
@@ -563,31 +574,51 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
     TH1::AddDirectory(oldStatus);
   }
 
-  // Eta() is extremely time consuming, therefore cache it for the inner loop here:
+  // Pt(), Eta(), Phi() and Charge() are virtual and Eta() is extremely time consuming, therefore cache them for the pair loops here:
   TObjArray* input = (mixed) ? mixed : particles;
-  TArrayF eta(input->GetEntriesFast());
-  for (Int_t i=0; i<input->GetEntriesFast(); i++)
-    eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
+  Int_t nInput = input->GetEntriesFast();
+  TArrayD pt(nInput);
+  TArrayF eta(nInput);
+  TArrayD phi(nInput);
+  TArrayS charge(nInput);
+  UnpackParticles(input, pt, eta, phi, charge);
   
   // if particles is not set, just fill event statistics
   if (particles)
   {
-    Int_t jMax = particles->GetEntriesFast();
+    Int_t iMax = particles->GetEntriesFast();
+    Int_t jMax = iMax;
     if (mixed)
       jMax = mixed->GetEntriesFast();
     
+    // trigger particles: same arrays as the associated ones unless mixing
+    TArrayD triggerPtArr;
+    TArrayF triggerEtaArr;
+    TArrayD triggerPhiArr;
+    TArrayS triggerChargeArr;
+    if (mixed)
+    {
+      triggerPtArr.Set(iMax);
+      triggerEtaArr.Set(iMax);
+      triggerPhiArr.Set(iMax);
+      triggerChargeArr.Set(iMax);
+      UnpackParticles(particles, triggerPtArr, triggerEtaArr, triggerPhiArr, triggerChargeArr);
+    }
+    const Double_t* triggerPt = (mixed) ? triggerPtArr.GetArray() : pt.GetArray();
+    const Float_t* triggerEtaV = (mixed) ? triggerEtaArr.GetArray() : eta.GetArray();
+    const Double_t* triggerPhi = (mixed) ? triggerPhiArr.GetArray() : phi.GetArray();
+    const Short_t* triggerCharge = (mixed) ? triggerChargeArr.GetArray() : charge.GetArray();
+    
     TH1* triggerWeighting = 0;
     if (fWeightPerEvent)
     {
       TAxis* axis = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->GetGrid(0)->GetGrid()->GetAxis(2);
       triggerWeighting = new TH1F("triggerWeighting", "", axis->GetNbins(), axis->GetXbins()->GetArray());
     
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+      for (Int_t i=0; i<iMax; i++)
       {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-	
 	// some optimization
-	Float_t triggerEta = triggerParticle->Eta();
+	Float_t triggerEta = triggerEtaV[i];
 
 	if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	  continue;
@@ -599,16 +630,20 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	if (fTriggerSelectCharge != 0)
-	  if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	  if (triggerCharge[i] * fTriggerSelectCharge < 0)
 	    continue;
 	
-	triggerWeighting->Fill(triggerParticle->Pt());
+	triggerWeighting->Fill(triggerPt[i]);
       }
     }
     
     // identify K, Lambda candidates and flag those particles
-    // a TObject bit is used for this
+    // a TObject bit is used for this (needed in case subsets of the same event are mixed), which is then copied to the flag arrays below
     const UInt_t kResonanceDaughterFlag = 1 << 14;
+    TArrayC flagged(jMax);
+    TArrayC triggerFlaggedArr;
+    if (mixed)
+      triggerFlaggedArr.Set(iMax);
     if (fRejectResonanceDaughters > 0)
     {
       Double_t resonanceMass = -1;
@@ -624,39 +659,35 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	default: AliFatal(Form("Invalid setting %d", fRejectResonanceDaughters));
       }
 
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+      for (Int_t i=0; i<iMax; i++)
 	particles->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
       if (mixed)
 	for (Int_t i=0; i<jMax; i++)
 	  mixed->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
       
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+      for (Int_t i=0; i<iMax; i++)
       {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+	TObject* triggerParticle = particles->UncheckedAt(i);
 	
 	for (Int_t j=0; j<jMax; j++)
 	{
 	  if (!mixed && i == j)
 	    continue;
 	
-	  AliVParticle* particle = 0;
-	  if (!mixed)
-	    particle = (AliVParticle*) particles->UncheckedAt(j);
-	  else
-	    particle = (AliVParticle*) mixed->UncheckedAt(j);
+	  if (triggerCharge[i] * charge[j] > 0)
+	    continue;
+      
+	  TObject* particle = input->UncheckedAt(j);
 	  
 	  // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
 	  if (mixed && triggerParticle->IsEqual(particle))
 	    continue;
 	 
-	  if (triggerParticle->Charge() * particle->Charge() > 0)
-	    continue;
-      
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt[i], triggerEtaV[i], triggerPhi[i], pt[j], eta[j], phi[j], massDaughter1, massDaughter2);
 	      
 	  if (TMath::Abs(mass - resonanceMass*resonanceMass) < interval*5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
+	    mass = GetInvMassSquared(triggerPt[i], triggerEtaV[i], triggerPhi[i], pt[j], eta[j], phi[j], massDaughter1, massDaughter2);
 
 	    if (mass > (resonanceMass-interval)*(resonanceMass-interval) && mass < (resonanceMass+interval)*(resonanceMass+interval))
 	    {
@@ -668,14 +699,22 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	}
       }
+      
+      for (Int_t j=0; j<jMax; j++)
+	flagged[j] = input->UncheckedAt(j)->TestBit(kResonanceDaughterFlag);
+      if (mixed)
+	for (Int_t i=0; i<iMax; i++)
+	  triggerFlaggedArr[i] = particles->UncheckedAt(i)->TestBit(kResonanceDaughterFlag);
     }
+    const Char_t* triggerFlagged = (mixed) ? triggerFlaggedArr.GetArray() : flagged.GetArray();
+    
+    // indices of the associated particles which pass the cheap cuts for the current trigger particle
+    TArrayI candidates(jMax);
     
-    for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+    for (Int_t i=0; i<iMax; i++)
     {
-      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-      
       // some optimization
-      Float_t triggerEta = triggerParticle->Eta();
+      Float_t triggerEta = triggerEtaV[i];
       
       if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	continue;
@@ -687,73 +726,71 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
       
       if (fTriggerSelectCharge != 0)
-	if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	if (triggerCharge[i] * fTriggerSelectCharge < 0)
 	  continue;
 	
       if (fRejectResonanceDaughters > 0)
-	if (triggerParticle->TestBit(kResonanceDaughterFlag))
+	if (triggerFlagged[i])
 	{
 // 	  Printf("Skipped i=%d", i);
 	  continue;
 	}
 	
+      const Double_t pt1 = triggerPt[i];
+      const Short_t charge1 = triggerCharge[i];
+      
+      // cheap cuts, batched over all associated particles
+      Int_t nCandidates = 0;
       for (Int_t j=0; j<jMax; j++)
       {
-        if (!mixed && i == j)
-          continue;
+	Bool_t accept = kTRUE;
+	
+	if (!mixed && i == j)
+	  accept = kFALSE;
+	
+	if (fPtOrder && pt[j] >= pt1)
+	  accept = kFALSE;
+	
+	if (fAssociatedSelectCharge != 0 && charge[j] * fAssociatedSelectCharge < 0)
+	  accept = kFALSE;
+
+	// skip like sign
+	if (fSelectCharge == 1 && charge[j] * charge1 > 0)
+	  accept = kFALSE;
+	
+	// skip unlike sign
+	if (fSelectCharge == 2 && charge[j] * charge1 < 0)
+	  accept = kFALSE;
+	
+	// eta ordering
+	if (fEtaOrdering && ((triggerEta < 0 && eta[j] < triggerEta) || (triggerEta > 0 && eta[j] > triggerEta)))
+	  accept = kFALSE;
+
+	if (fRejectResonanceDaughters > 0 && flagged[j])
+	  accept = kFALSE;
+	
+	candidates[nCandidates] = j;
+	nCandidates += accept;
+      }
       
-        AliVParticle* particle = 0;
-        if (!mixed)
-          particle = (AliVParticle*) particles->UncheckedAt(j);
-        else
-          particle = (AliVParticle*) mixed->UncheckedAt(j);
-        
+      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+      
+      for (Int_t k=0; k<nCandidates; k++)
+      {
+	Int_t j = candidates[k];
+	
         // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
-        if (mixed && triggerParticle->IsEqual(particle))
+        if (mixed && triggerParticle->IsEqual(mixed->UncheckedAt(j)))
           continue;
         
-        if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
-	    continue;
-	
-	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
-	    continue;
-
-        if (fSelectCharge > 0)
-        {
-          // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
-            continue;
-            
-          // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
-            continue;
-        }
-        
-	if (fEtaOrdering)
-	{
-	  if (triggerEta < 0 && eta[j] < triggerEta)
-	    continue;
-	  if (triggerEta > 0 && eta[j] > triggerEta)
-	    continue;
-	}
-
-	if (fRejectResonanceDaughters > 0)
-	  if (particle->TestBit(kResonanceDaughterFlag))
-	  {
-// 	    Printf("Skipped j=%d", j);
-	    continue;
-	  }
-
 	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutConversionsV > 0 && charge[j] * charge1 < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	  Float_t mass = GetInvMassSquaredCheap(pt1, triggerEta, triggerPhi[i], pt[j], eta[j], phi[j], 0.510e-3, 0.510e-3);
 	  
 	  if (mass < fCutConversionsV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	    mass = GetInvMassSquared(pt1, triggerEta, triggerPhi[i], pt[j], eta[j], phi[j], 0.510e-3, 0.510e-3);
 	    
 	    fControlConvResoncances->Fill(0.0, mass);
 
@@ -763,15 +800,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// K0s
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && charge[j] * charge1 < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	  Float_t mass = GetInvMassSquaredCheap(pt1, triggerEta, triggerPhi[i], pt[j], eta[j], phi[j], 0.1396, 0.1396);
 	  
 	  const Float_t kK0smass = 0.4976;
 	  
 	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutResonancesV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	    mass = GetInvMassSquared(pt1, triggerEta, triggerPhi[i], pt[j], eta[j], phi[j], 0.1396, 0.1396);
 	    
 	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
 
@@ -781,16 +818,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// Lambda
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && charge[j] * charge1 < 0)
 	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	  Float_t mass1 = GetInvMassSquaredCheap(pt1, triggerEta, triggerPhi[i], pt[j], eta[j], phi[j], 0.1396, 0.9383);
+	  Float_t mass2 = GetInvMassSquaredCheap(pt1, triggerEta, triggerPhi[i], pt[j], eta[j], phi[j], 0.9383, 0.1396);
 	  
 	  const Float_t kLambdaMass = 1.115;
 
 	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
+	    mass1 = GetInvMassSquared(pt1, triggerEta, triggerPhi[i], pt[j], eta[j], phi[j], 0.1396, 0.9383);
 
 	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
 	    
@@ -799,7 +836,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	    mass2 = GetInvMassSquared(pt1, triggerEta, triggerPhi[i], pt[j], eta[j], phi[j], 0.9383, 0.1396);
 
 	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
 
@@ -813,22 +850,22 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
-	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
-	      
 	  Float_t deta = triggerEta - eta[j];
 	      
 	  // optimization
 	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
 	  {
+	    Float_t phi1f = triggerPhi[i];
+	    Float_t pt1f = pt1;
+	    Float_t charge1f = charge1;
+	    
+	    Float_t phi2f = phi[j];
+	    Float_t pt2f = pt[j];
+	    Float_t charge2f = charge[j];
+	      
 	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
+	    Float_t dphistar1 = GetDPhiStar(phi1f, pt1f, charge1f, phi2f, pt2f, charge2f, fTwoTrackCutMinRadius, bSign);
+	    Float_t dphistar2 = GetDPhiStar(phi1f, pt1f, charge1f, phi2f, pt2f, charge2f, 2.5, bSign);
 	    
 	    const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
 
@@ -838,7 +875,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	    {
 	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
 	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
+		Float_t dphistar = GetDPhiStar(phi1f, pt1f, charge1f, phi2f, pt2f, charge2f, rad, bSign);
 
 		Float_t dphistarabs = TMath::Abs(dphistar);
 		
@@ -849,25 +886,25 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 		}
 	      }
 	      
-	      fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+	      fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1f - pt2f));
 	      
 	      if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
 	      {
-// 		Printf("Removed track pair %d %d with %f %f %f %f %f %f %f %f %f", i, j, deta, dphistarminabs, phi1, pt1, charge1, phi2, pt2, charge2, bSign);
+// 		Printf("Removed track pair %d %d with %f %f %f %f %f %f %f %f %f", i, j, deta, dphistarminabs, phi1f, pt1f, charge1f, phi2f, pt2f, charge2f, bSign);
 		continue;
 	      }
 
-    	      fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+    	      fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1f - pt2f));
 	    }
 	  }
 	}
         
         Double_t vars[6];
         vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
+        vars[1] = pt[j];
+        vars[2] = pt1;
         vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
+        vars[4] = triggerPhi[i] - phi[j];
         if (vars[4] > 1.5 * TMath::Pi()) 
           vars[4] -= TMath::TwoPi();
         if (vars[4] < -0.5 * TMath::Pi())
@@ -875,7 +912,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	vars[5] = zVtx;
 	
 	if (fillpT)
-	  weight = particle->Pt();
+	  weight = pt[j];
 	
 	Double_t useWeight = weight;
 	if (applyEfficiency)
@@ -922,7 +959,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       {
         // once per trigger particle
         Double_t vars[3];
-        vars[0] = triggerParticle->Pt();
+        vars[0] = pt1;
         vars[1] = centrality;
 	vars[2] = zVtx;
 
@@ -939,8 +976,8 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
 	}
 
-	if (TMath::Abs(triggerEta) < 0.8 && triggerParticle->Pt() > 0)
-	  fInvYield2->Fill(centrality, triggerParticle->Pt(), useWeight / triggerParticle->Pt());
+	if (TMath::Abs(triggerEta) < 0.8 && pt1 > 0)
+	  fInvYield2->Fill(centrality, pt1, useWeight / pt1);
 
 	if (fWeightPerEvent)
 	{
@@ -953,10 +990,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
         fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
 
 	// QA
-        fCorrelationpT->Fill(centrality, triggerParticle->Pt());
+        fCorrelationpT->Fill(centrality, pt1);
         fCorrelationEta->Fill(centrality, triggerEta);
-        fCorrelationPhi->Fill(centrality, triggerParticle->Phi());
-	fYields->Fill(centrality, triggerParticle->Pt(), triggerEta);
+        fCorrelationPhi->Fill(centrality, triggerPhi[i]);
+	fYields->Fill(centrality, pt1, triggerEta);
 	
 /*        if (dynamic_cast<AliAODTrack*>(triggerParticle))
           fITSClusterMap->Fill(((AliAODTrack*) triggerParticle)->GetITSClusterMap(), centrality, triggerParticle->Pt());*/
@@ -974,6 +1011,22 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   fCentralityCorrelation->Fill(centrality, particles->GetEntriesFast());
   FillEvent(centrality, step);
 }
+
+//____________________________________________________________________
+void AliUEHistograms::UnpackParticles(TObjArray* list, TArrayD& pt, TArrayF& eta, TArrayD& phi, TArrayS& charge)
+{
+  // copies the kinematics of the particles in list into contiguous arrays (which need to have the size of list)
+  // this avoids the virtual function calls (and the expensive Eta()) in the pair loops
+  
+  for (Int_t i=0; i<list->GetEntriesFast(); i++)
+  {
+    AliVParticle* particle = (AliVParticle*) list->UncheckedAt(i);
+    pt[i] = particle->Pt();
+    eta[i] = particle->Eta();
+    phi[i] = particle->Phi();
+    charge[i] = particle->Charge();
+  }
+}
   
 //____________________________________________________________________
 void AliUEHistograms::FillTrackingEfficiency(TObjArray* mc, TObjArray* recoPrim, TObjArray* recoAll, TObjArray* recoPrimPID, TObjArray* recoAllPID, TObjArray* fake, Int_t particleType, Double_t centrality, Double_t zVtx)
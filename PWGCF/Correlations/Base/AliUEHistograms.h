@@ -18,6 +18,9 @@ class AliVParticle;
 class TList;
 class TSeqCollection;
 class TObjArray;
+class TArrayD;
+class TArrayF;
+class TArrayS;
 class TH1F;
 class TH2F;
 class TH3F;
@@ -108,6 +111,7 @@ class AliUEHistograms : public TNamed
 protected:
   void FillRegion(AliUEHist::Region region, Float_t zVtx, AliUEHist::CFStep step, AliVParticle* leading, TList* list, Int_t multiplicity);
   Int_t CountParticles(TList* list, Float_t ptMin);
+  void UnpackParticles(TObjArray* list, TArrayD& pt, TArrayF& eta, TArrayD& phi, TArrayS& charge);
   void DeleteContainers();
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
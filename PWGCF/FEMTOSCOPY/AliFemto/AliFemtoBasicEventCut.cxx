@@ -5,6 +5,8 @@
 #include "AliFemtoBasicEventCut.h"
 #include "TObjString.h"
 
+#include <typeinfo>
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
   ClassImp(AliFemtoBasicEventCut);
@@ -83,6 +85,32 @@ bool AliFemtoBasicEventCut::Pass(const AliFemtoEvent* event)
 
   return goodEvent;
 }
+
+bool AliFemtoBasicEventCut::IsEquivalent(const AliFemtoEventCut* cut) const
+{
+  if (cut == this) {
+    return true;
+  }
+
+  // a subclass may cut on more than what is compared here
+  if (typeid(*this) != typeid(AliFemtoBasicEventCut)
+      || cut == NULL
+      || typeid(*cut) != typeid(AliFemtoBasicEventCut)) {
+    return false;
+  }
+
+  const AliFemtoBasicEventCut *c = static_cast<const AliFemtoBasicEventCut*>(cut);
+  return fEventMult[0] == c->fEventMult[0]
+      && fEventMult[1] == c->fEventMult[1]
+      && fVertZPos[0] == c->fVertZPos[0]
+      && fVertZPos[1] == c->fVertZPos[1]
+      && fPsiEP[0] == c->fPsiEP[0]
+      && fPsiEP[1] == c->fPsiEP[1]
+      && fAcceptBadVertex == c->fAcceptBadVertex
+      && fAcceptOnlyPhysics == c->fAcceptOnlyPhysics
+      && fSelectTrigger == c->fSelectTrigger;
+}
+
 TList* AliFemtoBasicEventCut::AppendSettings(TList *settings,
                                              const TString &prefix) const
 {
@@ -35,6 +35,7 @@ public:
   virtual TList* AppendSettings(TList*, const TString& prefix="") const;
   virtual AliFemtoString Report();
   virtual bool Pass(const AliFemtoEvent* event);
+  virtual bool IsEquivalent(const AliFemtoEventCut* cut) const;
 
   AliFemtoBasicEventCut* Clone();
 
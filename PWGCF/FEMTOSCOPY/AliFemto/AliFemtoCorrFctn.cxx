@@ -7,6 +7,20 @@
 void AliFemtoCorrFctn::AddRealPair(AliFemtoPair*) { cout << "Not implemented" << endl; }
 void AliFemtoCorrFctn::AddMixedPair(AliFemtoPair*) { cout << "Not implemented" << endl; }
 
+void AliFemtoCorrFctn::AddRealPairs(AliFemtoPairBlock* aBlock)
+{
+  for (int i = 0; i < aBlock->Size(); i++) {
+    if (aBlock->Passed(i)) AddRealPair(aBlock->Pair(i));
+  }
+}
+
+void AliFemtoCorrFctn::AddMixedPairs(AliFemtoPairBlock* aBlock)
+{
+  for (int i = 0; i < aBlock->Size(); i++) {
+    if (aBlock->Passed(i)) AddMixedPair(aBlock->Pair(i));
+  }
+}
+
 AliFemtoCorrFctn::AliFemtoCorrFctn(const AliFemtoCorrFctn& /* c */):fyAnalysis(0),fPairCut(0x0) {}
 AliFemtoCorrFctn::AliFemtoCorrFctn(): fyAnalysis(0),fPairCut(0x0) {/* no-op */}
 void AliFemtoCorrFctn::SetAnalysis(AliFemtoAnalysis* analysis) { fyAnalysis = analysis; }
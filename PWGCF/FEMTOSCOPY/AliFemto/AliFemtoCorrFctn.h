@@ -9,6 +9,7 @@
 #include "AliFemtoEvent.h"
 #include "AliFemtoPair.h"
 #include "AliFemtoPairCut.h"
+#include "AliFemtoPairBlock.h"
 
 class AliFemtoCorrFctn{
 
@@ -25,6 +26,12 @@ public:
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPir);
 
+  /// Add all pairs of the block which passed the pair cut. The defaults
+  /// call AddRealPair/AddMixedPair for each of them, correlation functions
+  /// may override them to fill from the precomputed kinematics arrays.
+  virtual void AddRealPairs(AliFemtoPairBlock* aBlock);
+  virtual void AddMixedPairs(AliFemtoPairBlock* aBlock);
+
   virtual void EventBegin(const AliFemtoEvent* aEvent);
   virtual void EventEnd(const AliFemtoEvent* aEvent);
   virtual void Finish() = 0;
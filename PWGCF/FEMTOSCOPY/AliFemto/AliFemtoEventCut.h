@@ -66,6 +66,14 @@ public:
   virtual AliFemtoString Report() = 0; ///< A user-written method to return a string describing cuts
   virtual AliFemtoEventCut* Clone();   ///< Returns NULL - users should overload.
 
+  /// True if this cut is known to accept exactly the events  cut accepts
+  ///
+  /// Analyses only share particle collections if their cuts are equivalent
+  /// (see AliFemtoSimpleAnalysis::HasEquivalentCuts). The default only
+  /// recognises the cut itself; overloads must compare every setting which
+  /// affects Pass().
+  virtual bool IsEquivalent(const AliFemtoEventCut* cut) const;
+
   /// Returns the analysis this cut belongs to
   AliFemtoAnalysis* HbtAnalysis();
 
@@ -124,6 +132,11 @@ inline AliFemtoEventCut* AliFemtoEventCut::Clone()
   return NULL;
 }
 
+inline bool AliFemtoEventCut::IsEquivalent(const AliFemtoEventCut* cut) const
+{
+  return cut == this;
+}
+
 inline TList* AliFemtoEventCut::ListSettings() const
 {
   return AppendSettings(new TList());
@@ -153,16 +153,36 @@ void AliFemtoKTPairCut::SetPTMin(double ptmin, double ptmax)
 //______________________________________________________
 bool AliFemtoKTPairCut::Pass(const AliFemtoPair* pair)
 {
-  bool temp = true;
-
 //Taking care of the Kt cut
   if (pair->KT() < fKTMin)
-    temp = false;
+    return false;
 
   if (pair->KT() > fKTMax)
-    temp = false;
+    return false;
+
+  return PassPtAndPhi(pair);
+}
+
+//______________________________________________________
+void AliFemtoKTPairCut::PassBlock(AliFemtoPairBlock* block)
+{
+  // Same as Pass() for every pair of the block, with kT taken from the
+  // precomputed array of the block
+  for (int i = 0; i < block->Size(); i++) {
+    const double kT = block->KT(i);
+    if ((kT < fKTMin) || (kT > fKTMax)) {
+      block->SetPassed(i, false);
+      continue;
+    }
+    block->SetPassed(i, PassPtAndPhi(block->Pair(i)));
+  }
+}
 
-  if (!temp) return temp;
+//______________________________________________________
+bool AliFemtoKTPairCut::PassPtAndPhi(const AliFemtoPair* pair) const
+{
+  // The single-particle pT and the reaction plane cuts
+  bool temp = true;
 
   if ((fPtMin > 0.0) || (fPtMax<1000.0)) {
 //     double px1 = pair->Track1()->Track()->P().x();
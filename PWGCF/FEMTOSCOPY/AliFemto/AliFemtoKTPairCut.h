@@ -45,8 +45,11 @@ public:
   void SetPTMin(double ptmin, double ptmax=1000.0);
   virtual bool Pass(const AliFemtoPair* pair);
   virtual bool Pass(const AliFemtoPair* pair, double aRPAngle);
+  virtual void PassBlock(AliFemtoPairBlock* block);
 
  protected:
+  bool PassPtAndPhi(const AliFemtoPair* pair) const;
+
   Double_t fKTMin;          // Minimum allowed pair transverse momentum
   Double_t fKTMax;          // Maximum allowed pair transverse momentum 
   Double_t fPhiMin;         // Minimum angle vs. reaction plane 
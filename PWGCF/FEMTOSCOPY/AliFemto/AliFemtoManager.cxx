@@ -8,10 +8,14 @@
 ///////////////////////////////////////////////////////////////////////////
 
 #include "AliFemtoManager.h"
+#include "AliFemtoSimpleAnalysis.h"
 //#include "AliFemtoParticleCollection.h"
 //#include "AliFemtoTrackCut.h"
 //#include "AliFemtoV0Cut.h"
 #include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -25,7 +29,9 @@
 AliFemtoManager::AliFemtoManager():
   fAnalysisCollection(NULL),
   fEventReader(NULL),
-  fEventWriterCollection(NULL)
+  fEventWriterCollection(NULL),
+  fShareParticleCollections(false),
+  fSharedCollectionsConfigured(false)
 {
   // default constructor
   fAnalysisCollection = new AliFemtoAnalysisCollection;
@@ -35,7 +41,9 @@ AliFemtoManager::AliFemtoManager():
 AliFemtoManager::AliFemtoManager(const AliFemtoManager& aManager):
   fAnalysisCollection(new AliFemtoAnalysisCollection),
   fEventReader(aManager.fEventReader),
-  fEventWriterCollection(new AliFemtoEventWriterCollection)
+  fEventWriterCollection(new AliFemtoEventWriterCollection),
+  fShareParticleCollections(aManager.fShareParticleCollections),
+  fSharedCollectionsConfigured(false)
 {
   // copy constructor
   AliFemtoSimpleAnalysisIterator tAnalysisIter;
@@ -75,6 +83,8 @@ AliFemtoManager& AliFemtoManager::operator=(const AliFemtoManager& aManager)
   }
 
   fEventReader = aManager.fEventReader;
+  fShareParticleCollections = aManager.fShareParticleCollections;
+  fSharedCollectionsConfigured = false;
   AliFemtoSimpleAnalysisIterator tAnalysisIter;
   if (fAnalysisCollection) {
     for (tAnalysisIter=fAnalysisCollection->begin();tAnalysisIter!=fAnalysisCollection->end();tAnalysisIter++){
@@ -241,6 +251,10 @@ int AliFemtoManager::ProcessEvent()
     (*tEventWriterIter)->WriteHbtEvent(currentHbtEvent);
   }
 
+  if (fShareParticleCollections && !fSharedCollectionsConfigured) {
+    ConfigureSharedCollections();
+  }
+
   // loop over all the Analysis
   AliFemtoSimpleAnalysisIterator tAnalysisIter;
   for (tAnalysisIter=fAnalysisCollection->begin();tAnalysisIter!=fAnalysisCollection->end();tAnalysisIter++){
@@ -256,3 +270,55 @@ int AliFemtoManager::ProcessEvent()
 #endif
   return 0;    // 0 = "good return"
 }       // ProcessEvent
+//____________________________
+static bool HasCutMonitors(AliFemtoCutMonitorHandler* cut)
+{
+  return cut && !(cut->PassMonitorColl()->empty() && cut->FailMonitorColl()->empty());
+}
+//____________________________
+void AliFemtoManager::ConfigureSharedCollections()
+{
+  // Group the analyses by their shared-collection key and the equivalence
+  // of their cuts. The first analysis of each group builds the
+  // collections; it is processed first in every event since the
+  // collection is iterated in order.
+  std::map<std::string, std::vector<AliFemtoSimpleAnalysis*> > tSources;
+  int tNShared = 0;
+
+  AliFemtoSimpleAnalysisIterator tAnalysisIter;
+  for (tAnalysisIter=fAnalysisCollection->begin();tAnalysisIter!=fAnalysisCollection->end();tAnalysisIter++){
+    AliFemtoSimpleAnalysis* tAnalysis = dynamic_cast<AliFemtoSimpleAnalysis*>(*tAnalysisIter);
+    if (!tAnalysis) continue;
+
+    const TString tKey = tAnalysis->SharedCollectionKey();
+    if (tKey.IsNull()) continue;
+
+    std::vector<AliFemtoSimpleAnalysis*>& tCandidates = tSources[tKey.Data()];
+    AliFemtoSimpleAnalysis* tSource = NULL;
+    for (size_t i = 0; i < tCandidates.size() && !tSource; i++) {
+      if (tAnalysis->HasEquivalentCuts(tCandidates[i])) {
+        tSource = tCandidates[i];
+      }
+    }
+
+    if (!tSource) {
+      tCandidates.push_back(tAnalysis);
+      continue;
+    }
+
+    // the cut monitors of this analysis would stay empty
+    if (HasCutMonitors(tAnalysis->EventCut())
+        || HasCutMonitors(tAnalysis->FirstParticleCut())
+        || HasCutMonitors(tAnalysis->SecondParticleCut())) {
+      continue;
+    }
+
+    tAnalysis->SetSharedCollectionSource(tSource);
+    tNShared++;
+  }
+
+  cout << " AliFemtoManager::ConfigureSharedCollections() - " << tNShared
+       << " analyses share the particle collections of another analysis" << endl;
+
+  fSharedCollectionsConfigured = true;
+}
@@ -37,6 +37,15 @@
 /// EventWriters added to them, and is responsible for deleting them
 /// upon its own destruction.
 ///
+/// With SetShareParticleCollections(true) the manager groups analyses with
+/// equal AliFemtoSimpleAnalysis::SharedCollectionKey() and equivalent
+/// event and particle cuts (AliFemtoEventCut::IsEquivalent,
+/// AliFemtoParticleCut::IsEquivalent). Only the first
+/// analysis of a group applies the event and particle cuts and keeps a
+/// mixing buffer; the others make their pairs from its pico events. An
+/// analysis only joins a group if its own event and particle cuts have no
+/// cut monitors, as these would no longer be filled.
+///
 /// AliFemtoManager objects are not copyable, as the AliFemtoAnalysis
 /// objects they contain have no means of copying/cloning.
 /// Denying copyability by making the copy constructor and assignment
@@ -49,6 +58,11 @@ private:
   AliFemtoAnalysisCollection* fAnalysisCollection;       ///< Collection of analyzes
   AliFemtoEventReader*        fEventReader;              ///< Event reader
   AliFemtoEventWriterCollection* fEventWriterCollection; ///< Event writer collection
+  bool fShareParticleCollections;                        ///< Build identical particle collections only once
+  bool fSharedCollectionsConfigured;                     //!<! Analyses have been grouped
+
+  /// Point analyses with equivalent cuts to the first one of their group
+  void ConfigureSharedCollections();
 
 public:
   AliFemtoManager();
@@ -70,6 +84,11 @@ public:
   AliFemtoEventReader* EventReader();
   void SetEventReader(AliFemtoEventReader* r);
 
+  /// Let analyses with equivalent event & particle cuts share particle
+  /// collections and mixing buffers. Takes effect at the first event.
+  void SetShareParticleCollections(bool share);
+  bool ShareParticleCollections() const;
+
   /// Calls `Init()` on all owned EventWriters
   ///
   /// Returns 0 for success, 1 for failure.
@@ -99,4 +118,7 @@ inline void AliFemtoManager::SetEventWriter(AliFemtoEventWriter* writer){fEventW
 inline AliFemtoEventReader* AliFemtoManager::EventReader(){return fEventReader;}
 inline void AliFemtoManager::SetEventReader(AliFemtoEventReader* reader){fEventReader = reader;}
 
+inline void AliFemtoManager::SetShareParticleCollections(bool share){fShareParticleCollections = share;}
+inline bool AliFemtoManager::ShareParticleCollections() const{return fShareParticleCollections;}
+
 #endif
@@ -0,0 +1,68 @@
+///
+/// \file AliFemtoPairBlock.cxx
+///
+
+#include <cmath>
+#include "AliFemtoPairBlock.h"
+
+//_________________
+AliFemtoPairBlock::AliFemtoPairBlock(int capacity):
+  fCapacity(capacity > 0 ? capacity : 1),
+  fSize(0),
+  fKinematicsValid(false),
+  fPairs(NULL),
+  fPassed(NULL),
+  fQInv(NULL),
+  fKT(NULL)
+{
+  /// Allocate the pairs and the kinematics arrays once
+  fPairs = new AliFemtoPair[fCapacity];
+  fPassed = new bool[fCapacity];
+  fQInv = new double[fCapacity];
+  fKT = new double[fCapacity];
+}
+//_________________
+AliFemtoPairBlock::~AliFemtoPairBlock()
+{
+  delete [] fPairs;
+  delete [] fPassed;
+  delete [] fQInv;
+  delete [] fKT;
+}
+//_________________
+int AliFemtoPairBlock::NPassed() const
+{
+  int n = 0;
+  for (int i = 0; i < fSize; i++) {
+    if (fPassed[i]) n++;
+  }
+  return n;
+}
+//_________________
+void AliFemtoPairBlock::CalculateKinematics()
+{
+  /// Compute qinv and kT for all pairs in the block. The four-momenta are
+  /// read once per pair and the arithmetic is kept in the same order as in
+  /// AliFemtoPair, so the results are bit-identical to the per-pair methods.
+
+  for (int i = 0; i < fSize; i++) {
+    const AliFemtoLorentzVector& p1 = fPairs[i].Track1()->FourMomentum();
+    const AliFemtoLorentzVector& p2 = fPairs[i].Track2()->FourMomentum();
+
+    const double px1 = p1.px(), py1 = p1.py(), pz1 = p1.pz(), pE1 = p1.e();
+    const double px2 = p2.px(), py2 = p2.py(), pz2 = p2.pz(), pE2 = p2.e();
+
+    const double dx = px1 - px2, dy = py1 - py2, dz = pz1 - pz2, dt = pE1 - pE2;
+    const double xt = px1 + px2, yt = py1 + py2;
+
+    // AliFemtoPair::QInv
+    const double tDiffM2 = dt*dt - (dx*dx + dy*dy + dz*dz);
+    fQInv[i] = (tDiffM2 < 0) ? ::sqrt(-tDiffM2) : -::sqrt(tDiffM2);
+
+    // AliFemtoPair::KT
+    const double tPerp = ::sqrt(xt*xt + yt*yt);
+    fKT[i] = tPerp * .5;
+  }
+
+  fKinematicsValid = true;
+}
@@ -0,0 +1,92 @@
+///
+/// \file AliFemtoPairBlock.h
+///
+
+#ifndef ALIFEMTOPAIRBLOCK_H
+#define ALIFEMTOPAIRBLOCK_H
+
+#include "AliFemtoPair.h"
+
+///
+/// \class AliFemtoPairBlock
+/// \brief A fixed-size batch of reusable pairs with their kinematics in
+///        structure-of-arrays form
+///
+/// The block owns a preallocated array of AliFemtoPair objects which are
+/// refilled for every batch, so no pair is allocated in the pair loop.
+/// Once filled, qinv and kT of all pairs are computed in a single pass
+/// over flat arrays (see CalculateKinematics), which pair cuts (kT) and
+/// correlation functions (qinv) read through the index accessors instead
+/// of recomputing them pair by pair.
+///
+/// The pass mask is set by AliFemtoPairCut::PassBlock and consulted by
+/// AliFemtoCorrFctn::AddRealPairs / AddMixedPairs.
+///
+class AliFemtoPairBlock {
+public:
+  AliFemtoPairBlock(int capacity=1024);
+  virtual ~AliFemtoPairBlock();
+
+  int Capacity() const;
+  int Size() const;
+  bool IsFull() const;
+
+  /// Forget all pairs - the pair objects are kept for reuse
+  void Clear();
+
+  /// Append a pair; the caller must check IsFull() first
+  AliFemtoPair* AddPair(const AliFemtoParticle* track1, const AliFemtoParticle* track2);
+
+  AliFemtoPair* Pair(int i) const;
+
+  bool Passed(int i) const;
+  void SetPassed(int i, bool pass);
+  int NPassed() const;
+
+  /// Pair variables, identical to the corresponding AliFemtoPair
+  /// methods. Computed for the whole block on first access.
+  double QInv(int i);
+  double KT(int i);
+
+  /// Compute qinv and kT for the pairs in the block
+  void CalculateKinematics();
+
+private:
+  AliFemtoPairBlock(const AliFemtoPairBlock& aBlock);
+  AliFemtoPairBlock& operator=(const AliFemtoPairBlock& aBlock);
+
+  int fCapacity;              ///< number of preallocated pairs
+  int fSize;                  ///< number of pairs currently in the block
+  bool fKinematicsValid;      ///< kinematics arrays match the current pairs
+
+  AliFemtoPair* fPairs;       ///< [fCapacity] reusable pair objects
+  bool* fPassed;              ///< [fCapacity] pair cut decision
+
+  double* fQInv;              ///< [fCapacity]
+  double* fKT;                ///< [fCapacity]
+};
+
+inline int AliFemtoPairBlock::Capacity() const { return fCapacity; }
+inline int AliFemtoPairBlock::Size() const { return fSize; }
+inline bool AliFemtoPairBlock::IsFull() const { return fSize >= fCapacity; }
+inline void AliFemtoPairBlock::Clear() { fSize = 0; fKinematicsValid = false; }
+
+inline AliFemtoPair* AliFemtoPairBlock::AddPair(const AliFemtoParticle* track1, const AliFemtoParticle* track2)
+{
+  AliFemtoPair* pair = &fPairs[fSize];
+  pair->SetTrack1(track1);
+  pair->SetTrack2(track2);
+  fPassed[fSize] = false;
+  fSize++;
+  fKinematicsValid = false;
+  return pair;
+}
+
+inline AliFemtoPair* AliFemtoPairBlock::Pair(int i) const { return &fPairs[i]; }
+inline bool AliFemtoPairBlock::Passed(int i) const { return fPassed[i]; }
+inline void AliFemtoPairBlock::SetPassed(int i, bool pass) { fPassed[i] = pass; }
+
+inline double AliFemtoPairBlock::QInv(int i) { if (!fKinematicsValid) CalculateKinematics(); return fQInv[i]; }
+inline double AliFemtoPairBlock::KT(int i) { if (!fKinematicsValid) CalculateKinematics(); return fKT[i]; }
+
+#endif
@@ -17,6 +17,7 @@ class AliFemtoAnalysis;
 #include "AliFemtoString.h"
 #include "AliFemtoEvent.h"
 #include "AliFemtoPair.h"
+#include "AliFemtoPairBlock.h"
 #include "AliFemtoCutMonitorHandler.h"
 #include <TList.h>
 #include <TObjString.h>
@@ -38,6 +39,11 @@ public:
 
   virtual bool Pass(const AliFemtoPair* pair) = 0;  ///< true if pair passes, false if not
 
+  /// Set the pass mask of every pair in the block. The default calls
+  /// Pass() pair by pair; cuts on relative-momentum variables can
+  /// override it to use the precomputed arrays of the block.
+  virtual void PassBlock(AliFemtoPairBlock* block);
+
   virtual AliFemtoString Report() = 0;              ///< user-written method to return string describing cuts
   virtual TList *ListSettings() = 0;                ///< Return a TList of settings
 
@@ -66,6 +72,13 @@ inline AliFemtoPairCut::~AliFemtoPairCut(){ /* no-op */ }
 inline void AliFemtoPairCut::SetAnalysis(AliFemtoAnalysis* analysis) { fyAnalysis = analysis; }
 inline AliFemtoPairCut& AliFemtoPairCut::operator=(const AliFemtoPairCut &aCut) { if (this == &aCut) return *this; fyAnalysis = aCut.fyAnalysis; return *this; }
 
+inline void AliFemtoPairCut::PassBlock(AliFemtoPairBlock* block)
+{
+  for (int i = 0; i < block->Size(); i++) {
+    block->SetPassed(i, Pass(block->Pair(i)));
+  }
+}
+
 inline void AliFemtoPairCut::EventBegin(const AliFemtoEvent* /* aEvent */ ) { /* no-op */ }
 
 inline void AliFemtoPairCut::EventEnd(const AliFemtoEvent* /* aEvent */ ) { /* no-op */ }
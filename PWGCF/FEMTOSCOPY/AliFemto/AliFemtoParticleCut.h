@@ -38,6 +38,11 @@ public:
 
   virtual AliFemtoParticleCut* Clone() { return NULL; }
 
+  /// True if this cut is known to accept exactly the particles  cut
+  /// accepts. The default only recognises the cut itself; overloads must
+  /// compare every setting which affects Pass(), see AliFemtoEventCut.
+  virtual bool IsEquivalent(const AliFemtoParticleCut* cut) const { return cut == this; }
+
   virtual AliFemtoParticleType Type() = 0;    ///< Pure virtual function which returns the particle type
 
   /// The following allows "back-pointing" from the CorrFctn to the "parent" Analysis
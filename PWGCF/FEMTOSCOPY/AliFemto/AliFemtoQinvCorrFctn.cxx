@@ -253,6 +253,22 @@ void AliFemtoQinvCorrFctn::AddRealPair(AliFemtoPair* pair){
   //" " << pair->track1().FourMomentum() << " " << pair->track2().FourMomentum() << endl;
 }
 
+//____________________________
+void AliFemtoQinvCorrFctn::AddRealPairs(AliFemtoPairBlock* block){
+  // add a block of true pairs - the extra pair cut and the
+  // delta-eta delta-phi* histograms need the pair itself
+  if (fPairCut || fDetaDphiscal) {
+    AliFemtoCorrFctn::AddRealPairs(block);
+    return;
+  }
+
+  for (int i = 0; i < block->Size(); i++) {
+    if (!block->Passed(i)) continue;
+    fNumerator->Fill(fabs(block->QInv(i)));
+    fkTMonitor->Fill(block->KT(i));
+  }
+}
+
 //____________________________
 void AliFemtoQinvCorrFctn::AddMixedPair(AliFemtoPair* pair){
   // add mixed (background) pair
@@ -326,6 +342,20 @@ void AliFemtoQinvCorrFctn::AddMixedPair(AliFemtoPair* pair){
   }
 //_______________________________________________________________
 
+}
+//____________________________
+void AliFemtoQinvCorrFctn::AddMixedPairs(AliFemtoPairBlock* block){
+  // add a block of mixed (background) pairs
+  if (fPairCut || fDetaDphiscal || fPairKinematics) {
+    AliFemtoCorrFctn::AddMixedPairs(block);
+    return;
+  }
+
+  double weight = 1.0;
+  for (int i = 0; i < block->Size(); i++) {
+    if (!block->Passed(i)) continue;
+    fDenominator->Fill(fabs(block->QInv(i)),weight);
+  }
 }
 //____________________________
 void AliFemtoQinvCorrFctn::Write(){
@@ -67,6 +67,8 @@ public:
   virtual AliFemtoString Report();
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
+  virtual void AddRealPairs(AliFemtoPairBlock* aBlock);
+  virtual void AddMixedPairs(AliFemtoPairBlock* aBlock);
 
   virtual void Finish();
 
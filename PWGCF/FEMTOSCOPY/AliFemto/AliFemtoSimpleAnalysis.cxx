@@ -11,8 +11,10 @@
 #include "AliFemtoPicoEvent.h"
 
 #include <string>
+#include <cstring>
 #include <iostream>
 #include <iterator>
+#include <typeinfo>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -161,7 +163,13 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fPairBlock(NULL),
+  fSharedSource(NULL),
+  fPublishSharedEvent(kFALSE),
+  fSharedPicoEvent(NULL),
+  fSharedMixingBuffer(NULL),
+  fSharedRetiredEvent(NULL)
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -183,7 +191,13 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fPairBlock(NULL),
+  fSharedSource(NULL),
+  fPublishSharedEvent(kFALSE),
+  fSharedPicoEvent(NULL),
+  fSharedMixingBuffer(NULL),
+  fSharedRetiredEvent(NULL)
 {
   /// Copy constructor
 
@@ -294,6 +308,9 @@ AliFemtoSimpleAnalysis::~AliFemtoSimpleAnalysis()
     }
     delete fMixingBuffer;
   }
+
+  delete fPairBlock;
+  delete fSharedRetiredEvent;
 }
 //______________________
 AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAnalysis& aAna)
@@ -431,12 +448,23 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
   // We will get a new pico event; NULL now to prevent corr fctn access to old pico event
   fPicoEvent = NULL;
 
+  // nothing is published to analyses sharing our collections until accepted
+  if (fPublishSharedEvent) {
+    ClearSharedEvent();
+  }
+
   // increment number of events processed
   AddEventProcessed();
 
   // startup for EbyE
   EventBegin(hbtEvent);
 
+  // particles and mixing buffer come from an equivalent analysis
+  if (fSharedSource) {
+    ProcessSharedEvent(hbtEvent);
+    return;
+  }
+
   // event cut and event cut monitor
   bool tmpPassEvent = fEventCut->Pass(hbtEvent);
 
@@ -546,28 +574,172 @@ void AliFemtoSimpleAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
 
   //--------- If mixing buffer is full, delete oldest event ---------//
   if ( MixingBufferFull() ) {
-    delete MixingBuffer()->back();
+    // analyses sharing our buffer still have to mix with it in this event
+    if (fPublishSharedEvent) {
+      fSharedRetiredEvent = MixingBuffer()->back();
+    } else {
+      delete MixingBuffer()->back();
+    }
     MixingBuffer()->pop_back();
   }
 
   //-------- Add current event (fPicoEvent) to mixing buffer --------//
   MixingBuffer()->push_front(fPicoEvent);
 
+  if (fPublishSharedEvent) {
+    fSharedPicoEvent = fPicoEvent;
+    fSharedMixingBuffer = MixingBuffer();
+  }
+
   EventEnd(hbtEvent);  // cleanup for EbyE
   //cout << "AliFemtoSimpleAnalysis::ProcessEvent() - return to caller ... " << endl;
 }
 
+//_________________________
+void AliFemtoSimpleAnalysis::ProcessSharedEvent(const AliFemtoEvent* hbtEvent)
+{
+  /// Make real and mixed pairs from the pico event and mixing buffer of
+  /// fSharedSource. The source applied the (equivalent) event and particle
+  /// cuts and has already put the current event in front of its buffer.
+
+  AliFemtoPicoEvent *picoEvent = fSharedSource->fSharedPicoEvent;
+  AliFemtoPicoEventCollection *mixingBuffer = fSharedSource->fSharedMixingBuffer;
+
+  // the source rejected this event
+  if (picoEvent == NULL || mixingBuffer == NULL) {
+    EventEnd(hbtEvent);
+    return;
+  }
+
+  // not owned - the source deletes it when it leaves its mixing buffer
+  fPicoEvent = picoEvent;
+
+  AliFemtoParticleCollection *collection1 = fPicoEvent->FirstParticleCollection(),
+                             *collection2 = AnalyzeIdenticalParticles()
+                                          ? NULL
+                                          : fPicoEvent->SecondParticleCollection();
+
+  MakePairs("real", collection1, collection2, EnablePairMonitors());
+
+  // mix with the events the source mixed with: its buffer without the
+  // current event, plus the event it dropped to make room for it
+  for (AliFemtoPicoEventIterator tPicoEventIter = mixingBuffer->begin();
+                                 tPicoEventIter != mixingBuffer->end();
+                               ++tPicoEventIter) {
+    if (*tPicoEventIter != fPicoEvent) {
+      MakeMixedPairs(collection1, collection2, *tPicoEventIter);
+    }
+  }
+
+  if (fSharedSource->fSharedRetiredEvent) {
+    MakeMixedPairs(collection1, collection2, fSharedSource->fSharedRetiredEvent);
+  }
+
+  EventEnd(hbtEvent);
+}
+//_________________________
+void AliFemtoSimpleAnalysis::MakeMixedPairs(AliFemtoParticleCollection *collection1,
+                                            AliFemtoParticleCollection *collection2,
+                                            AliFemtoPicoEvent *storedEvent)
+{
+  // If identical - only mix the first particle collections
+  if (collection2 == NULL) {
+    MakePairs("mixed", collection1, storedEvent->FirstParticleCollection());
+
+  // If non-identical - mix both combinations of first and second particles
+  } else {
+    MakePairs("mixed", collection1, storedEvent->SecondParticleCollection());
+    MakePairs("mixed", storedEvent->FirstParticleCollection(), collection2);
+  }
+}
+//_________________________
+void AliFemtoSimpleAnalysis::SetSharedCollectionSource(AliFemtoSimpleAnalysis* source)
+{
+  fSharedSource = (source == this) ? NULL : source;
+  if (fSharedSource) {
+    fSharedSource->fPublishSharedEvent = kTRUE;
+  }
+}
+//_________________________
+void AliFemtoSimpleAnalysis::ClearSharedEvent()
+{
+  delete fSharedRetiredEvent;
+  fSharedRetiredEvent = NULL;
+  fSharedPicoEvent = NULL;
+  fSharedMixingBuffer = NULL;
+}
+//_________________________
+TString AliFemtoSimpleAnalysis::BuildSharedCollectionKey()
+{
+  if (!fEventCut || !fFirstParticleCut || !fSecondParticleCut) {
+    return "";
+  }
+
+  // The cut settings are compared by HasEquivalentCuts(), the key only
+  // holds the cut classes and the mixing parameters
+  TString key;
+  key += typeid(*fEventCut).name();
+  key += ";";
+  key += typeid(*fFirstParticleCut).name();
+  key += ";";
+  if (AnalyzeIdenticalParticles()) {
+    key += "identical;";
+  } else {
+    key += typeid(*fSecondParticleCut).name();
+    key += ";";
+  }
+
+  key += TString::Format("mix=%u;minsize=%u;v0shared=%d;",
+                         fNumEventsToMix,
+                         fMinSizePartCollection,
+                         (int) fPerformSharedDaughterCut);
+  return key;
+}
+//_________________________
+bool AliFemtoSimpleAnalysis::HasEquivalentCuts(const AliFemtoSimpleAnalysis* other) const
+{
+  if (!fEventCut || !fFirstParticleCut || !fSecondParticleCut
+      || !other->fEventCut || !other->fFirstParticleCut || !other->fSecondParticleCut) {
+    return false;
+  }
+
+  if (AnalyzeIdenticalParticles() != other->AnalyzeIdenticalParticles()) {
+    return false;
+  }
+
+  return fEventCut->IsEquivalent(other->fEventCut)
+      && fFirstParticleCut->IsEquivalent(other->fFirstParticleCut)
+      && (AnalyzeIdenticalParticles()
+          || fSecondParticleCut->IsEquivalent(other->fSecondParticleCut));
+}
+//_________________________
+TString AliFemtoSimpleAnalysis::SharedCollectionKey()
+{
+  if (typeid(*this) != typeid(AliFemtoSimpleAnalysis)) {
+    return "";
+  }
+  const TString key = BuildSharedCollectionKey();
+  return key.IsNull() ? key : TString("AliFemtoSimpleAnalysis:") + key;
+}
 //_________________________
 void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
                                        AliFemtoParticleCollection *partCollection1,
                                        AliFemtoParticleCollection *partCollection2,
                                        Bool_t enablePairMonitors)
 {
-/// Build pairs, check pair cuts, and call CFs' AddRealPair() or
-/// AddMixedPair() methods. If no second particle collection is
+/// Build pairs, check pair cuts, and call CFs' AddRealPairs() or
+/// AddMixedPairs() methods. If no second particle collection is
 /// specfied, make pairs within first particle collection.
+///
+/// Pairs are collected in the (reused) fPairBlock and handed to the pair
+/// cut and the correlation functions a block at a time.
 
-  const string type = typeIn;
+  // Resolve the pair type once, not for every pair and correlation function
+  const bool isReal = (strcmp(typeIn, "real") == 0);
+  if (!isReal && strcmp(typeIn, "mixed") != 0) {
+    cout << "Problem with pair type, type = " << typeIn << endl;
+    return;
+  }
 
   //  int swpart = ((long int) partCollection1) % 2;
 
@@ -594,12 +766,18 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
     tEndInnerLoop   = partCollection2->end();    //
   }
   else {                                         // One collection:
+    if (partCollection1->empty()) {
+      return;
+    }
     tEndOuterLoop--;                             //   Outer loop goes to next-to-last particle
     tEndInnerLoop = partCollection1->end() ;     //   Inner loop goes to last particle
   }
 
-  // Create the pair outside the loop - only allocate once
-  AliFemtoPair* tPair = new AliFemtoPair;
+  // The pairs are allocated once per analysis and reused
+  if (!fPairBlock) {
+    fPairBlock = new AliFemtoPairBlock();
+  }
+  fPairBlock->Clear();
 
   // Begin the outer loop
   for (AliFemtoParticleConstIterator tPartIter1 = tStartOuterLoop;
@@ -613,55 +791,62 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
       tStartInnerLoop++;
     }
 
-    // If we have two collections - set the first track
-    if (partCollection2 != NULL) {
-      tPair->SetTrack1(*tPartIter1);
-    }
-
     // Begin the inner loop
     for (AliFemtoParticleConstIterator tPartIter2 = tStartInnerLoop;
                                        tPartIter2 != tEndInnerLoop;
                                      ++tPartIter2) {
-      // If we have two collections - only set the second track
+      // If we have two collections - keep the order of the collections
       if (partCollection2 != NULL) {
-        tPair->SetTrack2(*tPartIter2);
+        fPairBlock->AddPair(*tPartIter1, *tPartIter2);
 
       // Swap between first and second particles to avoid biased ordering
       } else {
-        tPair->SetTrack1(swpart ? *tPartIter2 : *tPartIter1);
-        tPair->SetTrack2(swpart ? *tPartIter1 : *tPartIter2);
+        fPairBlock->AddPair(swpart ? *tPartIter2 : *tPartIter1,
+                            swpart ? *tPartIter1 : *tPartIter2);
         swpart = !swpart;
       }
 
-      // check if the pair passes the cut
-      bool tmpPassPair = fPairCut->Pass(tPair);
-
-      // This is a condition for speed reasons
-      if (enablePairMonitors) {
-        fPairCut->FillCutMonitor(tPair, tmpPassPair);
-      }
-
-      // If pair passes cut, loop over CF's and add pair to real/mixed
-      if (tmpPassPair) {
-        for (AliFemtoCorrFctnIterator tCorrFctnIter = fCorrFctnCollection->begin();
-                                      tCorrFctnIter != fCorrFctnCollection->end();
-                                    ++tCorrFctnIter) {
-
-          AliFemtoCorrFctn* tCorrFctn = *tCorrFctnIter;
-
-          if (type == "real")
-            tCorrFctn->AddRealPair(tPair);
-          else if(type == "mixed")
-            tCorrFctn->AddMixedPair(tPair);
-          else
-            cout << "Problem with pair type, type = " << type << endl;
-        } // loop over corellatoin functions
+      if (fPairBlock->IsFull()) {
+        ProcessPairBlock(isReal, enablePairMonitors);
       }
     }    // loop over second particle
   }      // loop over first particle
 
-  // we are done with the pair
-  delete tPair;
+  ProcessPairBlock(isReal, enablePairMonitors);
+}
+//_________________________
+void AliFemtoSimpleAnalysis::ProcessPairBlock(bool isReal, Bool_t enablePairMonitors)
+{
+  /// Apply the pair cut to the pairs collected in fPairBlock, pass the
+  /// surviving ones to the correlation functions and empty the block.
+
+  if (fPairBlock->Size() == 0) {
+    return;
+  }
+
+  fPairCut->PassBlock(fPairBlock);
+
+  // This is a condition for speed reasons
+  if (enablePairMonitors) {
+    for (int i = 0; i < fPairBlock->Size(); i++) {
+      fPairCut->FillCutMonitor(fPairBlock->Pair(i), fPairBlock->Passed(i));
+    }
+  }
+
+  if (fPairBlock->NPassed() > 0) {
+    for (AliFemtoCorrFctnIterator tCorrFctnIter = fCorrFctnCollection->begin();
+                                  tCorrFctnIter != fCorrFctnCollection->end();
+                                ++tCorrFctnIter) {
+      AliFemtoCorrFctn* tCorrFctn = *tCorrFctnIter;
+
+      if (isReal)
+        tCorrFctn->AddRealPairs(fPairBlock);
+      else
+        tCorrFctn->AddMixedPairs(fPairBlock);
+    } // loop over correlation functions
+  }
+
+  fPairBlock->Clear();
 }
 //_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
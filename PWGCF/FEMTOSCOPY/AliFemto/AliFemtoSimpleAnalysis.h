@@ -14,6 +14,9 @@
 #include "AliFemtoPicoEventCollection.h"
 #include "AliFemtoParticleCollection.h"
 #include "AliFemtoV0SharedDaughterCut.h"
+#include "AliFemtoPairBlock.h"
+
+#include <TString.h>
 
 class AliFemtoPicoEventCollectionVectorHideAway;
 class AliFemtoPicoEvent;
@@ -142,22 +145,64 @@ public:
   /// Calls Finish method on all correlation functions
   virtual void Finish();
 
+  /// Key describing how this analysis builds its pico events and mixing
+  /// buffer: analysis class, cut classes and mixing parameters. Analyses
+  /// with equal keys and equivalent cuts (see HasEquivalentCuts) select
+  /// identical particle collections, which lets AliFemtoManager build them
+  /// only once.
+  ///
+  /// An empty key means the collections cannot be shared, either because
+  /// a cut is missing or because a subclass processes events differently.
+  /// Subclasses must override this to opt in.
+  virtual TString SharedCollectionKey();
+
+  /// True if the event and particle cuts of \a other are known to accept
+  /// exactly what ours accept, see AliFemtoEventCut::IsEquivalent
+  bool HasEquivalentCuts(const AliFemtoSimpleAnalysis* other) const;
+
+  /// Take the pico event and the mixing buffer from \a source instead of
+  /// building them. The source must have an equal SharedCollectionKey()
+  /// and equivalent cuts, and must be processed before this analysis in
+  /// every event. Passing NULL restores normal processing.
+  void SetSharedCollectionSource(AliFemtoSimpleAnalysis* source);
+  AliFemtoSimpleAnalysis* SharedCollectionSource() const;
+
 protected:
 
+  /// Forget the event published for analyses sharing our collections;
+  /// must be called at the start of every event by ProcessEvent overrides
+  void ClearSharedEvent();
+
+  /// Common part of SharedCollectionKey(): cuts and mixing-buffer settings
+  TString BuildSharedCollectionKey();
+
+  /// ProcessEvent for analyses reading the collections of fSharedSource
+  void ProcessSharedEvent(const AliFemtoEvent* hbtEvent);
+
+  /// Mix the current particle collections with a stored event;
+  /// collection2 is NULL for identical particles
+  void MakeMixedPairs(AliFemtoParticleCollection* collection1,
+                      AliFemtoParticleCollection* collection2,
+                      AliFemtoPicoEvent* storedEvent);
+
   /// Increment fNeventsProcessed - is this method neccessary?
   void AddEventProcessed();
 
-  /// Build pairs, check pair cuts, and call CFs' AddRealPair() or
-  /// AddMixedPair() methods. If no second particle collection is
+  /// Build pairs, check pair cuts, and call CFs' AddRealPairs() or
+  /// AddMixedPairs() methods. If no second particle collection is
   /// specfied, make pairs within first particle collection.
   ///
   /// \param type Either the string "real" or "mixed", specifying which method
-  ///             to call (AddRealPair or AddMixedPair)
+  ///             to call (AddRealPairs or AddMixedPairs)
   void MakePairs(const char* type,
                  AliFemtoParticleCollection* ParticlesPassingCut1,
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// Run the pair cut and the correlation functions on the pairs
+  /// collected so far in fPairBlock, then empty it
+  void ProcessPairBlock(bool isReal, Bool_t enablePairMonitors);
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -177,6 +222,14 @@ protected:
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
 
+  AliFemtoPairBlock* fPairBlock;                     //!<! Reusable pairs handed to cuts and CFs in batches
+
+  AliFemtoSimpleAnalysis* fSharedSource;             //!<! Analysis providing pico events and mixing buffer, not owned
+  Bool_t fPublishSharedEvent;                        //!<! Other analyses read our pico events
+  AliFemtoPicoEvent* fSharedPicoEvent;               //!<! Pico event accepted in the current event, if any
+  AliFemtoPicoEventCollection* fSharedMixingBuffer;  //!<! Mixing buffer used in the current event
+  AliFemtoPicoEvent* fSharedRetiredEvent;            //!<! Event dropped from the buffer in the current event, still needed for mixing
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
   ClassDef(AliFemtoSimpleAnalysis, 0);
@@ -186,6 +239,11 @@ protected:
 };
 
 // Gets
+inline AliFemtoSimpleAnalysis* AliFemtoSimpleAnalysis::SharedCollectionSource() const
+{
+  return fSharedSource;
+}
+
 inline AliFemtoPairCut* AliFemtoSimpleAnalysis::PairCut()
 {
   return fPairCut;
@@ -12,6 +12,8 @@
 #include "AliFemtoPicoEventCollectionVector.h"
 #include "AliFemtoPicoEventCollectionVectorHideAway.h"
 
+#include <typeinfo>
+
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -188,6 +190,23 @@ AliFemtoString AliFemtoVertexMultAnalysis::Report()
   return AliFemtoString(report);
 }
 
+TString AliFemtoVertexMultAnalysis::SharedCollectionKey()
+{
+  // Cuts plus the vertex/multiplicity mixing bins
+  if (typeid(*this) != typeid(AliFemtoVertexMultAnalysis)) {
+    return "";
+  }
+
+  const TString key = BuildSharedCollectionKey();
+  if (key.IsNull()) {
+    return key;
+  }
+
+  return TString::Format("AliFemtoVertexMultAnalysis:vz=%u,%f,%f;mult=%u,%f,%f;",
+                         fVertexZBins, fVertexZ[0], fVertexZ[1],
+                         fMultBins, fMult[0], fMult[1]) + key;
+}
+
 TList* AliFemtoVertexMultAnalysis::ListSettings()
 {
   TList *settings = AliFemtoSimpleAnalysis::ListSettings();
@@ -228,6 +247,11 @@ void AliFemtoVertexMultAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
 {
   // Perform event processing in bins of z vertex and multiplicity
 
+  // events outside the mixing bins are not published either
+  if (fPublishSharedEvent) {
+    ClearSharedEvent();
+  }
+
   // find the correct mixing buffer
   const Double_t vertexZ = hbtEvent->PrimVertPos().z(),
                     mult = hbtEvent->UncorrectedNumberOfPrimaries();
@@ -56,6 +56,10 @@ public:
   /// binning parameters.
   virtual TList* ListSettings();
 
+  /// Shared-collection key of AliFemtoSimpleAnalysis extended by the
+  /// vertex and multiplicity binning of the mixing buffers
+  virtual TString SharedCollectionKey();
+
   virtual UInt_t OverflowVertexZ() const;   ///< Number of events above vertex-z range
   virtual UInt_t UnderflowVertexZ() const;  ///< Number of events below vertex-z range
   virtual UInt_t OverflowMult() const;      ///< Number of events above multiplicity range
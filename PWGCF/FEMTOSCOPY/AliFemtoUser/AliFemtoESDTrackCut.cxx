@@ -46,6 +46,7 @@
 
 #include "AliFemtoESDTrackCut.h"
 #include <cstdio>
+#include <typeinfo>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -602,6 +603,74 @@ TList *AliFemtoESDTrackCut::ListSettings()
   }
   return tListSetttings;
 }
+//------------------------------
+bool AliFemtoESDTrackCut::IsEquivalent(const AliFemtoParticleCut* cut) const
+{
+  // Compare every setting used in Pass(); the track counters do not
+  // change the selection
+  if (cut == this) {
+    return true;
+  }
+
+  // a subclass may cut on more than what is compared here
+  if (typeid(*this) != typeid(AliFemtoESDTrackCut)
+      || cut == NULL
+      || typeid(*cut) != typeid(AliFemtoESDTrackCut)) {
+    return false;
+  }
+
+  const AliFemtoESDTrackCut *c = static_cast<const AliFemtoESDTrackCut*>(cut);
+
+  for (int i = 0; i < 2; i++) {
+    if (fPt[i] != c->fPt[i]
+        || fRapidity[i] != c->fRapidity[i]
+        || fEta[i] != c->fEta[i]
+        || fPidProbElectron[i] != c->fPidProbElectron[i]
+        || fPidProbPion[i] != c->fPidProbPion[i]
+        || fPidProbKaon[i] != c->fPidProbKaon[i]
+        || fPidProbProton[i] != c->fPidProbProton[i]
+        || fPidProbMuon[i] != c->fPidProbMuon[i]) {
+      return false;
+    }
+  }
+
+  for (int i = 0; i < 3; i++) {
+    if (fCutClusterRequirementITS[i] != c->fCutClusterRequirementITS[i]) {
+      return false;
+    }
+  }
+
+  return fMass == c->fMass
+      && fCharge == c->fCharge
+      && fLabel == c->fLabel
+      && fStatus == c->fStatus
+      && fPIDMethod == c->fPIDMethod
+      && fNsigmaTPCTOF == c->fNsigmaTPCTOF
+      && fNsigmaTPConly == c->fNsigmaTPConly
+      && fNsigma == c->fNsigma
+      && fminTPCclsF == c->fminTPCclsF
+      && fminTPCncls == c->fminTPCncls
+      && fminITScls == c->fminITScls
+      && fMaxITSchiNdof == c->fMaxITSchiNdof
+      && fMaxTPCchiNdof == c->fMaxTPCchiNdof
+      && fMaxSigmaToVertex == c->fMaxSigmaToVertex
+      && fRemoveKinks == c->fRemoveKinks
+      && fRemoveITSFake == c->fRemoveITSFake
+      && fMostProbable == c->fMostProbable
+      && fMaxImpactXY == c->fMaxImpactXY
+      && fMinImpactXY == c->fMinImpactXY
+      && fMaxImpactZ == c->fMaxImpactZ
+      && fMaxImpactXYPtOff == c->fMaxImpactXYPtOff
+      && fMaxImpactXYPtNrm == c->fMaxImpactXYPtNrm
+      && fMaxImpactXYPtPow == c->fMaxImpactXYPtPow
+      && fMinPforTOFpid == c->fMinPforTOFpid
+      && fMaxPforTOFpid == c->fMaxPforTOFpid
+      && fMinPforTPCpid == c->fMinPforTPCpid
+      && fMaxPforTPCpid == c->fMaxPforTPCpid
+      && fMinPforITSpid == c->fMinPforITSpid
+      && fMaxPforITSpid == c->fMaxPforITSpid
+      && fElectronRejection == c->fElectronRejection;
+}
 void AliFemtoESDTrackCut::SetRemoveKinks(const bool& flag)
 {
   fRemoveKinks = flag;
@@ -27,6 +27,7 @@ public:
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   virtual AliFemtoParticleType Type(){return hbtTrack;}
+  virtual bool IsEquivalent(const AliFemtoParticleCut* cut) const;
 
   void SetPt(const float& lo, const float& hi);
   void SetRapidity(const float& lo, const float& hi);
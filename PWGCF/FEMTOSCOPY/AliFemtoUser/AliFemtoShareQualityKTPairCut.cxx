@@ -80,6 +80,20 @@ bool AliFemtoShareQualityKTPairCut::Pass(const AliFemtoPair* pair){
   return temp;
 }
 //__________________
+void AliFemtoShareQualityKTPairCut::PassBlock(AliFemtoPairBlock* block){
+  // Same as Pass() for every pair of the block, with kT taken from the
+  // precomputed array of the block
+  for (int i = 0; i < block->Size(); i++) {
+    const double kT = block->KT(i);
+    if ((kT < fKTMin) || (kT > fKTMax)) {
+      fNPairsFailed++;
+      block->SetPassed(i, false);
+    }
+    else
+      block->SetPassed(i, AliFemtoShareQualityPairCut::Pass(block->Pair(i)));
+  }
+}
+//__________________
 AliFemtoString AliFemtoShareQualityKTPairCut::Report(){
   // Prepare a report from execution
   string stemp = "AliFemtoShareQuality Pair Cut - remove shared and split pairs\n";  char ctemp[100];
@@ -33,6 +33,7 @@ public:
   AliFemtoShareQualityKTPairCut& operator=(const AliFemtoShareQualityKTPairCut& c);
 
   virtual bool Pass(const AliFemtoPair* pair);
+  virtual void PassBlock(AliFemtoPairBlock* block);
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   AliFemtoShareQualityKTPairCut* Clone();
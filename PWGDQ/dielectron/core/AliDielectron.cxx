@@ -330,6 +330,11 @@ void AliDielectron::Init()
     (*fUsedVars)|= (*fHistos->GetUsedVars());
   }
 
+  // the efficiency maps need their axis variables to be filled as well
+  AliDielectronVarManager::SetLegEffMap(fLegEffMap);
+  AliDielectronVarManager::SetPairEffMap(fPairEffMap);
+  AliDielectronVarManager::AddDependencies(fUsedVars);
+
 }
 
 //________________________________________________________________
@@ -777,10 +777,14 @@ Double_t AliDielectronPID::GetPIDCorr(const AliVTrack *track, TH1 *hist)
   TF1 *fun = (TF1*)hist->GetListOfFunctions()->At(0);
   Int_t dim=(fun?fun->GetNdim():hist->GetDimension());
 
+  // event variables (e.g. multiplicity) are copied into the particle values
+  // only if the current fill map needs them, take them from the event data
+  const Double_t *eventValues = AliDielectronVarManager::GetData();
+  const UInt_t axisVars[3] = { hist->GetXaxis()->GetUniqueID(), hist->GetYaxis()->GetUniqueID(), hist->GetZaxis()->GetUniqueID() };
   Double_t var[3] = {0.,0.,0.};
-  if(dim>0) var[0] = values[hist->GetXaxis()->GetUniqueID()];
-  if(dim>1) var[1] = values[hist->GetYaxis()->GetUniqueID()];
-  if(dim>2) var[2] = values[hist->GetZaxis()->GetUniqueID()];
+  for(Int_t i=0; i<dim && i<3; i++) {
+    var[i] = (axisVars[i]>=(UInt_t)AliDielectronVarManager::kPairMax ? eventValues[axisVars[i]] : values[axisVars[i]]);
+  }
   Double_t corr = 0.0;
   if(fun) corr = fun->Eval(var[0],var[1],var[2]);
   else    corr = hist->GetBinContent( hist->FindFixBin(var[0],var[1],var[2]) );
@@ -619,15 +619,14 @@ const char* AliDielectronVarManager::fgkParticleNames[AliDielectronVarManager::k
   {"MixingBin",              "mixing bin",                                         ""}
 };
 
-AliPIDResponse* AliDielectronVarManager::fgPIDResponse      = 0x0;
-AliVEvent*      AliDielectronVarManager::fgEvent            = 0x0;
-AliEventplane*  AliDielectronVarManager::fgTPCEventPlane    = 0x0;
-AliKFVertex*    AliDielectronVarManager::fgKFVertex         = 0x0;
 TProfile*       AliDielectronVarManager::fgMultEstimatorAvg[6][9] = {{0x0}};
 TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
 TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
 TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
-TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
+UInt_t          AliDielectronVarManager::fgLegEffVars[AliDielectronVarManager::kMaxEffMapDim] = {0};
+UInt_t          AliDielectronVarManager::fgPairEffVars[AliDielectronVarManager::kMaxEffMapDim] = {0};
+Int_t           AliDielectronVarManager::fgNLegEffVars         = -1;
+Int_t           AliDielectronVarManager::fgNPairEffVars        = -1;
 Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
 TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
 TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
@@ -638,7 +637,68 @@ TProfile3D*     AliDielectronVarManager::fgZDCRecentering[3][2] = {{0x0,0x0},{0x
 AliDielectronQnEPcorrection* AliDielectronVarManager::fgQnEPacRemoval = 0x0;
 Bool_t          AliDielectronVarManager::fgEventPlaneACremoval = kFALSE;
 Int_t           AliDielectronVarManager::fgCurrentRun = -1;
-Double_t        AliDielectronVarManager::fgData[AliDielectronVarManager::kNMaxValues] = {0.};
+AliDielectronVarManager::VarManagerContext AliDielectronVarManager::fgDefaultContext;
+
+namespace {
+  // Context selected by the calling thread with SetContext(), 0x0 for the
+  // default context. Kept at file scope: the dictionary of the class does
+  // not handle thread_local members.
+#if __cplusplus >= 201103L
+  thread_local
+#endif
+  AliDielectronVarManager::VarManagerContext *gCurrentContext = 0x0;
+}
+
+//________________________________________________________________
+AliDielectronVarManager::VarManagerContext* AliDielectronVarManager::GetContext()
+{
+  //
+  // Context of the calling thread
+  //
+  return (gCurrentContext ? gCurrentContext : &fgDefaultContext);
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::SetContext(VarManagerContext *ctx)
+{
+  //
+  // Select the context of the calling thread, 0x0 selects the default one
+  //
+  gCurrentContext = ctx;
+}
+
+//________________________________________________________________
+AliDielectronVarManager::VarManagerContext::VarManagerContext() :
+  fPIDResponse(0x0),
+  fEvent(0x0),
+  fTPCEventPlane(0x0),
+  fKFVertex(0x0),
+  fFillMap(0x0),
+  fFillGroups(kFillAllGroups)
+{
+  //
+  // Empty context; PID response and fill map have to be set by the user
+  //
+  for (Int_t i=0; i<kNMaxValues; ++i) fData[i]=0.;
+}
+
+//________________________________________________________________
+void AliDielectronVarManager::VarManagerContext::ResetFillPlans()
+{
+  //
+  // Plan the fill groups again, after the current fill map was changed
+  //
+  fFillGroups=PlanFillGroups(fFillMap);
+}
+
+//________________________________________________________________
+AliDielectronVarManager::VarManagerContext::~VarManagerContext()
+{
+  //
+  // Destructor
+  //
+  delete fKFVertex;
+}
 //________________________________________________________________
 AliDielectronVarManager::AliDielectronVarManager() :
   TNamed("AliDielectronVarManager","AliDielectronVarManager")
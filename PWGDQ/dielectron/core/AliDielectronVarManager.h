@@ -648,10 +648,59 @@ public:
   };
 
 
+  // Per-event state of the variable manager. The static interface works on
+  // the context of the calling thread, which is fgDefaultContext unless
+  // changed with SetContext(). Separate contexts allow several event loops
+  // to fill variables concurrently, each from its own thread.
+  class VarManagerContext {
+  public:
+    VarManagerContext();
+    ~VarManagerContext();
+
+    void SetPIDResponse(AliPIDResponse *pidResponse) { fPIDResponse=pidResponse; }
+    void SetFillMap(TBits *map)                      { fFillMap=map; fFillGroups=PlanFillGroups(map); }
+    void ResetFillPlans();
+
+    AliPIDResponse*    GetPIDResponse() const { return fPIDResponse; }
+    TBits*             GetFillMap()     const { return fFillMap; }
+    UInt_t             GetFillGroups()  const { return fFillGroups; }
+    AliVEvent*         GetEvent()       const { return fEvent; }
+    const AliKFVertex* GetKFVertex()    const { return fKFVertex; }
+    const Double_t*    GetData()        const { return fData; }
+
+  private:
+    friend class AliDielectronVarManager;
+
+    AliPIDResponse  *fPIDResponse;        // PID response object
+    AliVEvent       *fEvent;              // current event pointer
+    AliEventplane   *fTPCEventPlane;      // current event tpc plane pointer
+    AliKFVertex     *fKFVertex;           // kf vertex (owned)
+    TBits           *fFillMap;            // map for requested variable filling
+    UInt_t           fFillGroups;         // groups of unconditional track work planned from fFillMap
+    Double_t         fData[kNMaxValues];  // event data
+
+    VarManagerContext(const VarManagerContext &c);
+    VarManagerContext &operator=(const VarManagerContext &c);
+  };
+
+
+  // Blocks of per-track work which feed several variables at once and are
+  // therefore not covered by a single Req(var). They are planned from the
+  // requested variables at every SetFillMap(), see PlanFillGroups(); a fill
+  // map changed in place needs another SetFillMap() before the next Fill.
+  enum FillGroup {
+    kFillTPCSharedMap  = BIT(0),  // TPC shared cluster map (AOD)
+    kFillTPCClusterMap = BIT(1),  // TPC cluster map segments / readout chambers
+    kFillMCTruth       = BIT(2),  // MC truth lookup of reconstructed tracks
+    kFillEventData     = BIT(3),  // copy of the event variables into particle arrays
+    kFillAllGroups     = 0xffffffff
+  };
+
   AliDielectronVarManager();
   AliDielectronVarManager(const char* name, const char* title);
   virtual ~AliDielectronVarManager();
   static void Fill(const TObject* particle, Double_t * const values);
+  static void Fill(VarManagerContext &ctx, const TObject* particle, Double_t * const values);
   static void FillVarMCParticle2(const AliVParticle *p1, const AliVParticle *p2, Double_t * const values);
   static void FillVarVParticle(const AliVParticle *particle,         Double_t * const values);
 
@@ -660,19 +709,24 @@ public:
   static void InitEstimatorAvg(const Char_t* filename);
   static void InitEstimatorObjArrayAvg(const TObjArray* array);
   static void InitTRDpidEffHistograms(const Char_t* filename);
-  static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
-  static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
-  static void SetFillMap(   TBits   *map) { fgFillMap=map; }
+  static void SetLegEffMap( TObject *map) { if(map!=fgLegEffMap)  { fgLegEffMap=map;  fgNLegEffVars=ResolveEffMapVars(map,fgLegEffVars); } }
+  static void SetPairEffMap(TObject *map) { if(map!=fgPairEffMap) { fgPairEffMap=map; fgNPairEffVars=ResolveEffMapVars(map,fgPairEffVars); } }
+  static void SetFillMap(   TBits   *map) { GetContext()->SetFillMap(map); }
+  static UInt_t PlanFillGroups(const TBits *map);
+  static void AddDependencies(TBits *map);
   static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
 
   static void SetVZERORecenteringFile(const Char_t* filename) {fgVZERORecenteringFile = filename;}
   static void SetZDCRecenteringFile(const Char_t* filename) {fgZDCRecenteringFile = filename;}
-  static void SetPIDResponse(AliPIDResponse *pidResponse) {fgPIDResponse=pidResponse;}
-  static AliPIDResponse* GetPIDResponse() { return fgPIDResponse; }
+  static void SetPIDResponse(AliPIDResponse *pidResponse) {GetContext()->fPIDResponse=pidResponse;}
+  static AliPIDResponse* GetPIDResponse() { return GetContext()->fPIDResponse; }
   static void SetEvent(AliVEvent * const ev);
   static void SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues]);
+  static void SetEvent(VarManagerContext &ctx, AliVEvent * const ev);
+  static void SetEventData(VarManagerContext &ctx, const Double_t data[AliDielectronVarManager::kNMaxValues]);
   static Bool_t GetDCA(const AliAODTrack *track, Double_t* d0z0, Double_t* covd0z0=0);
   static void SetTPCEventPlane(AliEventplane *const evplane);
+  static void SetTPCEventPlane(VarManagerContext &ctx, AliEventplane *const evplane);
   static void SetTPCEventPlaneACremoval(AliDielectronQnEPcorrection *acCuts) {fgQnEPacRemoval = acCuts; fgEventPlaneACremoval = kTRUE;}
   static void GetVzeroRP(const AliVEvent* event, Double_t* qvec, Int_t sideOption);      // 0- V0A; 1- V0C; 2- V0A+V0C
   static void GetZDCRP(const AliVEvent* event, Double_t qvec[][2]);
@@ -682,24 +736,30 @@ public:
   static Double_t GetSingleLegEff(Double_t * const values);
   static Double_t GetPairEff(Double_t * const values);
 
-  static const AliKFVertex* GetKFVertex() {return fgKFVertex;}
+  static const AliKFVertex* GetKFVertex() {return GetContext()->fKFVertex;}
 
   static const char* GetValueName(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][0]:""; }
   static const char* GetValueLabel(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][1]:""; }
   static const char* GetValueUnit(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][2]:""; }
   static UInt_t GetValueType(const char* valname);
-  static const Double_t* GetData() {return fgData;}
-  static AliVEvent* GetCurrentEvent() {return fgEvent;}
+  static const Double_t* GetData() {return GetContext()->fData;}
+  static AliVEvent* GetCurrentEvent() {return GetContext()->fEvent;}
 
-  static Double_t GetValue(ValueTypes var) {return fgData[var];}
-  static void SetValue(ValueTypes var, Double_t val) { fgData[var]=val; }
+  static Double_t GetValue(ValueTypes var) {return GetContext()->fData[var];}
+  static void SetValue(ValueTypes var, Double_t val) { GetContext()->fData[var]=val; }
+
+  static VarManagerContext* GetContext();
+  static VarManagerContext* GetDefaultContext() { return &fgDefaultContext; }
+  static void SetContext(VarManagerContext *ctx);
 
 
 private:
 
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
-  static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  static Bool_t Req(ValueTypes var) { return (GetContext()->fFillMap ? GetContext()->fFillMap->TestBitNumber(var) : kTRUE); }
+  static Bool_t ReqGroup(FillGroup group) { return (GetContext()->fFillGroups & group)!=0; }
+  static Int_t  ResolveEffMapVars(const TObject *map, UInt_t *vars);
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
@@ -719,16 +779,17 @@ private:
   static void InitVZERORecenteringHistograms(Int_t runNo);
   static void InitZDCRecenteringHistograms(Int_t runNo);
 
-  static AliPIDResponse  *fgPIDResponse;        // PID response object
-  static AliVEvent       *fgEvent;              // current event pointer
-  static AliEventplane   *fgTPCEventPlane;      // current event tpc plane pointer
-  static AliKFVertex     *fgKFVertex;           // kf vertex
+  static VarManagerContext  fgDefaultContext;  // context of the static interface
   static TProfile        *fgMultEstimatorAvg[6][9];  // multiplicity estimator averages (6 periods x 18 estimators)
   static Double_t         fgTRDpidEffCentRanges[10][4];   // centrality ranges for the TRD pid efficiency histograms
   static TH3D            *fgTRDpidEff[10][4];   // TRD pid efficiencies from conversion electrons
   static TObject         *fgLegEffMap;             // single electron efficiencies
   static TObject         *fgPairEffMap;             // pair efficiencies
-  static TBits           *fgFillMap;             // map for requested variable filling
+  enum { kMaxEffMapDim=20 };
+  static UInt_t           fgLegEffVars[kMaxEffMapDim];   // variables of the single electron efficiency axes
+  static UInt_t           fgPairEffVars[kMaxEffMapDim];  // variables of the pair efficiency axes
+  static Int_t            fgNLegEffVars;           // number of resolved leg efficiency axes, -1 if not resolved
+  static Int_t            fgNPairEffVars;          // number of resolved pair efficiency axes, -1 if not resolved
   static TString          fgVZEROCalibrationFile;  // file with VZERO channel-by-channel calibrations
   static TString          fgVZERORecenteringFile;  // file with VZERO Q-vector averages needed for event plane recentering
   static TProfile2D      *fgVZEROCalib[64];           // 1 histogram per VZERO channel
@@ -742,8 +803,6 @@ private:
   static Double_t CalculateEPDiff(Double_t detArp, Double_t detBrp);
 
 
-  static Double_t fgData[kNMaxValues];        //! data
-
   AliDielectronVarManager(const AliDielectronVarManager &c);
   AliDielectronVarManager &operator=(const AliDielectronVarManager &c);
 
@@ -821,9 +880,11 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
     }
   }
 
-//   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
-  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+//   if ( GetContext()->fEvent ) AliDielectronVarManager::Fill(GetContext()->fEvent, values);
+  if(ReqGroup(kFillEventData)) {
+    for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
+      values[i]=GetContext()->fData[i];
+  }
 }
 
 inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle, Double_t * const values)
@@ -879,25 +940,27 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   values[AliDielectronVarManager::kNclsSFracITS] = itsNcls ? itsNclsS/ itsNcls :0;
 
 
-  UChar_t threshold = 5;
-  TBits tpcClusterMap = particle->GetTPCClusterMap();
-  UChar_t n=0; UChar_t j=0;
-  for(UChar_t i=0; i<8; ++i) {
-    n=0;
-    for(j=i*20; j<(i+1)*20 && j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
-    if(n>=threshold) values[AliDielectronVarManager::kTPCclsSegments] += 1.0;
-  }
-
-  n=0;
-  threshold=0;
   values[AliDielectronVarManager::kTPCclsIRO]=0.;
-  for(j=0; j<63; ++j) n+=tpcClusterMap.TestBitNumber(j);
-  if(n>=threshold) values[AliDielectronVarManager::kTPCclsIRO] = n;
-  n=0;
-  threshold=0;
   values[AliDielectronVarManager::kTPCclsORO]=0.;
-  for(j=63; j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
-  if(n>=threshold) values[AliDielectronVarManager::kTPCclsORO] = n;
+  if(ReqGroup(kFillTPCClusterMap)) {
+    UChar_t threshold = 5;
+    const TBits &tpcClusterMap = particle->GetTPCClusterMap();
+    UChar_t n=0; UChar_t j=0;
+    for(UChar_t i=0; i<8; ++i) {
+      n=0;
+      for(j=i*20; j<(i+1)*20 && j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
+      if(n>=threshold) values[AliDielectronVarManager::kTPCclsSegments] += 1.0;
+    }
+
+    n=0;
+    threshold=0;
+    for(j=0; j<63; ++j) n+=tpcClusterMap.TestBitNumber(j);
+    if(n>=threshold) values[AliDielectronVarManager::kTPCclsIRO] = n;
+    n=0;
+    threshold=0;
+    for(j=63; j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
+    if(n>=threshold) values[AliDielectronVarManager::kTPCclsORO] = n;
+  }
 
   values[AliDielectronVarManager::kTrackStatus]   = (Double_t)particle->GetStatus();
   values[AliDielectronVarManager::kFilterBit]     = 0;
@@ -929,7 +992,7 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   values[AliDielectronVarManager::kNumberOfDaughters]=-999;
 
   AliDielectronMC *mc=AliDielectronMC::Instance();
-  if (mc->HasMC()){
+  if (mc->HasMC() && ReqGroup(kFillMCTruth)){
     if (mc->GetMCTrack(particle)) {
       Int_t trkLbl = TMath::Abs(mc->GetMCTrack(particle)->GetLabel());
       values[AliDielectronVarManager::kPdgCode]           =mc->GetMCTrack(particle)->PdgCode();
@@ -984,15 +1047,15 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   const AliExternalTrackParam *out=particle->GetOuterParam();
   if(out) values[AliDielectronVarManager::kPOut] = out->GetP();
   else values[AliDielectronVarManager::kPOut] = mom;
-  if(out && fgEvent) {
+  if(out && GetContext()->fEvent) {
     Double_t localCoord[3]={0.0};
-    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)fgEvent)->GetMagneticField(), localCoord);
+    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)GetContext()->fEvent)->GetMagneticField(), localCoord);
     values[AliDielectronVarManager::kTRDphi] = (localCoordGood && TMath::Abs(localCoord[0])>1.0e-6 && TMath::Abs(localCoord[1])>1.0e-6 ? TMath::ATan2(localCoord[1], localCoord[0]) : -999.);
   }
   if(mc->HasMC() && fgTRDpidEff[0][0]) {
-    Int_t runNo = (fgEvent ? fgEvent->GetRunNumber() : -1);
+    Int_t runNo = (GetContext()->fEvent ? GetContext()->fEvent->GetRunNumber() : -1);
     Float_t centrality=-1.0;
-    AliCentrality *esdCentrality = (fgEvent ? fgEvent->GetCentrality() : 0x0);
+    AliCentrality *esdCentrality = (GetContext()->fEvent ? GetContext()->fEvent->GetCentrality() : 0x0);
     if(esdCentrality) centrality = esdCentrality->GetCentralityPercentile("V0M");
     Double_t effErr=0.0;
     values[kTRDpidEffLeg] = GetTRDpidEfficiency(runNo, centrality, values[AliDielectronVarManager::kEta],
@@ -1010,7 +1073,7 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
 
   Double_t l = particle->GetIntegratedLength();  // cm
   Double_t t = particle->GetTOFsignal();
-  Double_t t0 = fgPIDResponse->GetTOFResponse().GetTimeZero(); // ps
+  Double_t t0 = GetContext()->fPIDResponse->GetTOFResponse().GetTimeZero(); // ps
 
   if( (l < 360. || l > 800.) || (t <= 0.) || (t0 >999990.0) ) {
 	values[AliDielectronVarManager::kTOFbeta]=0.0;
@@ -1026,40 +1089,40 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   }
   values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
 
-  values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+  values[AliDielectronVarManager::kTOFmismProb] = GetContext()->fPIDResponse->GetTOFMismatchProbability(particle);
 
   // nsigma to Electron band
   // TODO: for the moment we set the bethe bloch parameters manually
   //       this should be changed in future!
-  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
+  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kTPCnSigmaEle]   =(GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
 
-  values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kTPCnSigmaPio]=GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
+  values[AliDielectronVarManager::kTPCnSigmaMuo]=GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
+  values[AliDielectronVarManager::kTPCnSigmaKao]=GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
+  values[AliDielectronVarManager::kTPCnSigmaPro]=GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
 
-  values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
+  values[AliDielectronVarManager::kITSnSigmaEleRaw]= GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kITSnSigmaEle]   =(GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
                                                      -AliDielectronPID::GetCntrdCorrITS(particle)
                                                      ) / AliDielectronPID::GetWdthCorrITS(particle);
 
-  values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kITSnSigmaPio]=GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
+  values[AliDielectronVarManager::kITSnSigmaMuo]=GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
+  values[AliDielectronVarManager::kITSnSigmaKao]=GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
+  values[AliDielectronVarManager::kITSnSigmaPro]=GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
 
-  values[AliDielectronVarManager::kTOFnSigmaEle]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kTOFnSigmaEle]=GetContext()->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kTOFnSigmaPio]=GetContext()->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
+  values[AliDielectronVarManager::kTOFnSigmaMuo]=GetContext()->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
+  values[AliDielectronVarManager::kTOFnSigmaKao]=GetContext()->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
+  values[AliDielectronVarManager::kTOFnSigmaPro]=GetContext()->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
 
   //EMCAL PID information
   Double_t eop=0;
   Double_t showershape[4]={0.,0.,0.,0.};
-//   values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
+//   values[AliDielectronVarManager::kEMCALnSigmaEle]  = GetContext()->fPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kEMCALnSigmaEle]  = GetContext()->fPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
   values[AliDielectronVarManager::kEMCALEoverP]     = eop;
   values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
   values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
@@ -1076,19 +1139,19 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   if(Req(kTRDonlineA)||Req(kTRDonlineLayerMask)||Req(kTRDonlinePID)||Req(kTRDonlinePt)||Req(kTRDonlineStack)||Req(kTRDonlineTrackInTime)||Req(kTRDonlineSector)||Req(kTRDonlineFlagsTiming)||Req(kTRDonlineLabel)||Req(kTRDonlineNTracklets)||Req(kTRDonlineFirstLayer))
     FillVarVTrdTrack(particle,values);
 
-  if( fgEvent && fgEvent->GetMagneticField() ){
+  if( GetContext()->fEvent && GetContext()->fEvent->GetMagneticField() ){
     if(out){
       AliExternalTrackParam out_tmp(*out);
-      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), GetContext()->fEvent->GetMagneticField());
       values[AliDielectronVarManager::kTRDeta] = out_tmp.Eta();
     }
     else{
       AliESDtrack particle_tmp(*particle);
-      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), GetContext()->fEvent->GetMagneticField());
       values[AliDielectronVarManager::kTRDeta] = particle_tmp.Eta();
     }
     int mode = particle->GetInnerParam() ? 1:0;
-    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., fgEvent->GetMagneticField());
+    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., GetContext()->fEvent->GetMagneticField());
     values[kTPCGeomLength] = values[kTPCActiveLength] / ( 130 - TMath::Power( TMath::Abs( particle->GetSigned1Pt() ),1.5 ) );
     values[AliDielectronVarManager::kInTRDacceptance] = TMath::Abs( values[AliDielectronVarManager::kTRDeta] )<0.85 && (  (values[AliDielectronVarManager::kCharge]<0&&(  values[AliDielectronVarManager::kPhi]<1.32 || (values[AliDielectronVarManager::kPhi]>1.98 && values[AliDielectronVarManager::kPhi]<4.10)||  ( values[AliDielectronVarManager::kPhi]>5.12  && values[AliDielectronVarManager::kPhi]<5.48  && TMath::Abs( values[AliDielectronVarManager::kTRDeta] )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.48 )) ||   (values[AliDielectronVarManager::kCharge]>0&&(  values[AliDielectronVarManager::kPhi]<1.52 || (values[AliDielectronVarManager::kPhi]>2.20 && values[AliDielectronVarManager::kPhi]<4.32)||  ( values[AliDielectronVarManager::kPhi]>5.32  && values[AliDielectronVarManager::kPhi]<5.68  && TMath::Abs( values[AliDielectronVarManager::kTRDeta]  )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.68 )) )  ? 1: 0;
   }
@@ -1107,8 +1170,11 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
 
   //GetNclsS not present in AODtrack
   //Replace with method as soon as available
-  TBits tpcSharedMap = particle->GetTPCSharedMap();
-  Double_t tpcNclsS=  tpcSharedMap.CountBits(0)-tpcSharedMap.CountBits(159);
+  Double_t tpcNclsS=0.;
+  if(ReqGroup(kFillTPCSharedMap)) {
+    const TBits &tpcSharedMap = particle->GetTPCSharedMap();
+    tpcNclsS = tpcSharedMap.CountBits(0)-tpcSharedMap.CountBits(159);
+  }
 
   // Reset AliESDtrack interface specific information
   if(Req(kNclsITS))      values[AliDielectronVarManager::kNclsITS]       = particle->GetITSNcls();
@@ -1129,7 +1195,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   if(Req(kTRDsignal))      values[AliDielectronVarManager::kTRDsignal]     = particle->GetTRDsignal();
 
 
-  TBits tpcClusterMap = particle->GetTPCClusterMap();
+  const TBits &tpcClusterMap = particle->GetTPCClusterMap();
   UChar_t n=0; UChar_t j=0;
   UChar_t threshold = 5;
 
@@ -1233,7 +1299,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
     values[AliDielectronVarManager::kPIn]         = pid->GetTPCmomentum();
     if(Req(kTPCsignal))   values[AliDielectronVarManager::kTPCsignal]   = pid->GetTPCsignal();
     if(Req(kTOFsignal))   values[AliDielectronVarManager::kTOFsignal]   = pid->GetTOFsignal();
-    if(Req(kTOFmismProb)) values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+    if(Req(kTOFmismProb)) values[AliDielectronVarManager::kTOFmismProb] = GetContext()->fPIDResponse->GetTOFMismatchProbability(particle);
 
     // TOF beta calculation
     if(Req(kTOFbeta)) {
@@ -1242,8 +1308,8 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
       Double_t l  = TMath::C()* expt[0]*1e-12;    // m
       Double_t t  = pid->GetTOFsignal();          // ps start time subtracted (until v5-02-Rev09)
       AliTOFHeader* tofH=0x0;                     // from v5-02-Rev10 on subtract the start time
-      if(fgEvent) tofH = (AliTOFHeader*)fgEvent->GetTOFHeader();
-      if(tofH) t -= fgPIDResponse->GetTOFResponse().GetStartTime(particle->P()); // ps
+      if(GetContext()->fEvent) tofH = (AliTOFHeader*)GetContext()->fEvent->GetTOFHeader();
+      if(tofH) t -= GetContext()->fPIDResponse->GetTOFResponse().GetStartTime(particle->P()); // ps
 
     if( (l < 360.e-2 || l > 800.e-2) || (t <= 0.) ) {
       values[AliDielectronVarManager::kTOFbeta]  =0;
@@ -1258,54 +1324,54 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
     }
 
     // nsigma for various detectors
-    if(Req(kTPCnSigmaEleRaw)) values[kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-    if(Req(kTPCnSigmaEle))    values[kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron)-AliDielectronPID::GetCorrVal()-AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
+    if(Req(kTPCnSigmaEleRaw)) values[kTPCnSigmaEleRaw]= GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
+    if(Req(kTPCnSigmaEle))    values[kTPCnSigmaEle]   =(GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron)-AliDielectronPID::GetCorrVal()-AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
 
-    if(Req(kTPCnSigmaPio)) values[kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
-    if(Req(kTPCnSigmaMuo)) values[kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
-    if(Req(kTPCnSigmaKao)) values[kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
-    if(Req(kTPCnSigmaPro)) values[kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
+    if(Req(kTPCnSigmaPio)) values[kTPCnSigmaPio]=GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
+    if(Req(kTPCnSigmaMuo)) values[kTPCnSigmaMuo]=GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
+    if(Req(kTPCnSigmaKao)) values[kTPCnSigmaKao]=GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
+    if(Req(kTPCnSigmaPro)) values[kTPCnSigmaPro]=GetContext()->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
 
-    if(Req(kITSnSigmaEleRaw)) values[kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-    if(Req(kITSnSigmaEle))    values[kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle)) / AliDielectronPID::GetWdthCorrITS(particle);
+    if(Req(kITSnSigmaEleRaw)) values[kITSnSigmaEleRaw]= GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
+    if(Req(kITSnSigmaEle))    values[kITSnSigmaEle]   =(GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle)) / AliDielectronPID::GetWdthCorrITS(particle);
 
-    if(Req(kITSnSigmaPio)) values[kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
-    if(Req(kITSnSigmaMuo)) values[kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
-    if(Req(kITSnSigmaKao)) values[kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
-    if(Req(kITSnSigmaPro)) values[kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
+    if(Req(kITSnSigmaPio)) values[kITSnSigmaPio]=GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
+    if(Req(kITSnSigmaMuo)) values[kITSnSigmaMuo]=GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
+    if(Req(kITSnSigmaKao)) values[kITSnSigmaKao]=GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
+    if(Req(kITSnSigmaPro)) values[kITSnSigmaPro]=GetContext()->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
 
-    if(Req(kTOFnSigmaEle)) values[kTOFnSigmaEle]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-    if(Req(kTOFnSigmaPio)) values[kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
-    if(Req(kTOFnSigmaMuo)) values[kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
-    if(Req(kTOFnSigmaKao)) values[kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
-    if(Req(kTOFnSigmaPro)) values[kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+    if(Req(kTOFnSigmaEle)) values[kTOFnSigmaEle]=GetContext()->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
+    if(Req(kTOFnSigmaPio)) values[kTOFnSigmaPio]=GetContext()->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
+    if(Req(kTOFnSigmaMuo)) values[kTOFnSigmaMuo]=GetContext()->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
+    if(Req(kTOFnSigmaKao)) values[kTOFnSigmaKao]=GetContext()->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
+    if(Req(kTOFnSigmaPro)) values[kTOFnSigmaPro]=GetContext()->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
 
     Double_t prob[AliPID::kSPECIES]={0.0};
     // switch computation off since it takes 70% of the CPU time for filling all AODtrack variables
     // TODO: find a solution when this is needed (maybe at fill time in histos, CFcontainer and cut selection)
     // 1D TRD PID
     if( Req(kTRDprobEle) || Req(kTRDprobPio) ){
-      fgPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob);
+      GetContext()->fPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob);
       values[AliDielectronVarManager::kTRDprobEle]      = prob[AliPID::kElectron];
       values[AliDielectronVarManager::kTRDprobPio]      = prob[AliPID::kPion];
     }
     // 2D TRD PID
     if( Req(kTRDprob2DEle) || Req(kTRDprob2DPio) || Req(kTRDprob2DPro) ){
-      fgPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ2D);
+      GetContext()->fPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ2D);
       values[AliDielectronVarManager::kTRDprob2DEle]    = prob[AliPID::kElectron];
       values[AliDielectronVarManager::kTRDprob2DPio]    = prob[AliPID::kPion];
       values[AliDielectronVarManager::kTRDprob2DPro]    = prob[AliPID::kProton];
     }
     // 3D TRD PID
      if( Req(kTRDprob3DEle) || Req(kTRDprob3DPio) || Req(kTRDprob3DPro) ){
-       fgPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ3D);
+       GetContext()->fPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ3D);
        values[AliDielectronVarManager::kTRDprob3DEle]    = prob[AliPID::kElectron];
        values[AliDielectronVarManager::kTRDprob3DPio]    = prob[AliPID::kPion];
        values[AliDielectronVarManager::kTRDprob3DPro]    = prob[AliPID::kProton];
      }
     // 7D TRD PID
      if( Req(kTRDprob7DEle) || Req(kTRDprob7DPio) || Req(kTRDprob7DPro) ){
-       fgPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ7D);
+       GetContext()->fPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ7D);
        values[AliDielectronVarManager::kTRDprob7DEle]    = prob[AliPID::kElectron];
        values[AliDielectronVarManager::kTRDprob7DPio]    = prob[AliPID::kPion];
        values[AliDielectronVarManager::kTRDprob7DPro]    = prob[AliPID::kProton];
@@ -1319,10 +1385,10 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   //EMCAL PID information
   Double_t eop=0;
   Double_t showershape[4]={0.,0.,0.,0.};
-//   if(Req()) values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
+//   if(Req()) values[AliDielectronVarManager::kEMCALnSigmaEle]  = GetContext()->fPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
   if(Req(kEMCALnSigmaEle) || Req(kEMCALE) || Req(kEMCALEoverP) ||
      Req(kEMCALNCells) || Req(kEMCALM02) || Req(kEMCALM20) || Req(kEMCALDispersion))
-    values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
+    values[AliDielectronVarManager::kEMCALnSigmaEle]  = GetContext()->fPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
   values[AliDielectronVarManager::kEMCALEoverP]     = eop;
   values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
   values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
@@ -1339,7 +1405,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   values[AliDielectronVarManager::kNumberOfDaughters]=-1;
 
   AliDielectronMC *mc=AliDielectronMC::Instance();
-  if (mc->HasMC()){
+  if (mc->HasMC() && ReqGroup(kFillMCTruth)){
     if (mc->GetMCTrack(particle)) {
       Int_t trkLbl = TMath::Abs(mc->GetMCTrack(particle)->GetLabel());
       values[AliDielectronVarManager::kPdgCode]           =mc->GetMCTrack(particle)->PdgCode();
@@ -1602,7 +1668,7 @@ inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1,
   values[AliDielectronVarManager::kMMC] = values[AliDielectronVarManager::kM];
   values[AliDielectronVarManager::kPtMC] = values[AliDielectronVarManager::kPt];
 
-  if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
+  if ( GetContext()->fEvent ) AliDielectronVarManager::Fill(GetContext()->fEvent, values);
 
   values[AliDielectronVarManager::kThetaHE]   = AliDielectronPair::ThetaPhiCM(p1,p2,kTRUE,  kTRUE);
   values[AliDielectronVarManager::kPhiHE]     = AliDielectronPair::ThetaPhiCM(p1,p2,kTRUE,  kFALSE);
@@ -1676,7 +1742,7 @@ inline void AliDielectronVarManager::FillVarAODMCParticle(const AliAODMCParticle
   values[AliDielectronVarManager::kNumberOfDaughters]=mc->NumberOfDaughters(particle);
 
   // using AODMCHEader information
-  AliAODMCHeader *mcHeader = (AliAODMCHeader*)fgEvent->FindListObject(AliAODMCHeader::StdBranchName());
+  AliAODMCHeader *mcHeader = (AliAODMCHeader*)GetContext()->fEvent->FindListObject(AliAODMCHeader::StdBranchName());
   if(mcHeader) {
     values[AliDielectronVarManager::kImpactParZ]  = mcHeader->GetVtxZ()-particle->Zv();
     values[AliDielectronVarManager::kImpactParXY] = TMath::Sqrt(TMath::Power(mcHeader->GetVtxX()-particle->Xv(),2) +
@@ -1742,7 +1808,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kOpeningAngle))     values[AliDielectronVarManager::kOpeningAngle]     = pair->OpeningAngle();
   if(Req(kOpeningAngleXY))     values[AliDielectronVarManager::kOpeningAngleXY] = pair->OpeningAngleXY();
   if(Req(kOpeningAngleRZ))     values[AliDielectronVarManager::kOpeningAngleRZ] = pair->OpeningAngleRZ();
-  if(Req(kCosPointingAngle)) values[AliDielectronVarManager::kCosPointingAngle] = fgEvent ? pair->GetCosPointingAngle(fgEvent->GetPrimaryVertex()) : -1;
+  if(Req(kCosPointingAngle)) values[AliDielectronVarManager::kCosPointingAngle] = GetContext()->fEvent ? pair->GetCosPointingAngle(GetContext()->fEvent->GetPrimaryVertex()) : -1;
 
   if(Req(kLegDist))   values[AliDielectronVarManager::kLegDist]      = pair->DistanceDaughters();
   if(Req(kLegDistXY)) values[AliDielectronVarManager::kLegDistXY]    = pair->DistanceDaughtersXY();
@@ -1755,20 +1821,20 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kArmAlpha)) values[AliDielectronVarManager::kArmAlpha]     = pair->GetArmAlpha();
   if(Req(kArmPt))    values[AliDielectronVarManager::kArmPt]        = pair->GetArmPt();
 
-  if(Req(kPsiPair))  values[AliDielectronVarManager::kPsiPair]      = fgEvent ? pair->PsiPair(fgEvent->GetMagneticField()) : -5;
-  if(Req(kPhivPair)) values[AliDielectronVarManager::kPhivPair]      = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) : -5;
+  if(Req(kPsiPair))  values[AliDielectronVarManager::kPsiPair]      = GetContext()->fEvent ? pair->PsiPair(GetContext()->fEvent->GetMagneticField()) : -5;
+  if(Req(kPhivPair)) values[AliDielectronVarManager::kPhivPair]      = GetContext()->fEvent ? pair->PhivPair(GetContext()->fEvent->GetMagneticField()) : -5;
   if(Req(kDeltaCotTheta)) values[kDeltaCotTheta] =  pair->DeltaCotTheta();
-  if(Req(kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) - 21. * pair->M() : -999.;
+  if(Req(kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = GetContext()->fEvent ? pair->PhivPair(GetContext()->fEvent->GetMagneticField()) - 21. * pair->M() : -999.;
   if(Req(kPseudoProperTime) || Req(kPseudoProperTimeErr)) {
     values[AliDielectronVarManager::kPseudoProperTime] =
-      fgEvent ? kfPair.GetPseudoProperDecayTime(*(fgEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
-  // values[AliDielectronVarManager::kPseudoProperTime] = fgEvent ? pair->GetPseudoProperTime(fgEvent->GetPrimaryVertex()): -1e10;
+      GetContext()->fEvent ? kfPair.GetPseudoProperDecayTime(*(GetContext()->fEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
+  // values[AliDielectronVarManager::kPseudoProperTime] = GetContext()->fEvent ? pair->GetPseudoProperTime(GetContext()->fEvent->GetPrimaryVertex()): -1e10;
     values[AliDielectronVarManager::kPseudoProperTimeErr] = (errPseudoProperTime2 > 0) ? TMath::Sqrt(errPseudoProperTime2) : -1e10;
   }
 
   // impact parameter
   Double_t d0z0[2]={-999., -999.};
-  if( (Req(kImpactParXY) || Req(kImpactParZ)) && fgEvent) pair->GetDCA(fgEvent->GetPrimaryVertex(), d0z0);
+  if( (Req(kImpactParXY) || Req(kImpactParZ)) && GetContext()->fEvent) pair->GetDCA(GetContext()->fEvent->GetPrimaryVertex(), d0z0);
   values[AliDielectronVarManager::kImpactParXY]   = d0z0[0];
   values[AliDielectronVarManager::kImpactParZ]    = d0z0[1];
 
@@ -1937,7 +2003,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 	values[AliDielectronVarManager::kDeltaEta]     = TMath::Abs(feta1 -feta2 );
 	values[AliDielectronVarManager::kDeltaPhi]     = lv1.DeltaPhi(lv2);
 
-       if( Req(kDeltaPhiChargeOrdered) && fgEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * fgEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
+       if( Req(kDeltaPhiChargeOrdered) && GetContext()->fEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * GetContext()->fEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
 	values[AliDielectronVarManager::kPairType]     = pair->GetType();
 
         // Calculate pair variables for corresponding generated pair
@@ -2012,15 +2078,15 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if(Req(kSinPhiH2)) values[AliDielectronVarManager::kSinPhiH2] = TMath::Sin(2*phi);
   Double_t delta=0.0;
   // v2 with respect to VZERO-A event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0ArpH2]);
+  delta = TVector2::Phi_mpi_pi(phi - GetContext()->fData[AliDielectronVarManager::kV0ArpH2]);
   if(Req(kV0ArpH2FlowV2))   values[AliDielectronVarManager::kV0ArpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
   if(Req(kDeltaPhiV0ArpH2)) values[AliDielectronVarManager::kDeltaPhiV0ArpH2] = delta;
   // v2 with respect to VZERO-C event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0CrpH2]);
+  delta = TVector2::Phi_mpi_pi(phi - GetContext()->fData[AliDielectronVarManager::kV0CrpH2]);
   if(Req(kV0CrpH2FlowV2))   values[AliDielectronVarManager::kV0CrpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
   if(Req(kDeltaPhiV0CrpH2)) values[AliDielectronVarManager::kDeltaPhiV0CrpH2] = delta;
   // v2 with respect to the combined VZERO-A and VZERO-C event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0ACrpH2]);
+  delta = TVector2::Phi_mpi_pi(phi - GetContext()->fData[AliDielectronVarManager::kV0ACrpH2]);
   if(Req(kV0ACrpH2FlowV2))   values[AliDielectronVarManager::kV0ACrpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
   if(Req(kDeltaPhiV0ACrpH2)) values[AliDielectronVarManager::kDeltaPhiV0ACrpH2] = delta;
 
@@ -2105,11 +2171,11 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     // fill kPseudoProperTimeResolution
     values[AliDielectronVarManager::kPseudoProperTimeResolution] = -1e10;
     // values[AliDielectronVarManager::kPseudoProperTimePull] = -1e10;
-    if(samemother && fgEvent) {
+    if(samemother && GetContext()->fEvent) {
       if(pair->GetFirstDaughterP()->GetLabel() > 0) {
         const AliVParticle *motherMC = 0x0;
-        if(fgEvent->IsA() == AliESDEvent::Class())  motherMC = (AliMCParticle*)mc->GetMCTrackMother((AliESDtrack*)pair->GetFirstDaughterP());
-        else if(fgEvent->IsA() == AliAODEvent::Class())  motherMC = (AliAODMCParticle*)mc->GetMCTrackMother((AliAODTrack*)pair->GetFirstDaughterP());
+        if(GetContext()->fEvent->IsA() == AliESDEvent::Class())  motherMC = (AliMCParticle*)mc->GetMCTrackMother((AliESDtrack*)pair->GetFirstDaughterP());
+        else if(GetContext()->fEvent->IsA() == AliAODEvent::Class())  motherMC = (AliAODMCParticle*)mc->GetMCTrackMother((AliAODTrack*)pair->GetFirstDaughterP());
         Double_t vtxX, vtxY, vtxZ;
 	if(motherMC && mc->GetPrimaryVertex(vtxX,vtxY,vtxZ)) {
 	  Int_t motherLbl = motherMC->GetLabel();
@@ -2237,9 +2303,11 @@ inline void AliDielectronVarManager::FillVarKFParticle(const AliKFParticle *part
   values[AliDielectronVarManager::kHasCocktailMother]=0;
   values[AliDielectronVarManager::kHasCocktailGrandMother]=0;
 
-//   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
-  for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+//   if ( GetContext()->fEvent ) AliDielectronVarManager::Fill(GetContext()->fEvent, values);
+  if(ReqGroup(kFillEventData)) {
+    for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
+      values[i]=GetContext()->fData[i];
+  }
 
 }
 
@@ -2853,7 +2921,7 @@ inline void AliDielectronVarManager::InitESDpid(Int_t type)
   // type=0 is simulation
   // type=1 is data
 
-  if (!fgPIDResponse) fgPIDResponse=new AliESDpid((Bool_t)(type==0));
+  if (!GetContext()->fPIDResponse) GetContext()->fPIDResponse=new AliESDpid((Bool_t)(type==0));
   Double_t alephParameters[5];
   // simulation
   alephParameters[0] = 2.15898e+00/50.;
@@ -2861,7 +2929,7 @@ inline void AliDielectronVarManager::InitESDpid(Int_t type)
   alephParameters[2] = 3.40030e-09;
   alephParameters[3] = 1.96178e+00;
   alephParameters[4] = 3.91720e+00;
-  fgPIDResponse->GetTOFResponse().SetTimeResolution(80.);
+  GetContext()->fPIDResponse->GetTOFResponse().SetTimeResolution(80.);
 
   // data
   if (type==1){
@@ -2870,20 +2938,20 @@ inline void AliDielectronVarManager::InitESDpid(Int_t type)
     alephParameters[2] = 5.04114e-11;
     alephParameters[3] = 2.12543e+00;
     alephParameters[4] = 4.88663e+00;
-    fgPIDResponse->GetTOFResponse().SetTimeResolution(130.);
-    fgPIDResponse->GetTPCResponse().SetMip(50.);
+    GetContext()->fPIDResponse->GetTOFResponse().SetTimeResolution(130.);
+    GetContext()->fPIDResponse->GetTPCResponse().SetMip(50.);
   }
 
-  fgPIDResponse->GetTPCResponse().SetBetheBlochParameters(
+  GetContext()->fPIDResponse->GetTPCResponse().SetBetheBlochParameters(
     alephParameters[0],alephParameters[1],alephParameters[2],
     alephParameters[3],alephParameters[4]);
 
-  fgPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
+  GetContext()->fPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
 }
 
 inline void AliDielectronVarManager::InitAODpidUtil(Int_t type)
 {
-  if (!fgPIDResponse) fgPIDResponse=new AliAODpidUtil;
+  if (!GetContext()->fPIDResponse) GetContext()->fPIDResponse=new AliAODpidUtil;
   Double_t alephParameters[5];
   // simulation
   alephParameters[0] = 2.15898e+00/50.;
@@ -2891,7 +2959,7 @@ inline void AliDielectronVarManager::InitAODpidUtil(Int_t type)
   alephParameters[2] = 3.40030e-09;
   alephParameters[3] = 1.96178e+00;
   alephParameters[4] = 3.91720e+00;
-  fgPIDResponse->GetTOFResponse().SetTimeResolution(80.);
+  GetContext()->fPIDResponse->GetTOFResponse().SetTimeResolution(80.);
 
   // data
   if (type==1){
@@ -2900,15 +2968,15 @@ inline void AliDielectronVarManager::InitAODpidUtil(Int_t type)
     alephParameters[2] = 5.04114e-11;
     alephParameters[3] = 2.12543e+00;
     alephParameters[4] = 4.88663e+00;
-    fgPIDResponse->GetTOFResponse().SetTimeResolution(130.);
-    fgPIDResponse->GetTPCResponse().SetMip(50.);
+    GetContext()->fPIDResponse->GetTOFResponse().SetTimeResolution(130.);
+    GetContext()->fPIDResponse->GetTPCResponse().SetMip(50.);
   }
 
-  fgPIDResponse->GetTPCResponse().SetBetheBlochParameters(
+  GetContext()->fPIDResponse->GetTPCResponse().SetBetheBlochParameters(
     alephParameters[0],alephParameters[1],alephParameters[2],
     alephParameters[3],alephParameters[4]);
 
-  fgPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
+  GetContext()->fPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
 }
 
 
@@ -3026,7 +3094,7 @@ inline Double_t AliDielectronVarManager::GetSingleLegEff(Double_t * const values
     Int_t dim=eff->GetNdimensions();
     Int_t idx[dim];
     for(Int_t idim=0; idim<dim; idim++) {
-      UInt_t var = GetValueType(eff->GetAxis(idim)->GetName());
+      UInt_t var = (idim<fgNLegEffVars ? fgLegEffVars[idim] : GetValueType(eff->GetAxis(idim)->GetName()));
       idx[idim] = eff->GetAxis(idim)->FindBin(values[var]);
       if(idx[idim] < 0 || idx[idim]>eff->GetAxis(idim)->GetNbins()) return 0.0;
     }
@@ -3047,7 +3115,7 @@ inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
     Int_t dim=eff->GetNdimensions();
     Int_t idx[dim];
     for(Int_t idim=0; idim<dim; idim++) {
-      UInt_t var = GetValueType(eff->GetAxis(idim)->GetName());
+      UInt_t var = (idim<fgNPairEffVars ? fgPairEffVars[idim] : GetValueType(eff->GetAxis(idim)->GetName()));
       idx[idim] = eff->GetAxis(idim)->FindBin(values[var]);
       if(idx[idim] < 0 || idx[idim]>eff->GetAxis(idim)->GetNbins()) return 0.0;
     }
@@ -3057,13 +3125,79 @@ inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
   if(fgPairEffMap->IsA()== TSpline3::Class()) {
     TSpline3 *eff = static_cast<TSpline3*>(fgPairEffMap);
     if(!eff->GetHistogram()) { printf("no histogram added to the spline\n"); return -1.;}
-    UInt_t var = GetValueType(eff->GetHistogram()->GetXaxis()->GetName());
+    UInt_t var = (fgNPairEffVars>0 ? fgPairEffVars[0] : GetValueType(eff->GetHistogram()->GetXaxis()->GetName()));
     return (eff->Eval(values[var]));
   }
 
   return -1.;
 }
 
+inline Int_t AliDielectronVarManager::ResolveEffMapVars(const TObject *map, UInt_t *vars) {
+  //
+  // resolve the variables of the efficiency map axes once, instead of looking
+  // up the axis names for every track or pair; returns -1 if not resolvable
+  //
+  if(!map) return -1;
+
+  if(map->InheritsFrom(THnBase::Class())) {
+    const THnBase *eff = static_cast<const THnBase*>(map);
+    Int_t dim=eff->GetNdimensions();
+    if(dim>kMaxEffMapDim) return -1;
+    for(Int_t idim=0; idim<dim; idim++) vars[idim] = GetValueType(eff->GetAxis(idim)->GetName());
+    return dim;
+  }
+  if(map->IsA()== TSpline3::Class()) {
+    const TSpline3 *eff = static_cast<const TSpline3*>(map);
+    if(!eff->GetHistogram()) return -1;
+    vars[0] = GetValueType(eff->GetHistogram()->GetXaxis()->GetName());
+    return 1;
+  }
+  return -1;
+}
+
+inline UInt_t AliDielectronVarManager::PlanFillGroups(const TBits *map) {
+  //
+  // plan the blocks of unconditional per-track work from the requested
+  // variables; without fill map everything is filled
+  //
+  if(!map) return kFillAllGroups;
+
+  UInt_t groups=0;
+  if(map->TestBitNumber(kNclsSTPC) || map->TestBitNumber(kNclsSFracTPC))
+    groups |= kFillTPCSharedMap;
+  if(map->TestBitNumber(kTPCclsSegments) || map->TestBitNumber(kTPCclsIRO) || map->TestBitNumber(kTPCclsORO))
+    groups |= kFillTPCClusterMap;
+  if(map->TestBitNumber(kPdgCode)           || map->TestBitNumber(kPdgCodeMother)         ||
+     map->TestBitNumber(kPdgCodeGrandMother)|| map->TestBitNumber(kHasCocktailMother)     ||
+     map->TestBitNumber(kHasCocktailGrandMother) || map->TestBitNumber(kNumberOfDaughters) ||
+     map->TestBitNumber(kDistPrimToSecVtxXYMC)   || map->TestBitNumber(kDistPrimToSecVtxZMC))
+    groups |= kFillMCTruth;
+  // event variables are needed by the particle arrays if any pair or event
+  // variable is requested (pair variables are computed from event ones) or
+  // by the particle variables which are computed relative to the event
+  if(map->FirstSetBit(kParticleMax)<(UInt_t)kNMaxValues ||
+     map->TestBitNumber(kLegEff)     || map->TestBitNumber(kOneOverLegEff) ||
+     map->TestBitNumber(kImpactParXY)|| map->TestBitNumber(kImpactParZ)    ||
+     map->TestBitNumber(kDistPrimToSecVtxXYMC) || map->TestBitNumber(kDistPrimToSecVtxZMC))
+    groups |= kFillEventData;
+  return groups;
+}
+
+inline void AliDielectronVarManager::AddDependencies(TBits *map) {
+  //
+  // add to the fill map the variables the requested ones are computed from
+  //
+  if(!map) return;
+
+  if(map->TestBitNumber(kLegEff) || map->TestBitNumber(kOneOverLegEff)) {
+    for(Int_t i=0; i<fgNLegEffVars; ++i) map->SetBitNumber(fgLegEffVars[i], kTRUE);
+  }
+  if(map->TestBitNumber(kPairEff) || map->TestBitNumber(kOneOverPairEff) || map->TestBitNumber(kOneOverPairEffSq)) {
+    for(Int_t i=0; i<fgNPairEffVars; ++i) map->SetBitNumber(fgPairEffVars[i], kTRUE);
+  }
+  GetContext()->ResetFillPlans();
+}
+
 
 inline void AliDielectronVarManager::InitVZEROCalibrationHistograms(Int_t runNo) {
   //
@@ -3207,20 +3341,55 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
 inline void AliDielectronVarManager::SetEvent(AliVEvent * const ev)
 {
 
-  fgEvent = ev;
-  if (fgKFVertex) delete fgKFVertex;
-  fgKFVertex=0x0;
+  GetContext()->fEvent = ev;
+  if (GetContext()->fKFVertex) delete GetContext()->fKFVertex;
+  GetContext()->fKFVertex=0x0;
   if (!ev) return;
-  if (ev->GetPrimaryVertex()) fgKFVertex=new AliKFVertex(*ev->GetPrimaryVertex());
+  if (ev->GetPrimaryVertex()) GetContext()->fKFVertex=new AliKFVertex(*ev->GetPrimaryVertex());
 
-  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
-  AliDielectronVarManager::Fill(fgEvent, fgData);
+  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) GetContext()->fData[i]=0.;
+  AliDielectronVarManager::Fill(GetContext()->fEvent, GetContext()->fData);
 }
 
 inline void AliDielectronVarManager::SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues])
 {
-  for (Int_t i=0; i<kNMaxValues;++i) fgData[i]=0.;
-  for (Int_t i=kPairMax; i<kNMaxValues;++i) fgData[i]=data[i];
+  for (Int_t i=0; i<kNMaxValues;++i) GetContext()->fData[i]=0.;
+  for (Int_t i=kPairMax; i<kNMaxValues;++i) GetContext()->fData[i]=data[i];
+}
+
+inline void AliDielectronVarManager::Fill(VarManagerContext &ctx, const TObject* object, Double_t * const values)
+{
+  //
+  // Fill using the event state of ctx instead of the current context
+  //
+  VarManagerContext *current=GetContext();
+  SetContext(&ctx);
+  Fill(object, values);
+  SetContext(current);
+}
+
+inline void AliDielectronVarManager::SetEvent(VarManagerContext &ctx, AliVEvent * const ev)
+{
+  VarManagerContext *current=GetContext();
+  SetContext(&ctx);
+  SetEvent(ev);
+  SetContext(current);
+}
+
+inline void AliDielectronVarManager::SetEventData(VarManagerContext &ctx, const Double_t data[AliDielectronVarManager::kNMaxValues])
+{
+  VarManagerContext *current=GetContext();
+  SetContext(&ctx);
+  SetEventData(data);
+  SetContext(current);
+}
+
+inline void AliDielectronVarManager::SetTPCEventPlane(VarManagerContext &ctx, AliEventplane *const evplane)
+{
+  VarManagerContext *current=GetContext();
+  SetContext(&ctx);
+  SetTPCEventPlane(evplane);
+  SetContext(current);
 }
 
 
@@ -3235,7 +3404,7 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
   }
 
   Bool_t ok=kFALSE;
-  if(fgEvent) {
+  if(GetContext()->fEvent) {
     AliExternalTrackParam etp; etp.CopyFromVTrack(track);
 
     Float_t xstart = etp.GetX();
@@ -3245,8 +3414,8 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
       return kFALSE;
     }
 
-    AliAODVertex *vtx =(AliAODVertex*)(fgEvent->GetPrimaryVertex());
-    Double_t fBzkG = fgEvent->GetMagneticField(); // z componenent of field in kG
+    AliAODVertex *vtx =(AliAODVertex*)(GetContext()->fEvent->GetPrimaryVertex());
+    Double_t fBzkG = GetContext()->fEvent->GetMagneticField(); // z componenent of field in kG
     ok = etp.PropagateToDCA(vtx,fBzkG,kVeryBig,d0z0,covd0z0);
   }
   if(!ok){
@@ -3259,10 +3428,10 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
 inline void AliDielectronVarManager::SetTPCEventPlane(AliEventplane *const evplane)
 {
 
-  fgTPCEventPlane = evplane;
-  FillVarTPCEventPlane(evplane,fgData);
-  //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
-  //  AliDielectronVarManager::Fill(fgEvent, fgData);
+  GetContext()->fTPCEventPlane = evplane;
+  FillVarTPCEventPlane(evplane,GetContext()->fData);
+  //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) GetContext()->fData[i]=0.;
+  //  AliDielectronVarManager::Fill(GetContext()->fEvent, GetContext()->fData);
 }
 
 
@@ -82,6 +82,10 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fOutputContainer(0),
   fReaderGammas(NULL),
   fGammaCandidates(NULL),
+  fGammaCandidatesStepOne(NULL),
+  fGammaCandidatesStepTwo(NULL),
+  fPhotonSelector(NULL),
+  fPairKinematics(NULL),
   fEventCutArray(NULL),
   fCutArray(NULL),
   fMesonCutArray(NULL),
@@ -290,6 +294,10 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fOutputContainer(0),
   fReaderGammas(NULL),
   fGammaCandidates(NULL),
+  fGammaCandidatesStepOne(NULL),
+  fGammaCandidatesStepTwo(NULL),
+  fPhotonSelector(NULL),
+  fPairKinematics(NULL),
   fEventCutArray(NULL),
   fCutArray(NULL),
   fMesonCutArray(NULL),
@@ -482,6 +490,22 @@ AliAnalysisTaskGammaConvV1::~AliAnalysisTaskGammaConvV1()
     delete fGammaCandidates;
     fGammaCandidates = 0x0;
   }
+  if(fGammaCandidatesStepOne){
+    delete fGammaCandidatesStepOne;
+    fGammaCandidatesStepOne = 0x0;
+  }
+  if(fGammaCandidatesStepTwo){
+    delete fGammaCandidatesStepTwo;
+    fGammaCandidatesStepTwo = 0x0;
+  }
+  if(fPhotonSelector){
+    delete fPhotonSelector;
+    fPhotonSelector = 0x0;
+  }
+  if(fPairKinematics){
+    delete fPairKinematics;
+    fPairKinematics = 0x0;
+  }
   if(fBGHandler){
     delete[] fBGHandler;
     fBGHandler = 0x0;
@@ -602,6 +626,14 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
 
   // Array of current cut's gammas
   fGammaCandidates          = new TList();
+  fGammaCandidatesStepOne   = new TList();
+  fGammaCandidatesStepTwo   = new TList();
+
+  // Photon selection of all cuts
+  fPhotonSelector           = new AliConversionPhotonMultiCutSelector(fCutArray);
+
+  // Photon pairs of the meson analysis
+  fPairKinematics           = new AliConversionPairKinematics();
 
   fCutFolder                = new TList*[fnCuts];
   fESDList                  = new TList*[fnCuts];
@@ -1638,6 +1670,10 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
     RelabelAODPhotonCandidates(kTRUE);    // In case of AODMC relabeling MC
     fV0Reader->RelabelAODs(kTRUE);
   }
+
+  // Track lookups of the photon candidates, shared by all cuts
+  fPhotonSelector->ProcessEvent(fInputEvent,fReaderGammas);
+
   for(Int_t iCut = 0; iCut<fnCuts; iCut++){
     fiCut = iCut;
     
@@ -1827,8 +1863,10 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
 void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
 {
   Int_t nV0 = 0;
-  TList *GammaCandidatesStepOne = new TList();
-  TList *GammaCandidatesStepTwo = new TList();
+  TList *GammaCandidatesStepOne = fGammaCandidatesStepOne;
+  TList *GammaCandidatesStepTwo = fGammaCandidatesStepTwo;
+  GammaCandidatesStepOne->Clear();
+  GammaCandidatesStepTwo->Clear();
   // Loop over Photon Candidates allocated by ReaderV1
   for(Int_t i = 0; i < fReaderGammas->GetEntriesFast(); i++){
     AliAODConversionPhoton* PhotonCandidate = (AliAODConversionPhoton*) fReaderGammas->At(i);
@@ -1845,8 +1883,7 @@ void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
       if( (isNegFromMBHeader+isPosFromMBHeader) != 4) fIsFromMBHeader = kFALSE;
     }
   
-    if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent)) continue;
-    if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->InPlaneOutOfPlaneCut(PhotonCandidate->GetPhotonPhi(),fEventPlaneAngle)) continue;
+    if(!fPhotonSelector->IsSelected(i,fiCut,fEventPlaneAngle)) continue; // PhotonIsSelected and InPlaneOutOfPlaneCut
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseElecSharingCut() &&
       !((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseToCloseV0sCut()){
       fGammaCandidates->Add(PhotonCandidate); // if no second loop is required add to events good gammas
@@ -2017,10 +2054,8 @@ void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
     }
   }
 
-  delete GammaCandidatesStepOne;
-  GammaCandidatesStepOne = 0x0;
-  delete GammaCandidatesStepTwo;
-  GammaCandidatesStepTwo = 0x0;
+  GammaCandidatesStepOne->Clear();
+  GammaCandidatesStepTwo->Clear();
 
 }
 //________________________________________________________________________
@@ -2859,6 +2894,12 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
 
   // Conversion Gammas
   if(fGammaCandidates->GetEntries()>1){
+    // Kinematics of all pairs in one pass; mother objects are only created
+    // for the pairs passing the kinematic meson cuts
+    fPairKinematics->Clear();
+    for(Int_t gammaIndex=0;gammaIndex<fGammaCandidates->GetEntries();gammaIndex++){
+      fPairKinematics->AddPhoton((AliAODConversionPhoton*)fGammaCandidates->At(gammaIndex));
+    }
     for(Int_t firstGammaIndex=0;firstGammaIndex<fGammaCandidates->GetEntries()-1;firstGammaIndex++){
       AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fGammaCandidates->At(firstGammaIndex));
       if (gamma0==NULL) continue;
@@ -2870,110 +2911,125 @@ void AliAnalysisTaskGammaConvV1::CalculatePi0Candidates(){
         gamma0->GetTrackLabelNegative() == gamma1->GetTrackLabelNegative() ||
         gamma0->GetTrackLabelNegative() == gamma1->GetTrackLabelPositive() ||
         gamma0->GetTrackLabelPositive() == gamma1->GetTrackLabelNegative() ) continue;
-
-        AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
-        pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
-        pi0cand->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+        fPairKinematics->AddPair(firstGammaIndex,secondGammaIndex);
+      }
+    }
+    fPairKinematics->Compute();
+
+    AliConversionMesonCuts *mesonCuts = (AliConversionMesonCuts*)fMesonCutArray->At(fiCut);
+    Double_t etaShift = ((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift();
+    for(Int_t iPair=0;iPair<fPairKinematics->GetNPairs();iPair++){
+      Int_t cutIndex = 0;
+      if(!mesonCuts->MesonIsSelectedKinematics(fPairKinematics->Pt(iPair),fPairKinematics->E(iPair),fPairKinematics->Pz(iPair),fPairKinematics->M(iPair),
+                                               fPairKinematics->Rapidity(iPair),fPairKinematics->OpeningAngle(iPair),fPairKinematics->Alpha(iPair),
+                                               kTRUE,etaShift,cutIndex)) continue;
+      Int_t firstGammaIndex = fPairKinematics->GetFirst(iPair);
+      Int_t secondGammaIndex = fPairKinematics->GetSecond(iPair);
+      AliAODConversionPhoton *gamma0=(AliAODConversionPhoton*)fGammaCandidates->At(firstGammaIndex);
+      AliAODConversionPhoton *gamma1=(AliAODConversionPhoton*)fGammaCandidates->At(secondGammaIndex);
+
+      AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
+      pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
+      pi0cand->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+      
+      if(mesonCuts->MesonIsSelectedDCA(pi0cand,kTRUE,cutIndex)){
+        if(fDoCentralityFlat > 0){
+          fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
+          if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(), fWeightCentrality[fiCut]*fWeightJetJetMC);
+        } else {
+          fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
+          if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(),fWeightJetJetMC);
+        }
         
-        if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->MesonIsSelected(pi0cand,kTRUE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-          if(fDoCentralityFlat > 0){
-            fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-            if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-          } else {
-            fHistoMotherInvMassPt[fiCut]->Fill(pi0cand->M(),pi0cand->Pt(),fWeightJetJetMC);
-            if(TMath::Abs(pi0cand->GetAlpha())<0.1) fHistoMotherInvMassEalpha[fiCut]->Fill(pi0cand->M(),pi0cand->E(),fWeightJetJetMC);
+        if (fDoMesonQA > 0){
+
+          if(fDoMesonQA == 3 && TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius())<10 && pi0cand->GetOpeningAngle()<0.1){
+                  Double_t sparesFill[4] = {gamma0->GetPhotonPt(),gamma0->GetConversionRadius(),TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius()),pi0cand->GetOpeningAngle()};
+                  sPtRDeltaROpenAngle[fiCut]->Fill(sparesFill, 1);
           }
-          
-          if (fDoMesonQA > 0){
 
-            if(fDoMesonQA == 3 && TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius())<10 && pi0cand->GetOpeningAngle()<0.1){
-                    Double_t sparesFill[4] = {gamma0->GetPhotonPt(),gamma0->GetConversionRadius(),TMath::Abs(gamma0->GetConversionRadius()-gamma1->GetConversionRadius()),pi0cand->GetOpeningAngle()};
-                    sPtRDeltaROpenAngle[fiCut]->Fill(sparesFill, 1);
+          if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
+            if (fIsMC < 2){
+              fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
+              fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
             }
-
-            if ( pi0cand->M() > 0.05 && pi0cand->M() < 0.17){
-              if (fIsMC < 2){
-                fHistoMotherPi0PtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
-                fHistoMotherPi0PtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
-              }
-              fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),fWeightJetJetMC);
-              
+            fHistoMotherPi0PtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),fWeightJetJetMC);
+            
+          } 
+          if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
+            if (fIsMC < 2){
+              fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
+              fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
             } 
-            if ( pi0cand->M() > 0.45 && pi0cand->M() < 0.65){
-              if (fIsMC < 2){
-                fHistoMotherEtaPtY[fiCut]->Fill(pi0cand->Pt(),pi0cand->Rapidity()-((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
-                fHistoMotherEtaPtOpenAngle[fiCut]->Fill(pi0cand->Pt(),pi0cand->GetOpeningAngle());
-              } 
-              fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),fWeightJetJetMC);
-            }
-          }   
-          if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
-            Int_t psibin = 0;
-            Int_t zbin = 0;
-            Int_t mbin = 0;
-
-            Double_t sparesFill[4];
-            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
-              zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
-              if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
-              } else {
-                mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
-              }
-              sparesFill[0] = pi0cand->M();
-              sparesFill[1] = pi0cand->Pt();
-              sparesFill[2] = (Double_t)zbin; 
-              sparesFill[3] = (Double_t)mbin;
+            fHistoMotherEtaPtAlpha[fiCut]->Fill(pi0cand->Pt(),TMath::Abs(pi0cand->GetAlpha()),fWeightJetJetMC);
+          }
+        }   
+        if(fDoTHnSparse && ((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->DoBGCalculation()){
+          Int_t psibin = 0;
+          Int_t zbin = 0;
+          Int_t mbin = 0;
+
+          Double_t sparesFill[4];
+          if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->BackgroundHandlerType() == 0){
+            zbin = fBGHandler[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+            if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
             } else {
-              psibin = fBGHandlerRP[fiCut]->GetRPBinIndex(TMath::Abs(fEventPlaneAngle));
-              zbin = fBGHandlerRP[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
+              mbin = fBGHandler[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
+            }
+            sparesFill[0] = pi0cand->M();
+            sparesFill[1] = pi0cand->Pt();
+            sparesFill[2] = (Double_t)zbin; 
+            sparesFill[3] = (Double_t)mbin;
+          } else {
+            psibin = fBGHandlerRP[fiCut]->GetRPBinIndex(TMath::Abs(fEventPlaneAngle));
+            zbin = fBGHandlerRP[fiCut]->GetZBinIndex(fInputEvent->GetPrimaryVertex()->GetZ());
 //               if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
 //                 mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fV0Reader->GetNumberOfPrimaryTracks());
 //               } else {
 //                 mbin = fBGHandlerRP[fiCut]->GetMultiplicityBinIndex(fGammaCandidates->GetEntries());
 //               }
-              sparesFill[0] = pi0cand->M();
-              sparesFill[1] = pi0cand->Pt();
-              sparesFill[2] = (Double_t)zbin; 
-              sparesFill[3] = (Double_t)psibin;              
-            }
-//             Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
-            if(fDoCentralityFlat > 0) sESDMotherInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
-            else  sESDMotherInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
+            sparesFill[0] = pi0cand->M();
+            sparesFill[1] = pi0cand->Pt();
+            sparesFill[2] = (Double_t)zbin; 
+            sparesFill[3] = (Double_t)psibin;              
           }
-          
+//             Double_t sparesFill[4] = {pi0cand->M(),pi0cand->Pt(),(Double_t)zbin,(Double_t)mbin};
+          if(fDoCentralityFlat > 0) sESDMotherInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
+          else  sESDMotherInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
+        }
+        
 
-          if( fIsMC > 0 ){
-            if(fInputEvent->IsA()==AliESDEvent::Class())
-              ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1);
-            if(fInputEvent->IsA()==AliAODEvent::Class())
-              ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1);
-          }
-          if (fDoMesonQA == 2){
-            fInvMass = pi0cand->M();
-            fPt  = pi0cand->Pt();
-            if (TMath::Abs(gamma0->GetDCAzToPrimVtx()) < TMath::Abs(gamma1->GetDCAzToPrimVtx())){
-              fDCAzGammaMin = gamma0->GetDCAzToPrimVtx();
-              fDCAzGammaMax = gamma1->GetDCAzToPrimVtx();
-            } else {
-              fDCAzGammaMin = gamma1->GetDCAzToPrimVtx();
-              fDCAzGammaMax = gamma0->GetDCAzToPrimVtx();
-            }
-            iFlag = pi0cand->GetMesonQuality();
-    //                   cout << "gamma 0: " << gamma0->GetV0Index()<< "\t" << gamma0->GetPx() << "\t" << gamma0->GetPy() << "\t" <<  gamma0->GetPz() << "\t" << endl; 
-    //                   cout << "gamma 1: " << gamma1->GetV0Index()<< "\t"<< gamma1->GetPx() << "\t" << gamma1->GetPy() << "\t" <<  gamma1->GetPz() << "\t" << endl; 
-    //                    cout << "pi0: "<<fInvMass << "\t" << fPt <<"\t" << fDCAzGammaMin << "\t" << fDCAzGammaMax << "\t" << (Int_t)iFlag << "\t" << (Int_t)iMesonMCInfo <<endl;
-            if (fIsHeavyIon == 1 && fPt > 0.399 && fPt < 20. ) {
-              if (fInvMass > 0.08 && fInvMass < 0.2) tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
-              if ((fInvMass > 0.45 && fInvMass < 0.6) &&  (fPt > 0.999 && fPt < 20.) )tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
-            } else if (fPt > 0.299 && fPt < 20. )  {
-              if ( (fInvMass > 0.08 && fInvMass < 0.6) ) tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
-            }   
+        if( fIsMC > 0 ){
+          if(fInputEvent->IsA()==AliESDEvent::Class())
+            ProcessTrueMesonCandidates(pi0cand,gamma0,gamma1);
+          if(fInputEvent->IsA()==AliAODEvent::Class())
+            ProcessTrueMesonCandidatesAOD(pi0cand,gamma0,gamma1);
+        }
+        if (fDoMesonQA == 2){
+          fInvMass = pi0cand->M();
+          fPt  = pi0cand->Pt();
+          if (TMath::Abs(gamma0->GetDCAzToPrimVtx()) < TMath::Abs(gamma1->GetDCAzToPrimVtx())){
+            fDCAzGammaMin = gamma0->GetDCAzToPrimVtx();
+            fDCAzGammaMax = gamma1->GetDCAzToPrimVtx();
+          } else {
+            fDCAzGammaMin = gamma1->GetDCAzToPrimVtx();
+            fDCAzGammaMax = gamma0->GetDCAzToPrimVtx();
           }
+          iFlag = pi0cand->GetMesonQuality();
+  //                   cout << "gamma 0: " << gamma0->GetV0Index()<< "\t" << gamma0->GetPx() << "\t" << gamma0->GetPy() << "\t" <<  gamma0->GetPz() << "\t" << endl; 
+  //                   cout << "gamma 1: " << gamma1->GetV0Index()<< "\t"<< gamma1->GetPx() << "\t" << gamma1->GetPy() << "\t" <<  gamma1->GetPz() << "\t" << endl; 
+  //                    cout << "pi0: "<<fInvMass << "\t" << fPt <<"\t" << fDCAzGammaMin << "\t" << fDCAzGammaMax << "\t" << (Int_t)iFlag << "\t" << (Int_t)iMesonMCInfo <<endl;
+          if (fIsHeavyIon == 1 && fPt > 0.399 && fPt < 20. ) {
+            if (fInvMass > 0.08 && fInvMass < 0.2) tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
+            if ((fInvMass > 0.45 && fInvMass < 0.6) &&  (fPt > 0.999 && fPt < 20.) )tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
+          } else if (fPt > 0.299 && fPt < 20. )  {
+            if ( (fInvMass > 0.08 && fInvMass < 0.6) ) tESDMesonsInvMassPtDcazMinDcazMaxFlag[fiCut]->Fill();
+          }   
         }
-        delete pi0cand;
-        pi0cand=0x0;
       }
+      delete pi0cand;
+      pi0cand=0x0;
     }
   }
 }
@@ -3446,85 +3502,80 @@ void AliAnalysisTaskGammaConvV1::CalculateBackground(){
     }
   } else {
     AliGammaConversionAODBGHandler::GammaConversionVertex *bgEventVertex = NULL;
+    AliConversionMesonCuts *mesonCuts = (AliConversionMesonCuts*)fMesonCutArray->At(fiCut);
+    Double_t etaShift = ((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift();
+    Int_t nCurrent = fGammaCandidates->GetEntries();
+    vector<AliAODConversionPhoton> previousGoodV0s;
+    AliGammaConversionAODVector previousGoodV0Pointers;
+
+    for(Int_t nEventsInBG=0;nEventsInBG <fBGHandler[fiCut]->GetNBGEvents();nEventsInBG++){
+      AliGammaConversionAODVector *previousEventV0s = fBGHandler[fiCut]->GetBGGoodV0s(zbin,mbin,nEventsInBG);
+      if(!previousEventV0s) continue;
+      if(fMoveParticleAccordingToVertex == kTRUE || ((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
+        bgEventVertex = fBGHandler[fiCut]->GetBGEventVertex(zbin,mbin,nEventsInBG);
+      }
 
-    if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))->UseTrackMultiplicity()){
-      for(Int_t nEventsInBG=0;nEventsInBG<fBGHandler[fiCut]->GetNBGEvents();nEventsInBG++){
-        AliGammaConversionAODVector *previousEventV0s = fBGHandler[fiCut]->GetBGGoodV0s(zbin,mbin,nEventsInBG);
-        if(fMoveParticleAccordingToVertex == kTRUE || ((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
-          bgEventVertex = fBGHandler[fiCut]->GetBGEventVertex(zbin,mbin,nEventsInBG);
-        }
-
-        for(Int_t iCurrent=0;iCurrent<fGammaCandidates->GetEntries();iCurrent++){
-        AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fGammaCandidates->At(iCurrent));
-        for(Int_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
-          AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-          if(fMoveParticleAccordingToVertex == kTRUE){
-            MoveParticleAccordingToVertex(&previousGoodV0,bgEventVertex);
-          }
-          if(((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
-            RotateParticleAccordingToEP(&previousGoodV0,bgEventVertex->fEP,fEventPlaneAngle);
-          }
-          
-          AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
-          backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
-          if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))
-            ->MesonIsSelected(backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-            if(fDoCentralityFlat > 0) fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-            else fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(),fWeightJetJetMC);
-            if(fDoTHnSparse){
-              Double_t sparesFill[4] = {backgroundCandidate->M(),backgroundCandidate->Pt(),(Double_t)zbin,(Double_t)mbin};
-              if(fDoCentralityFlat > 0) sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
-              else sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
-            }
-          }
-          delete backgroundCandidate;
-          backgroundCandidate = 0x0;
+      // Copies of the previous event photons, moved to the vertex and event plane of this event once
+      previousGoodV0s.clear();
+      previousGoodV0s.reserve(previousEventV0s->size());
+      previousGoodV0Pointers.clear();
+      for(UInt_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
+        previousGoodV0s.push_back(*(previousEventV0s->at(iPrevious)));
+        if(fMoveParticleAccordingToVertex == kTRUE){
+          MoveParticleAccordingToVertex(&previousGoodV0s.back(),bgEventVertex);
         }
+        if(((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
+          RotateParticleAccordingToEP(&previousGoodV0s.back(),bgEventVertex->fEP,fEventPlaneAngle);
         }
       }
-    } else {
-      for(Int_t nEventsInBG=0;nEventsInBG <fBGHandler[fiCut]->GetNBGEvents();nEventsInBG++){
-        AliGammaConversionAODVector *previousEventV0s = fBGHandler[fiCut]->GetBGGoodV0s(zbin,mbin,nEventsInBG);
-        if(previousEventV0s){
-        if(fMoveParticleAccordingToVertex == kTRUE || ((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
-          bgEventVertex = fBGHandler[fiCut]->GetBGEventVertex(zbin,mbin,nEventsInBG);
-        }
-        for(Int_t iCurrent=0;iCurrent<fGammaCandidates->GetEntries();iCurrent++){
-          AliAODConversionPhoton currentEventGoodV0 = *(AliAODConversionPhoton*)(fGammaCandidates->At(iCurrent));
-          for(Int_t iPrevious=0;iPrevious<previousEventV0s->size();iPrevious++){
-
-            AliAODConversionPhoton previousGoodV0 = (AliAODConversionPhoton)(*(previousEventV0s->at(iPrevious)));
-
-            if(fMoveParticleAccordingToVertex == kTRUE){
-              MoveParticleAccordingToVertex(&previousGoodV0,bgEventVertex);
-            }
-            if(((AliConversionPhotonCuts*)fCutArray->At(fiCut))->GetInPlaneOutOfPlaneCut() != 0){
-              RotateParticleAccordingToEP(&previousGoodV0,bgEventVertex->fEP,fEventPlaneAngle);
-            }
-
-
-            AliAODConversionMother *backgroundCandidate = new AliAODConversionMother(&currentEventGoodV0,&previousGoodV0);
-            backgroundCandidate->CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
-            if((((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))
-              ->MesonIsSelected(backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift()))){
-              if(fDoCentralityFlat > 0) fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-              else fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate->M(),backgroundCandidate->Pt(),fWeightJetJetMC);
-              if(fDoTHnSparse){
-                Double_t sparesFill[4] = {backgroundCandidate->M(),backgroundCandidate->Pt(),(Double_t)zbin,(Double_t)mbin};
-                if(fDoCentralityFlat > 0) sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
-                else sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
-              }
-            }
-            delete backgroundCandidate;
-            backgroundCandidate = 0x0;
+      for(UInt_t iPrevious=0;iPrevious<previousGoodV0s.size();iPrevious++) previousGoodV0Pointers.push_back(&previousGoodV0s[iPrevious]);
+      SetMixedEventPairs(previousGoodV0Pointers);
+
+      for(Int_t iPair=0;iPair<fPairKinematics->GetNPairs();iPair++){
+        Int_t cutIndex = 0;
+        if(!mesonCuts->MesonIsSelectedKinematics(fPairKinematics->Pt(iPair),fPairKinematics->E(iPair),fPairKinematics->Pz(iPair),fPairKinematics->M(iPair),
+                                                 fPairKinematics->Rapidity(iPair),fPairKinematics->OpeningAngle(iPair),fPairKinematics->Alpha(iPair),
+                                                 kFALSE,etaShift,cutIndex)) continue;
+        AliAODConversionPhoton *currentEventGoodV0 = (AliAODConversionPhoton*)(fGammaCandidates->At(fPairKinematics->GetFirst(iPair)));
+        AliAODConversionPhoton *previousGoodV0 = previousGoodV0Pointers[fPairKinematics->GetSecond(iPair)-nCurrent];
+
+        AliAODConversionMother backgroundCandidate(currentEventGoodV0,previousGoodV0);
+        backgroundCandidate.CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+        if(mesonCuts->MesonIsSelectedDCA(&backgroundCandidate,kFALSE,cutIndex)){
+          if(fDoCentralityFlat > 0) fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
+          else fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(),fWeightJetJetMC);
+          if(fDoTHnSparse){
+            Double_t sparesFill[4] = {backgroundCandidate.M(),backgroundCandidate.Pt(),(Double_t)zbin,(Double_t)mbin};
+            if(fDoCentralityFlat > 0) sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightCentrality[fiCut]*fWeightJetJetMC); //instead of weight 1
+            else sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill, fWeightJetJetMC);
           }
         }
-        }
       }
     }
   }
 }
 //________________________________________________________________________
+void AliAnalysisTaskGammaConvV1::SetMixedEventPairs(const AliGammaConversionAODVector &previousEventGammas){
+  // Pairs of all photons of the current event with all photons of a
+  // previous event, in the order current (outer) x previous (inner).
+  // The previous event photons have indices shifted by the number of
+  // current photons
+  fPairKinematics->Clear();
+  Int_t nCurrent = fGammaCandidates->GetEntries();
+  for(Int_t iCurrent=0;iCurrent<nCurrent;iCurrent++){
+    fPairKinematics->AddPhoton((AliAODConversionPhoton*)(fGammaCandidates->At(iCurrent)));
+  }
+  for(UInt_t iPrevious=0;iPrevious<previousEventGammas.size();iPrevious++){
+    fPairKinematics->AddPhoton(previousEventGammas[iPrevious]);
+  }
+  for(Int_t iCurrent=0;iCurrent<nCurrent;iCurrent++){
+    for(UInt_t iPrevious=0;iPrevious<previousEventGammas.size();iPrevious++){
+      fPairKinematics->AddPair(iCurrent,nCurrent+iPrevious);
+    }
+  }
+  fPairKinematics->Compute();
+}
+//________________________________________________________________________
 void AliAnalysisTaskGammaConvV1::CalculateBackgroundRP(){
 
   Int_t psibin = 0;
@@ -3588,28 +3639,31 @@ void AliAnalysisTaskGammaConvV1::CalculateBackgroundRP(){
         // but BG leads to N_{a}*N_{b} combinations
         weight*=0.5*(Double_t(fGammaCandidates->GetEntries()-1))/Double_t(previousEventGammas->size());
 
-        for(Int_t iCurrent=0;iCurrent<fGammaCandidates->GetEntries();iCurrent++){
+        AliConversionMesonCuts *mesonCuts = (AliConversionMesonCuts*)fMesonCutArray->At(fiCut);
+        Double_t etaShift = ((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift();
+        Int_t nCurrent = fGammaCandidates->GetEntries();
+        SetMixedEventPairs(*previousEventGammas);
 
-                    AliAODConversionPhoton *gamma0 = (AliAODConversionPhoton*)(fGammaCandidates->At(iCurrent));
+        for(Int_t iPair=0;iPair<fPairKinematics->GetNPairs();iPair++){
+          Int_t cutIndex = 0;
+          if(!mesonCuts->MesonIsSelectedKinematics(fPairKinematics->Pt(iPair),fPairKinematics->E(iPair),fPairKinematics->Pz(iPair),fPairKinematics->M(iPair),
+                                                   fPairKinematics->Rapidity(iPair),fPairKinematics->OpeningAngle(iPair),fPairKinematics->Alpha(iPair),
+                                                   kFALSE,etaShift,cutIndex)) continue;
+          AliAODConversionPhoton *gamma0 = (AliAODConversionPhoton*)(fGammaCandidates->At(fPairKinematics->GetFirst(iPair)));
+          AliAODConversionPhoton *gamma1 = (AliAODConversionPhoton*)(previousEventGammas->at(fPairKinematics->GetSecond(iPair)-nCurrent));
 
-                    for(Int_t iPrevious=0;iPrevious<previousEventGammas->size();iPrevious++){
-
-                        AliAODConversionPhoton *gamma1 = (AliAODConversionPhoton*)(previousEventGammas->at(iPrevious));
-
-                        AliAODConversionMother backgroundCandidate(gamma0,gamma1);
-                        backgroundCandidate.CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
-                        if(((AliConversionMesonCuts*)fMesonCutArray->At(fiCut))
-                            ->MesonIsSelected(&backgroundCandidate,kFALSE,((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift())){
-                            if(fDoCentralityFlat > 0) fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
-              else fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(),fWeightJetJetMC);
-                            if(fDoTHnSparse){
-//                              Double_t sparesFill[4] = {backgroundCandidate.M(),backgroundCandidate.Pt(),(Double_t)zbin,(Double_t)mbin};
-                                Double_t sparesFill[4] = {backgroundCandidate.M(),backgroundCandidate.Pt(),(Double_t)zbin,(Double_t)psibin};
-                                if(fDoCentralityFlat > 0) sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill,weight*fWeightCentrality[fiCut]*fWeightJetJetMC);
-                                else sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill,weight*fWeightJetJetMC);   
-                            }
-                        }
-                    }
+          AliAODConversionMother backgroundCandidate(gamma0,gamma1);
+          backgroundCandidate.CalculateDistanceOfClossetApproachToPrimVtx(fInputEvent->GetPrimaryVertex());
+          if(mesonCuts->MesonIsSelectedDCA(&backgroundCandidate,kFALSE,cutIndex)){
+            if(fDoCentralityFlat > 0) fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(), fWeightCentrality[fiCut]*fWeightJetJetMC);
+            else fHistoMotherBackInvMassPt[fiCut]->Fill(backgroundCandidate.M(),backgroundCandidate.Pt(),fWeightJetJetMC);
+            if(fDoTHnSparse){
+//              Double_t sparesFill[4] = {backgroundCandidate.M(),backgroundCandidate.Pt(),(Double_t)zbin,(Double_t)mbin};
+              Double_t sparesFill[4] = {backgroundCandidate.M(),backgroundCandidate.Pt(),(Double_t)zbin,(Double_t)psibin};
+              if(fDoCentralityFlat > 0) sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill,weight*fWeightCentrality[fiCut]*fWeightJetJetMC);
+              else sESDMotherBackInvMassPtZM[fiCut]->Fill(sparesFill,weight*fWeightJetJetMC);   
+            }
+          }
         }
       }
     }
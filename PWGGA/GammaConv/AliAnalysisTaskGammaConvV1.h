@@ -10,6 +10,8 @@
 #include "AliGammaConversionAODBGHandler.h"
 #include "AliConversionAODBGHandlerRP.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionPhotonMultiCutSelector.h"
+#include "AliConversionPairKinematics.h"
 #include "AliAnalysisManager.h"
 #include "TProfile2D.h"
 #include "TH3.h"
@@ -48,6 +50,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void CalculatePi0Candidates();
     void CalculateBackground();
     void CalculateBackgroundRP();
+    void SetMixedEventPairs(const AliGammaConversionAODVector &previousEventGammas);
     void ProcessMCParticles();
     void ProcessAODMCParticles();
     void RelabelAODPhotonCandidates(Bool_t mode);
@@ -105,6 +108,10 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     TList*                            fOutputContainer;                           //
     TClonesArray*                     fReaderGammas;                              //
     TList*                            fGammaCandidates;                           //
+    TList*                            fGammaCandidatesStepOne;                    //! candidates for the shared electron cut, reused for each cut
+    TList*                            fGammaCandidatesStepTwo;                    //! candidates for the too close V0s cut, reused for each cut
+    AliConversionPhotonMultiCutSelector* fPhotonSelector;                         //! track lookups shared by the photon selection of all cuts
+    AliConversionPairKinematics*      fPairKinematics;                            //! kinematics of the photon pairs, reused for each cut
     TList*                            fEventCutArray;                             //
     TList*                            fCutArray;                                  //
     TList*                            fMesonCutArray;                             //
@@ -305,7 +312,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 39);
+    ClassDef(AliAnalysisTaskGammaConvV1, 41);
 };
 
 #endif
@@ -797,19 +797,37 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   // Selection of reconstructed Meson candidates
   // Use flag IsSignal in order to fill Fill different
   // histograms for Signal and Background
+  // The kinematic cuts and the DCA cuts can also be applied separately,
+  // see MesonIsSelectedKinematics and MesonIsSelectedDCA
+  Double_t rapidity = 0.;
+  if((pi0->E()+pi0->Pz())/(pi0->E()-pi0->Pz())>0) rapidity = pi0->Rapidity();
+
+  Int_t cutIndex=0;
+  if(!MesonIsSelectedKinematics(pi0->Pt(),pi0->E(),pi0->Pz(),pi0->M(),rapidity,pi0->GetOpeningAngle(),pi0->GetAlpha(),IsSignal,fRapidityShift,cutIndex)) return kFALSE;
+  return MesonIsSelectedDCA(pi0,IsSignal,cutIndex);
+}
+
+//________________________________________________________________________
+Bool_t AliConversionMesonCuts::MesonIsSelectedKinematics(Double_t pt, Double_t e, Double_t pz, Double_t m, Double_t rapidity, Double_t openingAngle, Double_t alpha,
+                                                         Bool_t IsSignal, Double_t fRapidityShift, Int_t &cutIndex)
+{
+  // Rapidity, mass, opening angle and alpha cuts of MesonIsSelected, on the
+  // kinematics of the candidate. Allows to reject pairs before an
+  // AliAODConversionMother is created. cutIndex is the index of the next cut,
+  // to be passed to MesonIsSelectedDCA
   TH2 *hist=0x0;
 
   if(IsSignal){hist=fHistoMesonCuts;}
   else{hist=fHistoMesonBGCuts;}
 
-  Int_t cutIndex=0;
+  cutIndex=0;
 
-  if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if(hist)hist->Fill(cutIndex, pt);
   cutIndex++;
 
   // Undefined Rapidity -> Floating Point exception
-  if((pi0->E()+pi0->Pz())/(pi0->E()-pi0->Pz())<=0){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if((e+pz)/(e-pz)<=0){
+    if(hist)hist->Fill(cutIndex, pt);
     cutIndex++;
     if (!IsSignal)cout << "undefined rapidity" << endl;
     return kFALSE;
@@ -817,22 +835,22 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   else{
     // PseudoRapidity Cut --> But we cut on Rapidity !!!
     cutIndex++;
-    if(TMath::Abs(pi0->Rapidity()-fRapidityShift)>fRapidityCutMeson){
-      if(hist)hist->Fill(cutIndex, pi0->Pt());
+    if(TMath::Abs(rapidity-fRapidityShift)>fRapidityCutMeson){
+      if(hist)hist->Fill(cutIndex, pt);
       return kFALSE;
     }
   }
   cutIndex++;
 
-  if (fHistoInvMassBefore) fHistoInvMassBefore->Fill(pi0->M());
+  if (fHistoInvMassBefore) fHistoInvMassBefore->Fill(m);
   // Mass cut
   if (fIsMergedClusterCut == 1 ){
     if (fEnableMassCut){
-      Double_t massMin = FunctionMinMassCut(pi0->E());
-      Double_t massMax = FunctionMaxMassCut(pi0->E());
-  //     cout << "Min mass: " << massMin << "\t max Mass: " << massMax << "\t mass current: " <<  pi0->M()<< "\t E current: " << pi0->E() << endl;
-      if (pi0->M() > massMax || pi0->M() < massMin ){
-        if(hist)hist->Fill(cutIndex, pi0->Pt());
+      Double_t massMin = FunctionMinMassCut(e);
+      Double_t massMax = FunctionMaxMassCut(e);
+  //     cout << "Min mass: " << massMin << "\t max Mass: " << massMax << "\t mass current: " <<  m << "\t E current: " << e << endl;
+      if (m > massMax || m < massMin ){
+        if(hist)hist->Fill(cutIndex, pt);
         return kFALSE;
       }
     }  
@@ -841,47 +859,60 @@ Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_
   
   // Opening Angle Cut
   //fOpeningAngle=2*TMath::ATan(0.134/pi0->P());// physical minimum opening angle
-  if( fEnableMinOpeningAngleCut && pi0->GetOpeningAngle() < fOpeningAngle){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if( fEnableMinOpeningAngleCut && openingAngle < fOpeningAngle){
+    if(hist)hist->Fill(cutIndex, pt);
     return kFALSE;
   }
 
   // Min Opening Angle
-  if (fMinOpanPtDepCut == kTRUE) fMinOpanCutMeson = fFMinOpanCut->Eval(pi0->Pt());
+  if (fMinOpanPtDepCut == kTRUE) fMinOpanCutMeson = fFMinOpanCut->Eval(pt);
 
-  if (pi0->GetOpeningAngle() < fMinOpanCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if (openingAngle < fMinOpanCutMeson){
+    if(hist)hist->Fill(cutIndex, pt);
     return kFALSE;
   }
 
   // Max Opening Angle
-  if (fMaxOpanPtDepCut == kTRUE) fMaxOpanCutMeson = fFMaxOpanCut->Eval(pi0->Pt());
+  if (fMaxOpanPtDepCut == kTRUE) fMaxOpanCutMeson = fFMaxOpanCut->Eval(pt);
 
-  if( pi0->GetOpeningAngle() > fMaxOpanCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if( openingAngle > fMaxOpanCutMeson){
+    if(hist)hist->Fill(cutIndex, pt);
     return kFALSE;
   }
   cutIndex++;
   
   // Alpha Max Cut
-  if (fIsMergedClusterCut == 1 && fAlphaPtDepCut) fAlphaCutMeson = fFAlphaCut->Eval(pi0->E());
-  else if (fAlphaPtDepCut == kTRUE) fAlphaCutMeson = fFAlphaCut->Eval(pi0->Pt());
+  if (fIsMergedClusterCut == 1 && fAlphaPtDepCut) fAlphaCutMeson = fFAlphaCut->Eval(e);
+  else if (fAlphaPtDepCut == kTRUE) fAlphaCutMeson = fFAlphaCut->Eval(pt);
   
-  if(TMath::Abs(pi0->GetAlpha())>fAlphaCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if(TMath::Abs(alpha)>fAlphaCutMeson){
+    if(hist)hist->Fill(cutIndex, pt);
     return kFALSE;
   }
   cutIndex++;
 
   // Alpha Min Cut
-  if(TMath::Abs(pi0->GetAlpha())<fAlphaMinCutMeson){
-    if(hist)hist->Fill(cutIndex, pi0->Pt());
+  if(TMath::Abs(alpha)<fAlphaMinCutMeson){
+    if(hist)hist->Fill(cutIndex, pt);
     return kFALSE;
   }
   cutIndex++;
 
-  if (fHistoInvMassAfter) fHistoInvMassAfter->Fill(pi0->M());
-  
+  if (fHistoInvMassAfter) fHistoInvMassAfter->Fill(m);
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliConversionMesonCuts::MesonIsSelectedDCA(AliAODConversionMother *pi0, Bool_t IsSignal, Int_t cutIndex)
+{
+  // DCA cuts of MesonIsSelected, for candidates which passed
+  // MesonIsSelectedKinematics
+  TH2 *hist=0x0;
+
+  if(IsSignal){hist=fHistoMesonCuts;}
+  else{hist=fHistoMesonBGCuts;}
+
   if (fIsMergedClusterCut == 0){ 
     if (fHistoDCAGGMesonBefore)fHistoDCAGGMesonBefore->Fill(pi0->GetDCABetweenPhotons());
     if (fHistoDCARMesonPrimVtxBefore)fHistoDCARMesonPrimVtxBefore->Fill(pi0->GetDCARMotherPrimVtx());
@@ -0,0 +1,129 @@
+/****************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.   *
+ *                                                                          *
+ * Permission to use, copy, modify and distribute this software and its     *
+ * documentation strictly for non-commercial purposes is hereby granted     *
+ * without fee, provided that the above copyright notice appears in all     *
+ * copies and that both the copyright notice and this permission notice     *
+ * appear in the supporting documentation. The authors make no claims       *
+ * about the suitability of this software for any purpose. It is            *
+ * provided "as is" without express or implied warranty.                    *
+ ***************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Kinematics of photon pairs, computed in
+// batches on contiguous arrays, see header
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "AliConversionPairKinematics.h"
+
+#include "TMath.h"
+#include "AliAODConversionPhoton.h"
+
+ClassImp(AliConversionPairKinematics)
+
+//________________________________________________________________________
+AliConversionPairKinematics::AliConversionPairKinematics() : TObject(),
+  fPx(),
+  fPy(),
+  fPz(),
+  fEnergy(),
+  fP2(),
+  fFirst(),
+  fSecond(),
+  fM(),
+  fPt(),
+  fE(),
+  fPzPair(),
+  fRapidity(),
+  fOpeningAngle(),
+  fAlpha()
+{
+}
+
+//________________________________________________________________________
+void AliConversionPairKinematics::Clear(Option_t *){
+  // Forget the photons and the pairs, the memory is kept for the next event
+  fPx.clear();
+  fPy.clear();
+  fPz.clear();
+  fEnergy.clear();
+  fP2.clear();
+  ClearPairs();
+}
+
+//________________________________________________________________________
+void AliConversionPairKinematics::ClearPairs(){
+  fFirst.clear();
+  fSecond.clear();
+}
+
+//________________________________________________________________________
+Int_t AliConversionPairKinematics::AddPhoton(const AliAODConversionPhoton *photon){
+  // Copy the four-momentum of the photon, returns its index
+  Double_t px = photon->Px();
+  Double_t py = photon->Py();
+  Double_t pz = photon->Pz();
+  fPx.push_back(px);
+  fPy.push_back(py);
+  fPz.push_back(pz);
+  fEnergy.push_back(photon->E());
+  fP2.push_back(px*px + py*py + pz*pz);
+  return fPx.size()-1;
+}
+
+//________________________________________________________________________
+void AliConversionPairKinematics::Compute(){
+  // Kinematics of all pairs, as in AliAODConversionMother(AliAODConversionPhoton*,AliAODConversionPhoton*)
+
+  Int_t nPairs = GetNPairs();
+  fM.resize(nPairs);
+  fPt.resize(nPairs);
+  fE.resize(nPairs);
+  fPzPair.resize(nPairs);
+  fRapidity.resize(nPairs);
+  fOpeningAngle.resize(nPairs);
+  fAlpha.resize(nPairs);
+
+  const Int_t *first = nPairs ? &fFirst[0] : 0x0;
+  const Int_t *second = nPairs ? &fSecond[0] : 0x0;
+  const Double_t *px = fPx.empty() ? 0x0 : &fPx[0];
+  const Double_t *py = fPy.empty() ? 0x0 : &fPy[0];
+  const Double_t *pz = fPz.empty() ? 0x0 : &fPz[0];
+  const Double_t *energy = fEnergy.empty() ? 0x0 : &fEnergy[0];
+  const Double_t *p2 = fP2.empty() ? 0x0 : &fP2[0];
+
+  for(Int_t iPair=0; iPair<nPairs; iPair++){
+    Int_t i = first[iPair];
+    Int_t j = second[iPair];
+
+    // mother four-momentum (TLorentzVector arithmetic)
+    Double_t sumPx = px[i] + px[j];
+    Double_t sumPy = py[i] + py[j];
+    Double_t sumPz = pz[i] + pz[j];
+    Double_t sumE  = energy[i] + energy[j];
+    Double_t mm = sumE*sumE - (sumPx*sumPx + sumPy*sumPy + sumPz*sumPz);
+    fM[iPair]      = mm < 0.0 ? -TMath::Sqrt(-mm) : TMath::Sqrt(mm);
+    fPt[iPair]     = TMath::Sqrt(sumPx*sumPx + sumPy*sumPy);
+    fE[iPair]      = sumE;
+    fPzPair[iPair] = sumPz;
+    Double_t ratio = (sumE+sumPz)/(sumE-sumPz);
+    fRapidity[iPair] = ratio > 0 ? 0.5*TMath::Log(ratio) : 0.;
+
+    // opening angle (TVector3::Angle)
+    Double_t ptot2 = p2[i]*p2[j];
+    if(ptot2 <= 0){
+      fOpeningAngle[iPair] = 0.0;
+    } else {
+      Double_t arg = (px[i]*px[j] + py[i]*py[j] + pz[i]*pz[j])/TMath::Sqrt(ptot2);
+      if(arg >  1.0) arg =  1.0;
+      if(arg < -1.0) arg = -1.0;
+      fOpeningAngle[iPair] = TMath::ACos(arg);
+    }
+
+    // energy asymmetry
+    fAlpha[iPair] = sumE != 0 ? (energy[i]-energy[j])/sumE : -1;
+  }
+}
@@ -0,0 +1,82 @@
+#ifndef ALICONVERSIONPAIRKINEMATICS_H
+#define ALICONVERSIONPAIRKINEMATICS_H
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Kinematics of photon pairs, computed in
+// batches on contiguous arrays
+//
+// The four-momenta of the photons are copied
+// once into flat arrays. For the pairs added
+// with AddPair, Compute fills the invariant
+// mass, pt, energy, pz, rapidity, opening angle
+// and energy asymmetry, with the same
+// arithmetic as AliAODConversionMother. The
+// pairs can then be preselected with
+// AliConversionMesonCuts::MesonIsSelectedKinematics,
+// and AliAODConversionMother objects created only
+// for the pairs which pass.
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "TObject.h"
+#include <vector>
+
+class AliAODConversionPhoton;
+
+class AliConversionPairKinematics : public TObject {
+
+  public:
+
+    AliConversionPairKinematics();
+    virtual ~AliConversionPairKinematics() {}
+
+    virtual void Clear(Option_t * opt = "");
+
+    // photons
+    Int_t AddPhoton(const AliAODConversionPhoton *photon);
+    Int_t GetNPhotons() const {return fPx.size();}
+
+    // pairs, indices as returned by AddPhoton
+    void ClearPairs();
+    void AddPair(Int_t first, Int_t second) {fFirst.push_back(first); fSecond.push_back(second);}
+    Int_t GetNPairs() const {return fFirst.size();}
+    void Compute();
+
+    Int_t GetFirst(Int_t iPair) const {return fFirst[iPair];}
+    Int_t GetSecond(Int_t iPair) const {return fSecond[iPair];}
+    Double_t M(Int_t iPair) const {return fM[iPair];}
+    Double_t Pt(Int_t iPair) const {return fPt[iPair];}
+    Double_t E(Int_t iPair) const {return fE[iPair];}
+    Double_t Pz(Int_t iPair) const {return fPzPair[iPair];}
+    Double_t Rapidity(Int_t iPair) const {return fRapidity[iPair];}           // 0 if undefined
+    Double_t OpeningAngle(Int_t iPair) const {return fOpeningAngle[iPair];}
+    Double_t Alpha(Int_t iPair) const {return fAlpha[iPair];}
+
+  private:
+
+    AliConversionPairKinematics(const AliConversionPairKinematics&); // not implemented
+    AliConversionPairKinematics& operator=(const AliConversionPairKinematics&); // not implemented
+
+    // photons
+    std::vector<Double_t> fPx;            //! photon px
+    std::vector<Double_t> fPy;            //! photon py
+    std::vector<Double_t> fPz;            //! photon pz
+    std::vector<Double_t> fEnergy;        //! photon energy
+    std::vector<Double_t> fP2;            //! photon momentum squared
+
+    // pairs
+    std::vector<Int_t>    fFirst;         //! index of the first photon
+    std::vector<Int_t>    fSecond;        //! index of the second photon
+    std::vector<Double_t> fM;             //! invariant mass
+    std::vector<Double_t> fPt;            //! transverse momentum
+    std::vector<Double_t> fE;             //! energy
+    std::vector<Double_t> fPzPair;        //! longitudinal momentum
+    std::vector<Double_t> fRapidity;      //! rapidity
+    std::vector<Double_t> fOpeningAngle;  //! opening angle of the photons
+    std::vector<Double_t> fAlpha;         //! energy asymmetry of the photons
+
+    ClassDef(AliConversionPairKinematics,1)
+};
+
+#endif
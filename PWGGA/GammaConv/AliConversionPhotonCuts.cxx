@@ -951,6 +951,22 @@ Bool_t AliConversionPhotonCuts::CorrectedTPCClusterCut(AliConversionPhotonBase *
 Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon, AliVEvent * event){
   //Selection of Reconstructed Photons
 
+  // Get Tracks
+  AliVTrack * negTrack = GetTrack(event, photon->GetTrackLabelNegative());
+  AliVTrack * posTrack = GetTrack(event, photon->GetTrackLabelPositive());
+
+  Bool_t isV0InAOD = kTRUE;
+  if(negTrack && posTrack && UseAODV0Check(event)) isV0InAOD = IsV0InAOD(event, negTrack, posTrack);
+
+  return PhotonIsSelected(photon, event, negTrack, posTrack, isV0InAOD);
+}
+
+///________________________________________________________________________
+Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon, AliVEvent * event, AliVTrack * negTrack, AliVTrack * posTrack, Bool_t isV0InAOD){
+  //Selection of Reconstructed Photons, with the tracks of the photon and the result of
+  //IsV0InAOD (only used if UseAODV0Check) provided by the caller. The lookups do not
+  //depend on the cut settings and can be shared by several cut selections
+
   FillPhotonCutIndex(kPhotonIn);
 
   if(event->IsA()==AliESDEvent::Class()) {
@@ -960,35 +976,15 @@ Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon
     }
   }
 
-  // Get Tracks
-  AliVTrack * negTrack = GetTrack(event, photon->GetTrackLabelNegative());
-  AliVTrack * posTrack = GetTrack(event, photon->GetTrackLabelPositive());
-
   if(!negTrack || !posTrack) {
     FillPhotonCutIndex(kNoTracks);
     return kFALSE;
   }
 
   // check if V0 from AliAODGammaConversion.root is actually contained in AOD by checking if V0 exists with same tracks
-  if(event->IsA()==AliAODEvent::Class() && fPreSelCut && ( fIsHeavyIon != 1 || (fIsHeavyIon == 1 && fProcessAODCheck) )) {
-    AliAODEvent* aodEvent = dynamic_cast<AliAODEvent*>(event);
-
-    Bool_t bFound = kFALSE;
-    Int_t v0PosID = posTrack->GetID();
-    Int_t v0NegID = negTrack->GetID();
-    AliAODv0* v0 = NULL;
-    for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
-      v0 = aodEvent->GetV0(iV);
-      if(!v0) continue;
-      if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
-        bFound = kTRUE;
-        break;
-      }
-    }
-    if(!bFound){
-      FillPhotonCutIndex(kNoV0);
-      return kFALSE;
-    }
+  if(!isV0InAOD && UseAODV0Check(event)){
+    FillPhotonCutIndex(kNoV0);
+    return kFALSE;
   }
 
   photon->DeterminePhotonQuality(negTrack,posTrack);
@@ -1017,6 +1013,32 @@ Bool_t AliConversionPhotonCuts::PhotonIsSelected(AliConversionPhotonBase *photon
   return kTRUE;
 }
 
+///________________________________________________________________________
+Bool_t AliConversionPhotonCuts::UseAODV0Check(AliVEvent * event) const {
+  // Whether V0s from AliAODGammaConversion.root have to be found in the AOD to be accepted
+  return event->IsA()==AliAODEvent::Class() && fPreSelCut && ( fIsHeavyIon != 1 || (fIsHeavyIon == 1 && fProcessAODCheck) );
+}
+
+///________________________________________________________________________
+Bool_t AliConversionPhotonCuts::IsV0InAOD(AliVEvent * event, AliVTrack * negTrack, AliVTrack * posTrack){
+  // Checks if a V0 with the given tracks exists in the AOD
+
+  AliAODEvent* aodEvent = dynamic_cast<AliAODEvent*>(event);
+  if(!aodEvent) return kFALSE;
+
+  Int_t v0PosID = posTrack->GetID();
+  Int_t v0NegID = negTrack->GetID();
+  AliAODv0* v0 = NULL;
+  for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
+    v0 = aodEvent->GetV0(iV);
+    if(!v0) continue;
+    if( (v0PosID == v0->GetPosID() && v0NegID == v0->GetNegID()) || (v0PosID == v0->GetNegID() && v0NegID == v0->GetPosID()) ){
+      return kTRUE;
+    }
+  }
+  return kFALSE;
+}
+
 ///________________________________________________________________________
 Bool_t AliConversionPhotonCuts::ArmenterosQtCut(AliConversionPhotonBase *photon){   // Armenteros Qt Cut
   if(fDo2DQt){
@@ -1449,7 +1471,7 @@ AliVTrack *AliConversionPhotonCuts::GetTrack(AliVEvent * event, Int_t label){
   } else {
     if(label == -999999) return NULL; // if AOD relabelling goes wrong, immediately return NULL
     AliVTrack * track = 0x0;
-    if(((AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data()))->AreAODsRelabeled()){
+    if(AreAODsRelabeled()){
       if(event->GetTrack(label)) track = dynamic_cast<AliVTrack*>(event->GetTrack(label));
       return track;
     }
@@ -1468,6 +1490,12 @@ AliVTrack *AliConversionPhotonCuts::GetTrack(AliVEvent * event, Int_t label){
   return NULL;
 }
 
+///________________________________________________________________________
+Bool_t AliConversionPhotonCuts::AreAODsRelabeled() const {
+  // Whether the AOD track labels were relabeled by the V0 reader of this cut
+  return ((AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data()))->AreAODsRelabeled();
+}
+
 ///________________________________________________________________________
 AliESDtrack *AliConversionPhotonCuts::GetESDTrack(AliESDEvent * event, Int_t label){
   //Returns pointer to the track with given ESD label
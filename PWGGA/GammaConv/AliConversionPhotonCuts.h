@@ -120,6 +120,7 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     
     // Cut Selection
     Bool_t PhotonIsSelected(AliConversionPhotonBase * photon, AliVEvent  * event);
+    Bool_t PhotonIsSelected(AliConversionPhotonBase * photon, AliVEvent  * event, AliVTrack * negTrack, AliVTrack * posTrack, Bool_t isV0InAOD); // tracks and AOD V0 lookup done by the caller
     Bool_t PhotonIsSelectedMC(TParticle *particle,AliStack *fMCStack,Bool_t checkForConvertedGamma=kTRUE);
     Bool_t PhotonIsSelectedAODMC(AliAODMCParticle *particle,TClonesArray *aodmcArray,Bool_t checkForConvertedGamma=kTRUE);
     Bool_t ElectronIsSelectedMC(TParticle *particle,AliStack *fMCStack);
@@ -142,6 +143,9 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     void SetProcessAODCheck(Bool_t flag){fProcessAODCheck = flag; return;}
 
     AliVTrack * GetTrack(AliVEvent * event, Int_t label);
+    Bool_t AreAODsRelabeled() const;
+    Bool_t UseAODV0Check(AliVEvent * event) const;
+    static Bool_t IsV0InAOD(AliVEvent * event, AliVTrack * negTrack, AliVTrack * posTrack);
     AliESDtrack *GetESDTrack(AliESDEvent * event, Int_t label);
     
     ///Cut functions
@@ -0,0 +1,163 @@
+/****************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.   *
+ *                                                                          *
+ * Permission to use, copy, modify and distribute this software and its     *
+ * documentation strictly for non-commercial purposes is hereby granted     *
+ * without fee, provided that the above copyright notice appears in all     *
+ * copies and that both the copyright notice and this permission notice     *
+ * appear in the supporting documentation. The authors make no claims       *
+ * about the suitability of this software for any purpose. It is            *
+ * provided "as is" without express or implied warranty.                    *
+ ***************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Shared track lookups for the photon
+// selection of AliConversionPhotonCuts,
+// see header
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "AliConversionPhotonMultiCutSelector.h"
+
+#include <algorithm>
+#include "TList.h"
+#include "TClonesArray.h"
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+#include "AliESDEvent.h"
+#include "AliAODEvent.h"
+#include "AliAODv0.h"
+#include "AliAODConversionPhoton.h"
+#include "AliConversionPhotonCuts.h"
+
+ClassImp(AliConversionPhotonMultiCutSelector)
+
+//________________________________________________________________________
+AliConversionPhotonMultiCutSelector::AliConversionPhotonMultiCutSelector(TList *cutArray) : TObject(),
+  fCutArray(NULL),
+  fNCuts(0),
+  fEvent(NULL),
+  fPhotons(NULL),
+  fNPhotons(0),
+  fCutLookup(),
+  fAODTracks(),
+  fAODV0s()
+{
+  SetCutArray(cutArray);
+}
+
+//________________________________________________________________________
+void AliConversionPhotonMultiCutSelector::SetCutArray(TList *cutArray){
+  // Set the list of AliConversionPhotonCuts
+  fCutArray = cutArray;
+  fNCuts    = cutArray ? cutArray->GetEntries() : 0;
+  fNPhotons = 0;
+  fCutLookup.assign(fNCuts, 0);
+}
+
+//________________________________________________________________________
+void AliConversionPhotonMultiCutSelector::ProcessEvent(AliVEvent *event, TClonesArray *photons){
+  // Look up the tracks of all photon candidates of the event, and whether
+  // their V0s exist in the AOD
+
+  fEvent    = event;
+  fPhotons  = photons;
+  fNPhotons = photons ? photons->GetEntriesFast() : 0;
+
+  // relabeling of the AODs as seen by each cut, as in AliConversionPhotonCuts::GetTrack
+  Bool_t isAOD = event->IsA()==AliAODEvent::Class();
+  Bool_t useLookup[2] = {kFALSE, kFALSE};
+  for(Int_t iCut=0; iCut<fNCuts; iCut++){
+    fCutLookup[iCut] = (isAOD && ((AliConversionPhotonCuts*) fCutArray->At(iCut))->AreAODsRelabeled()) ? 1 : 0;
+    useLookup[fCutLookup[iCut]] = kTRUE;
+  }
+
+  for(Int_t iLookup=0; iLookup<2; iLookup++){
+    fNegTracks[iLookup].assign(useLookup[iLookup] ? fNPhotons : 0, (AliVTrack*)NULL);
+    fPosTracks[iLookup].assign(useLookup[iLookup] ? fNPhotons : 0, (AliVTrack*)NULL);
+    fIsV0InAOD[iLookup].assign(useLookup[iLookup] ? fNPhotons : 0, kFALSE);
+  }
+  if(!fNPhotons) return;
+
+  fAODTracks.clear();
+  if(isAOD && useLookup[0]) FillAODTrackTable(event);
+  if(isAOD) FillAODV0Table(event);
+
+  for(Int_t iLookup=0; iLookup<2; iLookup++){
+    if(!useLookup[iLookup]) continue;
+    for(Int_t i=0; i<fNPhotons; i++){
+      AliAODConversionPhoton *photon = (AliAODConversionPhoton*) photons->At(i);
+      if(!photon) continue;
+      AliVTrack *negTrack = FindTrack(event, photon->GetTrackLabelNegative(), iLookup);
+      AliVTrack *posTrack = FindTrack(event, photon->GetTrackLabelPositive(), iLookup);
+      fNegTracks[iLookup][i] = negTrack;
+      fPosTracks[iLookup][i] = posTrack;
+      if(isAOD && negTrack && posTrack) fIsV0InAOD[iLookup][i] = IsV0InAOD(negTrack, posTrack);
+    }
+  }
+}
+
+//________________________________________________________________________
+Bool_t AliConversionPhotonMultiCutSelector::IsSelected(Int_t iPhoton, Int_t iCut, Double_t eventPlaneAngle){
+  // Decision of cut iCut for the photon iPhoton of the current event,
+  // with the track lookups of the event
+
+  Int_t iLookup = fCutLookup[iCut];
+  AliConversionPhotonCuts *cuts = (AliConversionPhotonCuts*) fCutArray->At(iCut);
+  AliAODConversionPhoton *photon = (AliAODConversionPhoton*) fPhotons->At(iPhoton);
+  return cuts->PhotonIsSelected(photon, fEvent, fNegTracks[iLookup][iPhoton], fPosTracks[iLookup][iPhoton], fIsV0InAOD[iLookup][iPhoton]) &&
+         cuts->InPlaneOutOfPlaneCut(photon->GetPhotonPhi(), eventPlaneAngle);
+}
+
+//________________________________________________________________________
+AliVTrack *AliConversionPhotonMultiCutSelector::FindTrack(AliVEvent *event, Int_t label, Bool_t aodsRelabeled) const {
+  // Same as AliConversionPhotonCuts::GetTrack
+
+  if(event->IsA()==AliESDEvent::Class()){
+    if(label > event->GetNumberOfTracks() ) return NULL;
+    return ((AliESDEvent*)event)->GetTrack(label);
+  }
+  if(label == -999999) return NULL; // if AOD relabelling goes wrong, immediately return NULL
+  if(aodsRelabeled){
+    if(event->GetTrack(label)) return dynamic_cast<AliVTrack*>(event->GetTrack(label));
+    return NULL;
+  }
+  std::map<Int_t,AliVTrack*>::const_iterator it = fAODTracks.find(label);
+  return it != fAODTracks.end() ? it->second : NULL;
+}
+
+//________________________________________________________________________
+void AliConversionPhotonMultiCutSelector::FillAODTrackTable(AliVEvent *event){
+  // AliConversionPhotonCuts::GetTrack searches the AOD tracks by ID,
+  // here the track array is read once per event
+
+  for(Int_t ii=0; ii<event->GetNumberOfTracks(); ii++) {
+    AliVTrack *track = dynamic_cast<AliVTrack*>(event->GetTrack(ii));
+    if(track) fAODTracks.insert(std::make_pair(track->GetID(),track)); // keeps the first track with a given ID
+  }
+}
+
+//________________________________________________________________________
+void AliConversionPhotonMultiCutSelector::FillAODV0Table(AliVEvent *event){
+  // Track IDs of all V0s of the AOD, ordered within the pair, sorted
+
+  fAODV0s.clear();
+  AliAODEvent *aodEvent = (AliAODEvent*) event;
+  for(Int_t iV=0; iV<aodEvent->GetNumberOfV0s(); iV++){
+    AliAODv0 *v0 = aodEvent->GetV0(iV);
+    if(!v0) continue;
+    Int_t posID = v0->GetPosID();
+    Int_t negID = v0->GetNegID();
+    fAODV0s.push_back(std::make_pair(std::min(posID,negID), std::max(posID,negID)));
+  }
+  std::sort(fAODV0s.begin(), fAODV0s.end());
+}
+
+//________________________________________________________________________
+Bool_t AliConversionPhotonMultiCutSelector::IsV0InAOD(AliVTrack *negTrack, AliVTrack *posTrack) const {
+  // Same as AliConversionPhotonCuts::IsV0InAOD, on the table of the event
+  Int_t posID = posTrack->GetID();
+  Int_t negID = negTrack->GetID();
+  return std::binary_search(fAODV0s.begin(), fAODV0s.end(), std::make_pair(std::min(posID,negID), std::max(posID,negID)));
+}
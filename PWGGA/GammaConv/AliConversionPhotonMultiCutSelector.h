@@ -0,0 +1,87 @@
+#ifndef ALICONVERSIONPHOTONMULTICUTSELECTOR_H
+#define ALICONVERSIONPHOTONMULTICUTSELECTOR_H
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Shared track lookups for the photon
+// selection of a list of
+// AliConversionPhotonCuts (cut variations)
+//
+// The track lookup and the check of the V0
+// in the AOD do not depend on the cut settings.
+// They are done once per photon and event,
+// instead of once per photon and cut. The AOD
+// track labels can be relabeled or not,
+// depending on the V0 reader of each cut, so
+// the lookups are kept for both cases if the
+// cuts use different V0 readers.
+//
+// Usage, for each event:
+//   selector->ProcessEvent(event, readerGammas);
+//   ... for each cut i, photon j:
+//   if(selector->IsSelected(j, i, eventPlaneAngle)) ...
+//
+// Only the lookups are shared: IsSelected calls
+// AliConversionPhotonCuts::PhotonIsSelected and
+// InPlaneOutOfPlaneCut of the cut, once per
+// photon and cut, with the same histogram fills.
+// The cut variables are not evaluated once for
+// all cuts, and there is no per-photon mask of
+// the passed cuts.
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "TObject.h"
+#include <vector>
+#include <map>
+#include <utility>
+
+class TList;
+class TClonesArray;
+class AliVEvent;
+class AliVTrack;
+class AliConversionPhotonCuts;
+
+class AliConversionPhotonMultiCutSelector : public TObject {
+
+  public:
+
+    AliConversionPhotonMultiCutSelector(TList *cutArray=NULL);
+    virtual ~AliConversionPhotonMultiCutSelector() {}
+
+    void SetCutArray(TList *cutArray);
+    Int_t GetNCuts() const {return fNCuts;}
+
+    // per event
+    void ProcessEvent(AliVEvent *event, TClonesArray *photons);
+    Int_t GetNPhotons() const {return fNPhotons;}
+
+    // decision of one cut, with the lookups of the event
+    Bool_t IsSelected(Int_t iPhoton, Int_t iCut, Double_t eventPlaneAngle);
+
+  private:
+
+    AliConversionPhotonMultiCutSelector(const AliConversionPhotonMultiCutSelector&); // not implemented
+    AliConversionPhotonMultiCutSelector& operator=(const AliConversionPhotonMultiCutSelector&); // not implemented
+
+    AliVTrack *FindTrack(AliVEvent *event, Int_t label, Bool_t aodsRelabeled) const;
+    void FillAODTrackTable(AliVEvent *event);
+    void FillAODV0Table(AliVEvent *event);
+    Bool_t IsV0InAOD(AliVTrack *negTrack, AliVTrack *posTrack) const;
+
+    TList                                *fCutArray;       //! photon cuts (not owned)
+    Int_t                                 fNCuts;          //! number of cuts
+    AliVEvent                            *fEvent;          //! current event
+    TClonesArray                         *fPhotons;        //! photon candidates of the current event
+    Int_t                                 fNPhotons;       //! number of photon candidates
+    std::vector<Int_t>                    fCutLookup;      //! lookup used by each cut: 1 if the AODs of its V0 reader are relabeled, else 0
+    std::vector<AliVTrack*>               fNegTracks[2];   //! negative track of each photon, per lookup
+    std::vector<AliVTrack*>               fPosTracks[2];   //! positive track of each photon, per lookup
+    std::vector<Bool_t>                   fIsV0InAOD[2];   //! photon V0 found in the AOD, per lookup
+    std::map<Int_t,AliVTrack*>            fAODTracks;      //! AOD tracks by ID (not relabeled AODs)
+    std::vector<std::pair<Int_t,Int_t> >  fAODV0s;         //! sorted track ID pairs of the AOD V0s
+
+    ClassDef(AliConversionPhotonMultiCutSelector,2)
+};
+
+#endif
@@ -14,6 +14,8 @@
 #pragma link C++ class AliCaloPhotonCuts+;
 #pragma link C++ class AliConvEventCuts+;
 #pragma link C++ class AliConversionPhotonCuts+;
+#pragma link C++ class AliConversionPhotonMultiCutSelector+;
+#pragma link C++ class AliConversionPairKinematics+;
 #pragma link C++ class AliConversionCuts+;
 #pragma link C++ class AliConversionSelection+;
 #pragma link C++ class AliV0ReaderV1+;
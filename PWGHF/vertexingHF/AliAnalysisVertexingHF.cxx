@@ -64,6 +64,7 @@
 #include "AliRDHFCutsDStartoKpipi.h"
 #include "AliAnalysisFilter.h"
 #include "AliAnalysisVertexingHF.h"
+#include "AliHFPrimVtxRemovalCache.h"
 #include "AliMixedEvent.h"
 #include "AliESDv0.h"
 #include "AliAODv0.h"
@@ -85,6 +86,8 @@ fBzkG(0.),
 fSecVtxWithKF(kFALSE),
 fRecoPrimVtxSkippingTrks(kFALSE),
 fRmTrksFromPrimVtx(kFALSE),
+fCachePrimVtxRemoval(kFALSE),
+fPrimVtxRemovalCache(0x0),
 fV1(0x0),
 fD0toKpi(kTRUE),
 fJPSItoEle(kTRUE),
@@ -180,6 +183,8 @@ fBzkG(source.fBzkG),
 fSecVtxWithKF(source.fSecVtxWithKF),
 fRecoPrimVtxSkippingTrks(source.fRecoPrimVtxSkippingTrks),
 fRmTrksFromPrimVtx(source.fRmTrksFromPrimVtx),
+fCachePrimVtxRemoval(source.fCachePrimVtxRemoval),
+fPrimVtxRemovalCache(0x0),
 fV1(source.fV1),
 fD0toKpi(source.fD0toKpi),
 fJPSItoEle(source.fJPSItoEle),
@@ -272,6 +277,7 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fSecVtxWithKF = source.fSecVtxWithKF;
   fRecoPrimVtxSkippingTrks = source.fRecoPrimVtxSkippingTrks;
   fRmTrksFromPrimVtx = source.fRmTrksFromPrimVtx;
+  fCachePrimVtxRemoval = source.fCachePrimVtxRemoval;
   fV1 = source.fV1;
   fD0toKpi = source.fD0toKpi;
   fJPSItoEle = source.fJPSItoEle;
@@ -352,6 +358,7 @@ AliAnalysisVertexingHF::~AliAnalysisVertexingHF() {
   /// Destructor
   if(fV1) { delete fV1; fV1=0; }
   delete fVertexerTracks;
+  delete fPrimVtxRemovalCache;
   if(fTrackFilter) { delete fTrackFilter; fTrackFilter=0; }
   if(fTrackFilter2prongCentral) { delete fTrackFilter2prongCentral; fTrackFilter2prongCentral=0; }
   if(fTrackFilter3prongCentral) { delete fTrackFilter3prongCentral; fTrackFilter3prongCentral=0; }
@@ -618,6 +625,37 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  // contributions of the tracks to the primary vertex, computed once
+  // per track for the removal of the daughters of all candidates
+  if(fRmTrksFromPrimVtx && fCachePrimVtxRemoval && fV1) {
+    if(!fPrimVtxRemovalCache) fPrimVtxRemovalCache = new AliHFPrimVtxRemovalCache();
+    Float_t diamondxy[2]={static_cast<Float_t>(event->GetDiamondX()),static_cast<Float_t>(event->GetDiamondY())};
+    fPrimVtxRemovalCache->SetVertex(fV1,diamondxy,event->GetMagneticField(),&seleTrksArray,&tracksAtVertex,nSeleTrks);
+  }
+
+  // Kinematic pre-filter for 3 and 4 prongs, used with the mass cut before vertexing:
+  // the mass of a n-prong candidate is larger than the mass of any pair of its tracks
+  // plus the masses of the other n-2 tracks, and the pair mass is smallest for the pion
+  // hypothesis. Pairs above the upper limit of all mass windows are skipped before
+  // the DCA calculation and the vertexing (-1 = no pre-filter)
+  Double_t *momAtVtx = 0; // px,py,pz,E(pion) at primary vertex
+  Double_t maxPairMass3Prong=-1.,maxPairMass4Prong=-1.;
+  if(fMassCutBeforeVertexing) {
+    momAtVtx = new Double_t[4*nSeleTrks];
+    FillMomentaAtVertex(tracksAtVertex,nSeleTrks,momAtVtx);
+    Double_t massPi=TDatabasePDG::Instance()->GetParticle(211)->Mass();
+    const Double_t kMassTolerance=1.e-4; // GeV/c^2, against rounding
+    if(f3Prong) {
+      Double_t hilim=fMassDplus+fCutsDplustoKpipi->GetMassCut();
+      hilim=TMath::Max(hilim,fMassDs+fCutsDstoKKpi->GetMassCut());
+      hilim=TMath::Max(hilim,fMassLambdaC+fCutsLctopKpi->GetMassCut());
+      maxPairMass3Prong=hilim-massPi+kMassTolerance;
+    }
+    if(f4Prong) {
+      maxPairMass4Prong=fMassDzero+fCutsD0toKpipipi->GetMassCut()-2.*massPi+kMassTolerance;
+    }
+  }
+
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -1048,6 +1086,15 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	continue;
       }
 
+      // can this pair be part of a 3 or 4 prong candidate?
+      Bool_t p1n1For3Prong = f3Prong && PairPassesMassBound(momAtVtx,iTrkP1,iTrkN1,maxPairMass3Prong);
+      Bool_t p1n1For4Prong = f4Prong && !isLikeSign2Prong && PairPassesMassBound(momAtVtx,iTrkP1,iTrkN1,maxPairMass4Prong);
+      if(!p1n1For3Prong && !p1n1For4Prong) {
+	negtrack1=0;
+	delete vertexp1n1;
+	continue;
+      }
+
 
       // 2nd LOOP  ON  POSITIVE  TRACKS
       for(iTrkP2=iTrkP1+1; iTrkP2<nSeleTrks; iTrkP2++) {
@@ -1121,6 +1168,17 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  if(!TESTBIT(seleFlags[iTrkP1],kBitKaonCompat) &&
 	     !TESTBIT(seleFlags[iTrkP2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
 	}
+	// mass pre-filter, before DCA and vertexing
+	Bool_t p2For3Prong = p1n1For3Prong &&
+	  PairPassesMassBound(momAtVtx,iTrkP2,iTrkN1,maxPairMass3Prong) &&
+	  PairPassesMassBound(momAtVtx,iTrkP1,iTrkP2,maxPairMass3Prong);
+	Bool_t p2For4Prong = p1n1For4Prong && !isLikeSign3Prong &&
+	  PairPassesMassBound(momAtVtx,iTrkP2,iTrkN1,maxPairMass4Prong) &&
+	  PairPassesMassBound(momAtVtx,iTrkP1,iTrkP2,maxPairMass4Prong);
+	if(!p2For3Prong && !p2For4Prong) {
+	  postrack2=0;
+	  continue;
+	}
 	// back to primary vertex
 	//	postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
 	//	postrack2->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1223,7 +1281,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	}
 
 	// 4 prong candidates
-	if(f4Prong
+	if(f4Prong && p2For4Prong
 	   // don't make 4 prong with like-sign pairs and triplets
 	   && !isLikeSign2Prong && !isLikeSign3Prong
 	   // track-to-track dca cuts already now
@@ -1275,6 +1333,14 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
+	    // mass pre-filter, before DCA and vertexing
+	    if(!PairPassesMassBound(momAtVtx,iTrkP1,iTrkN2,maxPairMass4Prong) ||
+	       !PairPassesMassBound(momAtVtx,iTrkP2,iTrkN2,maxPairMass4Prong) ||
+	       !PairPassesMassBound(momAtVtx,iTrkN1,iTrkN2,maxPairMass4Prong)) {
+	      negtrack2=0;
+	      continue;
+	    }
+
 	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
             dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
@@ -1399,6 +1465,13 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  if(!TESTBIT(seleFlags[iTrkN1],kBitKaonCompat) &&
 	     !TESTBIT(seleFlags[iTrkN2],kBitKaonCompat) ) okForDsToKKpi=kFALSE;
 	}
+	// mass pre-filter, before DCA and vertexing
+	if(!p1n1For3Prong ||
+	   !PairPassesMassBound(momAtVtx,iTrkP1,iTrkN2,maxPairMass3Prong) ||
+	   !PairPassesMassBound(momAtVtx,iTrkN1,iTrkN2,maxPairMass3Prong)) {
+	  negtrack2=0;
+	  continue;
+	}
 
 	// back to primary vertex
 	// postrack1->PropagateToDCA(fV1,fBzkG,kVeryBig);
@@ -1546,6 +1619,12 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   fourTrackArray->Delete();  delete fourTrackArray;
   delete [] seleFlags; seleFlags=NULL;
   if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
+  if(momAtVtx) {delete [] momAtVtx; momAtVtx=NULL;}
+  if(fPrimVtxRemovalCache) {
+    AliDebug(1,Form(" Track contributions to primary vertex cached: %d",fPrimVtxRemovalCache->GetNCachedTracks()));
+    fPrimVtxRemovalCache->PrintCheck();
+    fPrimVtxRemovalCache->Reset(); // before the tracks at vertex are deleted
+  }
   tracksAtVertex.Delete();
 
   if(fInputAOD) {
@@ -2793,10 +2872,11 @@ AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
     // primary vertex specific to this candidate
 
     Int_t nTrks = trkArray->GetEntriesFast();
-    AliVertexerTracks *vertexer = new AliVertexerTracks(event->GetMagneticField());
+    AliVertexerTracks *vertexer = 0;
 
     if(fRecoPrimVtxSkippingTrks) {
       // recalculating the vertex
+      vertexer = new AliVertexerTracks(event->GetMagneticField());
 
       if(strstr(fV1->GetTitle(),"VertexerTracksWithConstraint")) {
 	Float_t diamondcovxy[3];
@@ -2836,8 +2916,14 @@ AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
       vertexer->SetSkipTracks(nTrksToSkip,skipped);
       vertexESD = (AliESDVertex*)vertexer->FindPrimaryVertex(event);
 
+    } else if(fRmTrksFromPrimVtx && nTrks>0 && fPrimVtxRemovalCache &&
+	      fPrimVtxRemovalCache->GetVertex()==fV1 &&
+	      fPrimVtxRemovalCache->RemoveTracks(trkArray,vertexESD)) {
+      // removing the prongs tracks, with the contributions cached for the event
+
     } else if(fRmTrksFromPrimVtx && nTrks>0) {
       // removing the prongs tracks
+      vertexer = new AliVertexerTracks(event->GetMagneticField());
 
       TObjArray rmArray(nTrks);
       UShort_t *rmId = new UShort_t[nTrks];
@@ -2860,6 +2946,8 @@ AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
 
     }
 
+    delete vertexer; vertexer=NULL;
+
     if(!vertexESD) return vertexAOD;
     if(vertexESD->GetNContributors()<=0) {
       //AliDebug(2,"vertexing failed");
@@ -2867,8 +2955,6 @@ AliAODVertex* AliAnalysisVertexingHF::PrimaryVertex(const TObjArray *trkArray,
       return vertexAOD;
     }
 
-    delete vertexer; vertexer=NULL;
-
   }
 
   // convert to AliAODVertex
@@ -2894,7 +2980,7 @@ void AliAnalysisVertexingHF::PrintStatus() const {
     printf("Secondary vertex with AliVertexerTracks\n");
   }
   if(fRecoPrimVtxSkippingTrks) printf("RecoPrimVtxSkippingTrks\n");
-  if(fRmTrksFromPrimVtx) printf("RmTrksFromPrimVtx\n");
+  if(fRmTrksFromPrimVtx) printf("RmTrksFromPrimVtx%s\n",fCachePrimVtxRemoval ? " (cached track contributions)" : "");
   if(fD0toKpi) {
     printf("Reconstruct D0->Kpi candidates with cuts:\n");
     if(fCutsD0toKpi) fCutsD0toKpi->PrintAll();
@@ -3695,6 +3781,35 @@ void AliAnalysisVertexingHF::SetParametersAtVertex(AliESDtrack* esdt, const AliE
   return;
 }
 //-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::FillMomentaAtVertex(const TObjArray &tracksAtVertex,Int_t nSeleTrks,Double_t *momAtVtx) const{
+  /// Store px,py,pz and the energy in the pion hypothesis of the selected tracks
+  /// at primary vertex, 4 values per track, for the mass pre-filter
+
+  Double_t massPi=TDatabasePDG::Instance()->GetParticle(211)->Mass();
+  for(Int_t iTrk=0; iTrk<nSeleTrks; iTrk++) {
+    Double_t *mom=&momAtVtx[4*iTrk];
+    ((AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrk))->GetPxPyPz(mom);
+    mom[3]=TMath::Sqrt(mom[0]*mom[0]+mom[1]*mom[1]+mom[2]*mom[2]+massPi*massPi);
+  }
+  return;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::PairPassesMassBound(const Double_t *momAtVtx,Int_t iTrk1,Int_t iTrk2,
+						   Double_t maxPairMass) const{
+  /// Check the invariant mass of the tracks iTrk1 and iTrk2 in the pion hypothesis
+  /// against the upper limit maxPairMass (no check if maxPairMass<0)
+  /// momAtVtx: px,py,pz,E(pion) of the selected tracks, see FillMomentaAtVertex
+
+  if(maxPairMass<0.) return kTRUE;
+  const Double_t *mom1=&momAtVtx[4*iTrk1];
+  const Double_t *mom2=&momAtVtx[4*iTrk2];
+  Double_t e=mom1[3]+mom2[3];
+  Double_t px=mom1[0]+mom2[0];
+  Double_t py=mom1[1]+mom2[1];
+  Double_t pz=mom1[2]+mom2[2];
+  return (e*e-px*px-py*py-pz*pz < maxPairMass*maxPairMass);
+}
+//-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::SetMasses(){
   /// Set the hadron mass values from TDatabasePDG
 
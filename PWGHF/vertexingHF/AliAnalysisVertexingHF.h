@@ -43,6 +43,7 @@ class AliESDtrack;
 class AliVEvent;
 class AliAODVertex;
 class AliVertexerTracks;
+class AliHFPrimVtxRemovalCache;
 class AliESDv0;
 class AliAODv0;
 
@@ -119,6 +120,11 @@ class AliAnalysisVertexingHF : public TNamed {
     { fRecoPrimVtxSkippingTrks=kFALSE; fRmTrksFromPrimVtx=kFALSE;}
   void SetRmTrksFromPrimVtx()
     {fRmTrksFromPrimVtx=kTRUE; fRecoPrimVtxSkippingTrks=kFALSE; }
+  /// with SetRmTrksFromPrimVtx, subtract cached track contributions from the
+  /// primary vertex instead of refitting for each candidate (off by default).
+  /// The vertex differs slightly from the refit, see AliHFPrimVtxRemovalCache
+  void SetCachePrimVtxRemoval(Bool_t cache=kTRUE) { fCachePrimVtxRemoval=cache; }
+  Bool_t GetCachePrimVtxRemoval() const { return fCachePrimVtxRemoval; }
   void SetTrackFilter(AliAnalysisFilter* trackF) {
     /// switch off the TOF selection that cannot be applied with AODTracks
     TList *l = (TList*)trackF->GetCuts();
@@ -262,6 +268,10 @@ class AliAnalysisVertexingHF : public TNamed {
                                    /// for each candidate, w/o its daughters
   Bool_t fRmTrksFromPrimVtx; /// flag for fast removal of daughters from
                              /// the primary vertex
+  Bool_t fCachePrimVtxRemoval; /// with fRmTrksFromPrimVtx, cache the track
+                               /// contributions to the primary vertex in FindCandidates
+                               /// (default: kFALSE, refit for each candidate)
+  AliHFPrimVtxRemovalCache *fPrimVtxRemovalCache; //! track contributions to fV1 for the event
 
   AliESDVertex *fV1; /// primary vertex
 
@@ -411,6 +421,8 @@ class AliAnalysisVertexingHF : public TNamed {
 				   Int_t &nSeleTrks,
 				   UChar_t *seleFlags,Int_t *evtNumber);
   void SetParametersAtVertex(AliESDtrack* esdt, const AliExternalTrackParam* extpar) const;
+  void FillMomentaAtVertex(const TObjArray &tracksAtVertex,Int_t nSeleTrks,Double_t *momAtVtx) const;
+  Bool_t PairPassesMassBound(const Double_t *momAtVtx,Int_t iTrk1,Int_t iTrk2,Double_t maxPairMass) const;
 
   Bool_t SingleTrkCuts(AliESDtrack *trk,Float_t centralityperc, Bool_t &okDisplaced,Bool_t &okSoftPi, Bool_t &ok3prong, Bool_t &okBachelor) const;
 
@@ -420,7 +432,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,27);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,28);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
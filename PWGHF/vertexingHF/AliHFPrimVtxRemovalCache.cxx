@@ -0,0 +1,285 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* $Id$ */
+
+//----------------------------------------------------------------------------
+// Removal of the candidate daughters from the primary vertex, with the
+// contribution of each track to the vertex fit cached for the event.
+// Used by AliAnalysisVertexingHF::PrimaryVertex with fRmTrksFromPrimVtx.
+//----------------------------------------------------------------------------
+
+#include <TObjArray.h>
+#include <TMath.h>
+#include "AliLog.h"
+#include "AliESDVertex.h"
+#include "AliESDtrack.h"
+#include "AliVertexerTracks.h"
+#include "AliHFPrimVtxRemovalCache.h"
+
+/// \cond CLASSIMP
+ClassImp(AliHFPrimVtxRemovalCache);
+/// \endcond
+
+//----------------------------------------------------------------------------
+AliHFPrimVtxRemovalCache::AliHFPrimVtxRemovalCache() :
+TObject(),
+fVertexer(0x0),
+fVertex(0x0),
+fNIndices(0),
+fNContribOffset(-999),
+fTracksAtVertex(),
+fTrackIndex(),
+fContrib(),
+fNRemoved(),
+fNCandidates(0),
+fNChecked(0),
+fNCheckMismatch(0),
+fMaxPosPull(0.),
+fMaxCovRelDiff(0.),
+fMaxChi2Diff(0.)
+{
+  /// Default constructor
+  fDiamondXY[0]=0.; fDiamondXY[1]=0.;
+  for(Int_t k=0; k<kNPars; k++) fPars[k]=0.;
+}
+//----------------------------------------------------------------------------
+AliHFPrimVtxRemovalCache::~AliHFPrimVtxRemovalCache() {
+  /// Destructor
+  delete fVertexer;
+}
+//----------------------------------------------------------------------------
+void AliHFPrimVtxRemovalCache::Reset() {
+  /// Forget the vertex and the track contributions of the event
+
+  fVertex=0x0;
+  fNIndices=0;
+  fNContribOffset=-999;
+  fTracksAtVertex.clear();
+  fTrackIndex.clear();
+  fContrib.clear();
+  fNRemoved.clear();
+}
+//----------------------------------------------------------------------------
+void AliHFPrimVtxRemovalCache::SetVertex(const AliESDVertex *vtx,const Float_t *diamondxy,Double_t bzkG,
+					 const TObjArray *tracks,const TObjArray *tracksAtVertex,Int_t nTracks) {
+  /// Set the primary vertex of the event, to be used until the next call or Reset.
+  /// tracks, tracksAtVertex: selected tracks and their parameters at the primary
+  /// vertex (not owned, to be kept until Reset); the contributions are computed
+  /// from these parameters
+
+  Reset();
+  if(!vtx) return;
+
+  for(Int_t i=0; i<nTracks; i++) {
+    const AliESDtrack *track=(const AliESDtrack*)tracks->UncheckedAt(i);
+    if(!track || track->GetID()<0) continue;
+    // the first track with a given ID is kept, as for the contributions
+    fTracksAtVertex.insert(std::make_pair((UShort_t)track->GetID(),(const AliExternalTrackParam*)tracksAtVertex->UncheckedAt(i)));
+  }
+
+  if(!fVertexer) {
+    fVertexer=new AliVertexerTracks(bzkG);
+  } else if(fVertexer->GetFieldkG()!=bzkG) {
+    fVertexer->SetFieldkG(bzkG);
+  }
+  fDiamondXY[0]=diamondxy[0];
+  fDiamondXY[1]=diamondxy[1];
+
+  // weight matrix and weighted position of the vertex
+  Double_t pos[3],cov[6];
+  vtx->GetXYZ(pos);
+  vtx->GetCovMatrix(cov);
+  if(!InvertCov(cov,fPars)) return;
+  fPars[6]=fPars[0]*pos[0]+fPars[1]*pos[1]+fPars[3]*pos[2];
+  fPars[7]=fPars[1]*pos[0]+fPars[2]*pos[1]+fPars[4]*pos[2];
+  fPars[8]=fPars[3]*pos[0]+fPars[4]*pos[1]+fPars[5]*pos[2];
+  fPars[9]=vtx->GetChi2();
+
+  fVertex=vtx;
+  fNIndices=vtx->GetNIndices();
+}
+//----------------------------------------------------------------------------
+Bool_t AliHFPrimVtxRemovalCache::RemoveTracks(const TObjArray *trkArray,AliESDVertex *&vertex) {
+  /// Primary vertex without the tracks of trkArray, as
+  /// AliVertexerTracks::RemoveTracksFromVertex (new object, owned by the caller).
+  /// vertex is 0x0 if less than 2 tracks would be left.
+  /// Returns kFALSE if the removal has to be done with AliVertexerTracks.
+
+  vertex=0x0;
+  if(!fVertex) return kFALSE;
+
+  Double_t pars[kNPars];
+  for(Int_t k=0; k<kNPars; k++) pars[k]=fPars[k];
+  Int_t nIndices=fNIndices;
+
+  Int_t nTrks=trkArray->GetEntriesFast();
+  for(Int_t i=0; i<nTrks; i++) {
+    TObject *obj=trkArray->UncheckedAt(i);
+    if(!obj || obj->IsA()!=AliESDtrack::Class()) return kFALSE;
+    Int_t index=GetContribution((AliESDtrack*)obj);
+    if(index<0) return kFALSE;
+    const Double_t *contrib=&fContrib[kNPars*index];
+    for(Int_t k=0; k<kNPars; k++) pars[k]-=contrib[k];
+    nIndices-=fNRemoved[index];
+  }
+
+  if(nIndices<fNIndices && nIndices<2) {
+    // "Trying to remove too many tracks"
+  } else {
+    if(fNContribOffset==-999) return kFALSE;
+
+    Double_t pos[3],cov[6];
+    if(!InvertCov(pars,cov)) return kFALSE;
+    pos[0]=cov[0]*pars[6]+cov[1]*pars[7]+cov[3]*pars[8];
+    pos[1]=cov[1]*pars[6]+cov[2]*pars[7]+cov[4]*pars[8];
+    pos[2]=cov[3]*pars[6]+cov[4]*pars[7]+cov[5]*pars[8];
+
+    vertex=new AliESDVertex(pos,cov,pars[9],nIndices+fNContribOffset);
+    vertex->SetTitle(fVertex->GetTitle());
+  }
+
+  if(AliDebugLevel()>=1 && (fNCandidates%kCheckEvery)==0) CheckRemoval(trkArray,vertex);
+  fNCandidates++;
+  return kTRUE;
+}
+//----------------------------------------------------------------------------
+void AliHFPrimVtxRemovalCache::CheckRemoval(const TObjArray *trkArray,const AliESDVertex *vertex) {
+  /// Compare the vertex obtained with the cache with RemoveTracksFromVertex,
+  /// done as in AliAnalysisVertexingHF::PrimaryVertex without the cache
+
+  Int_t nTrks=trkArray->GetEntriesFast();
+  TObjArray rmArray(nTrks);
+  UShort_t *rmId=new UShort_t[nTrks];
+  for(Int_t i=0; i<nTrks; i++) {
+    AliESDtrack *esdTrack=new AliESDtrack(*(AliESDtrack*)trkArray->UncheckedAt(i));
+    rmArray.AddLast(esdTrack);
+    rmId[i]=(esdTrack->GetID()>=0) ? (UShort_t)esdTrack->GetID() : 9999;
+  }
+  AliESDVertex *ref=fVertexer->RemoveTracksFromVertex(const_cast<AliESDVertex*>(fVertex),&rmArray,rmId,fDiamondXY);
+  delete [] rmId;
+  rmArray.Delete();
+
+  fNChecked++;
+  Int_t nContrib=vertex ? vertex->GetNContributors() : -1;
+  Int_t nContribRef=ref ? ref->GetNContributors() : -1;
+  if(nContrib!=nContribRef) {
+    fNCheckMismatch++;
+    AliDebug(1,Form("Candidate %lld: %d contributors, %d with RemoveTracksFromVertex (-1: no vertex)",fNCandidates,nContrib,nContribRef));
+  }
+  if(vertex && ref) {
+    Double_t pos[3],cov[6],posRef[3],covRef[6];
+    vertex->GetXYZ(pos);
+    vertex->GetCovMatrix(cov);
+    ref->GetXYZ(posRef);
+    ref->GetCovMatrix(covRef);
+    const Int_t kDiag[3]={0,2,5};
+    for(Int_t k=0; k<3; k++) {
+      Double_t covDiag=covRef[kDiag[k]];
+      if(covDiag<=0.) continue;
+      fMaxPosPull=TMath::Max(fMaxPosPull,TMath::Abs(pos[k]-posRef[k])/TMath::Sqrt(covDiag));
+      fMaxCovRelDiff=TMath::Max(fMaxCovRelDiff,TMath::Abs(cov[kDiag[k]]-covDiag)/covDiag);
+    }
+    fMaxChi2Diff=TMath::Max(fMaxChi2Diff,TMath::Abs(vertex->GetChi2()-ref->GetChi2()));
+  }
+  delete ref;
+}
+//----------------------------------------------------------------------------
+void AliHFPrimVtxRemovalCache::PrintCheck() const {
+  /// Print the comparison with RemoveTracksFromVertex, if candidates
+  /// were compared (debug level >= 1 for this class)
+
+  if(!fNChecked) return;
+  printf("AliHFPrimVtxRemovalCache: %lld of %lld candidates compared with RemoveTracksFromVertex\n",fNChecked,fNCandidates);
+  printf("  different n. of contributors or missing vertex: %lld\n",fNCheckMismatch);
+  printf("  max |position difference|/sigma: %g\n",fMaxPosPull);
+  printf("  max relative difference of the variances: %g\n",fMaxCovRelDiff);
+  printf("  max |chi2 difference|: %g\n",fMaxChi2Diff);
+}
+//----------------------------------------------------------------------------
+Int_t AliHFPrimVtxRemovalCache::GetContribution(const AliESDtrack *track) {
+  /// Index of the contribution of the track to the vertex fit,
+  /// obtained from the removal of the track alone at the first call,
+  /// with the parameters of the track at the primary vertex.
+  /// -1 if not available
+
+  // same track ID as in AliAnalysisVertexingHF::PrimaryVertex
+  UShort_t id=(track->GetID()>=0) ? (UShort_t)track->GetID() : 9999;
+  std::map<UShort_t,Int_t>::const_iterator it=fTrackIndex.find(id);
+  if(it!=fTrackIndex.end()) return it->second;
+
+  Double_t contrib[kNPars];
+  for(Int_t k=0; k<kNPars; k++) contrib[k]=0.;
+  Int_t nRemoved=0;
+  Bool_t ok=kTRUE;
+
+  std::map<UShort_t,const AliExternalTrackParam*>::const_iterator itpar=fTracksAtVertex.find(id);
+  if(fVertex->UsesTrack(id)) ok=kFALSE;
+  if(fVertex->UsesTrack(id) && itpar!=fTracksAtVertex.end()) {
+    // same point and frame for all candidates using the track
+    const AliExternalTrackParam *par=itpar->second;
+    AliESDtrack *trackAtVertex=new AliESDtrack(*track);
+    trackAtVertex->Set(par->GetX(),par->GetAlpha(),par->GetParameter(),par->GetCovariance());
+    TObjArray rmArray(1);
+    rmArray.AddLast(trackAtVertex);
+    AliESDVertex *vtx=fVertexer->RemoveTracksFromVertex(const_cast<AliESDVertex*>(fVertex),&rmArray,&id,fDiamondXY);
+    rmArray.Delete();
+    if(vtx) {
+      Double_t pos[3],cov[6],w[6];
+      vtx->GetXYZ(pos);
+      vtx->GetCovMatrix(cov);
+      nRemoved=fNIndices-vtx->GetNIndices();
+      if(nRemoved==1 && InvertCov(cov,w)) {
+	for(Int_t k=0; k<6; k++) contrib[k]=fPars[k]-w[k];
+	contrib[6]=fPars[6]-(w[0]*pos[0]+w[1]*pos[1]+w[3]*pos[2]);
+	contrib[7]=fPars[7]-(w[1]*pos[0]+w[2]*pos[1]+w[4]*pos[2]);
+	contrib[8]=fPars[8]-(w[3]*pos[0]+w[4]*pos[1]+w[5]*pos[2]);
+	contrib[9]=fPars[9]-vtx->GetChi2();
+	if(fNContribOffset==-999) fNContribOffset=vtx->GetNContributors()-vtx->GetNIndices();
+	ok=kTRUE;
+      }
+      delete vtx;
+    }
+  }
+
+  Int_t index=-1;
+  if(ok) {
+    index=(Int_t)fNRemoved.size();
+    fContrib.insert(fContrib.end(),contrib,contrib+kNPars);
+    fNRemoved.push_back(nRemoved);
+  }
+  fTrackIndex[id]=index;
+  return index;
+}
+//----------------------------------------------------------------------------
+Bool_t AliHFPrimVtxRemovalCache::InvertCov(const Double_t *sym,Double_t *inv) {
+  /// Inverse of a symmetric 3x3 matrix (xx,xy,yy,xz,yz,zz)
+
+  Double_t c00=sym[2]*sym[5]-sym[4]*sym[4];
+  Double_t c01=sym[3]*sym[4]-sym[1]*sym[5];
+  Double_t c11=sym[0]*sym[5]-sym[3]*sym[3];
+  Double_t c02=sym[1]*sym[4]-sym[3]*sym[2];
+  Double_t c12=sym[1]*sym[3]-sym[0]*sym[4];
+  Double_t c22=sym[0]*sym[2]-sym[1]*sym[1];
+  Double_t det=sym[0]*c00+sym[1]*c01+sym[3]*c02;
+  if(det==0.) return kFALSE;
+  inv[0]=c00/det;
+  inv[1]=c01/det;
+  inv[2]=c11/det;
+  inv[3]=c02/det;
+  inv[4]=c12/det;
+  inv[5]=c22/det;
+  return kTRUE;
+}
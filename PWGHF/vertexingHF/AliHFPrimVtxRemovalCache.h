@@ -0,0 +1,97 @@
+#ifndef ALIHFPRIMVTXREMOVALCACHE_H
+#define ALIHFPRIMVTXREMOVALCACHE_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+//-------------------------------------------------------------------------
+/// \class AliHFPrimVtxRemovalCache
+/// \brief Removal of candidate daughters from the primary vertex, with
+///        the track contributions cached for the event
+///
+/// AliVertexerTracks::RemoveTracksFromVertex subtracts from the weight
+/// matrix, the weighted position and the chi2 of the primary vertex the
+/// contribution of each removed track. These contributions do not depend
+/// on the other removed tracks: they are obtained once per track and event
+/// (from the removal of that track alone) and subtracted in closed form
+/// for each candidate, so that the D0, D+, Ds, Lc and 4-prong candidates
+/// sharing a daughter share its contribution.
+///
+/// The contribution of a track is computed from its parameters at the
+/// primary vertex (the tracksAtVertex copy of AliAnalysisVertexingHF), not
+/// from the daughter as passed, which can be propagated to the secondary
+/// vertex of the candidate. The vertex has no track indices. Candidates with
+/// tracks that are not AliESDtrack, tracks not given to SetVertex, or whose
+/// contribution cannot be obtained, are left to RemoveTracksFromVertex.
+///
+/// The result is therefore not identical to RemoveTracksFromVertex, which
+/// uses the daughters as passed: the position, covariance and chi2 of the
+/// vertex differ for candidates with a daughter already propagated to a
+/// secondary vertex, and by rounding otherwise. This difference is accepted
+/// in exchange for the refit per candidate; the cache is only used if
+/// enabled with AliAnalysisVertexingHF::SetCachePrimVtxRemoval.
+///
+/// With debug level >= 1 for this class, every kCheckEvery-th candidate is
+/// also given to RemoveTracksFromVertex (with the daughters as passed, as
+/// without the cache) and the difference is reported, see PrintCheck.
+//-------------------------------------------------------------------------
+
+#include <TObject.h>
+#include <map>
+#include <vector>
+
+class TObjArray;
+class AliESDVertex;
+class AliESDtrack;
+class AliExternalTrackParam;
+class AliVertexerTracks;
+
+class AliHFPrimVtxRemovalCache : public TObject {
+ public:
+  AliHFPrimVtxRemovalCache();
+  virtual ~AliHFPrimVtxRemovalCache();
+
+  void SetVertex(const AliESDVertex *vtx,const Float_t *diamondxy,Double_t bzkG,
+		 const TObjArray *tracks,const TObjArray *tracksAtVertex,Int_t nTracks);
+  void Reset();
+  const AliESDVertex *GetVertex() const {return fVertex;}
+  Int_t GetNCachedTracks() const {return (Int_t)fTrackIndex.size();}
+
+  Bool_t RemoveTracks(const TObjArray *trkArray,AliESDVertex *&vertex);
+  void PrintCheck() const;
+
+ private:
+  AliHFPrimVtxRemovalCache(const AliHFPrimVtxRemovalCache& source);
+  AliHFPrimVtxRemovalCache& operator=(const AliHFPrimVtxRemovalCache& source);
+
+  Int_t GetContribution(const AliESDtrack *track);
+  void CheckRemoval(const TObjArray *trkArray,const AliESDVertex *vertex);
+  static Bool_t InvertCov(const Double_t *sym,Double_t *inv);
+
+  enum {kNPars=10};       // weight matrix (6), weighted position (3), chi2
+  enum {kCheckEvery=100}; // with debug level >= 1, compare one candidate out of kCheckEvery
+
+  AliVertexerTracks *fVertexer;         //! vertexer for the single-track removals
+  const AliESDVertex *fVertex;          //! primary vertex of the event (not owned)
+  Float_t fDiamondXY[2];                //! diamond position, as in RemoveTracksFromVertex
+  Int_t fNIndices;                      //! n. of tracks used in the fit of fVertex
+  Int_t fNContribOffset;                //! n. of contributors minus n. of indices of a vertex after removal (-999: unknown)
+  Double_t fPars[kNPars];               //! weight matrix, weighted position and chi2 of fVertex
+  std::map<UShort_t,const AliExternalTrackParam*> fTracksAtVertex; //! track ID -> parameters at primary vertex (not owned)
+  std::map<UShort_t,Int_t> fTrackIndex; //! track ID -> index of its contribution (-1: not available)
+  std::vector<Double_t> fContrib;       //! kNPars values per track
+  std::vector<Int_t> fNRemoved;         //! n. of indices removed with each track (0 or 1)
+  Long64_t fNCandidates;                //! n. of candidates removed with the cache
+  Long64_t fNChecked;                   //! n. of candidates compared with RemoveTracksFromVertex
+  Long64_t fNCheckMismatch;             //! n. of compared candidates with a different n. of contributors or no vertex in one of the two
+  Double_t fMaxPosPull;                 //! max |position difference|/sigma of the compared candidates
+  Double_t fMaxCovRelDiff;              //! max relative difference of the diagonal covariance elements
+  Double_t fMaxChi2Diff;                //! max |chi2 difference|
+
+  /// \cond CLASSIMP
+  ClassDef(AliHFPrimVtxRemovalCache,1); // Cached removal of tracks from the primary vertex
+  /// \endcond
+};
+
+#endif